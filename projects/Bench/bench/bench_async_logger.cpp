@@ -0,0 +1,54 @@
+/**
+ * @brief Бенчмарк горячего пути асинхронного журнала.
+ * @note Меряется только `log` в потоке графика: запись в очередь, форматирование и запись в файл идут в фоновом потоке.
+ * Записи идут пачками размером с очередь, между пачками журнал сбрасывается вне замера, поэтому записи не отбрасываются.
+ */
+#include "bench_common.hpp"
+
+#include "sierra/core/async_logger.hpp"
+
+#include <filesystem>
+
+namespace {
+
+void BM_AsyncLoggerLog(benchmark::State& state) {
+  const auto burst = static_cast<std::size_t>(state.range(0));
+  sierra::core::AsyncLoggerOptions options;
+  options.path = (std::filesystem::temp_directory_path() / "sierra_bench_async_logger.log").string();
+  options.ring_capacity = burst;
+  options.max_files = 0;
+  {
+    sierra::core::AsyncLogger logger(options);
+    std::int64_t index = 0;
+    for (auto _ : state) {
+      for (std::size_t i = 0; i < burst; ++i) {
+        benchmark::DoNotOptimize(
+            logger.log(sierra::core::LogLevel::kInfo, "bar {} close {} period {}", index++, 4000.25, 20));
+      }
+      // Между пачками фоновый поток успевает всё записать — как между обновлениями графика.
+      state.PauseTiming();
+      logger.flush();
+      state.ResumeTiming();
+    }
+    state.counters["per_record"] = benchmark::Counter(static_cast<double>(state.iterations() * burst),
+                                                      benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    state.counters["dropped"] = static_cast<double>(logger.dropped());
+  }
+  std::filesystem::remove(options.path);
+}
+BENCHMARK(BM_AsyncLoggerLog)->ArgName("burst")->Arg(64)->Arg(1024);
+
+void BM_AsyncLoggerFiltered(benchmark::State& state) {
+  sierra::core::AsyncLoggerOptions options;
+  options.path = (std::filesystem::temp_directory_path() / "sierra_bench_async_logger.log").string();
+  {
+    sierra::core::AsyncLogger logger(options);
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(logger.log(sierra::core::LogLevel::kDebug, "bar {}", 1));
+    }
+  }
+  std::filesystem::remove(options.path);
+}
+BENCHMARK(BM_AsyncLoggerFiltered);
+
+}  // namespace
@@ -0,0 +1,57 @@
+/**
+ * @brief Бенчмарки событийного бэктестера.
+ * @note Стратегия разворачивается каждые 1000 тиков со скобкой OCO; прогон с исполнением «по касанию» и с моделью стакана.
+ */
+#include "bench_common.hpp"
+
+#include "sierra/core/backtester.hpp"
+#include "sierra/core/depth_fill.hpp"
+
+namespace {
+
+struct FlipStrategy {
+  std::size_t tick = 0;
+
+  void on_tick(sierra::core::Backtester& backtester, const sierra::core::ScidRecord&) {
+    if (++tick % 1000 != 0) {
+      return;
+    }
+    sierra::core::OrderRequest request;
+    request.side = (tick / 1000) % 2 == 0 ? sierra::core::OrderSide::kBuy : sierra::core::OrderSide::kSell;
+    request.quantity = 1 + (backtester.position() != 0 ? 1 : 0);
+    request.target_offset = 4.0;
+    request.stop_offset = 2.0;
+    backtester.submit(request);
+  }
+};
+
+sierra::core::DepthBook MakeBook(const std::vector<sierra::core::ScidRecord>& ticks) {
+  sierra::core::DepthBook book(0.25);
+  std::vector<sierra::core::DepthLevel> levels(81, sierra::core::DepthLevel{20, 20, 10, 10});
+  for (std::size_t i = 0; i < ticks.size(); i += 6000) {
+    book.add_bar(ticks[i].date_time, book.tick_index(ticks[i].close) - 40, levels);
+  }
+  return book;
+}
+
+void BM_Backtester(benchmark::State& state) {
+  const auto ticks = sierra::bench::synthetic_ticks(static_cast<std::size_t>(state.range(0)));
+  const bool with_depth = state.range(1) != 0;
+  const sierra::core::DepthBook book = MakeBook(ticks);
+  const sierra::core::DepthFillModel model(book);
+  for (auto _ : state) {
+    sierra::core::Backtester backtester;
+    if (with_depth) {
+      backtester.set_fill_model(&model);
+    }
+    FlipStrategy strategy;
+    backtester.run(ticks.data(), ticks.size(), strategy);
+    benchmark::DoNotOptimize(backtester.statistics().net_profit());
+  }
+  sierra::bench::set_items(state, ticks.size(), sizeof(sierra::core::ScidRecord));
+}
+BENCHMARK(BM_Backtester)->ArgNames({"size", "depth"})->Apply([](benchmark::internal::Benchmark* bench) {
+  sierra::bench::add_sizes(bench, {0, 1}, 10000000);
+});
+
+}  // namespace
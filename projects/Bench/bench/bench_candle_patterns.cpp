@@ -0,0 +1,93 @@
+/**
+ * @brief Бенчмарк поиска свечных моделей.
+ * @note `BM_CandlePatternsScalar` — `is_candle_pattern` по 64 моделям маски на каждом баре, как цикл исследования;
+ * `BM_CandlePatterns` — маски `CandlePatternEngine`, `trend:1` — с определением тренда. Элементы — бары, байты —
+ * шесть столбцов `float` на бар.
+ */
+#include "bench_common.hpp"
+
+#include "sierra/core/candle_patterns.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+/// @brief Бары из блуждания: открытие — прошлое закрытие, тени — по соседним шагам блуждания.
+struct Bars {
+  std::vector<float> open, high, low, close, hl_avg, ohlc_avg;
+
+  explicit Bars(std::size_t count) {
+    const auto walk = sierra::bench::random_walk(count + 2);
+    for (std::size_t i = 1; i <= count; ++i) {
+      const auto o = static_cast<float>(walk[i - 1]);
+      const auto c = static_cast<float>(walk[i]);
+      const auto h = (std::max)({o, c, static_cast<float>(walk[i + 1])});
+      const auto l = (std::min)({o, c, static_cast<float>(walk[i + 1])});
+      open.push_back(o);
+      high.push_back(h);
+      low.push_back(l);
+      close.push_back(c);
+      hl_avg.push_back((h + l) / 2);
+      ohlc_avg.push_back((o + h + l + c) / 4);
+    }
+  }
+
+  sierra::core::CandleSeries series() const {
+    return {open.data(), high.data(), low.data(), close.data(), hl_avg.data(), ohlc_avg.data(), open.size()};
+  }
+};
+
+void BM_CandlePatternsScalar(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  const Bars bars(count);
+  const sierra::core::CandleSeries series = bars.series();
+  const sierra::core::CandlePatternSettings settings;
+  std::vector<std::uint64_t> masks(count);
+  std::vector<std::uint64_t> high_masks(count);
+  for (auto _ : state) {
+    for (std::size_t bar = 0; bar < count; ++bar) {
+      std::uint64_t mask[2] = {};
+      for (std::size_t number = 1; number <= sierra::core::kCandlePatternCount; ++number) {
+        const auto pattern = static_cast<sierra::core::CandlePattern>(number);
+        mask[sierra::core::candle_mask_word(pattern)] |=
+            sierra::core::is_candle_pattern(series, nullptr, settings, pattern, bar)
+                ? sierra::core::candle_mask_bit(pattern)
+                : 0;
+      }
+      masks[bar] = mask[0];
+      high_masks[bar] = mask[1];
+    }
+    benchmark::DoNotOptimize(masks.data());
+    benchmark::DoNotOptimize(high_masks.data());
+  }
+  sierra::bench::set_items(state, count, 6 * sizeof(float));
+}
+BENCHMARK(BM_CandlePatternsScalar)->ArgName("size")->Apply([](benchmark::internal::Benchmark* bench) {
+  sierra::bench::add_sizes(bench, {}, 100000);
+});
+
+void BM_CandlePatterns(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  const Bars bars(count);
+  sierra::core::CandlePatternSettings settings;
+  settings.use_trend_detection = state.range(1) != 0;
+  sierra::core::CandlePatternEngine engine(settings);
+  for (auto _ : state) {
+    engine.evaluate(bars.series());
+    benchmark::DoNotOptimize(engine.masks().data());
+    benchmark::DoNotOptimize(engine.high_masks().data());
+  }
+  std::size_t found = 0;
+  for (const std::uint64_t mask : engine.masks()) {
+    found += mask != 0 ? 1 : 0;
+  }
+  state.counters["bars_with_patterns"] = static_cast<double>(found);
+  sierra::bench::set_items(state, count, 6 * sizeof(float));
+}
+BENCHMARK(BM_CandlePatterns)->ArgNames({"size", "trend"})->Apply([](benchmark::internal::Benchmark* bench) {
+  sierra::bench::add_sizes(bench, {0, 1}, 10000000);
+});
+
+}  // namespace
@@ -0,0 +1,51 @@
+/**
+ * @brief Бенчмарк перезагрузки графика из файла посчитанных значений.
+ * @note `cached:0` — полный пересчёт скользящего среднего, как после замены DLL без кэша; `cached:1` — сверка и
+ * копирование блоков из отображённого файла и расчёт хвоста за последним блоком.
+ */
+#include "bench_common.hpp"
+
+#include "sierra/core/column_store.hpp"
+#include "sierra/core/moving_average.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+void BM_ChartReload(benchmark::State& state) {
+  const auto bars = static_cast<std::size_t>(state.range(0));
+  const bool cached = state.range(1) != 0;
+  const auto walk = sierra::bench::random_walk(bars);
+  const std::vector<float> closes(walk.begin(), walk.end());
+  std::vector<std::int64_t> times(bars);
+  for (std::size_t i = 0; i < bars; ++i) {
+    times[i] = 60'000'000LL * static_cast<std::int64_t>(i);
+  }
+  const sierra::core::MovingAverageConfig config{20};
+  std::vector<float> output(bars);
+  const std::string path = "sierra_bench_" + std::to_string(bars) + ".col";
+  const std::uint64_t key = sierra::core::persistent_hash({"BENCH", 60, "SierraStudy.MovingAverage", {20.0}, 0});
+  {
+    sierra::core::MovingAverageEngine engine(config);
+    engine.update(closes.data(), bars, 0, output.data());
+    sierra::core::ColumnStore(path, key).store(times.data(), closes.data(), output.data(), bars - 1);
+  }
+  std::size_t loaded = 0;
+  for (auto _ : state) {
+    sierra::core::MovingAverageEngine engine(config);
+    if (cached) {
+      sierra::core::ColumnStore store(path, key);
+      loaded = store.load(times.data(), closes.data(), bars - 1, output.data());
+    }
+    engine.update(closes.data(), bars, loaded, output.data());
+    benchmark::DoNotOptimize(output.data());
+  }
+  std::remove(path.c_str());
+  state.counters["loaded"] = static_cast<double>(loaded);
+  sierra::bench::set_items(state, bars, sizeof(float));
+}
+BENCHMARK(BM_ChartReload)->ArgNames({"bars", "cached"})->Args({1000000, 0})->Args({1000000, 1});
+
+}  // namespace
@@ -0,0 +1,54 @@
+#include "bench_common.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+
+namespace sierra::bench {
+
+void add_sizes(benchmark::internal::Benchmark* bench, const std::vector<std::int64_t>& second,
+               std::int64_t largest) {
+  std::int64_t limit = largest;
+  if (const char* text = std::getenv("SIERRA_BENCH_MAX_SIZE")) {
+    const std::int64_t value = std::atoll(text);
+    limit = value > 0 ? (std::min)(value, largest) : largest;
+  }
+  for (std::int64_t size = 1000; size <= limit; size *= 10) {
+    if (second.empty()) {
+      bench->Arg(size);
+    }
+    for (const std::int64_t value : second) {
+      bench->Args({size, value});
+    }
+  }
+}
+
+std::vector<double> random_walk(std::size_t count, std::uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<double> prices(count);
+  double price = 4000.0;
+  for (auto& value : prices) {
+    price += 0.25 * static_cast<double>(static_cast<int>(rng() % 5) - 2);
+    value = price;
+  }
+  return prices;
+}
+
+std::vector<core::ScidRecord> synthetic_ticks(std::size_t count, std::uint64_t seed) {
+  const std::vector<double> prices = random_walk(count, seed);
+  std::vector<core::ScidRecord> ticks(count);
+  const std::int64_t start = 3'900'000'000'000'000;  // 2023 год в микросекундах SCDateTime
+  for (std::size_t i = 0; i < count; ++i) {
+    auto& tick = ticks[i];
+    tick.date_time = start + static_cast<std::int64_t>(i) * 10'000;
+    tick.close = static_cast<float>(prices[i]);
+    tick.low = tick.close - 0.25f;
+    tick.high = tick.close;
+    tick.num_trades = 1;
+    tick.total_volume = 1 + static_cast<std::uint32_t>(i % 7);
+    (i % 2 == 0 ? tick.bid_volume : tick.ask_volume) = tick.total_volume;
+  }
+  return ticks;
+}
+
+}  // namespace sierra::bench
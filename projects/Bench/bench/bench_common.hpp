@@ -0,0 +1,36 @@
+#pragma once
+
+#include "sierra/core/scid_file.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sierra::bench {
+
+/// @brief Наибольший размер входа по умолчанию (1e8 элементов).
+constexpr std::int64_t kMaxSize = 100000000;
+
+/// @brief Регистрирует размеры входа 1e3, 1e4, ... до предела.
+/// @param bench Регистрируемый бенчмарк.
+/// @param second Значения второго аргумента (период, точность и т. п.); для каждого размера регистрируются все.
+/// @param largest Наибольший размер для ядер, которым 1e8 элементов не поместится в память.
+/// @note Предел можно понизить переменной окружения `SIERRA_BENCH_MAX_SIZE`, чтобы прогон уместился в память машины.
+void add_sizes(benchmark::internal::Benchmark* bench, const std::vector<std::int64_t>& second = {},
+               std::int64_t largest = kMaxSize);
+
+/// @brief Детерминированное случайное блуждание цены с шагом тика.
+std::vector<double> random_walk(std::size_t count, std::uint64_t seed = 1);
+
+/// @brief Синтетические тики: блуждание цены, сделки по Bid/Ask, шаг времени 10 мс.
+std::vector<core::ScidRecord> synthetic_ticks(std::size_t count, std::uint64_t seed = 1);
+
+/// @brief Учитывает обработанные элементы и байты в отчёте.
+inline void set_items(benchmark::State& state, std::size_t items, std::size_t bytes_per_item) {
+  state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * items));
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * items * bytes_per_item));
+}
+
+}  // namespace sierra::bench
@@ -0,0 +1,45 @@
+/**
+ * @brief Бенчмарк масок пересечений цены и её скользящего среднего.
+ * @note `masks:0` — `cross_over` на каждом баре, как цикл исследований с `sc.CrossOver`; `masks:1` — маски
+ * `crossover_masks` и извлечение номеров событий. Байты — два столбца `float` на бар.
+ */
+#include "bench_common.hpp"
+
+#include "sierra/core/crossover.hpp"
+#include "sierra/core/moving_average.hpp"
+
+#include <vector>
+
+namespace {
+
+void BM_CrossoverMasks(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  const auto walk = sierra::bench::random_walk(count);
+  const std::vector<float> prices(walk.begin(), walk.end());
+  std::vector<float> average(count);
+  sierra::core::moving_average(prices.data(), count, 20, 0, average.data());
+  sierra::core::CrossMasks masks;
+  std::vector<std::size_t> events;
+  for (auto _ : state) {
+    events.clear();
+    if (state.range(1) != 0) {
+      sierra::core::crossover_masks(prices.data(), average.data(), count, masks);
+      sierra::core::extract_events(masks.from_bottom, events);
+      sierra::core::extract_events(masks.from_top, events);
+    } else {
+      for (std::size_t bar = 0; bar < count; ++bar) {
+        if (sierra::core::cross_over(prices.data(), average.data(), bar) != sierra::core::CrossDirection::kNone) {
+          events.push_back(bar);
+        }
+      }
+    }
+    benchmark::DoNotOptimize(events.data());
+  }
+  state.counters["events"] = static_cast<double>(events.size());
+  sierra::bench::set_items(state, count, 2 * sizeof(float));
+}
+BENCHMARK(BM_CrossoverMasks)->ArgNames({"size", "masks"})->Apply([](benchmark::internal::Benchmark* bench) {
+  sierra::bench::add_sizes(bench, {0, 1}, 10000000);
+});
+
+}  // namespace
@@ -0,0 +1,40 @@
+/**
+ * @brief Бенчмарки накопительной дельты.
+ * @note Бары по 100 сделок; сравниваются источники дельты.
+ */
+#include "bench_common.hpp"
+
+#include "sierra/core/cumulative_delta.hpp"
+
+namespace {
+
+void BM_CumulativeDelta(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  sierra::core::CumulativeDeltaOptions options;
+  options.source = static_cast<sierra::core::DeltaSource>(state.range(1));
+  std::vector<sierra::core::TradeRecord> trades(count);
+  const auto prices = sierra::bench::random_walk(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    trades[i].price = static_cast<float>(prices[i]);
+    trades[i].bid = trades[i].price - 0.25f;
+    trades[i].ask = trades[i].price;
+    trades[i].volume = 1 + static_cast<std::uint32_t>(i % 5);
+    trades[i].side = i % 3 == 0 ? sierra::core::TradeSide::kBid : sierra::core::TradeSide::kAsk;
+  }
+  for (auto _ : state) {
+    sierra::core::CumulativeDeltaEngine engine(options);
+    for (std::size_t i = 0; i < count; ++i) {
+      if (i % 100 == 0) {
+        engine.start_bar(i % 100000 == 0);
+      }
+      engine.add_trade(trades[i]);
+    }
+    benchmark::DoNotOptimize(engine.value());
+  }
+  sierra::bench::set_items(state, count, sizeof(sierra::core::TradeRecord));
+}
+BENCHMARK(BM_CumulativeDelta)->ArgNames({"size", "source"})->Apply([](benchmark::internal::Benchmark* bench) {
+  sierra::bench::add_sizes(bench, {0, 1, 2}, 10000000);
+});
+
+}  // namespace
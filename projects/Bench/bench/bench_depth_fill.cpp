@@ -0,0 +1,76 @@
+/**
+ * @brief Бенчмарки модели исполнения по стакану.
+ * @note Поиск бара по времени, продвижение очереди лимитной заявки и проход рыночной заявки по уровням.
+ */
+#include "bench_common.hpp"
+
+#include "sierra/core/depth_fill.hpp"
+
+#include <random>
+
+namespace {
+
+constexpr std::size_t kBars = 100000;
+
+sierra::core::DepthBook MakeBook() {
+  sierra::core::DepthBook book(0.25);
+  std::vector<sierra::core::DepthLevel> levels(81, sierra::core::DepthLevel{20, 20, 10, 10});
+  for (std::size_t bar = 0; bar < kBars; ++bar) {
+    book.add_bar(static_cast<std::int64_t>(bar) * 60'000'000, 16000 - 40, levels);
+  }
+  return book;
+}
+
+void BM_DepthBookLocate(benchmark::State& state) {
+  const sierra::core::DepthBook book = MakeBook();
+  const bool sequential = state.range(0) != 0;
+  std::vector<std::int64_t> times(4096);
+  std::mt19937_64 rng(3);
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    times[i] = sequential ? static_cast<std::int64_t>(i) * 1'000'000
+                          : static_cast<std::int64_t>(rng() % kBars) * 60'000'000;
+  }
+  std::size_t hint = 0;
+  std::size_t i = 0;
+  for (auto _ : state) {
+    hint = book.locate(times[i++ & 4095], hint);
+    benchmark::DoNotOptimize(hint);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DepthBookLocate)->ArgName("sequential")->Arg(1)->Arg(0);
+
+void BM_DepthLimitFill(benchmark::State& state) {
+  const sierra::core::DepthBook book = MakeBook();
+  const sierra::core::DepthFillModel model(book);
+  const auto ticks = sierra::bench::synthetic_ticks(4096);
+  std::size_t i = 0;
+  double queue = model.initial_queue(sierra::core::OrderSide::kBuy, 4000.0, 0);
+  for (auto _ : state) {
+    const auto& tick = ticks[i++ & 4095];
+    int filled = model.limit_fill(sierra::core::OrderSide::kBuy, tick.close, 5, queue, tick, 0);
+    if (filled != 0) {
+      queue = model.initial_queue(sierra::core::OrderSide::kBuy, tick.close, 0);
+    }
+    benchmark::DoNotOptimize(filled);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DepthLimitFill);
+
+void BM_DepthMarketPrice(benchmark::State& state) {
+  const sierra::core::DepthBook book = MakeBook();
+  const sierra::core::DepthFillModel model(book);
+  const auto quantity = static_cast<int>(state.range(0));
+  sierra::core::ScidRecord tick;
+  tick.close = 4000.0f;
+  tick.low = 3999.75f;
+  tick.high = 4000.0f;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(model.market_price(sierra::core::OrderSide::kBuy, quantity, tick, 0));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DepthMarketPrice)->ArgName("quantity")->Arg(1)->Arg(50)->Arg(500);
+
+}  // namespace
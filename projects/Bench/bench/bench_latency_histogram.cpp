@@ -0,0 +1,55 @@
+/**
+ * @brief Бенчмарк записи в гистограмму задержек и замера вызова тактами.
+ * @note `BM_LatencyHistogramTimedCall` повторяет то, что `StudyCallTimer` добавляет к каждому вызову исследования: два чтения тактов и запись.
+ */
+#include "bench_common.hpp"
+
+#include "sierra/core/latency_histogram.hpp"
+#include "sierra/core/tick_clock.hpp"
+
+#include <random>
+
+namespace {
+
+void BM_LatencyHistogramRecord(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  std::mt19937_64 rng(1);
+  std::lognormal_distribution<double> latency(8.0, 1.5);
+  std::vector<std::uint64_t> values(count);
+  for (auto& value : values) {
+    value = static_cast<std::uint64_t>(latency(rng));
+  }
+  sierra::core::LatencyHistogram histogram;
+  for (auto _ : state) {
+    for (std::uint64_t value : values) {
+      histogram.record(value);
+    }
+    benchmark::DoNotOptimize(histogram.count());
+  }
+  sierra::bench::set_items(state, count, sizeof(std::uint64_t));
+}
+BENCHMARK(BM_LatencyHistogramRecord)->ArgName("size")->Range(1000, 1000000);
+
+void BM_LatencyHistogramTimedCall(benchmark::State& state) {
+  sierra::core::LatencyHistogram histogram;
+  for (auto _ : state) {
+    const std::int64_t start = sierra::core::read_ticks();
+    const std::int64_t end = sierra::core::read_ticks();
+    histogram.record(static_cast<std::uint64_t>(end - start));
+  }
+  benchmark::DoNotOptimize(histogram.count());
+}
+BENCHMARK(BM_LatencyHistogramTimedCall);
+
+void BM_LatencyHistogramQuantile(benchmark::State& state) {
+  sierra::core::LatencyHistogram histogram;
+  for (std::uint64_t value = 1; value < 1000000; value = value * 3 / 2 + 1) {
+    histogram.record(value);
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(histogram.quantile(0.99));
+  }
+}
+BENCHMARK(BM_LatencyHistogramQuantile);
+
+}  // namespace
@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <string>
+
+namespace {
+
+/// @brief Компилятор и его версия для `context` JSON: эталоны разных компиляторов несравнимы.
+std::string CompilerName() {
+#if defined(_MSC_VER) && !defined(__clang__)
+  return "msvc " + std::to_string(_MSC_VER);
+#elif defined(__clang__)
+  return "clang " + std::to_string(__clang_major__) + "." + std::to_string(__clang_minor__);
+#elif defined(__GNUC__)
+  return "gcc " + std::to_string(__GNUC__) + "." + std::to_string(__GNUC_MINOR__);
+#else
+  return "unknown";
+#endif
+}
+
+}  // namespace
+
+/// @note Кроме `library_build_type` самого Google Benchmark, в `context` пишется сборка бенчмарков и предел размеров:
+/// `scripts/Compare-Bench.ps1` отказывается сравнивать прогоны, у которых они расходятся.
+int main(int argc, char** argv) {
+#ifdef NDEBUG
+  benchmark::AddCustomContext("sierra_build_type", "release");
+#else
+  benchmark::AddCustomContext("sierra_build_type", "debug");
+#endif
+  benchmark::AddCustomContext("sierra_compiler", CompilerName());
+  const char* maxSize = std::getenv("SIERRA_BENCH_MAX_SIZE");
+  benchmark::AddCustomContext("sierra_max_size", maxSize != nullptr && *maxSize != '\0' ? maxSize : "default");
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,29 @@
+/**
+ * @brief Бенчмарк бутстрэп-моделирования сделок.
+ * @note 500 сделок на путь; число путей меняется, пул — на все ядра машины.
+ */
+#include "bench_common.hpp"
+
+#include "sierra/core/monte_carlo.hpp"
+
+namespace {
+
+void BM_MonteCarlo(benchmark::State& state) {
+  std::vector<double> profits(500);
+  for (std::size_t i = 0; i < profits.size(); ++i) {
+    profits[i] = (static_cast<double>(i * 37 % 21) - 10.0) * 10.0;
+  }
+  sierra::core::MonteCarloOptions options;
+  options.paths = static_cast<std::size_t>(state.range(0));
+  options.starting_capital = 2000.0;
+  options.ruin_capital = 0.0;
+  sierra::core::ThreadPool pool;
+  for (auto _ : state) {
+    const auto report = sierra::core::monte_carlo(profits, options, pool);
+    benchmark::DoNotOptimize(report.ruined_paths);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(profits.size()));
+}
+BENCHMARK(BM_MonteCarlo)->ArgName("paths")->Arg(1000)->Arg(10000)->Arg(100000)->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,45 @@
+/**
+ * @brief Бенчмарки простого скользящего среднего.
+ * @note Размер входа 1e3..1e8 в сочетании с короткими и длинными периодами.
+ */
+#include "bench_common.hpp"
+
+#include "sierra/core/moving_average.hpp"
+
+#include <vector>
+
+namespace {
+
+void BM_MovingAverage(benchmark::State& state) {
+  const auto prices = sierra::bench::random_walk(static_cast<std::size_t>(state.range(0)));
+  const auto period = static_cast<std::size_t>(state.range(1));
+  for (auto _ : state) {
+    auto result = sierra::core::moving_average(prices, period);
+    benchmark::DoNotOptimize(result.data());
+  }
+  sierra::bench::set_items(state, prices.size(), sizeof(double));
+}
+
+BENCHMARK(BM_MovingAverage)->ArgNames({"size", "period"})->Apply([](benchmark::internal::Benchmark* bench) {
+  sierra::bench::add_sizes(bench, {5, 50, 500});
+});
+
+/// Диапазонная форма над массивами `float`, как в обёртке: полный пересчёт (`last_bar = 0`) и обновление последнего бара.
+void BM_MovingAverageRange(benchmark::State& state) {
+  const auto walk = sierra::bench::random_walk(static_cast<std::size_t>(state.range(0)));
+  const std::vector<float> prices(walk.begin(), walk.end());
+  std::vector<float> output(prices.size());
+  const std::size_t period = 50;
+  const std::size_t first = state.range(1) != 0 ? prices.size() - 1 : 0;
+  for (auto _ : state) {
+    sierra::core::moving_average(prices.data(), prices.size(), period, first, output.data());
+    benchmark::DoNotOptimize(output.data());
+  }
+  sierra::bench::set_items(state, prices.size() - first, sizeof(float));
+}
+
+BENCHMARK(BM_MovingAverageRange)->ArgNames({"size", "last_bar"})->Apply([](benchmark::internal::Benchmark* bench) {
+  sierra::bench::add_sizes(bench, {0, 1});
+});
+
+}  // namespace
@@ -0,0 +1,90 @@
+/**
+ * @brief Бенчмарки оптимизатора параметров и walk-forward анализа.
+ * @note Перебор сетки периодов пересечения средних на общем кэше индикаторов.
+ */
+#include "bench_common.hpp"
+
+#include "sierra/core/optimizer.hpp"
+#include "sierra/core/walk_forward.hpp"
+
+namespace {
+
+std::vector<float> Closes(const std::vector<sierra::core::ScidRecord>& ticks) {
+  std::vector<float> closes(ticks.size());
+  for (std::size_t i = 0; i < ticks.size(); ++i) {
+    closes[i] = ticks[i].close;
+  }
+  return closes;
+}
+
+void BM_IndicatorCache(benchmark::State& state) {
+  const auto walk = sierra::bench::random_walk(static_cast<std::size_t>(state.range(0)));
+  const std::vector<float> closes(walk.begin(), walk.end());
+  for (auto _ : state) {
+    sierra::core::IndicatorCache cache(closes);
+    for (std::size_t period = 10; period <= 100; period += 10) {
+      benchmark::DoNotOptimize(cache.moving_average(period)->data());
+    }
+  }
+  sierra::bench::set_items(state, closes.size() * 10, sizeof(float));
+}
+BENCHMARK(BM_IndicatorCache)->ArgName("size")->Apply([](benchmark::internal::Benchmark* bench) {
+  sierra::bench::add_sizes(bench, {}, 10000000);
+});
+
+void BM_OptimizeGrid(benchmark::State& state) {
+  const auto ticks = sierra::bench::synthetic_ticks(static_cast<std::size_t>(state.range(0)));
+  const auto candidates = sierra::core::grid_search(
+      {sierra::core::ParameterRange{"fast", 10.0, 50.0, 10.0}, sierra::core::ParameterRange{"slow", 100.0, 300.0, 100.0}});
+  sierra::core::ThreadPool pool;
+  for (auto _ : state) {
+    sierra::core::IndicatorCache cache(Closes(ticks));
+    sierra::core::ResultTable table(5);
+    sierra::core::optimize(
+        candidates,
+        [&](const sierra::core::ParameterSet& set) {
+          return sierra::core::evaluate_ma_crossover(ticks.data(), ticks.size(), cache,
+                                                     static_cast<std::size_t>(set[0]),
+                                                     static_cast<std::size_t>(set[1]), {});
+        },
+        pool, table);
+    benchmark::DoNotOptimize(table.evaluated());
+  }
+  sierra::bench::set_items(state, ticks.size() * candidates.size(), sizeof(sierra::core::ScidRecord));
+}
+BENCHMARK(BM_OptimizeGrid)->ArgName("size")->Arg(100000)->Arg(1000000)->UseRealTime();
+
+void BM_WalkForward(benchmark::State& state) {
+  const auto ticks = sierra::bench::synthetic_ticks(static_cast<std::size_t>(state.range(0)));
+  const auto candidates = sierra::core::grid_search(
+      {sierra::core::ParameterRange{"fast", 10.0, 50.0, 20.0}, sierra::core::ParameterRange{"slow", 100.0, 300.0, 100.0}});
+  sierra::core::WalkForwardOptions options;
+  options.segment_ticks = ticks.size() / 20;
+  options.train_segments = 4;
+  options.test_segments = 1;
+  sierra::core::ThreadPool pool;
+  for (auto _ : state) {
+    sierra::core::IndicatorCache cache(Closes(ticks));
+    sierra::core::Backtester account;
+    const auto report = sierra::core::walk_forward(
+        ticks.size(), candidates,
+        [&](const sierra::core::ParameterSet& set, std::size_t begin, std::size_t end) {
+          return sierra::core::evaluate_ma_crossover_range(ticks.data(), begin, end, cache,
+                                                           static_cast<std::size_t>(set[0]),
+                                                           static_cast<std::size_t>(set[1]), {})
+              .objective;
+        },
+        [&](const sierra::core::ParameterSet& set, std::size_t begin, std::size_t end) {
+          return sierra::core::continue_ma_crossover_range(ticks.data(), begin, end, cache,
+                                                           static_cast<std::size_t>(set[0]),
+                                                           static_cast<std::size_t>(set[1]), account)
+              .objective;
+        },
+        options, pool);
+    benchmark::DoNotOptimize(report.total_test_objective);
+  }
+  sierra::bench::set_items(state, ticks.size() * candidates.size(), sizeof(sierra::core::ScidRecord));
+}
+BENCHMARK(BM_WalkForward)->ArgName("size")->Arg(100000)->Arg(1000000)->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,30 @@
+/**
+ * @brief Бенчмарк фонового обработчика ленты сделок.
+ * @note Меряется полный путь: запись в очередь потоком графика и разбор рабочим потоком до `drain`.
+ */
+#include "bench_common.hpp"
+
+#include "sierra/core/order_flow_worker.hpp"
+
+namespace {
+
+void BM_OrderFlowWorker(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  sierra::core::OrderFlowWorker worker(1 << 16);
+  sierra::core::TradeRecord trade;
+  trade.price = 4000.0f;
+  trade.volume = 2;
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < count; ++i) {
+      trade.side = i % 2 == 0 ? sierra::core::TradeSide::kBid : sierra::core::TradeSide::kAsk;
+      trade.sequence = static_cast<std::uint32_t>(i);
+      while (!worker.push(trade)) {
+      }
+    }
+    worker.drain();
+  }
+  sierra::bench::set_items(state, count, sizeof(sierra::core::TradeRecord));
+}
+BENCHMARK(BM_OrderFlowWorker)->ArgName("size")->Range(1000, 1000000)->UseRealTime();
+
+}  // namespace
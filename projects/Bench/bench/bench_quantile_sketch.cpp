@@ -0,0 +1,58 @@
+/**
+ * @brief Бенчмарки потокового скетча квантилей.
+ * @note Добавление значений при разной точности, объединение и запрос квантиля.
+ */
+#include "bench_common.hpp"
+
+#include "sierra/core/quantile_sketch.hpp"
+
+#include <random>
+
+namespace {
+
+std::vector<double> Samples(std::size_t count) {
+  std::mt19937_64 rng(9);
+  std::normal_distribution<double> dist(0.0, 1000.0);
+  std::vector<double> values(count);
+  for (auto& value : values) {
+    value = dist(rng);
+  }
+  return values;
+}
+
+/// Точность передаётся в десятитысячных: 100 — 1%, 10 — 0.1%.
+double Accuracy(const benchmark::State& state) { return static_cast<double>(state.range(1)) / 10000.0; }
+
+void BM_QuantileSketchAdd(benchmark::State& state) {
+  const auto values = Samples(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    sierra::core::QuantileSketch sketch(Accuracy(state));
+    for (const double value : values) {
+      sketch.add(value);
+    }
+    benchmark::DoNotOptimize(sketch.count());
+  }
+  sierra::bench::set_items(state, values.size(), sizeof(double));
+}
+BENCHMARK(BM_QuantileSketchAdd)->ArgNames({"size", "accuracy"})->Apply([](benchmark::internal::Benchmark* bench) {
+  sierra::bench::add_sizes(bench, {100, 10}, 10000000);
+});
+
+void BM_QuantileSketchMergeAndQuery(benchmark::State& state) {
+  const auto values = Samples(100000);
+  std::vector<sierra::core::QuantileSketch> parts(16, sierra::core::QuantileSketch(Accuracy(state)));
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    parts[i % parts.size()].add(values[i]);
+  }
+  for (auto _ : state) {
+    sierra::core::QuantileSketch total(Accuracy(state));
+    for (const auto& part : parts) {
+      total.merge(part);
+    }
+    benchmark::DoNotOptimize(total.quantile(0.99));
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(parts.size()));
+}
+BENCHMARK(BM_QuantileSketchMergeAndQuery)->ArgNames({"parts", "accuracy"})->Args({16, 100})->Args({16, 10});
+
+}  // namespace
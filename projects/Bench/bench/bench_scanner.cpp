@@ -0,0 +1,45 @@
+/**
+ * @brief Бенчмарк сканера символов по файлам `.scid`.
+ * @note 128 синтетических тиковых файлов по 100 000 тиков (около 4 МБ); условия `close > sma(200)` и
+ * `rsi(14) < 30` на минутных барах. Пул — один поток или все ядра машины; `symbols/s` — символов в секунду.
+ */
+#include "bench_common.hpp"
+
+#include "sierra/core/scanner.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kSymbols = 128;
+constexpr std::size_t kTicksPerSymbol = 100000;
+
+void BM_ScanSymbols(benchmark::State& state) {
+  std::vector<std::string> paths;
+  for (std::size_t symbol = 0; symbol < kSymbols; ++symbol) {
+    paths.push_back("sierra_bench_scan_" + std::to_string(symbol) + ".scid");
+    sierra::core::write_scid(paths.back(), sierra::bench::synthetic_ticks(kTicksPerSymbol, symbol + 1));
+  }
+  const std::vector<sierra::core::ScanCondition> conditions = {
+      sierra::core::parse_scan_condition("close > sma(200)"), sierra::core::parse_scan_condition("rsi(14) < 30")};
+  sierra::core::ScanOptions options;
+  options.bar_period_seconds = 60;
+  sierra::core::ThreadPool pool(static_cast<std::size_t>(state.range(0)));
+  std::size_t bytes = 0;
+  for (auto _ : state) {
+    const auto report = sierra::core::scan_symbols(paths, conditions, options, pool);
+    bytes = report.bytes;
+    benchmark::DoNotOptimize(report.rows.data());
+  }
+  for (const auto& path : paths) {
+    std::remove(path.c_str());
+  }
+  state.counters["symbols/s"] =
+      benchmark::Counter(static_cast<double>(kSymbols), benchmark::Counter::kIsIterationInvariantRate);
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes));
+}
+BENCHMARK(BM_ScanSymbols)->ArgName("threads")->Arg(1)->Arg(0)->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,33 @@
+/**
+ * @brief Бенчмарк чтения `.scid` через отображение файла в память.
+ * @note Каждая итерация открывает файл заново и суммирует объём — так меряется путь «открыть и пройти» без копирования записей.
+ */
+#include "bench_common.hpp"
+
+#include "sierra/core/scid_file.hpp"
+
+#include <cstdio>
+#include <string>
+
+namespace {
+
+void BM_ScidFileScan(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  const std::string path = "sierra_bench_" + std::to_string(count) + ".scid";
+  sierra::core::write_scid(path, sierra::bench::synthetic_ticks(count));
+  for (auto _ : state) {
+    sierra::core::ScidFile file(path);
+    std::uint64_t volume = 0;
+    for (std::size_t i = 0; i < file.size(); ++i) {
+      volume += file.records()[i].total_volume;
+    }
+    benchmark::DoNotOptimize(volume);
+  }
+  std::remove(path.c_str());
+  sierra::bench::set_items(state, count, sizeof(sierra::core::ScidRecord));
+}
+BENCHMARK(BM_ScidFileScan)->ArgName("size")->Apply([](benchmark::internal::Benchmark* bench) {
+  sierra::bench::add_sizes(bench, {}, 10000000);
+});
+
+}  // namespace
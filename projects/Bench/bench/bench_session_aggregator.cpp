@@ -0,0 +1,41 @@
+/**
+ * @brief Бенчмарк потокового агрегатора сессий.
+ * @note Минутные бары, дневная сессия с начальным балансом в 1 час.
+ */
+#include "bench_common.hpp"
+
+#include "sierra/core/session_aggregator.hpp"
+
+namespace {
+
+void BM_SessionAggregator(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  const auto prices = sierra::bench::random_walk(count);
+  std::vector<sierra::core::OhlcBar> bars(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    auto& bar = bars[i];
+    bar.time = sierra::core::Timestamp::from_microseconds(3'900'000'000'000'000 +
+                                                          static_cast<std::int64_t>(i) * 60'000'000);
+    bar.open = prices[i];
+    bar.high = prices[i] + 0.5;
+    bar.low = prices[i] - 0.5;
+    bar.close = prices[i];
+    bar.volume = 100.0;
+  }
+  sierra::core::SessionTimes times;
+  times.start_second = 34200;
+  times.end_second = 57599;
+  for (auto _ : state) {
+    sierra::core::SessionAggregator aggregator(times, 3600);
+    for (std::size_t i = 0; i < count; ++i) {
+      aggregator.update(i, bars[i]);
+    }
+    benchmark::DoNotOptimize(aggregator.periods().data());
+  }
+  sierra::bench::set_items(state, count, sizeof(sierra::core::OhlcBar));
+}
+BENCHMARK(BM_SessionAggregator)->ArgName("size")->Apply([](benchmark::internal::Benchmark* bench) {
+  sierra::bench::add_sizes(bench, {}, 10000000);
+});
+
+}  // namespace
@@ -0,0 +1,68 @@
+/**
+ * @brief Бенчмарки lock-free очереди одного писателя и одного читателя.
+ * @note Пропускная способность в одном потоке и передача между двумя потоками для 8-байтных и 32-байтных элементов.
+ */
+#include "bench_common.hpp"
+
+#include "sierra/core/spsc_ring.hpp"
+#include "sierra/core/trade_record.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace {
+
+template <typename T>
+void BM_SpscRingPushPop(benchmark::State& state) {
+  sierra::core::SpscRing<T> ring(1024);
+  const auto batch = static_cast<std::size_t>(state.range(0));
+  T value{};
+  T out[256];
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < batch; ++i) {
+      ring.try_push(value);
+    }
+    std::size_t popped = 0;
+    while (popped < batch) {
+      popped += ring.pop_bulk(out, (std::min)(batch - popped, std::size_t{256}));
+    }
+    benchmark::DoNotOptimize(out);
+  }
+  sierra::bench::set_items(state, batch, sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_SpscRingPushPop, std::uint64_t)->ArgName("batch")->Arg(1)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_SpscRingPushPop, sierra::core::TradeRecord)->ArgName("batch")->Arg(1)->Arg(64)->Arg(1024);
+
+template <typename T>
+void BM_SpscRingTransfer(benchmark::State& state) {
+  const auto count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    sierra::core::SpscRing<T> ring(4096);
+    std::thread producer([&] {
+      T value{};
+      for (std::size_t i = 0; i < count;) {
+        if (ring.try_push(value)) {
+          ++i;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+    T out[256];
+    std::size_t received = 0;
+    while (received < count) {
+      const std::size_t popped = ring.pop_bulk(out, 256);
+      if (popped == 0) {
+        std::this_thread::yield();
+      }
+      received += popped;
+    }
+    producer.join();
+    benchmark::DoNotOptimize(out);
+  }
+  sierra::bench::set_items(state, count, sizeof(T));
+}
+BENCHMARK_TEMPLATE(BM_SpscRingTransfer, std::uint64_t)->ArgName("size")->Arg(1000000)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SpscRingTransfer, sierra::core::TradeRecord)->ArgName("size")->Arg(1000000)->UseRealTime();
+
+}  // namespace
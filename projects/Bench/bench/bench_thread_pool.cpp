@@ -0,0 +1,27 @@
+/**
+ * @brief Бенчмарк накладных расходов пула потоков.
+ * @note Пустые задачи: меряется стоимость `submit` и `wait_idle`, а не полезная работа.
+ */
+#include "bench_common.hpp"
+
+#include "sierra/core/thread_pool.hpp"
+
+#include <atomic>
+
+namespace {
+
+void BM_ThreadPoolSubmit(benchmark::State& state) {
+  const auto tasks = static_cast<std::size_t>(state.range(0));
+  sierra::core::ThreadPool pool;
+  std::atomic<std::size_t> done{0};
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < tasks; ++i) {
+      pool.submit([&done] { done.fetch_add(1, std::memory_order_relaxed); });
+    }
+    pool.wait_idle();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(tasks));
+}
+BENCHMARK(BM_ThreadPoolSubmit)->ArgName("tasks")->Range(64, 65536)->UseRealTime();
+
+}  // namespace
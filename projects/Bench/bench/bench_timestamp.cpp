@@ -0,0 +1,90 @@
+/**
+ * @brief Бенчмарки пакетных календарных ядер.
+ * @note `decompose_calendar` меряется на отсортированном (SIMD-ветка) и перемешанном (скалярная ветка) столбцах.
+ */
+#include "bench_common.hpp"
+
+#include "sierra/core/timestamp.hpp"
+
+#include <algorithm>
+#include <random>
+
+namespace {
+
+std::vector<std::int64_t> TimeColumn(std::size_t count, bool sorted) {
+  std::vector<std::int64_t> column(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    column[i] = 3'900'000'000'000'000 + static_cast<std::int64_t>(i) * 250'000;
+  }
+  if (!sorted) {
+    std::shuffle(column.begin(), column.end(), std::mt19937_64(5));
+  }
+  return column;
+}
+
+void BM_ToMicroseconds(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  std::vector<double> days(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    days[i] = 45000.0 + static_cast<double>(i) / 86400.0;
+  }
+  std::vector<std::int64_t> out(size);
+  for (auto _ : state) {
+    sierra::core::to_microseconds(days.data(), size, out.data());
+    benchmark::ClobberMemory();
+  }
+  sierra::bench::set_items(state, size, sizeof(double));
+}
+BENCHMARK(BM_ToMicroseconds)->ArgName("size")->Apply([](benchmark::internal::Benchmark* bench) {
+  sierra::bench::add_sizes(bench);
+});
+
+void BM_DecomposeCalendar(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto column = TimeColumn(size, state.range(1) != 0);
+  std::vector<std::int32_t> date(size);
+  std::vector<std::int32_t> seconds(size);
+  std::vector<std::uint8_t> weekday(size);
+  for (auto _ : state) {
+    sierra::core::decompose_calendar(column.data(), size, date.data(), seconds.data(), weekday.data());
+    benchmark::ClobberMemory();
+  }
+  sierra::bench::set_items(state, size, sizeof(std::int64_t));
+}
+BENCHMARK(BM_DecomposeCalendar)->ArgNames({"size", "sorted"})->Apply([](benchmark::internal::Benchmark* bench) {
+  sierra::bench::add_sizes(bench, {1, 0});
+});
+
+void BM_SessionMask(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  std::vector<std::int32_t> seconds(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    seconds[i] = static_cast<std::int32_t>((i * 60) % 86400);
+  }
+  std::vector<std::uint8_t> mask(size);
+  const bool overnight = state.range(1) != 0;
+  for (auto _ : state) {
+    sierra::core::session_mask(seconds.data(), size, overnight ? 64800 : 34200, overnight ? 61200 : 57600,
+                               mask.data());
+    benchmark::ClobberMemory();
+  }
+  sierra::bench::set_items(state, size, sizeof(std::int32_t));
+}
+BENCHMARK(BM_SessionMask)->ArgNames({"size", "overnight"})->Apply([](benchmark::internal::Benchmark* bench) {
+  sierra::bench::add_sizes(bench, {0, 1});
+});
+
+void BM_TimestampFromDays(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    std::int64_t sum = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+      sum += sierra::core::Timestamp::from_days(45000.0 + static_cast<double>(i) * 1e-5).microseconds();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  sierra::bench::set_items(state, size, sizeof(double));
+}
+BENCHMARK(BM_TimestampFromDays)->ArgName("size")->Range(1000, 1000000);
+
+}  // namespace
@@ -0,0 +1,62 @@
+/**
+ * @brief Бенчмарки выравнивания времени нескольких графиков.
+ * @note Полный пересчёт и инкрементальное обновление последнего бара при разном числе источников.
+ */
+#include "bench_common.hpp"
+
+#include "sierra/core/timestamp_aligner.hpp"
+
+namespace {
+
+struct Columns {
+  std::vector<std::int64_t> destination;
+  std::vector<std::vector<std::int64_t>> sources;
+  std::vector<sierra::core::TimeColumn> views;
+};
+
+Columns MakeColumns(std::size_t size, std::size_t source_count) {
+  Columns columns;
+  columns.destination.resize(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    columns.destination[i] = (std::int64_t{45000} * 86400 + static_cast<std::int64_t>(i) * 10) * 1000000;
+  }
+  for (std::size_t s = 0; s < source_count; ++s) {
+    std::vector<std::int64_t> source;
+    for (std::size_t i = 0; i < size; i += 1 + s % 3) {
+      source.push_back(columns.destination[i]);
+    }
+    columns.sources.push_back(std::move(source));
+  }
+  for (const auto& source : columns.sources) {
+    columns.views.push_back({source.data(), source.size()});
+  }
+  return columns;
+}
+
+void BM_TimestampAlignerFull(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto sources = static_cast<std::size_t>(state.range(1));
+  const Columns columns = MakeColumns(size, sources);
+  for (auto _ : state) {
+    sierra::core::TimestampAligner aligner(sources);
+    benchmark::DoNotOptimize(aligner.update({columns.destination.data(), size}, columns.views));
+  }
+  sierra::bench::set_items(state, size * sources, sizeof(std::int64_t));
+}
+BENCHMARK(BM_TimestampAlignerFull)->ArgNames({"size", "sources"})->Apply([](benchmark::internal::Benchmark* bench) {
+  sierra::bench::add_sizes(bench, {1, 4}, 10000000);
+});
+
+void BM_TimestampAlignerIncremental(benchmark::State& state) {
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const Columns columns = MakeColumns(size, 4);
+  sierra::core::TimestampAligner aligner(4);
+  aligner.update({columns.destination.data(), size}, columns.views);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(aligner.update({columns.destination.data(), size}, columns.views));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimestampAlignerIncremental)->ArgName("size")->Range(1000, 1000000);
+
+}  // namespace
@@ -0,0 +1,57 @@
+/**
+ * @brief Бенчмарки накопительной статистики сделок.
+ * @note Учёт сделок по одной и объединение статистик шардов.
+ */
+#include "bench_common.hpp"
+
+#include "sierra/core/backtester.hpp"
+#include "sierra/core/trade_statistics.hpp"
+
+namespace {
+
+std::vector<sierra::core::BacktestTrade> MakeTrades(std::size_t count) {
+  const auto prices = sierra::bench::random_walk(count + 1);
+  std::vector<sierra::core::BacktestTrade> trades(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    trades[i].direction = i % 2 == 0 ? 1 : -1;
+    trades[i].exit_quantity = 1;
+    trades[i].profit_loss = (prices[i + 1] - prices[i]) * 50.0;
+    trades[i].commission = 2.0;
+  }
+  return trades;
+}
+
+void BM_TradeStatisticsAdd(benchmark::State& state) {
+  const auto trades = MakeTrades(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    sierra::core::TradeStatistics stats;
+    for (const auto& trade : trades) {
+      stats.add(trade);
+    }
+    benchmark::DoNotOptimize(stats.maximum_drawdown);
+  }
+  sierra::bench::set_items(state, trades.size(), sizeof(sierra::core::BacktestTrade));
+}
+BENCHMARK(BM_TradeStatisticsAdd)->ArgName("size")->Apply([](benchmark::internal::Benchmark* bench) {
+  sierra::bench::add_sizes(bench, {}, 10000000);
+});
+
+void BM_TradeStatisticsMerge(benchmark::State& state) {
+  const auto shards = static_cast<std::size_t>(state.range(0));
+  const auto trades = MakeTrades(shards * 16);
+  std::vector<sierra::core::TradeStatistics> parts(shards);
+  for (std::size_t i = 0; i < trades.size(); ++i) {
+    parts[i / 16].add(trades[i]);
+  }
+  for (auto _ : state) {
+    sierra::core::TradeStatistics total;
+    for (const auto& part : parts) {
+      total.merge(part);
+    }
+    benchmark::DoNotOptimize(total.maximum_drawdown);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(shards));
+}
+BENCHMARK(BM_TradeStatisticsMerge)->ArgName("shards")->Range(8, 8192);
+
+}  // namespace
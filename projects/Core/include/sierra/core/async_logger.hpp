@@ -0,0 +1,212 @@
+#pragma once
+
+#include "sierra/core/spsc_ring.hpp"
+#include "sierra/core/tick_clock.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace sierra::core {
+
+/// @brief Уровень важности записи журнала.
+enum class LogLevel : std::uint8_t { kDebug, kInfo, kWarning, kError };
+
+/// @brief Наибольшее число аргументов одной записи: с ними запись занимает ровно одну кэш-линию.
+inline constexpr std::size_t kMaxLogArguments = 4;
+
+/// @brief Тип аргумента записи.
+enum class LogArgumentType : std::uint8_t { kInt, kUint, kDouble, kBool, kString };
+
+/// @brief Значение аргумента без форматирования; какое поле занято, говорит `LogArgumentType`.
+union LogValue {
+  std::int64_t i;
+  std::uint64_t u;
+  double d;
+  const char* s;
+};
+
+/// @brief Компактная двоичная запись, которую поток графика кладёт в очередь.
+/// @note Формат хранится указателем на строковый литерал — это и есть идентификатор формата; текст собирается только в фоновом потоке.
+/// Запись выровнена по кэш-линии и занимает её целиком: запись в очередь трогает одну линию. Значения дальше `count` не инициализируются.
+struct alignas(kCacheLineSize) LogRecord {
+  std::int64_t ticks = 0;  ///< Отметка `read_ticks()` в момент записи.
+  const char* format = nullptr;
+  std::uint16_t thread = 0;  ///< Порядковый номер потока-писателя в журнале.
+  LogLevel level = LogLevel::kInfo;
+  std::uint8_t count = 0;
+  LogArgumentType types[kMaxLogArguments] = {};
+  LogValue values[kMaxLogArguments];
+};
+
+static_assert(sizeof(LogRecord) == kCacheLineSize, "LogRecord must fill exactly one cache line");
+
+/// @brief Параметры асинхронного журнала.
+struct AsyncLoggerOptions {
+  std::string path = "Logs/SierraStudy.log";
+  std::size_t max_file_bytes = 5 * 1024 * 1024;
+  /// Сколько прежних файлов хранить (`path.1` … `path.N`).
+  std::size_t max_files = 3;
+  /// Ёмкость очереди одного потока-писателя в записях.
+  std::size_t ring_capacity = 4096;
+  LogLevel min_level = LogLevel::kInfo;
+  /// Пауза фонового потока после прохода с записями; каждый пустой проход удваивает её до `idle_interval`.
+  std::chrono::milliseconds poll_interval{1};
+  /// Пауза простоя: журнал без записей будит поток раз в этот интервал, а первая запись после простоя — сразу.
+  std::chrono::milliseconds idle_interval{1000};
+};
+
+/// @brief Собирает текст записи: время, уровень, номер потока и формат с подставленными `{}`.
+/// @param record Запись журнала.
+/// @param time_ns Время записи в наносекундах `system_clock` от эпохи Unix.
+/// @param out Строка, в конец которой дописывается текст с переводом строки.
+/// @note Лишние `{}` остаются как есть, лишние аргументы дописываются через пробел.
+void format_log_record(const LogRecord& record, std::int64_t time_ns, std::string& out);
+
+/**
+ * @brief Журнал, в котором горячий путь только копирует двоичную запись в lock-free очередь своего потока.
+ * @note У каждого потока-писателя своя `SpscRing`, созданная при первой записи; фоновый поток забирает записи
+ * всех очередей, упорядочивает пачку по времени, форматирует и пишет в файл с ротацией по размеру.
+ * При переполнении очереди запись отбрасывается и учитывается в `dropped()` — поток графика никогда не ждёт.
+ * Без записей поток просыпается всё реже, до `idle_interval`; тогда первая запись будит его через условную
+ * переменную, а в остальное время `log` платит только за чтение флага простоя.
+ * @warning Формат и строковые аргументы сохраняются указателями: передавайте только строки со статическим
+ * временем жизни (литералы). Разрушайте журнал вне `DllMain`: деструктор дожидается фонового потока.
+ * При ошибке открытия файла конструктор выбрасывает `std::runtime_error`.
+ */
+class AsyncLogger {
+ public:
+  explicit AsyncLogger(AsyncLoggerOptions options);
+
+  /// @brief Дописывает все записи, закрывает файл и останавливает фоновый поток.
+  ~AsyncLogger();
+
+  AsyncLogger(const AsyncLogger&) = delete;
+  AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+  /// @brief Кладёт запись в очередь текущего потока.
+  /// @param level Уровень; записи ниже `min_level` отбрасываются сразу.
+  /// @param format Строковый литерал с местами `{}` для аргументов.
+  /// @param args Целые, вещественные, `bool` и строковые литералы.
+  /// @return `false`, если запись отфильтрована или очередь переполнена.
+  template <typename... Args>
+  bool log(LogLevel level, const char* format, const Args&... args) noexcept {
+    static_assert(sizeof...(Args) <= kMaxLogArguments, "too many log arguments");
+    if (level < min_level_) {
+      return false;
+    }
+    Producer* producer = current_producer();
+    if (producer == nullptr) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    LogRecord record;
+    record.ticks = read_ticks();
+    record.format = format;
+    record.thread = producer->thread;
+    record.level = level;
+    record.count = static_cast<std::uint8_t>(sizeof...(Args));
+    std::size_t index = 0;
+    (set_argument(record, index++, args), ...);
+    if (producer->ring.try_push(record)) {
+      if (idle_.load(std::memory_order_relaxed)) {
+        wake_idle();
+      }
+      return true;
+    }
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  /// @brief Блокирует вызывающий поток, пока всё, что было в очередях на момент вызова, не записано в файл.
+  void flush();
+
+  /// @brief Записи, отброшенные из-за переполнения очередей.
+  std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+  /// @brief Записи, уже записанные в файл.
+  std::uint64_t written() const noexcept { return written_.load(std::memory_order_relaxed); }
+
+ private:
+  struct Producer {
+    Producer(std::size_t capacity, std::uint16_t index) : ring(capacity), thread(index) {}
+
+    SpscRing<LogRecord> ring;
+    std::uint16_t thread;
+    std::thread::id owner;
+  };
+
+  template <typename T>
+  static void set_argument(LogRecord& record, std::size_t index, const T& value) noexcept {
+    using Value = std::decay_t<T>;
+    LogValue& slot = record.values[index];
+    LogArgumentType& type = record.types[index];
+    if constexpr (std::is_same_v<Value, bool>) {
+      type = LogArgumentType::kBool;
+      slot.u = value ? 1 : 0;
+    } else if constexpr (std::is_enum_v<Value>) {
+      type = LogArgumentType::kInt;
+      slot.i = static_cast<std::int64_t>(value);
+    } else if constexpr (std::is_integral_v<Value> && std::is_signed_v<Value>) {
+      type = LogArgumentType::kInt;
+      slot.i = value;
+    } else if constexpr (std::is_integral_v<Value>) {
+      type = LogArgumentType::kUint;
+      slot.u = value;
+    } else if constexpr (std::is_floating_point_v<Value>) {
+      type = LogArgumentType::kDouble;
+      slot.d = static_cast<double>(value);
+    } else {
+      static_assert(std::is_convertible_v<const T&, const char*>, "unsupported log argument type");
+      type = LogArgumentType::kString;
+      slot.s = value;
+    }
+  }
+
+  Producer* current_producer() noexcept;
+  Producer* register_producer() noexcept;
+  void run();
+  std::size_t drain(std::vector<LogRecord>& batch, std::string& text, std::string& line);
+  void write(const std::string& text);
+  void rotate();
+  void wait_for_work(std::chrono::milliseconds pause);
+  void wake_idle() noexcept;
+
+  AsyncLoggerOptions options_;
+  LogLevel min_level_;
+  std::uint64_t id_;
+
+  std::mutex producers_mutex_;
+  std::vector<std::unique_ptr<Producer>> producers_;
+
+  TickCalibration clock_;  // уточняется на каждом проходе фонового потока
+
+  std::FILE* file_ = nullptr;
+  std::size_t file_bytes_ = 0;
+
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<std::uint64_t> written_{0};
+  std::atomic<bool> stop_{false};
+  std::atomic<bool> idle_{false};  ///< Фоновый поток спит паузу простоя; писатель будит его сам.
+
+  // Проходы фонового потока: `flush` ждёт двух полных проходов после своего вызова.
+  std::mutex pass_mutex_;
+  std::condition_variable pass_done_;
+  std::condition_variable wakeup_;
+  std::uint64_t passes_ = 0;
+  bool wake_ = false;
+  bool running_ = true;
+
+  std::thread thread_;
+};
+
+}  // namespace sierra::core
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "sierra/core/scid_file.hpp"
+#include "sierra/core/timestamp.hpp"
+#include "sierra/core/trade_statistics.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sierra::core {
+
+class DepthFillModel;
+
+/// @brief Направление ордера.
+enum class OrderSide : std::int8_t {
+  kBuy = 1,
+  kSell = -1,
+};
+
+/// @brief Тип ордера (подмножество `SCT_ORDERTYPE_*`).
+enum class OrderType : std::uint8_t {
+  kMarket,
+  kLimit,
+  kStop,
+};
+
+/// @brief Заявка стратегии, аналог `s_SCNewOrder`.
+/// @note Ненулевые `target_offset` / `stop_offset` создают присоединённую OCO-пару после исполнения, как `Target1Offset` / `Stop1Offset`.
+struct OrderRequest {
+  OrderSide side = OrderSide::kBuy;
+  OrderType type = OrderType::kMarket;
+  int quantity = 1;
+  double price = 0.0;
+  double target_offset = 0.0;
+  double stop_offset = 0.0;
+};
+
+/// @brief Закрытая сделка «от flat до flat», аналог `s_ACSTrade`.
+struct BacktestTrade {
+  Timestamp open_time;
+  Timestamp close_time;
+  int direction = 0;  ///< +1 — long, -1 — short.
+  int entry_quantity = 0;
+  int exit_quantity = 0;
+  int max_open_quantity = 0;
+  double average_entry_price = 0.0;
+  double average_exit_price = 0.0;
+  double profit_loss = 0.0;
+  double max_open_loss = 0.0;
+  double max_open_profit = 0.0;
+  double commission = 0.0;
+};
+
+/// @brief Параметры симуляции.
+struct BacktestOptions {
+  double point_value = 1.0;
+  double commission_per_contract = 0.0;
+};
+
+/// @brief Событийный бэктестер по тикам `.scid` с семантикой ордеров ACSIL.
+/// @note Без модели стакана рыночные заявки исполняются на следующем тике по Ask/Bid, лимитные — при касании цены, стопы — по худшей из цены стопа и Bid/Ask. Присоединённые цели и стопы образуют OCO-группу и снимаются, когда закрывается их сделка — в том числе разворотом.
+/// @warning Заявки, поданные из `on_tick`, впервые проверяются на следующем тике — заглядывания вперёд нет.
+class Backtester {
+ public:
+  using OrderId = std::uint32_t;
+
+  explicit Backtester(BacktestOptions options = {});
+
+  /// @brief Регистрирует заявку.
+  /// @return Идентификатор заявки; 0, если количество не положительное.
+  OrderId submit(const OrderRequest& request);
+
+  /// @brief Снимает активную заявку.
+  /// @return `false`, если заявка уже исполнена или не найдена.
+  bool cancel(OrderId id);
+
+  /// @brief Снимает все заявки и закрывает позицию рыночным ордером.
+  void flatten();
+
+  /// @brief Подключает модель исполнения по стакану.
+  /// @param model Модель или `nullptr` для исполнения «по касанию».
+  /// @note С моделью лимитные заявки учитывают позицию в очереди и исполняются частично, рыночные и стоп-заявки — с влиянием на цену.
+  /// @warning Модель должна жить дольше бэктестера.
+  void set_fill_model(const DepthFillModel* model) noexcept;
+
+  /// @brief Обрабатывает один тик: исполнения, учёт позиции и MAE/MFE.
+  void process_tick(const ScidRecord& tick);
+
+  /// @brief Прогоняет стратегию по массиву тиков.
+  /// @tparam Strategy Тип с методом `void on_tick(Backtester&, const ScidRecord&)`.
+  /// @note Шаблон позволяет встроить вызов стратегии во внутренний цикл без виртуального вызова.
+  template <typename Strategy>
+  void run(const ScidRecord* ticks, std::size_t count, Strategy& strategy) {
+    for (std::size_t i = 0; i < count; ++i) {
+      process_tick(ticks[i]);
+      strategy.on_tick(*this, ticks[i]);
+    }
+  }
+
+  /// @brief Возвращает движок в исходное состояние.
+  void reset();
+
+  /// @brief Текущая позиция (положительная — long).
+  int position() const noexcept { return position_; }
+
+  /// @brief Средняя цена входа открытой позиции.
+  double average_price() const noexcept { return trade_.average_entry_price; }
+
+  /// @brief Плавающий результат открытой позиции по цене `last` (без комиссии).
+  double open_profit_loss(double last) const noexcept {
+    return position_ == 0 ? 0.0 : (last - trade_.average_entry_price) * position_ * options_.point_value;
+  }
+
+  /// @brief Количество активных заявок.
+  std::size_t active_orders() const noexcept { return orders_.size(); }
+
+  /// @brief Закрытые сделки.
+  const std::vector<BacktestTrade>& trades() const noexcept { return trades_; }
+
+  /// @brief Статистика закрытых сделок, обновляемая при закрытии каждой сделки.
+  const TradeStatistics& statistics() const noexcept { return statistics_; }
+
+ private:
+  struct Order {
+    OrderId id = 0;
+    OrderId oco_partner = 0;
+    OrderRequest request;
+    int remaining = 0;
+    double queue_ahead = 0.0;
+    bool queue_ready = false;
+    bool attached = false;
+  };
+
+  OrderId add_order(const OrderRequest& request, bool attached);
+  void fill(const Order& order, double price, int quantity, Timestamp time);
+  void apply_fill(int signed_quantity, double price, Timestamp time);
+  void close_trade(Timestamp time);
+  void track_excursion(double last);
+
+  BacktestOptions options_;
+  const DepthFillModel* fill_model_ = nullptr;
+  std::size_t depth_bar_ = 0;
+  std::vector<Order> orders_;
+  std::vector<Order> pending_;
+  std::vector<BacktestTrade> trades_;
+  TradeStatistics statistics_;
+  BacktestTrade trade_;
+  double exit_value_ = 0.0;
+  int position_ = 0;
+  OrderId next_id_ = 1;
+};
+
+}  // namespace sierra::core
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sierra::core {
+
+/// @brief Заголовок файла записи вызовов исследования.
+struct CallRecordingHeader {
+  static constexpr std::uint32_t kMagic = 0x43524353;  // "SCRC"
+  static constexpr std::uint16_t kVersion = 1;
+
+  std::string study;                ///< Имя исследования (`sc.GraphName`).
+  std::uint32_t base_arrays = 0;    ///< Число массивов `BaseDataIn[]` в срезах.
+  float tick_size = 0.0f;
+};
+
+/**
+ * @brief Входные данные одного вызова `scsf_*`, которых достаточно, чтобы повторить его вне Sierra Chart.
+ * @note Бары до `slice_start` не менялись с прошлой записи и в файл не попадают; срез `[slice_start, array_size)`
+ * лежит по массивам: сначала все `BaseDataIn[0]`, затем `BaseDataIn[1]` и т. д. Входы и persistent-значения
+ * записываются только изменившиеся (в первом вызове — все).
+ */
+struct RecordedCall {
+  static constexpr std::uint32_t kFullRecalculation = 1;
+
+  std::uint32_t flags = 0;
+  std::int32_t index = 0;
+  std::int32_t array_size = 0;
+  std::int32_t update_start_index = 0;
+  std::int32_t slice_start = 0;
+  std::vector<std::pair<std::int32_t, double>> inputs;             ///< Номер входа и значение.
+  std::vector<std::pair<std::int32_t, std::int32_t>> persistent_ints;  ///< Ключ и значение.
+  std::vector<std::pair<std::int32_t, double>> persistent_doubles;     ///< Ключ и значение.
+  std::vector<std::int64_t> date_times;  ///< `SCDateTime` баров среза в микросекундах.
+  std::vector<float> base;               ///< `base_arrays * (array_size - slice_start)` значений.
+  std::uint64_t output_digest = 0;       ///< `digest_floats` выходов после вызова.
+
+  /// @brief Длина среза в барах.
+  std::size_t slice_size() const noexcept {
+    return array_size > slice_start ? static_cast<std::size_t>(array_size - slice_start) : 0;
+  }
+};
+
+/// @brief Начальное значение `digest_floats`.
+constexpr std::uint64_t kDigestSeed = 0xcbf29ce484222325ULL;
+
+/// @brief FNV-1a по битовому представлению чисел; продолжает отпечаток `seed`.
+/// @note Сравниваются биты, а не значения: NaN с одинаковым представлением совпадают, `0.0f` и `-0.0f` — нет.
+std::uint64_t digest_floats(const float* data, std::size_t count, std::uint64_t seed = kDigestSeed) noexcept;
+
+/**
+ * @brief Пишет вызовы в компактный двоичный файл (порядок байт платформы).
+ * @note Запись буферизована; `close()` или деструктор сбрасывают буфер.
+ * @warning При ошибке ввода-вывода конструктор, `write` и `close` выбрасывают `std::runtime_error`.
+ */
+class CallRecordWriter {
+ public:
+  CallRecordWriter(const std::string& path, const CallRecordingHeader& header);
+
+  CallRecordWriter(const CallRecordWriter&) = delete;
+  CallRecordWriter& operator=(const CallRecordWriter&) = delete;
+
+  /// @brief Добавляет вызов.
+  /// @warning При длине `base`, не равной `base_arrays * slice_size()`, выбрасывает `std::invalid_argument`.
+  void write(const RecordedCall& call);
+
+  /// @brief Сбрасывает буфер и закрывает файл.
+  void close();
+
+  /// @brief Записанные вызовы.
+  std::uint64_t calls() const noexcept { return calls_; }
+
+  /// @brief Записанные байты, включая заголовок.
+  std::uint64_t bytes() const noexcept { return bytes_; }
+
+ private:
+  void put(const void* data, std::size_t size);
+
+  std::string path_;
+  std::ofstream out_;
+  std::uint32_t base_arrays_;
+  std::uint64_t calls_ = 0;
+  std::uint64_t bytes_ = 0;
+};
+
+/**
+ * @brief Последовательно читает файл `CallRecordWriter`.
+ * @warning Неверный заголовок, обрезанная запись или неправдоподобные размеры — `std::runtime_error`.
+ */
+class CallRecordReader {
+ public:
+  explicit CallRecordReader(const std::string& path);
+
+  /// @brief Заголовок файла.
+  const CallRecordingHeader& header() const noexcept { return header_; }
+
+  /// @brief Читает следующий вызов в `call` (его буферы переиспользуются).
+  /// @return `false` в конце файла.
+  bool next(RecordedCall& call);
+
+ private:
+  void get(void* data, std::size_t size);
+
+  std::string path_;
+  std::ifstream in_;
+  CallRecordingHeader header_;
+};
+
+}  // namespace sierra::core
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sierra::core {
+
+/// @brief Свечная модель; значение — номер в `CandleStickPatternNames` и входе `SetCandleStickPatternIndex`.
+enum class CandlePattern : std::uint8_t {
+  kNone = 0,
+  kHammer,
+  kHangingMan,
+  kBullishEngulfing,
+  kBearishEngulfing,
+  kDarkCloudCover,
+  kPiercingLine,
+  kMorningStar,
+  kEveningStar,
+  kMorningDojiStar,
+  kEveningDojiStar,
+  kBullishAbandonedBaby,
+  kBearishAbandonedBaby,
+  kShootingStar,
+  kInvertedHammer,
+  kBearishHarami,
+  kBullishHarami,
+  kBearishHaramiCross,
+  kBullishHaramiCross,
+  kTweezerTop,
+  kTweezerBottom,
+  kBearishBeltHoldLine,
+  kBullishBeltHoldLine,
+  kTwoCrows,
+  kThreeBlackCrows,
+  kBearishCounterattackLine,
+  kBullishCounterattackLine,
+  kThreeInsideUp,
+  kThreeOutsideUp,
+  kThreeInsideDown,
+  kThreeOutsideDown,
+  kKicker,
+  kKicking,
+  kThreeWhiteSoldiers,
+  kAdvanceBlock,
+  kDeliberation,
+  kBearishTriStar,
+  kBullishTriStar,
+  kUniqueThreeRiverBottom,
+  kBearishDojiStar,
+  kBullishDojiStar,
+  kBearishDragonflyDoji,
+  kBullishDragonflyDoji,
+  kBearishGravestoneDoji,
+  kBullishGravestoneDoji,
+  kBearishLongLeggedDoji,
+  kBullishLongLeggedDoji,
+  kBearishSideBySideWhiteLines,
+  kBullishSideBySideWhiteLines,
+  kFallingThreeMethods,
+  kRisingThreeMethods,
+  kBearishSeparatingLines,
+  kBullishSeparatingLines,
+  kDownsideTasukiGap,
+  kUpsideTasukiGap,
+  kBearishThreeLineStrike,
+  kBullishThreeLineStrike,
+  kDownsideGapThreeMethods,
+  kUpsideGapThreeMethods,
+  kOnNeck,
+  kInNeck,
+  kBearishThrusting,
+  kMatHold,
+  kDoji,
+  kBullishEngulfingBodyOnly,
+  kBearishEngulfingBodyOnly,
+};
+
+/// @brief Число моделей без `kNone`.
+constexpr std::size_t kCandlePatternCount = 65;
+
+/// @brief Модели в одном слове маски бара: слово 0 — `kHammer` … `kBullishEngulfingBodyOnly`.
+constexpr std::size_t kCandleMaskPatterns = 64;
+
+/// @brief Слово маски бара с моделью: 0 — `CandlePatternEngine::masks`, 1 — `CandlePatternEngine::high_masks`.
+constexpr std::size_t candle_mask_word(CandlePattern pattern) noexcept {
+  const auto number = static_cast<std::size_t>(pattern);
+  return number == 0 ? 0 : (number - 1) / kCandleMaskPatterns;
+}
+
+/// @brief Бит модели в её слове `candle_mask_word`: `kHammer` — бит 0 слова 0, `kBearishEngulfingBodyOnly` — бит 0
+/// слова 1; для `kNone` — 0.
+constexpr std::uint64_t candle_mask_bit(CandlePattern pattern) noexcept {
+  const auto number = static_cast<std::size_t>(pattern);
+  return number == 0 ? 0 : std::uint64_t{1} << ((number - 1) % kCandleMaskPatterns);
+}
+
+/**
+ * @brief Столбцы `sc.BaseData` одного графика.
+ * @note Усреднённые столбцы передаются как есть (`SC_HL_AVG`, `SC_OHLC_AVG`): модели сравнивают их значения, и
+ * пересчёт здесь мог бы разойтись с Sierra Chart в последнем бите.
+ */
+struct CandleSeries {
+  const float* open = nullptr;
+  const float* high = nullptr;
+  const float* low = nullptr;
+  const float* close = nullptr;
+  const float* hl_avg = nullptr;    ///< `SC_HL_AVG`: по нему считается наклон тренда.
+  const float* ohlc_avg = nullptr;  ///< `SC_OHLC_AVG`: Falling/Rising Three Methods.
+  std::size_t count = 0;
+};
+
+/// @brief Входы `scsf_CandleStickPatternsFinder`, от которых зависят модели.
+struct CandlePatternSettings {
+  bool use_trend_detection = false;   ///< «Use Trend Detection».
+  std::size_t trend_bars = 4;         ///< «Number of Bars Used For Trend Detection».
+  std::size_t price_range_bars = 100; ///< «Number of Bars for Price Range Detection».
+  /// @brief «Price Range Multiplier»; вход исследования — `float`, поэтому по умолчанию `double(0.01f)`.
+  double price_range_multiplier = static_cast<double>(0.01f);
+};
+
+/**
+ * @brief Тренд бара `index`, как `Subgraph_TrendForPatterns` исследования: -1, 0 или 1.
+ * @note Наклон регрессии `SC_HL_AVG` по `trend_bars` барам до `index - 1` делится на размах High/Low за
+ * `price_range_bars` баров, умноженный на `price_range_multiplier`; индексы до 0 читают бар 0, как массивы Sierra
+ * Chart, а размах — только существующие бары, как `sc.GetHighest`/`sc.GetLowest`.
+ */
+float candle_trend(const CandleSeries& bars, const CandlePatternSettings& settings, std::size_t index) noexcept;
+
+/**
+ * @brief Скалярный эталон: модель на баре `index` — дословно функции `Is*` из `Studies4.cpp`.
+ * @param trend Столбец `candle_trend` всех баров (`Subgraph_TrendForPatterns`); читается, только если тренд включён.
+ * @note Индексы до 0 читают бар 0, как массивы Sierra Chart; `max`/`min` тела — макросы Windows (`a > b ? a : b`).
+ */
+bool is_candle_pattern(const CandleSeries& bars, const float* trend, const CandlePatternSettings& settings,
+                       CandlePattern pattern, std::size_t index) noexcept;
+
+/**
+ * @brief Все 65 моделей на всех барах за один проход; результат бит в бит как `is_candle_pattern`.
+ * @note Бары идут словами по 64. Общие сравнения бара (цвет, доджи, тени, «сильное» тело и свеча, разрывы и
+ * сравнения с барами `i - 1` … `i - 4`) считаются один раз, по 16 баров за шаг SSE2, и складываются в слово бит на
+ * сравнение. Модели — логика над этими словами, сдвиг слова — то же сравнение на прошлом баре; 64 слова моделей
+ * транспонируются в маски баров. Бары, у которых в пяти прошлых или в самом баре есть NaN, пересчитываются эталоном:
+ * `<=` там не равно отрицанию `>`.
+ * @warning Нулевые `trend_bars` или `price_range_bars` — `std::invalid_argument` в конструкторе.
+ */
+class CandlePatternEngine {
+ public:
+  explicit CandlePatternEngine(const CandlePatternSettings& settings = {});
+
+  const CandlePatternSettings& settings() const noexcept { return settings_; }
+
+  /// @brief Находит модели на барах `[0, bars.count)`; буферы переиспользуются между вызовами.
+  void evaluate(const CandleSeries& bars);
+
+  /// @brief Число баров последнего `evaluate`.
+  std::size_t size() const noexcept { return masks_.size(); }
+
+  /// @brief Слово 0 маски на бар: бит `candle_mask_bit(p)` — модель `p` с `candle_mask_word(p) == 0`.
+  const std::vector<std::uint64_t>& masks() const noexcept { return masks_; }
+
+  /// @brief Слово 1 маски на бар: модели 65-я и дальше, сейчас только `kBearishEngulfingBodyOnly` (бит 0).
+  const std::vector<std::uint64_t>& high_masks() const noexcept { return high_masks_; }
+
+  /// @brief Найдена ли модель на баре `index`; для любой из 65 моделей, `kNone` — `false`.
+  bool contains(CandlePattern pattern, std::size_t index) const noexcept;
+
+ private:
+  void build_trend(const CandleSeries& bars);
+
+  CandlePatternSettings settings_;
+  std::vector<std::uint64_t> masks_;
+  std::vector<std::uint64_t> high_masks_;
+  std::vector<float> trend_;        ///< `candle_trend` каждого бара, если тренд включён.
+  std::vector<float> suffix_high_;  ///< Максимум High от бара до конца его блока `price_range_bars`.
+  std::vector<float> suffix_low_;
+  std::vector<double> range_;       ///< Размах High/Low окна `price_range_bars`, кончающегося баром.
+};
+
+}  // namespace sierra::core
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "sierra/core/shared_column_cache.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace sierra::core {
+
+/// @brief Начальное значение `hash_bars` для первого бара истории.
+constexpr std::uint64_t kBarHashSeed = 0xcbf29ce484222325ULL;
+
+/// @brief Хеш содержимого баров: времени и значения источника.
+/// @param seed Хеш предыдущих баров: цепочка вызовов по блокам даёт хеш всего префикса истории.
+/// @note Изменение времени или значения одного бара всегда меняет результат; хеш не зависит от платформы и сборки.
+std::uint64_t hash_bars(const std::int64_t* times, const float* sources, std::size_t count,
+                        std::uint64_t seed) noexcept;
+
+/// @brief Хеш ключа столбца для файла на диске: символ, период бара, расчёт, параметры и версия расчёта.
+/// @note Не зависит от сборки (в отличие от `ColumnKeyHash`); `first_bar_time` не входит — начало истории
+/// проверяет хеш содержимого.
+std::uint64_t persistent_hash(const ColumnKey& key) noexcept;
+
+/**
+ * @brief Файл с посчитанными значениями исследования по закрытым барам для быстрой перезагрузки графика.
+ * @note Файл — заголовок и блоки по `kChunkBars` баров: хеш всех баров истории до конца блока (`hash_bars`)
+ * и значения. При загрузке файл отображается в память, блоки сверяются с барами графика по порядку, и значения
+ * совпавших блоков копируются в выход; исследованию остаётся посчитать хвост. Правка бара меняет хеш его блока
+ * и всех следующих, поэтому они отбрасываются и пишутся заново. Дописываются только завершённые блоки.
+ * @warning Один файл — один писатель: путь не должен совпадать у двух экземпляров.
+ */
+class ColumnStore {
+ public:
+  /// @brief Баров в блоке файла.
+  static constexpr std::size_t kChunkBars = 65536;
+
+  /// @brief Записывает время баров `[first, first + count)` графика в `times`.
+  using BarTimes = std::function<void(std::size_t first, std::size_t count, std::int64_t* times)>;
+
+  /// @param path Путь к файлу; каталог должен существовать.
+  /// @param key_hash `persistent_hash` ключа: файл другого ключа не загружается и перезаписывается.
+  ColumnStore(std::string path, std::uint64_t key_hash);
+
+  /// @brief Сверяет файл с барами `[0, bars)` и копирует значения совпавших блоков в `output`.
+  /// @return Баров, взятых из файла (кратно `kChunkBars`); 0, если файла нет или он не подходит.
+  std::size_t load(const std::int64_t* times, const float* sources, std::size_t bars, float* output);
+
+  /// @brief То же, но время баров запрашивается у `bar_times` по блоку в буфер `scratch`.
+  /// @note Заголовок и длина файла проверяются до первого запроса: если файла нет или он другого ключа, время не
+  /// запрашивается вовсе, а дальше — только для сверяемых блоков до первого несовпавшего.
+  std::size_t load(const BarTimes& bar_times, const float* sources, std::size_t bars, float* output,
+                   std::vector<std::int64_t>& scratch);
+
+  /// @brief Есть ли что дописать для `bars` закрытых баров.
+  bool needs_store(std::size_t bars) const noexcept {
+    return !synced_ || bars / kChunkBars > hashes_.size();
+  }
+
+  /// @brief Дописывает завершённые блоки баров `[stored_bars(), bars)`; массивы индексируются с бара 0.
+  /// @return Баров в файле после записи.
+  /// @warning При ошибке ввода-вывода выбрасывает `std::runtime_error`.
+  std::size_t store(const std::int64_t* times, const float* sources, const float* values, std::size_t bars);
+
+  /// @brief То же, но время запрашивается у `bar_times` по блоку в буфер `scratch` и только для дописываемых блоков.
+  std::size_t store(const BarTimes& bar_times, const float* sources, const float* values, std::size_t bars,
+                    std::vector<std::int64_t>& scratch);
+
+  /// @brief Отбрасывает блоки, начиная с блока бара `bar` (бар изменён); файл обрезается при следующей записи.
+  void invalidate(std::size_t bar) noexcept;
+
+  /// @brief Баров в файле, совпадающих с историей графика.
+  std::size_t stored_bars() const noexcept { return hashes_.size() * kChunkBars; }
+
+  const std::string& path() const noexcept { return path_; }
+  std::uint64_t key_hash() const noexcept { return key_hash_; }
+
+ private:
+  /// @param chunk_times Время баров блока по номеру его первого бара: `const std::int64_t*(std::size_t first)`.
+  template <typename ChunkTimes>
+  std::size_t load_chunks(const ChunkTimes& chunk_times, const float* sources, std::size_t bars, float* output);
+
+  template <typename ChunkTimes>
+  std::size_t store_chunks(const ChunkTimes& chunk_times, const float* sources, const float* values,
+                           std::size_t bars);
+
+  std::string path_;
+  std::uint64_t key_hash_;
+  std::vector<std::uint64_t> hashes_;  ///< Хеш истории на конце каждого блока, совпадающего с файлом.
+  bool synced_ = false;                ///< Файл содержит ровно `hashes_.size()` блоков.
+};
+
+}  // namespace sierra::core
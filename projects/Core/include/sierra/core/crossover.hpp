@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sierra::core {
+
+/// @brief Направление пересечения, как результат `sc.CrossOver`.
+enum class CrossDirection {
+  kNone,        ///< `NO_CROSS`.
+  kFromBottom,  ///< `CROSS_FROM_BOTTOM`: первый ряд поднялся над вторым.
+  kFromTop,     ///< `CROSS_FROM_TOP`: первый ряд опустился под второй.
+};
+
+/// @brief Сколько баров назад `sc.CrossOver` ищет неравные значения, если на предыдущем баре ряды равны.
+constexpr std::size_t kCrossLookback = 100;
+
+/**
+ * @brief Пересечение рядов на баре `index` — скалярный эталон с семантикой `sc.CrossOver`.
+ * @note Если на баре `index` ряды различны, а на предыдущем равны, сравнение берётся с ближайшим более ранним
+ * баром с неравными значениями, но не дальше `kCrossLookback` баров. NaN не равен ничему: бар с NaN и бар сразу
+ * после него (если сравнение дошло до NaN) не дают пересечения. Бар 0 сравнивается сам с собой и пересечения
+ * не даёт, как индекс -1, зажатый в 0 массивом Sierra Chart.
+ */
+CrossDirection cross_over(const float* first, const float* second, std::size_t index) noexcept;
+
+/// @brief Битовые маски событий: бит `i % 64` слова `i / 64` — бар `i`; биты за последним баром нулевые.
+struct CrossMasks {
+  std::vector<std::uint64_t> from_bottom;
+  std::vector<std::uint64_t> from_top;
+};
+
+/**
+ * @brief Маски пересечений двух столбцов на всех барах `[0, count)`, бит в бит как `cross_over` на каждом баре.
+ * @param masks Результат; буферы переиспользуются между вызовами.
+ * @note Сравнения идут по 16 баров SSE2 (`cmpgt`/`cmplt`/`cmpeq`, упаковка и `movemask`) в слова по 64 бара.
+ * Состояние «ближайший неравный бар был ниже/выше» переносится через равные бары сложением с переносом, без
+ * ветвлений; ограничение `kCrossLookback` проверяется скалярно только у событий сразу после равного бара.
+ */
+void crossover_masks(const float* first, const float* second, std::size_t count, CrossMasks& masks);
+
+/// @brief Маски пересечений столбца с уровнем `level`, как `sc.CrossOver` с массивом, заполненным `level`.
+void threshold_masks(const float* values, float level, std::size_t count, CrossMasks& masks);
+
+/// @brief Число событий в маске (popcount по словам).
+std::size_t count_events(const std::vector<std::uint64_t>& mask) noexcept;
+
+/// @brief Дописывает в `indices` номера баров с установленными битами по возрастанию.
+/// @note Выход резервируется по `count_events`, номера извлекаются по младшему биту слова без проверки каждого бара.
+void extract_events(const std::vector<std::uint64_t>& mask, std::vector<std::size_t>& indices);
+
+}  // namespace sierra::core
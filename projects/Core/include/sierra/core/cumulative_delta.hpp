@@ -0,0 +1,99 @@
+#pragma once
+
+#include "sierra/core/engine_snapshot.hpp"
+#include "sierra/core/trade_record.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sierra::core {
+
+/// @brief Какая величина накапливается в кумулятивной дельте.
+/// @note Соответствует `CumulativeDeltaVolume_S`, `CumulativeDeltaTicks_S` и `CumulativeDeltaTickVolume_S` из ACSIL.
+enum class DeltaSource {
+  kVolume,      ///< Объём по Ask минус объём по Bid.
+  kTrades,      ///< Число сделок по Ask минус число сделок по Bid.
+  kTickVolume,  ///< Объём на uptick минус объём на downtick.
+};
+
+/// @brief Параметры движка кумулятивной дельты.
+struct CumulativeDeltaOptions {
+  DeltaSource source = DeltaSource::kVolume;
+  /// Сбрасывать накопление в начале новой торговой сессии.
+  bool reset_at_session = true;
+  /// Сбрасывать накопление каждые N баров; 0 — не сбрасывать по счётчику.
+  std::size_t reset_bar_count = 0;
+};
+
+/// @brief OHLC кумулятивной дельты одного бара.
+struct DeltaBar {
+  double open = 0.0;
+  double high = 0.0;
+  double low = 0.0;
+  double close = 0.0;
+};
+
+/// @brief Потоковый расчёт OHLC кумулятивной дельты по сделкам.
+/// @note Хранит O(1) состояния на бар: значение дельты на начало бара и контрольную точку для отката последнего бара.
+/// @warning Сделки принимаются только после `start_bar`, иначе выбрасывается `std::logic_error`.
+class CumulativeDeltaEngine {
+ public:
+  explicit CumulativeDeltaEngine(CumulativeDeltaOptions options);
+
+  /// @brief Открывает новый бар.
+  /// @param new_session Бар начинает новую торговую сессию.
+  void start_bar(bool new_session);
+
+  /// @brief Учитывает сделку в текущем баре.
+  /// @param trade Сделка с классификацией стороны.
+  void add_trade(const TradeRecord& trade);
+
+  /// @brief Возвращает последний бар в состояние на момент его открытия.
+  /// @note Используется, когда Sierra Chart пересобирает последний бар: сделки бара подаются заново.
+  void rollback_last_bar();
+
+  /// @brief Полностью очищает движок.
+  void reset();
+
+  /// @brief Количество баров.
+  std::size_t size() const noexcept { return bars_.size(); }
+
+  /// @brief Все бары в порядке открытия.
+  const std::vector<DeltaBar>& bars() const noexcept { return bars_; }
+
+  /// @brief Текущее значение кумулятивной дельты.
+  double value() const noexcept { return cumulative_; }
+
+  /// @brief Версия формата снимка состояния (`save`/`restore`).
+  static constexpr std::uint32_t kSnapshotVersion = 1;
+
+  /// @brief Записывает параметры, бары и накопленное значение с контрольной точкой последнего бара в снимок.
+  void save(SnapshotWriter& writer) const;
+
+  /// @brief Восстанавливает состояние из снимка `save` за O(размера состояния).
+  /// @return `false`, если версия снимка или параметры не совпадают с текущими; состояние тогда не меняется.
+  /// @warning Обрезанный снимок — `std::runtime_error`.
+  bool restore(SnapshotReader& reader);
+
+ private:
+  struct Checkpoint {
+    double base = 0.0;
+    float last_price = 0.0f;
+    int last_direction = 0;
+    std::size_t bars_since_reset = 0;
+  };
+
+  double contribution(const TradeRecord& trade);
+
+  CumulativeDeltaOptions options_;
+  std::vector<DeltaBar> bars_;
+  Checkpoint checkpoint_;
+  double cumulative_ = 0.0;
+  float last_price_ = 0.0f;
+  int last_direction_ = 0;
+  std::size_t bars_since_reset_ = 0;
+  bool bar_has_trades_ = false;
+};
+
+}  // namespace sierra::core
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "sierra/core/backtester.hpp"
+#include "sierra/core/scid_file.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sierra::core {
+
+/// @brief Сводка стакана на одном ценовом уровне бара, как в `c_ACSILDepthBars`.
+struct DepthLevel {
+  std::uint32_t max_bid = 0;
+  std::uint32_t max_ask = 0;
+  std::uint32_t last_bid = 0;
+  std::uint32_t last_ask = 0;
+};
+
+/// @brief Предрассчитанные сводки стакана по барам.
+/// @note Уровни каждого бара лежат плотно от нижнего тика вверх в одном общем массиве, поэтому поиск уровня по цене — O(1).
+class DepthBook {
+ public:
+  /// @brief Создаёт пустую книгу.
+  /// @param tick_size Шаг цены инструмента; должен быть положительным.
+  /// @warning При неположительном шаге выбрасывает `std::invalid_argument`.
+  explicit DepthBook(double tick_size);
+
+  /// @brief Добавляет бар.
+  /// @param start_time Время начала бара в микросекундах (как `ScidRecord::date_time`).
+  /// @param lowest_tick_index Индекс нижнего уровня в шкале `tick_index`; индекс `GetBarLowestPriceTickIndex`
+  /// переводится через `TickIndexToPrice`.
+  /// @param levels Уровни от нижнего вверх.
+  /// @warning Бары должны добавляться по возрастанию времени.
+  void add_bar(std::int64_t start_time, int lowest_tick_index, const std::vector<DepthLevel>& levels);
+
+  /// @brief Количество баров.
+  std::size_t size() const noexcept { return bars_.size(); }
+
+  /// @brief Шаг цены.
+  double tick_size() const noexcept { return tick_size_; }
+
+  /// @brief Индекс тика для цены.
+  int tick_index(double price) const noexcept;
+
+  /// @brief Находит бар, содержащий момент времени, начиная с подсказки.
+  /// @param time Время в микросекундах.
+  /// @param hint Бар, найденный для предыдущего тика; для монотонного времени поиск амортизированно O(1).
+  /// @return Индекс бара; 0, если время раньше первого бара.
+  std::size_t locate(std::int64_t time, std::size_t hint) const noexcept;
+
+  /// @brief Уровень бара по цене.
+  /// @return Указатель на уровень или `nullptr`, если цены нет в баре.
+  const DepthLevel* level(std::size_t bar, double price) const noexcept;
+
+ private:
+  struct Bar {
+    std::int64_t start_time = 0;
+    int lowest_tick_index = 0;
+    std::uint32_t offset = 0;
+    std::uint32_t count = 0;
+  };
+
+  double tick_size_;
+  std::vector<Bar> bars_;
+  std::vector<DepthLevel> levels_;
+};
+
+/// @brief Параметры модели исполнения.
+struct DepthFillOptions {
+  /// Доля видимого объёма уровня, стоящая в очереди перед нашей заявкой (1 — встаём в конец).
+  double queue_fraction_ahead = 1.0;
+  /// Объём на уровне, если сводки стакана нет.
+  std::uint32_t default_level_quantity = 1;
+};
+
+/// @brief Модель исполнения с позицией в очереди, частичными исполнениями и влиянием на цену.
+/// @note Все операции — O(1) на заявку на тик: очередь уменьшается объёмом сделок на цене заявки и сокращением видимого объёма (отмены), рыночная заявка «проходит» уровни с объёмом лучшей котировки по закрытой формуле.
+/// @warning Объект только читает `DepthBook`; одну модель можно разделять между потоками.
+class DepthFillModel {
+ public:
+  DepthFillModel(const DepthBook& book, DepthFillOptions options = {});
+
+  /// @brief Книга стакана модели.
+  const DepthBook& book() const noexcept { return book_; }
+
+  /// @brief Начальный объём в очереди перед новой лимитной заявкой.
+  double initial_queue(OrderSide side, double price, std::size_t bar) const noexcept;
+
+  /// @brief Сколько контрактов лимитной заявки исполняется на тике.
+  /// @param side Сторона заявки.
+  /// @param price Цена заявки.
+  /// @param remaining Неисполненный остаток.
+  /// @param queue_ahead Объём перед заявкой; обновляется.
+  /// @param tick Текущий тик.
+  /// @param bar Бар стакана для тика.
+  /// @return Исполненное количество (0..remaining).
+  int limit_fill(OrderSide side, double price, int remaining, double& queue_ahead,
+                 const ScidRecord& tick, std::size_t bar) const noexcept;
+
+  /// @brief Средняя цена исполнения рыночной заявки с учётом влияния на цену.
+  double market_price(OrderSide side, int quantity, const ScidRecord& tick,
+                      std::size_t bar) const noexcept;
+
+ private:
+  const DepthBook& book_;
+  DepthFillOptions options_;
+};
+
+}  // namespace sierra::core
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace sierra::core {
+
+/**
+ * @brief Двоичный снимок состояния движка: значения подряд в порядке записи, без выравнивания.
+ * @note Формат — порядок байт и раскладка процесса: снимок переживает перезагрузку DLL, но не переносится между
+ * платформами. Версию формата своего состояния движок пишет первым значением сам.
+ */
+class SnapshotWriter {
+ public:
+  /// @brief Дописывает значение тривиально копируемого типа.
+  template <typename T>
+  void put(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>, "snapshot values must be trivially copyable");
+    const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+    bytes_.insert(bytes_.end(), bytes, bytes + sizeof(T));
+  }
+
+  /// @brief Дописывает длину вектора и его элементы.
+  template <typename T>
+  void put_vector(const std::vector<T>& values) {
+    static_assert(std::is_trivially_copyable_v<T>, "snapshot values must be trivially copyable");
+    put<std::uint64_t>(values.size());
+    const auto* bytes = reinterpret_cast<const unsigned char*>(values.data());
+    bytes_.insert(bytes_.end(), bytes, bytes + values.size() * sizeof(T));
+  }
+
+  const std::vector<unsigned char>& bytes() const noexcept { return bytes_; }
+
+ private:
+  std::vector<unsigned char> bytes_;
+};
+
+/**
+ * @brief Читает значения `SnapshotWriter` в том же порядке.
+ * @warning Чтение за концом снимка выбрасывает `std::runtime_error`: снимок обрезан или другого формата.
+ */
+class SnapshotReader {
+ public:
+  SnapshotReader(const unsigned char* data, std::size_t size) noexcept : data_(data), size_(size) {}
+  explicit SnapshotReader(const std::vector<unsigned char>& bytes) noexcept
+      : SnapshotReader(bytes.data(), bytes.size()) {}
+
+  template <typename T>
+  T get() {
+    static_assert(std::is_trivially_copyable_v<T>, "snapshot values must be trivially copyable");
+    T value;
+    std::memcpy(&value, take(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  /// @brief Читает вектор, записанный `put_vector`.
+  template <typename T>
+  void get_vector(std::vector<T>& values) {
+    static_assert(std::is_trivially_copyable_v<T>, "snapshot values must be trivially copyable");
+    const auto count = get<std::uint64_t>();
+    if (count > remaining() / sizeof(T)) {
+      throw std::runtime_error("SnapshotReader: vector is longer than the snapshot");
+    }
+    values.resize(static_cast<std::size_t>(count));
+    std::memcpy(values.data(), take(values.size() * sizeof(T)), values.size() * sizeof(T));
+  }
+
+  /// @brief Непрочитанные байты.
+  std::size_t remaining() const noexcept { return size_ - offset_; }
+
+ private:
+  const unsigned char* take(std::size_t bytes) {
+    if (bytes > remaining()) {
+      throw std::runtime_error("SnapshotReader: snapshot is truncated");
+    }
+    const unsigned char* position = data_ + offset_;
+    offset_ += bytes;
+    return position;
+  }
+
+  const unsigned char* data_;
+  std::size_t size_;
+  std::size_t offset_ = 0;
+};
+
+}  // namespace sierra::core
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "sierra/core/spsc_ring.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace sierra::core {
+
+/**
+ * @brief Эпохи для освобождения памяти, которую читатели видят без блокировок.
+ * @note Читатель закрепляет текущую эпоху (`pin()`) на время чтения. Писатель, заменив опубликованный указатель,
+ * передаёт старый объект в `retire()`: тот освобождается, когда все закреплённые эпохи станут не меньше эпохи
+ * замены, то есть когда ни один читатель, начавший раньше, не может его держать.
+ * Закрепление — поиск свободного слота и два атомарных обмена, без выделения памяти и мьютекса.
+ * @warning Читателей одновременно не больше `kMaxReaders`; лишние ждут свободного слота. Объекты, переданные
+ * в `retire()`, освобождаются не позже деструктора домена.
+ */
+class EpochDomain {
+ public:
+  /// @brief Одновременно закреплённых читателей.
+  static constexpr std::size_t kMaxReaders = 64;
+
+  /// @brief Закреплённая эпоха; пока объект жив, указатели, прочитанные после `pin()`, не освобождаются.
+  class Guard {
+   public:
+    Guard(Guard&& other) noexcept : domain_(other.domain_), slot_(other.slot_) { other.domain_ = nullptr; }
+    Guard& operator=(Guard&&) = delete;
+    Guard(const Guard&) = delete;
+    ~Guard() {
+      if (domain_ != nullptr) {
+        domain_->slots_[slot_].epoch.store(kIdle, std::memory_order_release);
+      }
+    }
+
+   private:
+    friend class EpochDomain;
+    Guard(EpochDomain* domain, std::size_t slot) noexcept : domain_(domain), slot_(slot) {}
+
+    EpochDomain* domain_;
+    std::size_t slot_;
+  };
+
+  EpochDomain() = default;
+  ~EpochDomain();
+
+  EpochDomain(const EpochDomain&) = delete;
+  EpochDomain& operator=(const EpochDomain&) = delete;
+
+  /// @brief Закрепляет текущую эпоху.
+  Guard pin() noexcept;
+
+  /// @brief Передаёт объект, уже недоступный новым читателям, на отложенное освобождение.
+  /// @param object Объект.
+  /// @param deleter Функция освобождения.
+  void retire(void* object, void (*deleter)(void*));
+
+  /// @brief Освобождает объекты, которые не может держать ни один закреплённый читатель.
+  /// @return Количество освобождённых объектов.
+  std::size_t reclaim();
+
+  /// @brief Объекты, ожидающие освобождения.
+  std::size_t pending() const;
+
+ private:
+  static constexpr std::uint64_t kIdle = 0;
+
+  struct alignas(kCacheLineSize) Slot {
+    std::atomic<std::uint64_t> epoch{kIdle};
+  };
+
+  struct Retired {
+    void* object;
+    void (*deleter)(void*);
+    std::uint64_t epoch;
+  };
+
+  std::size_t reclaim_locked();
+
+  std::array<Slot, kMaxReaders> slots_;
+  alignas(kCacheLineSize) std::atomic<std::uint64_t> epoch_{1};
+  mutable std::mutex mutex_;  // защищает retired_
+  std::vector<Retired> retired_;
+};
+
+}  // namespace sierra::core
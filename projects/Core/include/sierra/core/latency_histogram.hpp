@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace sierra::core {
+
+/**
+ * @brief Гистограмма задержек с логарифмическими корзинами в духе HdrHistogram.
+ * @note Значения до `2 * kSubBuckets` хранятся точно, дальше каждая октава `[2^k, 2^(k+1))` делится на `kSubBuckets`
+ * равных корзин, поэтому относительная погрешность квантиля не больше `1 / kSubBuckets` (≈3%).
+ * Все корзины лежат в массиве фиксированного размера: `record` не выделяет память и не считает логарифмов — только
+ * старший бит значения и сдвиг, что годится для записи на каждом вызове исследования.
+ * Единица значений не задана: обычно такты `read_ticks()` или наносекунды.
+ */
+class LatencyHistogram {
+ public:
+  /// @brief Число бит под корзину внутри октавы.
+  static constexpr int kSubBucketBits = 5;
+  static constexpr std::uint64_t kSubBuckets = std::uint64_t{1} << kSubBucketBits;
+  /// @brief Всего корзин: точный диапазон `[0, 2 * kSubBuckets)` и по `kSubBuckets` на каждую старшую октаву.
+  static constexpr std::size_t kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+  /// @brief Учитывает значение.
+  void record(std::uint64_t value) noexcept {
+    ++counts_[bucket_of(value)];
+    ++count_;
+    sum_ += value;
+    if (value < min_) {
+      min_ = value;
+    }
+    if (value > max_) {
+      max_ = value;
+    }
+  }
+
+  /// @brief Добавляет счётчики другой гистограммы.
+  void merge(const LatencyHistogram& other) noexcept;
+
+  /// @brief Очищает гистограмму.
+  void reset() noexcept;
+
+  /// @brief Оценка квантиля.
+  /// @param q Уровень в `[0, 1]`; значения вне диапазона приводятся к границам.
+  /// @return Середина корзины квантиля, ограниченная точными минимумом и максимумом; 0 для пустой гистограммы.
+  std::uint64_t quantile(double q) const noexcept;
+
+  /// @brief Количество учтённых значений.
+  std::uint64_t count() const noexcept { return count_; }
+
+  /// @brief Точный минимум; 0 для пустой гистограммы.
+  std::uint64_t min() const noexcept { return count_ == 0 ? 0 : min_; }
+
+  /// @brief Точный максимум.
+  std::uint64_t max() const noexcept { return max_; }
+
+  /// @brief Среднее значение; 0 для пустой гистограммы.
+  double mean() const noexcept { return count_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(count_); }
+
+  /// @brief Номер корзины значения.
+  static std::size_t bucket_of(std::uint64_t value) noexcept {
+    if (value < 2 * kSubBuckets) {
+      return static_cast<std::size_t>(value);
+    }
+    const int shift = highest_bit(value) - kSubBucketBits;
+    return static_cast<std::size_t>((static_cast<std::uint64_t>(shift) + 1) * kSubBuckets +
+                                    ((value >> shift) - kSubBuckets));
+  }
+
+  /// @brief Наименьшее значение корзины.
+  static std::uint64_t bucket_lower(std::size_t bucket) noexcept;
+
+  /// @brief Ширина корзины.
+  static std::uint64_t bucket_width(std::size_t bucket) noexcept;
+
+ private:
+  /// Номер старшего единичного бита; `value` не ноль.
+  static int highest_bit(std::uint64_t value) noexcept {
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanReverse64(&index, value);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(value);
+#endif
+  }
+
+  std::array<std::uint64_t, kBucketCount> counts_{};
+  std::uint64_t count_ = 0;
+  std::uint64_t sum_ = 0;
+  std::uint64_t min_ = UINT64_MAX;
+  std::uint64_t max_ = 0;
+};
+
+}  // namespace sierra::core
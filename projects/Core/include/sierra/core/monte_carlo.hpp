@@ -0,0 +1,63 @@
+#pragma once
+
+#include "sierra/core/backtester.hpp"
+#include "sierra/core/quantile_sketch.hpp"
+#include "sierra/core/thread_pool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace sierra::core {
+
+/// @brief Счётный генератор: случайное число как чистая функция потока и номера.
+/// @param stream Ключ потока (например, номер пути, смешанный с зерном).
+/// @param counter Номер числа в потоке.
+/// @return 64 равномерно распределённых бита.
+/// @note Значение равно `counter`-му выходу SplitMix64, запущенного с состояния `stream`; состояние между вызовами не хранится, поэтому порядок и распределение вызовов по потокам не влияют на результат. Не криптостойкий.
+std::uint64_t counter_random(std::uint64_t stream, std::uint64_t counter) noexcept;
+
+/// @brief Параметры бутстрэп-моделирования.
+struct MonteCarloOptions {
+  std::size_t paths = 100000;
+  /// Сделок в одном пути; 0 — столько же, сколько в исходной выборке.
+  std::size_t trades_per_path = 0;
+  double starting_capital = 0.0;
+  /// Путь считается разорённым, если капитал хотя бы раз опустился до этого уровня.
+  double ruin_capital = -std::numeric_limits<double>::infinity();
+  std::uint64_t seed = 0;
+  double relative_accuracy = 0.01;
+};
+
+/// @brief Распределения по всем путям.
+/// @note Пути не хранятся: квантили накапливаются в скетчах.
+struct MonteCarloReport {
+  explicit MonteCarloReport(double relative_accuracy = 0.01)
+      : max_drawdown(relative_accuracy), final_profit(relative_accuracy) {}
+
+  QuantileSketch max_drawdown;  ///< Наибольшая просадка пути (неположительная).
+  QuantileSketch final_profit;  ///< Итоговая прибыль пути.
+  std::size_t paths = 0;
+  std::size_t ruined_paths = 0;
+
+  /// @brief Доля разорённых путей.
+  double risk_of_ruin() const noexcept {
+    return paths == 0 ? 0.0 : static_cast<double>(ruined_paths) / static_cast<double>(paths);
+  }
+};
+
+/// @brief Чистая прибыль каждой сделки (`profit_loss - commission`).
+std::vector<double> net_profits(const std::vector<BacktestTrade>& trades);
+
+/// @brief Бутстрэп последовательности сделок: пути из случайных сделок с возвращением.
+/// @param profits Чистые прибыли исходных сделок.
+/// @param options Количество путей, капитал, порог разорения и зерно.
+/// @param pool Пул потоков.
+/// @return MonteCarloReport с распределениями просадки и итоговой прибыли.
+/// @note Путь `i` использует поток генератора `i`, а пути делятся на задачи блоками фиксированного размера, поэтому результат зависит только от зерна, но не от числа потоков. Кривые капитала считаются сразу для нескольких путей в массивах без ветвлений, что позволяет компилятору векторизовать внутренний цикл.
+/// @warning При пустой выборке или больше 2^32 сделок выбрасывает `std::invalid_argument`.
+MonteCarloReport monte_carlo(const std::vector<double>& profits, const MonteCarloOptions& options,
+                             ThreadPool& pool);
+
+}  // namespace sierra::core
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "sierra/core/engine_snapshot.hpp"
+
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace sierra::core {
@@ -13,4 +16,71 @@ namespace sierra::core {
 /// @warning Если передать период 0, будет выброшено исключение `std::invalid_argument`.
 std::vector<double> moving_average(const std::vector<double>& input, std::size_t period);
 
+/// @brief Пересчитывает простое скользящее среднее только для индексов `[first, size)`.
+/// @param input Значения ряда (например, `sc.Close`); читаются индексы от `first - period` до `size - 1`.
+/// @param size Длина ряда.
+/// @param period Размер окна; должен быть положительным.
+/// @param first Первый пересчитываемый индекс; значения до него в `output` не трогаются.
+/// @param output Массив результата длиной `size` (например, `Subgraph[].Data`).
+/// @note Работа пропорциональна `period + size - first`, поэтому обновление последних баров не зависит от длины истории. Сумма окна накапливается в `double`, результат до накопления истории — `NaN`.
+/// @warning Если передать период 0, будет выброшено исключение `std::invalid_argument`.
+void moving_average(const float* input, std::size_t size, std::size_t period, std::size_t first, float* output);
+
+/// @brief Параметры движка скользящего среднего.
+struct MovingAverageConfig {
+  std::size_t period = 20;
+
+  friend bool operator==(const MovingAverageConfig& lhs, const MovingAverageConfig& rhs) {
+    return lhs.period == rhs.period;
+  }
+  friend bool operator!=(const MovingAverageConfig& lhs, const MovingAverageConfig& rhs) { return !(lhs == rhs); }
+};
+
+/**
+ * @brief Инкрементальное простое скользящее среднее, которое живёт между вызовами исследования.
+ * @note Закрытые бары (все, кроме последнего) входят в сумму окна один раз; последний бар пересчитывается
+ * поверх неё без фиксации. Поэтому обновление в реальном времени стоит O(новых баров), а не O(period).
+ * Если `first` не совпадает с числом закрытых баров — вызывающий просит пересчитать закрытые бары или уже
+ * заполнил `output` до `first` сам (например, из общего кэша), — сумма окна строится заново с `first` за O(period).
+ * @warning При периоде 0 конструктор и `reset` выбрасывают `std::invalid_argument`.
+ */
+class MovingAverageEngine {
+ public:
+  explicit MovingAverageEngine(const MovingAverageConfig& config);
+
+  /// @brief Текущие параметры.
+  const MovingAverageConfig& config() const noexcept { return config_; }
+
+  /// @brief Сбрасывает состояние и при необходимости меняет параметры.
+  void reset(const MovingAverageConfig& config);
+
+  /// @brief Обновляет среднее для индексов `[first, size)`; контракт как у диапазонной `moving_average`.
+  void update(const float* input, std::size_t size, std::size_t first, float* output);
+
+  /// @brief Количество закрытых баров, учтённых в сумме окна.
+  std::size_t committed_bars() const noexcept { return committed_; }
+
+  /// @brief Версия формата снимка состояния (`save`/`restore`).
+  static constexpr std::uint32_t kSnapshotVersion = 1;
+
+  /// @brief Версия расчёта: увеличивается, когда меняются значения выхода, чтобы столбцы на диске от прошлой сборки
+  /// не загружались (`ColumnKey::version`).
+  static constexpr std::uint32_t kResultVersion = 1;
+
+  /// @brief Записывает параметры, сумму окна и число закрытых баров в снимок.
+  void save(SnapshotWriter& writer) const;
+
+  /// @brief Восстанавливает состояние из снимка `save` за O(размера состояния).
+  /// @return `false`, если версия снимка или период не совпадают с текущими; состояние тогда не меняется.
+  /// @warning Обрезанный снимок — `std::runtime_error`.
+  bool restore(SnapshotReader& reader);
+
+ private:
+  void rewind(const float* input, std::size_t to);
+
+  MovingAverageConfig config_;
+  double sum_ = 0.0;  ///< Сумма `input[committed_ - period, committed_)`.
+  std::size_t committed_ = 0;
+};
+
 }  // namespace sierra::core
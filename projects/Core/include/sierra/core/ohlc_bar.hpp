@@ -0,0 +1,18 @@
+#pragma once
+
+#include "sierra/core/timestamp.hpp"
+
+namespace sierra::core {
+
+/// @brief Бар OHLCV с временем открытия.
+/// @note Аналог строки `sc.BaseData` без зависимости от ACSIL.
+struct OhlcBar {
+  Timestamp time;
+  double open = 0.0;
+  double high = 0.0;
+  double low = 0.0;
+  double close = 0.0;
+  double volume = 0.0;
+};
+
+}  // namespace sierra::core
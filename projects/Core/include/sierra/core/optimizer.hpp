@@ -0,0 +1,158 @@
+#pragma once
+
+#include "sierra/core/backtester.hpp"
+#include "sierra/core/thread_pool.hpp"
+#include "sierra/core/trade_statistics.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sierra::core {
+
+/// @brief Диапазон одного параметра стратегии: значения `first, first + step, ...` до `last` включительно.
+struct ParameterRange {
+  std::string name;
+  double first = 0.0;
+  double last = 0.0;
+  double step = 1.0;
+};
+
+/// @brief Набор значений параметров в порядке диапазонов.
+using ParameterSet = std::vector<double>;
+
+/// @brief Перебирает все сочетания значений (декартово произведение).
+/// @warning При шаге не больше нуля выбрасывает `std::invalid_argument`.
+std::vector<ParameterSet> grid_search(const std::vector<ParameterRange>& ranges);
+
+/// @brief Выбирает случайные сочетания из узлов сетки.
+/// @param ranges Диапазоны параметров.
+/// @param count Количество сочетаний.
+/// @param seed Зерно генератора; одно и то же зерно даёт одну и ту же выборку.
+std::vector<ParameterSet> random_search(const std::vector<ParameterRange>& ranges, std::size_t count,
+                                        std::uint64_t seed);
+
+/// @brief Результат прогона одного набора параметров.
+struct OptimizationResult {
+  ParameterSet parameters;
+  double objective = 0.0;
+  double net_profit = 0.0;
+  std::size_t trade_count = 0;
+  TradeStatistics statistics;
+};
+
+/// @brief Потокобезопасная таблица лучших результатов.
+/// @note Результаты добавляются по мере готовности; хранится не больше `capacity` лучших по `objective`.
+class ResultTable {
+ public:
+  explicit ResultTable(std::size_t capacity);
+
+  /// @brief Предлагает результат в таблицу.
+  void offer(OptimizationResult result);
+
+  /// @brief Лучшие результаты по убыванию `objective`.
+  std::vector<OptimizationResult> ranked() const;
+
+  /// @brief Сколько результатов было предложено всего.
+  std::size_t evaluated() const;
+
+ private:
+  std::size_t capacity_;
+  mutable std::mutex mutex_;
+  std::vector<OptimizationResult> best_;
+  std::size_t evaluated_ = 0;
+};
+
+/// @brief Общий кэш столбцов индикаторов для всех наборов параметров.
+/// @note Столбец считается один раз: первый запросивший поток вычисляет его, остальные ждут готовый результат. Столбцы
+/// хранятся во `float`, как цены `ScidRecord`. В памяти держится не больше `capacity` последних запрошенных столбцов;
+/// вытесненный столбец живёт, пока его держат выданные `shared_ptr`, а при следующем запросе считается заново.
+class IndicatorCache {
+ public:
+  /// @brief Столбцов в памяти по умолчанию.
+  static constexpr std::size_t kDefaultCapacity = 16;
+
+  /// @brief Создаёт кэш над столбцом цен.
+  /// @param prices Цены (обычно `close` тиков).
+  /// @param capacity Сколько столбцов держать в памяти; не меньше одного.
+  explicit IndicatorCache(std::vector<float> prices, std::size_t capacity = kDefaultCapacity);
+
+  /// @brief Исходный столбец цен.
+  const std::vector<float>& prices() const noexcept { return prices_; }
+
+  /// @brief Простое скользящее среднее цен с заданным периодом.
+  /// @return Столбец той же длины, что цены; до накопления истории — `NaN`.
+  std::shared_ptr<const std::vector<float>> moving_average(std::size_t period);
+
+  /// @brief Сколько раз столбец вычислялся (повторно — после вытеснения).
+  std::size_t computed_count() const;
+
+  /// @brief Сколько столбцов сейчас в кэше.
+  std::size_t resident_count() const;
+
+ private:
+  using Column = std::shared_ptr<const std::vector<float>>;
+
+  struct Entry {
+    std::shared_future<Column> column;
+    std::list<std::size_t>::iterator recent;
+  };
+
+  std::vector<float> prices_;
+  std::size_t capacity_;
+  mutable std::mutex mutex_;
+  std::map<std::size_t, Entry> averages_;
+  std::list<std::size_t> recent_;  ///< Периоды от последнего запрошенного к самому давнему.
+  std::size_t computed_ = 0;
+};
+
+/// @brief Оценивает набор параметров и возвращает результат.
+using Evaluator = std::function<OptimizationResult(const ParameterSet&)>;
+
+/// @brief Параллельно оценивает кандидатов на пуле потоков.
+/// @param candidates Наборы параметров.
+/// @param evaluate Функция оценки; должна быть потокобезопасной.
+/// @param pool Пул потоков.
+/// @param table Таблица, куда стекаются результаты.
+void optimize(const std::vector<ParameterSet>& candidates, const Evaluator& evaluate, ThreadPool& pool,
+              ResultTable& table);
+
+/// @brief Прогоняет стратегию пересечения двух скользящих средних по тикам.
+/// @param ticks Тики (обычно из общего `ScidFile`).
+/// @param count Количество тиков.
+/// @param cache Кэш индикаторов над ценами закрытия этих тиков.
+/// @param fast_period Период быстрой средней.
+/// @param slow_period Период медленной средней.
+/// @param options Параметры бэктеста.
+/// @return OptimizationResult с чистой прибылью в качестве `objective`.
+/// @note Позиция всегда в рынке: пересечение вверх — long, вниз — short (разворот), как `scsf_MovingAverageCrossover`-системы.
+OptimizationResult evaluate_ma_crossover(const ScidRecord* ticks, std::size_t count,
+                                         IndicatorCache& cache, std::size_t fast_period,
+                                         std::size_t slow_period, const BacktestOptions& options);
+
+/// @brief То же, что `evaluate_ma_crossover`, но на диапазоне тиков `[begin, end)`.
+/// @param ticks Все тики; столбцы кэша выровнены по `ticks[0]`.
+/// @param begin Первый тик диапазона.
+/// @param end Тик после последнего.
+/// @note Диапазон начинается без позиции, а в конце позиция закрывается — результаты соседних диапазонов аддитивны. Средние берутся из общего кэша, поэтому уже «прогреты» историей до `begin`.
+OptimizationResult evaluate_ma_crossover_range(const ScidRecord* ticks, std::size_t begin,
+                                               std::size_t end, IndicatorCache& cache,
+                                               std::size_t fast_period, std::size_t slow_period,
+                                               const BacktestOptions& options);
+
+/// @brief Продолжает стратегию пересечения средних на диапазоне `[begin, end)` на общем счёте, не закрывая позицию.
+/// @param account Бэктестер с позицией, оставшейся от предыдущего диапазона; стратегия продолжает с её знаком.
+/// @return OptimizationResult за диапазон: `objective` и `net_profit` — закрытые сделки плюс изменение плавающего результата от котировки тика перед `begin` до последнего тика, `trade_count` — сделки, закрытые в диапазоне, `statistics` — накопленные счётом.
+/// @note Заявки, поданные на последнем тике, исполняются по его котировкам, чтобы следующий диапазон видел итоговую позицию. Если на последних тиках диапазонов сигналов нет, сумма по подряд идущим диапазонам равна результату одного прогона по их объединению.
+OptimizationResult continue_ma_crossover_range(const ScidRecord* ticks, std::size_t begin, std::size_t end,
+                                               IndicatorCache& cache, std::size_t fast_period,
+                                               std::size_t slow_period, Backtester& account);
+
+}  // namespace sierra::core
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "sierra/core/spsc_ring.hpp"
+#include "sierra/core/trade_record.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace sierra::core {
+
+/// @brief Накопленные метрики потока ордеров.
+struct OrderFlowMetrics {
+  std::uint64_t trade_count = 0;
+  std::uint64_t bid_volume = 0;
+  std::uint64_t ask_volume = 0;
+  std::uint64_t unclassified_volume = 0;
+  double volume_price_sum = 0.0;
+  std::uint32_t last_sequence = 0;
+  std::uint64_t dropped = 0;
+
+  /// @brief Дельта объёма: покупки по Ask минус продажи по Bid.
+  std::int64_t delta() const noexcept {
+    return static_cast<std::int64_t>(ask_volume) - static_cast<std::int64_t>(bid_volume);
+  }
+
+  /// @brief VWAP всех учтённых сделок; `NaN`, если объёма нет.
+  double vwap() const noexcept;
+};
+
+/// @brief Фоновый обработчик ленты сделок.
+/// @note Поток графика кладёт сделки через `push`, рабочий поток разбирает очередь пачками и обновляет метрики вне потока графика.
+/// Без сделок поток просыпается всё реже, от `kPollInterval` до `kMaxPause`; начиная с `kIdleInterval` первая сделка будит его
+/// через условную переменную.
+/// @warning `push` должен вызываться из одного потока — очередь рассчитана на одного писателя.
+class OrderFlowWorker {
+ public:
+  /// @brief Создаёт обработчик и запускает рабочий поток.
+  /// @param capacity Ёмкость очереди сделок.
+  explicit OrderFlowWorker(std::size_t capacity);
+
+  /// @brief Останавливает поток, предварительно дочитав очередь.
+  ~OrderFlowWorker();
+
+  OrderFlowWorker(const OrderFlowWorker&) = delete;
+  OrderFlowWorker& operator=(const OrderFlowWorker&) = delete;
+
+  /// @brief Передаёт сделку рабочему потоку.
+  /// @param trade Запись сделки.
+  /// @return `false`, если очередь переполнена и сделка отброшена (учитывается в `dropped`).
+  bool push(const TradeRecord& trade) noexcept {
+    if (!ring_.try_push(trade)) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    // Писатель один, поэтому счётчику хватает обычной записи без read-modify-write.
+    pushed_.store(pushed_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    if (idle_.load(std::memory_order_relaxed)) {
+      wake_idle();
+    }
+    return true;
+  }
+
+  /// @brief Возвращает согласованную копию метрик.
+  OrderFlowMetrics snapshot() const;
+
+  /// @brief Блокирует вызывающий поток, пока не будут учтены все сделки, переданные до вызова.
+  void drain() const;
+
+  /// Пауза после пачки со сделками; каждый пустой проход удваивает её до `kMaxPause`.
+  static constexpr std::chrono::microseconds kPollInterval{50};
+  /// С этой паузы поток ждёт сделки на условной переменной, и `push` его будит.
+  static constexpr std::chrono::microseconds kIdleInterval{1000};
+  static constexpr std::chrono::microseconds kMaxPause{100000};
+
+ private:
+  void run();
+  void wait_for_work(std::chrono::microseconds pause);
+  void wake_idle() const noexcept;
+
+  SpscRing<TradeRecord> ring_;
+  std::atomic<std::uint64_t> pushed_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<bool> stop_{false};
+  mutable std::atomic<bool> idle_{false};  ///< Поток спит паузу простоя; писатель будит его сам.
+  mutable std::mutex metrics_mutex_;
+  mutable std::condition_variable metrics_updated_;
+  OrderFlowMetrics metrics_;
+  mutable std::mutex wake_mutex_;
+  mutable std::condition_variable wakeup_;
+  mutable bool wake_ = false;
+  std::thread thread_;
+};
+
+}  // namespace sierra::core
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace sierra::core {
+
+/// @brief Потоковая оценка квантилей с гарантированной относительной точностью.
+/// @note Значения раскладываются по логарифмическим корзинам (схема DDSketch): корзина `i` покрывает модули `(γ^(i-1), γ^i]`, `γ = (1 + α) / (1 - α)`. Память растёт с логарифмом диапазона значений, а не с их количеством.
+/// @note Объединение складывает счётчики корзин, поэтому результат не зависит от того, как значения были поделены между частями и в каком порядке части объединялись.
+class QuantileSketch {
+ public:
+  /// @brief Создаёт пустой скетч.
+  /// @param relative_accuracy Допустимая относительная погрешность квантиля `α`.
+  /// @warning При `α` вне `(0, 1)` выбрасывает `std::invalid_argument`.
+  explicit QuantileSketch(double relative_accuracy = 0.01);
+
+  /// @brief Учитывает значение; `NaN` игнорируется.
+  void add(double value);
+
+  /// @brief Добавляет к скетчу значения другого скетча.
+  /// @warning При разной точности скетчей выбрасывает `std::invalid_argument`.
+  void merge(const QuantileSketch& other);
+
+  /// @brief Оценка квантиля.
+  /// @param q Уровень в `[0, 1]`; значения вне диапазона приводятся к границам.
+  /// @return Значение, отличающееся от точного квантиля не более чем на `α` относительно; `NaN` для пустого скетча.
+  /// @note Уровни 0 и 1 возвращают точные минимум и максимум.
+  double quantile(double q) const;
+
+  /// @brief Количество учтённых значений.
+  std::uint64_t count() const noexcept { return count_; }
+
+  /// @brief Точный минимум; `NaN` для пустого скетча.
+  double min() const noexcept;
+
+  /// @brief Точный максимум; `NaN` для пустого скетча.
+  double max() const noexcept;
+
+  /// @brief Заданная относительная точность.
+  double relative_accuracy() const noexcept { return accuracy_; }
+
+ private:
+  /// Плотный массив счётчиков корзин начиная с индекса `offset`.
+  struct Store {
+    int offset = 0;
+    std::vector<std::uint64_t> counts;
+
+    void add(int index, std::uint64_t count);
+  };
+
+  int index_of(double magnitude) const noexcept;
+  double value_of(int index) const noexcept;
+
+  double accuracy_;
+  double gamma_;
+  double log_gamma_;
+  Store positive_;
+  Store negative_;
+  std::uint64_t zero_count_ = 0;
+  std::uint64_t count_ = 0;
+  double min_ = 0.0;
+  double max_ = 0.0;
+};
+
+}  // namespace sierra::core
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "sierra/core/ohlc_bar.hpp"
+#include "sierra/core/scid_file.hpp"
+#include "sierra/core/thread_pool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace sierra::core {
+
+/// @brief Ряд, значение которого на последнем баре сравнивает условие сканера.
+enum class ScanSeries {
+  kClose,     ///< Цена закрытия бара.
+  kSma,       ///< Простое скользящее среднее закрытий.
+  kRsi,       ///< RSI Уайлдера по закрытиям.
+  kConstant,  ///< Число.
+};
+
+/// @brief Операнд условия сканера.
+struct ScanOperand {
+  ScanSeries series = ScanSeries::kClose;
+  double value = 0.0;  ///< Период для `kSma` и `kRsi`, число для `kConstant`.
+
+  friend bool operator==(const ScanOperand& lhs, const ScanOperand& rhs) noexcept {
+    return lhs.series == rhs.series && lhs.value == rhs.value;
+  }
+};
+
+enum class ScanComparison { kLess, kGreater };
+
+/// @brief Условие `left < right` или `left > right` на последнем баре символа.
+struct ScanCondition {
+  ScanOperand left;
+  ScanComparison comparison = ScanComparison::kGreater;
+  ScanOperand right;
+};
+
+/**
+ * @brief Разбирает условие вида `close > sma(200)` или `rsi(14) < 30`.
+ * @note Операнды: `close`, `sma(N)`, `rsi(N)` и числа; пробелы между лексемами необязательны.
+ * @warning При ошибке синтаксиса или периоде не из `[1, 100000]` выбрасывает `std::invalid_argument`.
+ */
+ScanCondition parse_scan_condition(const std::string& text);
+
+/// @brief Операнд в синтаксисе `parse_scan_condition`.
+std::string to_string(const ScanOperand& operand);
+
+/**
+ * @brief Сворачивает записи `.scid` в бары периода `period_microseconds`.
+ * @param bars Результат; буфер переиспользуется между вызовами.
+ * @note Начало бара кратно периоду от эпохи (дневные бары — от полуночи времени файла), время сессий не
+ * учитывается. Тиковая запись (`open == 0`) даёт цену `close`, запись бара — свои OHLC. Записи с временем
+ * раньше текущего бара дописываются в него.
+ * @warning При неположительном периоде выбрасывает `std::invalid_argument`.
+ */
+void aggregate_bars(const ScidRecord* records, std::size_t count, std::int64_t period_microseconds,
+                    std::vector<OhlcBar>& bars);
+
+/// @brief Значение операнда на последнем баре; NaN, если баров меньше, чем нужно ряду.
+/// @note RSI считается по всей истории со сглаживанием Уайлдера: первое среднее — простое по `N` изменениям.
+double scan_value(const std::vector<OhlcBar>& bars, const ScanOperand& operand);
+
+/// @brief Параметры сканера.
+struct ScanOptions {
+  std::int64_t bar_period_seconds = kSecondsPerDay;
+};
+
+/// @brief Строка таблицы результатов: один символ.
+struct ScanRow {
+  std::string symbol;          ///< Имя файла без каталога и расширения.
+  std::size_t bars = 0;
+  Timestamp last_time;         ///< Начало последнего бара.
+  std::vector<double> values;  ///< Значения `ScanReport::columns` на последнем баре.
+  bool matched = false;        ///< Выполнены все условия.
+  std::string error;           ///< Файл не прочитан; остальные поля пусты.
+};
+
+/// @brief Результат прогона сканера.
+struct ScanReport {
+  std::vector<ScanOperand> columns;  ///< Различные операнды условий, кроме чисел, в порядке появления.
+  std::vector<ScanRow> rows;         ///< В порядке путей.
+  std::size_t bytes = 0;             ///< Объём прочитанных файлов.
+  double seconds = 0.0;
+
+  std::size_t matched() const noexcept;
+  double symbols_per_second() const noexcept {
+    return seconds > 0.0 ? static_cast<double>(rows.size()) / seconds : 0.0;
+  }
+  double bytes_per_second() const noexcept { return seconds > 0.0 ? static_cast<double>(bytes) / seconds : 0.0; }
+};
+
+/**
+ * @brief Проверяет условия на последнем баре каждого файла `.scid`.
+ * @param paths Файлы символов.
+ * @param conditions Условия; символ проходит, если выполнены все.
+ * @param options Период бара.
+ * @param pool Пул потоков.
+ * @return ScanReport Строка на каждый путь и пропускная способность.
+ * @note Каждый поток пула берёт следующий путь из общего счётчика, отображает файл, сворачивает его в свой буфер
+ * баров и освобождает отображение до следующего пути: в памяти одновременно не больше одного файла и одного
+ * буфера на поток, сколько бы символов ни было. Ошибка открытия файла попадает в `ScanRow::error`.
+ * @warning При неположительном периоде бара выбрасывает `std::invalid_argument`.
+ */
+ScanReport scan_symbols(const std::vector<std::string>& paths, const std::vector<ScanCondition>& conditions,
+                        const ScanOptions& options, ThreadPool& pool);
+
+/// @brief Печатает таблицу CSV: `symbol,bars,<столбцы>,matched,error`; пустое значение — ряду не хватило баров.
+/// @param matched_only Только строки символов, прошедших условия.
+void write_scan_table(std::ostream& out, const ScanReport& report, bool matched_only);
+
+}  // namespace sierra::core
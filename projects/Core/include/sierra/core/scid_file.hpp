@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sierra::core {
+
+/// @brief Заголовок файла внутридневных данных `.scid` (56 байт).
+/// @note Повторяет раскладку `s_IntradayFileHeader` из SDK.
+struct ScidHeader {
+  static constexpr std::uint32_t kUniqueHeaderId = 0x44494353;  // "SCID"
+
+  std::uint32_t file_type_unique_header_id = kUniqueHeaderId;
+  std::uint32_t header_size = 56;
+  std::uint32_t record_size = 40;
+  std::uint16_t version = 1;
+  std::uint16_t unused1 = 0;
+  std::uint32_t unused2 = 0;
+  char reserve[36] = {};
+};
+
+/// @brief Запись `.scid` (40 байт), совместимая с `s_IntradayRecord`.
+/// @note Для тиковых записей `open` — признак (0 или маркер части разбитой сделки), `high` — Ask, `low` — Bid,
+/// `close` — цена сделки.
+struct ScidRecord {
+  /// @brief `open` первой и последней частей разбитой сделки: `FIRST_SUB_TRADE_OF_UNBUNDLED_TRADE_VALUE` и
+  /// `LAST_SUB_TRADE_OF_UNBUNDLED_TRADE_VALUE` из `IntradayRecord.h`.
+  static constexpr float kFirstSubTradeOpen = -1.99900095e+37F;
+  static constexpr float kLastSubTradeOpen = -1.99900197e+37F;
+
+  std::int64_t date_time = 0;  ///< Микросекунды от 1899-12-30, как `SCDateTimeMS`.
+  float open = 0.0f;
+  float high = 0.0f;
+  float low = 0.0f;
+  float close = 0.0f;
+  std::uint32_t num_trades = 0;
+  std::uint32_t total_volume = 0;
+  std::uint32_t bid_volume = 0;
+  std::uint32_t ask_volume = 0;
+
+  /// @brief Запись содержит одиночную сделку с Bid/Ask, в том числе часть разбитой сделки.
+  /// @note Как `IsSingleTradeWithBidAsk`, но без проверки `num_trades == 1`: признак тика — только `open`.
+  bool is_tick() const noexcept { return open == 0.0f || is_unbundled_trade(); }
+
+  /// @brief Первая или последняя часть разбитой сделки, как `IsFirstOrLastSubTradeOfUnbundledTrade`.
+  bool is_unbundled_trade() const noexcept { return open == kFirstSubTradeOpen || open == kLastSubTradeOpen; }
+};
+
+static_assert(sizeof(ScidHeader) == 56, "ScidHeader must match s_IntradayFileHeader");
+static_assert(sizeof(ScidRecord) == 40, "ScidRecord must match s_IntradayRecord");
+
+/// @brief Файл `.scid`, отображённый в память только для чтения.
+/// @note Записи читаются напрямую из отображения без копирования; несколько потоков могут читать один объект одновременно.
+/// @warning При ошибке открытия или неверном заголовке конструктор выбрасывает `std::runtime_error`.
+class ScidFile {
+ public:
+  /// @brief Открывает и отображает файл.
+  /// @param path Путь к файлу `.scid`.
+  explicit ScidFile(const std::string& path);
+  ~ScidFile();
+
+  ScidFile(const ScidFile&) = delete;
+  ScidFile& operator=(const ScidFile&) = delete;
+
+  /// @brief Указатель на первую запись.
+  const ScidRecord* records() const noexcept { return records_; }
+
+  /// @brief Количество целых записей.
+  std::size_t size() const noexcept { return size_; }
+
+  /// @brief Размер файла в байтах.
+  std::size_t byte_size() const noexcept { return byte_size_; }
+
+ private:
+  void close() noexcept;
+
+  const ScidRecord* records_ = nullptr;
+  std::size_t size_ = 0;
+  std::size_t byte_size_ = 0;
+  void* view_ = nullptr;
+#ifdef _WIN32
+  void* file_handle_ = nullptr;
+  void* mapping_handle_ = nullptr;
+#else
+  int fd_ = -1;
+#endif
+};
+
+/// @brief Записывает записи в новый файл `.scid` со стандартным заголовком.
+/// @param path Путь к создаваемому файлу.
+/// @param records Записи для сохранения.
+/// @warning При ошибке ввода-вывода выбрасывает `std::runtime_error`.
+void write_scid(const std::string& path, const std::vector<ScidRecord>& records);
+
+}  // namespace sierra::core
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "sierra/core/engine_snapshot.hpp"
+#include "sierra/core/ohlc_bar.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sierra::core {
+
+/// @brief Время сессий графика в секундах от полуночи, как `s_ChartSessionTimes`.
+/// @note Если начало торгового дня больше конца дневной сессии, сессия переходит через полночь и бары после начала относятся к следующей дате.
+struct SessionTimes {
+  int start_second = 0;
+  int end_second = 86399;
+  int evening_start_second = 0;
+  int evening_end_second = 0;
+  bool use_evening_session = false;
+};
+
+/// @brief Агрегат одного торгового дня.
+struct SessionPeriod {
+  int trading_date = 0;
+  std::size_t first_bar = 0;
+  std::size_t last_bar = 0;
+  double open = 0.0;
+  double high = 0.0;
+  double low = 0.0;
+  double close = 0.0;
+  double volume = 0.0;
+  /// Диапазон Initial Balance; `NaN`, пока в IB не попал ни один бар.
+  double ib_high = 0.0;
+  double ib_low = 0.0;
+  /// IB закрыт: в дневной сессии появился бар после окончания окна IB.
+  bool ib_complete = false;
+};
+
+/// @brief Классические уровни пивотов.
+struct PivotLevels {
+  double pivot = 0.0;
+  double r1 = 0.0;
+  double s1 = 0.0;
+  double r2 = 0.0;
+  double s2 = 0.0;
+  double r3 = 0.0;
+  double s3 = 0.0;
+};
+
+/// @brief Считает классические пивоты по High/Low/Close периода.
+/// @param period Завершённый торговый день (обычно предыдущий).
+/// @return PivotLevels Уровни в формулировке `scsf_PivotPointsDaily` (тип 0).
+PivotLevels classic_pivots(const SessionPeriod& period);
+
+/// @brief Потоковая агрегация баров по торговым дням.
+/// @note Каждый бар обрабатывается за O(1); предыдущие периоды и период любого бара доступны за O(1) без повторного сканирования, в отличие от `sc.GetOHLCOfTimePeriod`.
+/// @warning Бары подаются по возрастанию индекса; пересчитать можно только последний бар.
+class SessionAggregator {
+ public:
+  /// @brief Создаёт агрегатор.
+  /// @param times Время сессий графика.
+  /// @param initial_balance_seconds Длина окна Initial Balance от начала дневной сессии; 0 — не считать IB.
+  SessionAggregator(SessionTimes times, int initial_balance_seconds);
+
+  /// @brief Добавляет новый бар или пересчитывает последний.
+  /// @param bar_index Индекс бара: `size()` для нового или `size() - 1` для обновления последнего.
+  /// @param bar Данные бара.
+  /// @return std::size_t Индекс периода, к которому отнесён бар.
+  /// @warning Для других индексов выбрасывает `std::invalid_argument` — нужен `reset` и полный пересчёт.
+  std::size_t update(std::size_t bar_index, const OhlcBar& bar);
+
+  /// @brief Очищает состояние.
+  void reset();
+
+  /// @brief Торговая дата бара по правилам сессии.
+  int trading_date(Timestamp time) const noexcept;
+
+  /// @brief Количество обработанных баров.
+  std::size_t size() const noexcept { return bar_periods_.size(); }
+
+  /// @brief Все периоды по порядку.
+  const std::vector<SessionPeriod>& periods() const noexcept { return periods_; }
+
+  /// @brief Индекс периода для бара.
+  std::size_t period_of_bar(std::size_t bar_index) const { return bar_periods_.at(bar_index); }
+
+  /// @brief Период, отстоящий на `back` назад от текущего (0 — текущий).
+  /// @return Указатель на период или `nullptr`, если истории не хватает.
+  const SessionPeriod* prior(std::size_t back) const noexcept;
+
+  /// @brief Версия формата снимка состояния (`save`/`restore`).
+  static constexpr std::uint32_t kSnapshotVersion = 1;
+
+  /// @brief Записывает время сессий, периоды и отнесение баров к периодам в снимок.
+  void save(SnapshotWriter& writer) const;
+
+  /// @brief Восстанавливает состояние из снимка `save` за O(размера состояния).
+  /// @return `false`, если версия снимка или время сессий и окно IB не совпадают с текущими; состояние тогда не меняется.
+  /// @warning Обрезанный снимок — `std::runtime_error`.
+  bool restore(SnapshotReader& reader);
+
+ private:
+  void apply(std::size_t bar_index, const OhlcBar& bar);
+
+  SessionTimes times_;
+  int trading_start_second_ = 0;
+  bool wraps_midnight_ = false;
+  int initial_balance_seconds_ = 0;
+  std::vector<SessionPeriod> periods_;
+  std::vector<std::uint32_t> bar_periods_;
+  SessionPeriod checkpoint_;
+  bool checkpoint_new_period_ = false;
+};
+
+}  // namespace sierra::core
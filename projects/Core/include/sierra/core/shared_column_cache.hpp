@@ -0,0 +1,118 @@
+#pragma once
+
+#include "sierra/core/epoch_domain.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sierra::core {
+
+/// @brief Ключ общего столбца: одинаковые исследования на одинаковых данных дают один столбец.
+struct ColumnKey {
+  std::string symbol;
+  std::int32_t bar_period_seconds = 0;
+  std::string study;               ///< Идентификатор расчёта, например `"SierraStudy.MovingAverage"`.
+  std::vector<double> parameters;  ///< Входы, от которых зависит результат.
+  std::int64_t first_bar_time = 0;  ///< Время первого бара: графики с разной глубиной истории не смешиваются.
+  std::uint32_t version = 0;        ///< Версия расчёта: другая формула после пересборки DLL — другой столбец.
+
+  friend bool operator==(const ColumnKey& lhs, const ColumnKey& rhs) {
+    return lhs.symbol == rhs.symbol && lhs.bar_period_seconds == rhs.bar_period_seconds && lhs.study == rhs.study &&
+           lhs.parameters == rhs.parameters && lhs.first_bar_time == rhs.first_bar_time &&
+           lhs.version == rhs.version;
+  }
+  friend bool operator!=(const ColumnKey& lhs, const ColumnKey& rhs) { return !(lhs == rhs); }
+};
+
+/// @brief Хеш `ColumnKey` для `std::unordered_map`.
+struct ColumnKeyHash {
+  std::size_t operator()(const ColumnKey& key) const noexcept;
+};
+
+/**
+ * @brief Столбец результатов по закрытым барам, общий для всех подписчиков.
+ * @note Читатели получают `View` без блокировок под `EpochDomain::Guard`. Писатель дописывает бары в свободную
+ * ёмкость блока и публикует новую длину; когда ёмкость кончается, блок копируется в вдвое больший, а старый
+ * освобождается через эпохи, когда его не держит ни один читатель. Вместе со значением хранятся время и цена
+ * источника бара: по ним подписчик проверяет, что его данные совпадают с данными, на которых считали столбец.
+ * @warning Дописывает один писатель за раз (внутренний мьютекс); значения уже опубликованных баров не меняются.
+ */
+class SharedColumn {
+ public:
+  /// @brief Неизменяемый срез столбца; действителен, пока жив `Guard`, под которым он получен.
+  struct View {
+    const float* values = nullptr;
+    const std::int64_t* times = nullptr;   ///< Время бара источника.
+    const float* sources = nullptr;        ///< Значение источника (например, Close), по которому считался бар.
+    std::size_t size = 0;
+  };
+
+  explicit SharedColumn(std::shared_ptr<EpochDomain> domain);
+  ~SharedColumn();
+
+  SharedColumn(const SharedColumn&) = delete;
+  SharedColumn& operator=(const SharedColumn&) = delete;
+
+  /// @brief Закрепляет эпоху для чтения.
+  EpochDomain::Guard pin() const noexcept { return domain_->pin(); }
+
+  /// @brief Опубликованные бары.
+  View read(const EpochDomain::Guard& guard) const noexcept;
+
+  /// @brief Дописывает бары `[from, from + count)`.
+  /// @return `false`, если длина столбца уже не равна `from` (бары дописал другой подписчик).
+  bool append(std::size_t from, const float* values, const std::int64_t* times, const float* sources,
+              std::size_t count);
+
+  /// @brief Заранее выделяет блок на `bars` баров, чтобы длинная публикация не копировала блок при каждом росте.
+  void reserve(std::size_t bars);
+
+  /// @brief Длина столбца; одно атомарное чтение, без закрепления эпохи.
+  std::size_t size() const noexcept { return size_.load(std::memory_order_acquire); }
+
+  /// @brief Память текущего блока в байтах.
+  std::size_t memory_bytes() const noexcept;
+
+ private:
+  struct Block;
+
+  static void destroy(void* block);
+  Block* grow(Block* block, std::size_t capacity);
+
+  std::shared_ptr<EpochDomain> domain_;
+  std::atomic<Block*> block_{nullptr};
+  std::atomic<std::size_t> size_{0};  ///< Копия длины текущего блока.
+  std::mutex writer_;
+};
+
+/**
+ * @brief Процессный кэш общих столбцов: графики с одинаковым `ColumnKey` считают закрытые бары один раз.
+ * @note Столбец живёт, пока его держит хотя бы один подписчик (`std::shared_ptr`); кэш хранит только слабые ссылки.
+ * Потокобезопасен.
+ */
+class SharedColumnCache {
+ public:
+  SharedColumnCache();
+
+  /// @brief Столбец ключа; создаётся при первом запросе.
+  std::shared_ptr<SharedColumn> acquire(const ColumnKey& key);
+
+  /// @brief Живые столбцы.
+  std::size_t columns() const;
+
+  /// @brief Память живых столбцов в байтах.
+  std::size_t memory_bytes() const;
+
+ private:
+  std::shared_ptr<EpochDomain> domain_;
+  mutable std::mutex mutex_;
+  std::unordered_map<ColumnKey, std::weak_ptr<SharedColumn>, ColumnKeyHash> columns_;
+};
+
+}  // namespace sierra::core
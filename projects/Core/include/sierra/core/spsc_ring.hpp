@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+namespace sierra::core {
+
+/// @brief Размер кэш-линии, по которому выравниваются индексы очереди.
+inline constexpr std::size_t kCacheLineSize = 64;
+
+/// @brief Ограниченная lock-free очередь «один писатель — один читатель».
+/// @tparam T Тривиально копируемый тип элемента.
+/// @note Индексы писателя и читателя лежат в разных кэш-линиях, а каждая сторона держит локальную копию чужого индекса, чтобы не трогать общую линию на каждом вызове.
+/// @warning `try_push` вызывается только из одного потока, `try_pop` — только из другого.
+template <typename T>
+class SpscRing {
+  static_assert(std::is_trivially_copyable_v<T>, "SpscRing requires trivially copyable elements");
+
+ public:
+  /// @brief Создаёт очередь указанной ёмкости.
+  /// @param capacity Желаемая ёмкость; округляется вверх до степени двойки.
+  /// @warning При нулевой ёмкости выбрасывает `std::invalid_argument`.
+  explicit SpscRing(std::size_t capacity) {
+    if (capacity == 0) {
+      throw std::invalid_argument("SpscRing capacity must be greater than zero");
+    }
+    std::size_t rounded = 1;
+    while (rounded < capacity) {
+      rounded <<= 1;
+    }
+    mask_ = rounded - 1;
+    slots_ = std::make_unique<T[]>(rounded);
+  }
+
+  SpscRing(const SpscRing&) = delete;
+  SpscRing& operator=(const SpscRing&) = delete;
+
+  /// @brief Ёмкость очереди (степень двойки).
+  std::size_t capacity() const noexcept { return mask_ + 1; }
+
+  /// @brief Кладёт элемент в очередь.
+  /// @param value Копируемое значение.
+  /// @return `false`, если очередь заполнена.
+  bool try_push(const T& value) noexcept {
+    const std::size_t head = producer_.index.load(std::memory_order_relaxed);
+    if (head - producer_.cached_other > mask_) {
+      producer_.cached_other = consumer_.index.load(std::memory_order_acquire);
+      if (head - producer_.cached_other > mask_) {
+        return false;
+      }
+    }
+    slots_[head & mask_] = value;
+    producer_.index.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// @brief Забирает элемент из очереди.
+  /// @param out Куда записать значение.
+  /// @return `false`, если очередь пуста.
+  bool try_pop(T& out) noexcept {
+    const std::size_t tail = consumer_.index.load(std::memory_order_relaxed);
+    if (tail == consumer_.cached_other) {
+      consumer_.cached_other = producer_.index.load(std::memory_order_acquire);
+      if (tail == consumer_.cached_other) {
+        return false;
+      }
+    }
+    out = slots_[tail & mask_];
+    consumer_.index.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// @brief Забирает до `max_count` элементов за один проход.
+  /// @param out Буфер назначения.
+  /// @param max_count Размер буфера.
+  /// @return Количество скопированных элементов.
+  /// @note Публикует новый индекс читателя один раз на пачку.
+  std::size_t pop_bulk(T* out, std::size_t max_count) noexcept {
+    const std::size_t tail = consumer_.index.load(std::memory_order_relaxed);
+    std::size_t available = consumer_.cached_other - tail;
+    if (available < max_count) {
+      consumer_.cached_other = producer_.index.load(std::memory_order_acquire);
+      available = consumer_.cached_other - tail;
+    }
+    const std::size_t count = available < max_count ? available : max_count;
+    for (std::size_t i = 0; i < count; ++i) {
+      out[i] = slots_[(tail + i) & mask_];
+    }
+    if (count != 0) {
+      consumer_.index.store(tail + count, std::memory_order_release);
+    }
+    return count;
+  }
+
+  /// @brief Приблизительное число элементов в очереди.
+  /// @note Точно только когда обе стороны неактивны.
+  std::size_t size_approx() const noexcept {
+    return producer_.index.load(std::memory_order_acquire) -
+           consumer_.index.load(std::memory_order_acquire);
+  }
+
+ private:
+  struct alignas(kCacheLineSize) Side {
+    std::atomic<std::size_t> index{0};
+    std::size_t cached_other = 0;
+  };
+
+  Side producer_;
+  Side consumer_;
+  std::size_t mask_ = 0;
+  std::unique_ptr<T[]> slots_;
+};
+
+}  // namespace sierra::core
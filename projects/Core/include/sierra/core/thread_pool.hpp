@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sierra::core {
+
+/// @brief Пул потоков с перехватом работы (work stealing).
+/// @note У каждого потока своя очередь: владелец берёт задачи с конца (LIFO, тёплый кэш), остальные крадут с начала. Задачи, поданные из потока пула, попадают в его собственную очередь.
+/// @warning Первое исключение из задачи сохраняется и повторно выбрасывается из `wait_idle`.
+class ThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  /// @brief Запускает пул.
+  /// @param threads Число потоков; 0 — по числу аппаратных потоков.
+  explicit ThreadPool(std::size_t threads = 0);
+
+  /// @brief Дожидается выполнения всех задач и останавливает потоки.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// @brief Ставит задачу в очередь.
+  void submit(Task task);
+
+  /// @brief Блокирует вызывающий поток до выполнения всех поданных задач.
+  void wait_idle();
+
+  /// @brief Количество рабочих потоков.
+  std::size_t size() const noexcept { return threads_.size(); }
+
+  /// @brief Сколько задач было украдено из чужих очередей (для диагностики).
+  std::size_t steal_count() const noexcept { return steals_.load(std::memory_order_relaxed); }
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void worker_loop(std::size_t index);
+  bool take(std::size_t index, Task& task);
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> threads_;
+  std::mutex state_mutex_;
+  std::condition_variable wake_;
+  std::condition_variable idle_;
+  std::size_t queued_ = 0;
+  std::size_t unfinished_ = 0;
+  bool stop_ = false;
+  std::exception_ptr error_;
+  std::atomic<std::size_t> next_queue_{0};
+  std::atomic<std::size_t> steals_{0};
+};
+
+}  // namespace sierra::core
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace sierra::core {
+
+/// @brief Дешёвый монотонный счётчик для отметок времени горячего пути.
+/// @return Такты TSC на x86, иначе наносекунды `steady_clock`.
+/// @note `system_clock::now()` и `steady_clock::now()` стоят десятки наносекунд, поэтому горячий путь читает такты, а в наносекунды их переводит `TickCalibration` вне горячего пути.
+inline std::int64_t read_ticks() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  return static_cast<std::int64_t>(__rdtsc());
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+  return static_cast<std::int64_t>(__builtin_ia32_rdtsc());
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+/**
+ * @brief Перевод тактов `read_ticks()` в наносекунды.
+ * @note Опорная точка берётся при создании; наклон измеряется по `steady_clock` от неё до последнего `update()`,
+ * поэтому со временем только уточняется и не прыгает при переводе системных часов.
+ * @warning До первого `update()` наклон равен 1 (верно только для запасного `steady_clock`).
+ */
+class TickCalibration {
+ public:
+  TickCalibration() noexcept;
+
+  /// @brief Уточняет наклон по текущему моменту.
+  void update() noexcept;
+
+  /// @brief Наносекунд в одном такте.
+  double nanoseconds_per_tick() const noexcept { return ns_per_tick_; }
+
+  /// @brief Длительность в тактах, переведённая в наносекунды.
+  double to_nanoseconds(std::int64_t ticks) const noexcept { return static_cast<double>(ticks) * ns_per_tick_; }
+
+  /// @brief Отметка `read_ticks()`, переведённая в наносекунды `system_clock` от эпохи Unix.
+  std::int64_t to_system_ns(std::int64_t ticks) const noexcept;
+
+ private:
+  std::int64_t anchor_ticks_;
+  std::int64_t anchor_steady_ns_;
+  std::int64_t anchor_system_ns_;
+  double ns_per_tick_ = 1.0;
+};
+
+}  // namespace sierra::core
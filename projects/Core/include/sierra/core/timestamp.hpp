@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace sierra::core {
+
+inline constexpr std::int64_t kMicrosecondsPerSecond = 1000000;
+inline constexpr std::int64_t kSecondsPerDay = 86400;
+inline constexpr std::int64_t kMicrosecondsPerDay = kMicrosecondsPerSecond * kSecondsPerDay;
+
+/// @brief Момент времени в целых микросекундах от эпохи Sierra Chart (1899-12-30 00:00).
+/// @note Совпадает с внутренним представлением `SCDateTimeMS` (`GetInternalDateTime()`), поэтому перевод в обе стороны точен без арифметики с плавающей точкой.
+/// @warning Дата и время суток берутся усечением, как `SCDateTime::GetDate()` и `SCDateTime::GetTime()`.
+class Timestamp {
+ public:
+  constexpr Timestamp() = default;
+
+  /// @brief Создаёт момент из числа микросекунд от эпохи.
+  static constexpr Timestamp from_microseconds(std::int64_t microseconds) {
+    return Timestamp(microseconds);
+  }
+
+  /// @brief Создаёт момент из `SCDateTime` в днях (тип `double`), округляя до микросекунды.
+  /// @warning У `double` на современных датах шаг около 0.6 мкс, поэтому точный обмен гарантирован только для значений с миллисекундной точностью.
+  static Timestamp from_days(double days) {
+    const double whole = std::floor(days);
+    const std::int64_t fraction =
+        std::llround((days - whole) * static_cast<double>(kMicrosecondsPerDay));
+    return Timestamp(static_cast<std::int64_t>(whole) * kMicrosecondsPerDay + fraction);
+  }
+
+  /// @brief Число микросекунд от эпохи.
+  constexpr std::int64_t microseconds() const { return microseconds_; }
+
+  /// @brief Значение в днях, как `SCDateTime::GetAsDouble()`.
+  double to_days() const {
+    return static_cast<double>(microseconds_) / static_cast<double>(kMicrosecondsPerDay);
+  }
+
+  /// @brief Номер дня от эпохи.
+  constexpr int date() const { return static_cast<int>(microseconds_ / kMicrosecondsPerDay); }
+
+  /// @brief Секунды от полуночи (0..86399).
+  constexpr int seconds_of_day() const {
+    return static_cast<int>((microseconds_ % kMicrosecondsPerDay) / kMicrosecondsPerSecond);
+  }
+
+  /// @brief День недели: 0 — воскресенье, как `SCDateTime::GetDayOfWeek()`.
+  constexpr int day_of_week() const {
+    int date_value = date() - 1;
+    if (date_value < 0) {
+      date_value = date_value % 7 + 7;
+    }
+    return date_value % 7;
+  }
+
+  friend constexpr bool operator==(Timestamp lhs, Timestamp rhs) {
+    return lhs.microseconds_ == rhs.microseconds_;
+  }
+  friend constexpr bool operator!=(Timestamp lhs, Timestamp rhs) { return !(lhs == rhs); }
+  friend constexpr bool operator<(Timestamp lhs, Timestamp rhs) {
+    return lhs.microseconds_ < rhs.microseconds_;
+  }
+  friend constexpr bool operator<=(Timestamp lhs, Timestamp rhs) { return !(rhs < lhs); }
+
+ private:
+  constexpr explicit Timestamp(std::int64_t microseconds) : microseconds_(microseconds) {}
+
+  std::int64_t microseconds_ = 0;
+};
+
+/// @brief Переводит столбец `SCDateTime` в днях в микросекунды.
+/// @param days Входной столбец.
+/// @param count Количество элементов.
+/// @param out Выходной столбец микросекунд (не меньше `count` элементов).
+void to_microseconds(const double* days, std::size_t count, std::int64_t* out);
+
+/// @brief Раскладывает столбец времени на дату, секунды от полуночи и день недели.
+/// @param microseconds Входной столбец микросекунд.
+/// @param count Количество элементов.
+/// @param date Выход: номер дня от эпохи.
+/// @param seconds Выход: секунды от полуночи.
+/// @param weekday Выход: день недели (0 — воскресенье).
+/// @note Для отсортированных столбцов блоки внутри одного дня обрабатываются SIMD-веткой без деления int64; результат совпадает со скалярным `Timestamp` для любых входов.
+void decompose_calendar(const std::int64_t* microseconds, std::size_t count, std::int32_t* date,
+                        std::int32_t* seconds, std::uint8_t* weekday);
+
+/// @brief Строит маску попадания в сессию по секундам от полуночи.
+/// @param seconds Столбец секунд от полуночи.
+/// @param count Количество элементов.
+/// @param start_second Начало сессии (включительно).
+/// @param end_second Конец сессии (включительно); если меньше начала — сессия переходит через полночь.
+/// @param mask Выход: 1 для баров внутри сессии, иначе 0.
+void session_mask(const std::int32_t* seconds, std::size_t count, int start_second, int end_second,
+                  std::uint8_t* mask);
+
+}  // namespace sierra::core
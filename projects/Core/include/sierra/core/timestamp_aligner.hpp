@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace sierra::core {
+
+/// @brief Невладеющее представление отсортированного столбца времени в микросекундах (`SCDateTime::GetInternalDateTime`,
+/// `Timestamp::microseconds`).
+struct TimeColumn {
+  const std::int64_t* data = nullptr;
+  std::size_t size = 0;
+};
+
+/// @brief Сопоставляет бары целевого графика с барами нескольких исходных графиков.
+/// @note Для каждого целевого бара ищется «содержащий» бар источника — последний бар, чьё время не больше времени целевого бара, как `sc.GetContainingIndexForDateTimeIndex`. Все источники проходятся одним линейным слиянием с монотонными курсорами.
+/// @warning Столбцы времени должны быть отсортированы по неубыванию; при полном пересчёте графика вызывайте `reset`.
+class TimestampAligner {
+ public:
+  /// @brief Индекс, возвращаемый для целевых баров раньше первого бара источника.
+  static constexpr int kNoMatch = -1;
+
+  /// @brief Создаёт выравниватель для заданного числа источников.
+  /// @param source_count Количество исходных графиков.
+  explicit TimestampAligner(std::size_t source_count);
+
+  /// @brief Досчитывает сопоставление для новых целевых баров.
+  /// @param destination Время баров целевого графика.
+  /// @param sources Время баров исходных графиков; размер должен совпадать с `source_count`.
+  /// @return Индекс первого целевого бара, сопоставление которого могло измениться.
+  /// @note Последний уже сопоставленный бар пересчитывается всегда. Если источник вырос, его слияние начинается с первого
+  /// целевого бара, чьё время не меньше времени первого нового бара источника: так учитываются источники, которые
+  /// догружаются позже целевого графика или были пустыми. Если источник уменьшился или сменилось время его первого бара
+  /// (догружена более ранняя история), он сопоставляется заново целиком.
+  /// @warning При несовпадении числа источников выбрасывает `std::invalid_argument`.
+  std::size_t update(TimeColumn destination, const std::vector<TimeColumn>& sources);
+
+  /// @brief Сбрасывает накопленное сопоставление.
+  void reset();
+
+  /// @brief Количество сопоставленных целевых баров.
+  std::size_t size() const noexcept { return mapped_; }
+
+  /// @brief Индексы источника `source` для всех целевых баров.
+  const std::vector<int>& mapping(std::size_t source) const { return mappings_.at(source); }
+
+ private:
+  /// @brief Состояние источника на прошлом `update`: по нему видно, какие его бары новые.
+  struct SourceState {
+    std::size_t size = 0;
+    std::int64_t first = 0;
+  };
+
+  std::vector<std::vector<int>> mappings_;
+  std::vector<SourceState> sources_;
+  std::size_t mapped_ = 0;
+};
+
+/// @brief Разбирает список номеров графиков вида "1, 3,5".
+/// @param text Строка со списком, разделённым запятыми.
+/// @return Номера графиков; пустые и нечисловые элементы пропускаются.
+/// @note Замена `strtok` из примеров ACSIL: результат можно закэшировать и разбирать строку только при смене входа.
+std::vector<int> parse_chart_numbers(std::string_view text);
+
+}  // namespace sierra::core
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "sierra/core/spsc_ring.hpp"
+#include "sierra/core/tick_clock.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @brief Включены ли метки `SIERRA_TRACE_SCOPE`.
+/// @note По умолчанию метки есть в Debug и вырезаются в Release (`NDEBUG`); `SIERRA_ENABLE_TRACE` возвращает их в Release
+/// (MSBuild: `/p:SierraTrace=true`). При `SIERRA_TRACE == 0` макрос раскрывается в пустой оператор и не оставляет в коде ничего.
+#if !defined(SIERRA_TRACE)
+#if defined(SIERRA_ENABLE_TRACE) || !defined(NDEBUG)
+#define SIERRA_TRACE 1
+#else
+#define SIERRA_TRACE 0
+#endif
+#endif
+
+namespace sierra::core {
+
+/// @brief Завершённый интервал трассировки в тактах `read_ticks()`.
+/// @note Категория и имя — указатели на строковые литералы.
+struct TraceEvent {
+  const char* category = nullptr;
+  const char* name = nullptr;
+  std::int64_t start = 0;
+  std::int64_t end = 0;
+};
+
+/**
+ * @brief Сборщик интервалов трассировки для экспорта в формате Chrome trace-event (`chrome://tracing`, Perfetto).
+ * @note Один экземпляр на модуль (DLL или exe). У каждого потока своя `SpscRing` с интервалами, созданная при первой
+ * записи; `write_chrome_json` забирает интервалы всех потоков и пишет их событиями `"ph": "X"`.
+ * Пока запись не включена `start()`, метка стоит одной проверки флага. При переполнении очереди потока интервал
+ * отбрасывается и учитывается в `dropped()`.
+ * @warning Ёмкость очереди задаётся при первой записи потока; `start()` с другой ёмкостью действует только на новые потоки.
+ * Очередь завершившегося потока достаётся следующему потоку с тем же `std::thread::id`, так что память не растёт
+ * при пересоздании потоков.
+ */
+class TraceRecorder {
+ public:
+  /// @brief Сборщик текущего модуля.
+  static TraceRecorder& instance();
+
+  TraceRecorder(const TraceRecorder&) = delete;
+  TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+  /// @brief Отбрасывает накопленное и включает запись.
+  /// @param per_thread_capacity Ёмкость очереди нового потока в интервалах.
+  void start(std::size_t per_thread_capacity = std::size_t{1} << 16);
+
+  /// @brief Выключает запись; накопленное остаётся до выгрузки.
+  void stop() noexcept { enabled_.store(false, std::memory_order_relaxed); }
+
+  /// @brief Включена ли запись.
+  bool enabled() const noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+  /// @brief Кладёт интервал в очередь текущего потока.
+  void record(const char* category, const char* name, std::int64_t start, std::int64_t end) noexcept;
+
+  /// @brief Забирает интервалы всех потоков и пишет их документом Chrome trace JSON.
+  /// @param out Поток назначения.
+  /// @return Количество записанных интервалов.
+  /// @note Время отсчитывается в микросекундах от последнего `start()`; номера потоков — порядок их первой записи.
+  std::size_t write_chrome_json(std::ostream& out);
+
+  /// @brief То же в файл.
+  /// @warning При ошибке открытия файла выбрасывает `std::runtime_error`.
+  std::size_t dump(const std::string& path);
+
+  /// @brief Интервалы, отброшенные из-за переполнения очередей.
+  std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+ private:
+  struct Buffer {
+    Buffer(std::size_t capacity, std::uint32_t index) : ring(capacity), thread(index) {}
+
+    SpscRing<TraceEvent> ring;
+    std::uint32_t thread;
+    std::thread::id owner;
+  };
+
+  TraceRecorder() = default;
+
+  Buffer* current_buffer() noexcept;
+
+  std::atomic<bool> enabled_{false};
+  std::atomic<std::uint64_t> dropped_{0};
+  // Защищает список очередей и сторону читателя всех очередей.
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<Buffer>> buffers_;
+  std::size_t capacity_ = std::size_t{1} << 16;
+  TickCalibration clock_;
+  std::int64_t origin_ = 0;
+};
+
+/// @brief Интервал от конструктора до деструктора; используйте через `SIERRA_TRACE_SCOPE`.
+class TraceSpan {
+ public:
+  TraceSpan(const char* category, const char* name) noexcept
+      : category_(category), name_(name), start_(TraceRecorder::instance().enabled() ? read_ticks() : 0) {}
+
+  ~TraceSpan() {
+    if (start_ != 0) {
+      TraceRecorder::instance().record(category_, name_, start_, read_ticks());
+    }
+  }
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+ private:
+  const char* category_;
+  const char* name_;
+  std::int64_t start_;
+};
+
+}  // namespace sierra::core
+
+#define SIERRA_TRACE_CONCAT_INNER(a, b) a##b
+#define SIERRA_TRACE_CONCAT(a, b) SIERRA_TRACE_CONCAT_INNER(a, b)
+
+/// @brief Метка трассировки до конца текущей области видимости.
+/// @param category Строковый литерал категории (`"core"`, `"acsil"`).
+/// @param name Строковый литерал имени интервала.
+#if SIERRA_TRACE
+#define SIERRA_TRACE_SCOPE(category, name) \
+  ::sierra::core::TraceSpan SIERRA_TRACE_CONCAT(sierra_trace_span_, __LINE__)(category, name)
+#else
+#define SIERRA_TRACE_SCOPE(category, name) static_cast<void>(0)
+#endif
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+namespace sierra::core {
+
+/// @brief Сторона сделки по классификации Time & Sales.
+/// @note Значения совпадают с константами ACSIL `SC_TS_BID` и `SC_TS_ASK`, поэтому обёртка может приводить `s_TimeAndSales::Type` напрямую.
+enum class TradeSide : std::int16_t {
+  kUnknown = 0,
+  kBid = 1,
+  kAsk = 2,
+};
+
+/// @brief Компактная запись сделки (32 байта) для передачи между потоками.
+/// @note Время хранится в днях как `SCDateTime`, чтобы ядро не зависело от ACSIL.
+/// @warning Поле `sequence` приходит из Sierra Chart и теоретически может переполниться.
+struct TradeRecord {
+  double date_time = 0.0;
+  float price = 0.0f;
+  std::uint32_t volume = 0;
+  float bid = 0.0f;
+  float ask = 0.0f;
+  std::uint32_t sequence = 0;
+  TradeSide side = TradeSide::kUnknown;
+  std::int16_t reserved = 0;
+};
+
+static_assert(sizeof(TradeRecord) == 32, "TradeRecord must stay compact");
+
+}  // namespace sierra::core
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace sierra::core {
+
+struct BacktestTrade;
+
+/// @brief Накопительная статистика закрытых сделок, аналог `s_ACSTradeStatistics`.
+/// @note Каждая сделка учитывается за O(1); итоговые метрики не требуют повторного прохода по списку сделок. Прибыль сделки — `profit_loss - commission`: выигрышная — больше нуля, проигрышная — меньше, нулевые считаются отдельно и прерывают серии.
+/// @note Статистики соседних по времени участков объединяются `merge` — так параллельные шарды одного прогона дают тот же результат, что и последовательный прогон.
+struct TradeStatistics {
+  double closed_profit = 0.0;  ///< Сумма прибылей выигрышных сделок.
+  double closed_loss = 0.0;    ///< Сумма убытков проигрышных сделок (неположительная).
+  double total_commission = 0.0;
+
+  double maximum_runup = 0.0;     ///< Наибольший рост кривой закрытой прибыли от минимума.
+  double maximum_drawdown = 0.0;  ///< Наибольшее падение кривой закрытой прибыли от максимума (неположительное).
+  double maximum_trade_runup = 0.0;    ///< Наибольшая нереализованная прибыль внутри сделки.
+  double maximum_trade_drawdown = 0.0;  ///< Наибольший нереализованный убыток внутри сделки (неположительный).
+
+  std::size_t total_trades = 0;
+  std::size_t winning_trades = 0;
+  std::size_t losing_trades = 0;
+  std::size_t long_trades = 0;
+  std::size_t short_trades = 0;
+
+  std::int64_t winning_quantity = 0;
+  std::int64_t losing_quantity = 0;
+  int largest_trade_quantity = 0;
+
+  double largest_winning_trade = 0.0;
+  double largest_losing_trade = 0.0;
+
+  std::int64_t time_in_winning_trades = 0;  ///< Микросекунды.
+  std::int64_t time_in_losing_trades = 0;   ///< Микросекунды.
+
+  std::size_t max_consecutive_winners = 0;
+  std::size_t max_consecutive_losers = 0;
+
+  /// @name Служебное состояние для `merge`
+  /// @{
+  double equity_high = 0.0;  ///< Максимум кривой закрытой прибыли с учётом начального нуля.
+  double equity_low = 0.0;   ///< Минимум кривой закрытой прибыли с учётом начального нуля.
+  std::size_t leading_winners = 0;
+  std::size_t leading_losers = 0;
+  std::size_t trailing_winners = 0;
+  std::size_t trailing_losers = 0;
+  /// @}
+
+  /// @brief Учитывает закрытую сделку.
+  void add(const BacktestTrade& trade) noexcept;
+
+  /// @brief Дописывает статистику следующего по времени участка.
+  /// @param next Статистика участка, начинающегося после последней сделки этого.
+  /// @note Операция ассоциативна, но не коммутативна: просадка, рост и серии зависят от порядка участков.
+  void merge(const TradeStatistics& next) noexcept;
+
+  /// @brief Сбрасывает статистику.
+  void reset() noexcept { *this = TradeStatistics{}; }
+
+  /// @brief Чистая закрытая прибыль.
+  double net_profit() const noexcept { return closed_profit + closed_loss; }
+
+  /// @brief Отношение суммы прибылей к сумме убытков; 0, если убытков нет.
+  double profit_factor() const noexcept;
+
+  /// @brief Доля выигрышных сделок среди всех.
+  double percent_profitable() const noexcept;
+
+  /// @brief Средняя чистая прибыль сделки.
+  double average_trade() const noexcept;
+
+  /// @brief Средняя прибыль выигрышной сделки.
+  double average_winner() const noexcept;
+
+  /// @brief Средний убыток проигрышной сделки.
+  double average_loser() const noexcept;
+};
+
+}  // namespace sierra::core
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "sierra/core/optimizer.hpp"
+#include "sierra/core/thread_pool.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace sierra::core {
+
+/// @brief Разбиение данных для walk-forward анализа.
+/// @note Данные делятся на сегменты по `segment_ticks`; окно обучения — `train_segments` сегментов, следующее за ним окно проверки — `test_segments`. Окна сдвигаются на `test_segments`.
+struct WalkForwardOptions {
+  std::size_t segment_ticks = 0;
+  std::size_t train_segments = 1;
+  std::size_t test_segments = 1;
+  /// Окна проверки прогоняются подряд на одном счёте, и позиция переходит через их границы; `false` — каждое окно начинается без позиции.
+  bool carry_position = true;
+};
+
+/// @brief Результат одного фолда.
+struct WalkForwardFold {
+  std::size_t train_begin = 0;
+  std::size_t train_end = 0;
+  std::size_t test_begin = 0;
+  std::size_t test_end = 0;
+  ParameterSet best_parameters;
+  double train_objective = 0.0;
+  /// Результат окна проверки в выбранном режиме (`carry_position`).
+  double test_objective = 0.0;
+  /// Результат того же окна, начатого и закрытого без позиции.
+  double flat_test_objective = 0.0;
+  /// Оценки «параметры × сегмент», впервые посчитанные для этого фолда.
+  std::size_t evaluated_segments = 0;
+  /// Оценки, взятые готовыми из предыдущих фолдов.
+  std::size_t reused_segments = 0;
+  /// Суммарное время вычисления новых оценок фолда (секунды потоков).
+  double seconds = 0.0;
+  /// Обработанные тики новых оценок в секунду.
+  double ticks_per_second = 0.0;
+};
+
+/// @brief Итог walk-forward анализа.
+/// @note Разница `total_test_objective - flat_test_objective` показывает, сколько сшитому результату стоит принудительный flat на границах окон.
+struct WalkForwardReport {
+  std::vector<WalkForwardFold> folds;
+  double total_test_objective = 0.0;
+  double flat_test_objective = 0.0;
+  double wall_seconds = 0.0;
+};
+
+/// @brief Оценивает набор параметров на диапазоне тиков `[begin, end)`.
+/// @note Результаты соседних диапазонов должны складываться (стратегия начинает и заканчивает диапазон без позиции).
+using SegmentEvaluator = std::function<double(const ParameterSet&, std::size_t, std::size_t)>;
+
+/// @brief Прогоняет набор параметров фолда на его окне проверки `[begin, end)`, продолжая с позицией предыдущего окна.
+/// @note Вызывается из одного потока по порядку фолдов, поэтому может хранить счёт между вызовами (см. `continue_ma_crossover_range`).
+using OutOfSampleEvaluator = std::function<double(const ParameterSet&, std::size_t, std::size_t)>;
+
+/// @brief Выполняет walk-forward оптимизацию.
+/// @param tick_count Количество тиков в данных.
+/// @param candidates Наборы параметров.
+/// @param evaluate Потокобезопасная оценка сегмента.
+/// @param run_out_of_sample Непрерывный прогон окон проверки; может быть пустым при `carry_position = false`.
+/// @param options Разбиение на окна.
+/// @param pool Пул потоков.
+/// @return WalkForwardReport с фолдами по порядку.
+/// @note Каждая пара «параметры × сегмент» считается ровно один раз и переиспользуется всеми перекрывающимися окнами; все оценки независимы и идут на пуле параллельно, а выбор лучшего набора в фолде — суммирование готовых оценок. С `carry_position` окна проверки затем прогоняются последовательно через `run_out_of_sample`.
+/// @warning При нулевых размерах окон или `carry_position` без `run_out_of_sample` выбрасывает `std::invalid_argument`.
+WalkForwardReport walk_forward(std::size_t tick_count, const std::vector<ParameterSet>& candidates,
+                               const SegmentEvaluator& evaluate, const OutOfSampleEvaluator& run_out_of_sample,
+                               const WalkForwardOptions& options, ThreadPool& pool);
+
+}  // namespace sierra::core
@@ -0,0 +1,299 @@
+#include "sierra/core/async_logger.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <ctime>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace sierra::core {
+
+namespace {
+
+/// Идентификаторы журналов: кэш потока не спутает новый журнал с удалённым по тому же адресу.
+std::atomic<std::uint64_t> g_next_logger_id{1};
+
+/// Журнал и очередь, к которым текущий поток обращался последним.
+struct ProducerCache {
+  std::uint64_t logger = 0;
+  void* producer = nullptr;
+};
+
+thread_local ProducerCache t_producer_cache;
+
+const char* level_name(LogLevel level) noexcept {
+  switch (level) {
+    case LogLevel::kDebug:
+      return "DEBUG";
+    case LogLevel::kInfo:
+      return "INFO ";
+    case LogLevel::kWarning:
+      return "WARN ";
+    case LogLevel::kError:
+      return "ERROR";
+  }
+  return "?    ";
+}
+
+void append_argument(LogArgumentType type, const LogValue& value, std::string& out) {
+  char buffer[32];
+  int length = 0;
+  switch (type) {
+    case LogArgumentType::kInt:
+      length = std::snprintf(buffer, sizeof(buffer), "%" PRId64, value.i);
+      break;
+    case LogArgumentType::kUint:
+      length = std::snprintf(buffer, sizeof(buffer), "%" PRIu64, value.u);
+      break;
+    case LogArgumentType::kDouble:
+      length = std::snprintf(buffer, sizeof(buffer), "%.10g", value.d);
+      break;
+    case LogArgumentType::kBool:
+      out += value.u != 0 ? "true" : "false";
+      return;
+    case LogArgumentType::kString:
+      out += value.s != nullptr ? value.s : "(null)";
+      return;
+  }
+  out.append(buffer, static_cast<std::size_t>((std::max)(length, 0)));
+}
+
+std::tm local_time(std::time_t seconds) {
+  std::tm result{};
+#ifdef _WIN32
+  localtime_s(&result, &seconds);
+#else
+  localtime_r(&seconds, &result);
+#endif
+  return result;
+}
+
+}  // namespace
+
+void format_log_record(const LogRecord& record, std::int64_t time_ns, std::string& out) {
+  std::int64_t seconds = time_ns / 1'000'000'000;
+  std::int64_t nanoseconds = time_ns % 1'000'000'000;
+  if (nanoseconds < 0) {
+    nanoseconds += 1'000'000'000;
+    --seconds;
+  }
+  const std::tm time = local_time(static_cast<std::time_t>(seconds));
+  char prefix[64];
+  const int length = std::snprintf(prefix, sizeof(prefix), "%04d-%02d-%02d %02d:%02d:%02d.%06d %s [%u] ",
+                                   time.tm_year + 1900, time.tm_mon + 1, time.tm_mday, time.tm_hour,
+                                   time.tm_min, time.tm_sec, static_cast<int>(nanoseconds / 1000),
+                                   level_name(record.level), static_cast<unsigned>(record.thread));
+  out.append(prefix, static_cast<std::size_t>((std::max)(length, 0)));
+
+  const std::size_t count = (std::min)(static_cast<std::size_t>(record.count), kMaxLogArguments);
+  std::size_t next = 0;
+  const char* cursor = record.format != nullptr ? record.format : "";
+  while (*cursor != '\0') {
+    if (cursor[0] == '{' && cursor[1] == '}' && next < count) {
+      append_argument(record.types[next], record.values[next], out);
+      ++next;
+      cursor += 2;
+    } else {
+      out += *cursor++;
+    }
+  }
+  for (; next < count; ++next) {
+    out += ' ';
+    append_argument(record.types[next], record.values[next], out);
+  }
+  out += '\n';
+}
+
+AsyncLogger::AsyncLogger(AsyncLoggerOptions options)
+    : options_(std::move(options)),
+      min_level_(options_.min_level),
+      id_(g_next_logger_id.fetch_add(1, std::memory_order_relaxed)) {
+  if (options_.ring_capacity == 0) {
+    throw std::invalid_argument("AsyncLogger ring capacity must be greater than zero");
+  }
+  const std::filesystem::path path(options_.path);
+  std::error_code error;
+  if (path.has_parent_path()) {
+    std::filesystem::create_directories(path.parent_path(), error);
+  }
+  file_ = std::fopen(options_.path.c_str(), "ab");
+  if (file_ == nullptr) {
+    throw std::runtime_error("AsyncLogger cannot open " + options_.path);
+  }
+  const auto size = std::filesystem::file_size(path, error);
+  file_bytes_ = error ? 0 : static_cast<std::size_t>(size);
+  thread_ = std::thread([this] { run(); });
+}
+
+AsyncLogger::~AsyncLogger() {
+  stop_.store(true, std::memory_order_release);
+  {
+    std::lock_guard<std::mutex> lock(pass_mutex_);
+    wake_ = true;
+  }
+  wakeup_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  if (file_ != nullptr) {
+    std::fclose(file_);
+  }
+}
+
+void AsyncLogger::flush() {
+  std::unique_lock<std::mutex> lock(pass_mutex_);
+  // Текущий проход мог начаться до вызова, поэтому ждём ещё один целиком.
+  const std::uint64_t target = passes_ + 2;
+  wake_ = true;
+  wakeup_.notify_one();
+  pass_done_.wait(lock, [&] { return passes_ >= target || !running_; });
+}
+
+AsyncLogger::Producer* AsyncLogger::current_producer() noexcept {
+  ProducerCache& cache = t_producer_cache;
+  if (cache.logger == id_) {
+    return static_cast<Producer*>(cache.producer);
+  }
+  Producer* producer = register_producer();
+  if (producer != nullptr) {
+    cache.logger = id_;
+    cache.producer = producer;
+  }
+  return producer;
+}
+
+/// @note Очередь закреплена за `std::thread::id`: поток, переключавшийся между журналами, получает прежнюю очередь.
+AsyncLogger::Producer* AsyncLogger::register_producer() noexcept {
+  const std::thread::id self = std::this_thread::get_id();
+  std::lock_guard<std::mutex> lock(producers_mutex_);
+  for (const auto& producer : producers_) {
+    if (producer->owner == self) {
+      return producer.get();
+    }
+  }
+  try {
+    auto producer = std::make_unique<Producer>(options_.ring_capacity,
+                                               static_cast<std::uint16_t>(producers_.size()));
+    producer->owner = self;
+    producers_.push_back(std::move(producer));
+    return producers_.back().get();
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void AsyncLogger::run() {
+  std::vector<LogRecord> batch;
+  std::string text;
+  std::string line;
+  std::chrono::milliseconds pause = options_.poll_interval;
+  for (;;) {
+    const bool stopping = stop_.load(std::memory_order_acquire);
+    const std::size_t count = drain(batch, text, line);
+    {
+      std::lock_guard<std::mutex> lock(pass_mutex_);
+      ++passes_;
+      if (stopping && count == 0) {
+        running_ = false;
+      }
+    }
+    pass_done_.notify_all();
+    if (stopping && count == 0) {
+      return;
+    }
+    if (count != 0) {
+      pause = options_.poll_interval;
+      continue;
+    }
+    wait_for_work(pause);
+    pause = (std::min)(pause * 2, (std::max)(options_.idle_interval, options_.poll_interval));
+  }
+}
+
+/// @note Запись, положенная между пустым проходом и установкой флага простоя, ждёт до конца паузы, но не теряется.
+void AsyncLogger::wait_for_work(std::chrono::milliseconds pause) {
+  std::unique_lock<std::mutex> lock(pass_mutex_);
+  if (pause >= options_.idle_interval) {
+    idle_.store(true, std::memory_order_relaxed);
+  }
+  wakeup_.wait_for(lock, pause, [&] { return wake_; });
+  wake_ = false;
+  idle_.store(false, std::memory_order_relaxed);
+}
+
+void AsyncLogger::wake_idle() noexcept {
+  if (!idle_.exchange(false, std::memory_order_relaxed)) {
+    return;  // поток уже разбудил другой писатель
+  }
+  {
+    std::lock_guard<std::mutex> lock(pass_mutex_);
+    wake_ = true;
+  }
+  wakeup_.notify_one();
+}
+
+/// @note За проход из каждой очереди берётся не больше её ёмкости, чтобы непрерывный поток записей не держал проход бесконечно.
+/// Буферы живут между проходами, поэтому после первых записей фоновый поток память не выделяет.
+std::size_t AsyncLogger::drain(std::vector<LogRecord>& batch, std::string& text, std::string& line) {
+  batch.clear();
+  {
+    std::lock_guard<std::mutex> lock(producers_mutex_);
+    for (const auto& producer : producers_) {
+      const std::size_t offset = batch.size();
+      batch.resize(offset + producer->ring.capacity());
+      batch.resize(offset + producer->ring.pop_bulk(batch.data() + offset, producer->ring.capacity()));
+    }
+  }
+  if (batch.empty()) {
+    return 0;
+  }
+  std::stable_sort(batch.begin(), batch.end(),
+                   [](const LogRecord& a, const LogRecord& b) { return a.ticks < b.ticks; });
+  clock_.update();
+
+  text.clear();
+  for (const LogRecord& record : batch) {
+    line.clear();
+    format_log_record(record, clock_.to_system_ns(record.ticks), line);
+    if (file_bytes_ + text.size() + line.size() > options_.max_file_bytes &&
+        file_bytes_ + text.size() > 0) {
+      write(text);
+      text.clear();
+      rotate();
+    }
+    text += line;
+  }
+  write(text);
+  std::fflush(file_);
+  written_.fetch_add(batch.size(), std::memory_order_relaxed);
+  return batch.size();
+}
+
+void AsyncLogger::write(const std::string& text) {
+  if (file_ == nullptr || text.empty()) {
+    return;
+  }
+  file_bytes_ += std::fwrite(text.data(), 1, text.size(), file_);
+}
+
+/// @note Схема как у plog: `path` → `path.1` → … → `path.N`, самый старый файл удаляется.
+void AsyncLogger::rotate() {
+  if (file_ != nullptr) {
+    std::fclose(file_);
+  }
+  std::error_code error;
+  if (options_.max_files > 0) {
+    const std::string base = options_.path + ".";
+    std::filesystem::remove(base + std::to_string(options_.max_files), error);
+    for (std::size_t i = options_.max_files; i > 1; --i) {
+      std::filesystem::rename(base + std::to_string(i - 1), base + std::to_string(i), error);
+    }
+    std::filesystem::rename(options_.path, base + "1", error);
+  }
+  file_ = std::fopen(options_.path.c_str(), options_.max_files > 0 ? "ab" : "wb");
+  file_bytes_ = 0;
+}
+
+}  // namespace sierra::core
@@ -0,0 +1,276 @@
+#include "sierra/core/backtester.hpp"
+
+#include "sierra/core/depth_fill.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace sierra::core {
+
+namespace {
+
+/// @brief Цены тика, из которых строятся правила исполнения.
+struct TickPrices {
+  double last;
+  double bid;
+  double ask;
+  double range_high;
+  double range_low;
+};
+
+/// @note Для тиков `high`/`low` — это Ask/Bid, для баровых записей — диапазон бара.
+inline TickPrices prices_of(const ScidRecord& tick) {
+  const double last = tick.close;
+  if (tick.is_tick()) {
+    return TickPrices{last, tick.low > 0.0f ? tick.low : last, tick.high > 0.0f ? tick.high : last,
+                      last, last};
+  }
+  return TickPrices{last, last, last, tick.high, tick.low};
+}
+
+}  // namespace
+
+Backtester::Backtester(BacktestOptions options) : options_(options) {}
+
+Backtester::OrderId Backtester::submit(const OrderRequest& request) {
+  if (request.quantity <= 0) {
+    return 0;
+  }
+  return add_order(request, false);
+}
+
+Backtester::OrderId Backtester::add_order(const OrderRequest& request, bool attached) {
+  Order order;
+  order.id = next_id_++;
+  order.request = request;
+  order.remaining = request.quantity;
+  order.attached = attached;
+  pending_.push_back(order);
+  return order.id;
+}
+
+bool Backtester::cancel(OrderId id) {
+  for (auto* list : {&orders_, &pending_}) {
+    const auto it = std::find_if(list->begin(), list->end(),
+                                 [id](const Order& order) { return order.id == id; });
+    if (it != list->end()) {
+      list->erase(it);
+      return true;
+    }
+  }
+  return false;
+}
+
+void Backtester::flatten() {
+  orders_.clear();
+  pending_.clear();
+  if (position_ != 0) {
+    OrderRequest request;
+    request.side = position_ > 0 ? OrderSide::kSell : OrderSide::kBuy;
+    request.quantity = std::abs(position_);
+    add_order(request, false);
+  }
+}
+
+void Backtester::process_tick(const ScidRecord& tick) {
+  const Timestamp time = Timestamp::from_microseconds(tick.date_time);
+  const TickPrices prices = prices_of(tick);
+  track_excursion(prices.last);
+  if (fill_model_ != nullptr) {
+    depth_bar_ = fill_model_->book().locate(tick.date_time, depth_bar_);
+  }
+
+  if (!pending_.empty()) {
+    orders_.insert(orders_.end(), pending_.begin(), pending_.end());
+    pending_.clear();
+  }
+
+  // Исполненные и снятые по OCO заявки помечаются нулевым id и удаляются одним проходом.
+  bool any_filled = false;
+  for (std::size_t i = 0; i < orders_.size(); ++i) {
+    Order& order = orders_[i];
+    if (order.id == 0) {
+      continue;
+    }
+    const OrderRequest& request = order.request;
+    const bool buy = request.side == OrderSide::kBuy;
+    double fill_price = 0.0;
+    int quantity = 0;
+    switch (request.type) {
+      case OrderType::kMarket:
+        quantity = order.remaining;
+        fill_price = fill_model_ != nullptr
+                         ? fill_model_->market_price(request.side, quantity, tick, depth_bar_)
+                         : (buy ? prices.ask : prices.bid);
+        break;
+      case OrderType::kLimit:
+        fill_price = request.price;
+        if (fill_model_ != nullptr) {
+          if (!order.queue_ready) {
+            order.queue_ahead = fill_model_->initial_queue(request.side, request.price, depth_bar_);
+            order.queue_ready = true;
+          }
+          quantity = fill_model_->limit_fill(request.side, request.price, order.remaining,
+                                             order.queue_ahead, tick, depth_bar_);
+        } else if (buy ? prices.range_low <= request.price : prices.range_high >= request.price) {
+          quantity = order.remaining;
+        }
+        break;
+      case OrderType::kStop:
+        if (buy ? prices.range_high >= request.price : prices.range_low <= request.price) {
+          quantity = order.remaining;
+          const double market = fill_model_ != nullptr
+                                    ? fill_model_->market_price(request.side, quantity, tick, depth_bar_)
+                                    : (buy ? prices.ask : prices.bid);
+          fill_price = buy ? (std::max)(request.price, market) : (std::min)(request.price, market);
+        }
+        break;
+    }
+    if (quantity == 0) {
+      continue;
+    }
+
+    order.remaining -= quantity;
+    const Order executed = order;
+    if (order.remaining == 0) {
+      order.id = 0;
+    }
+    any_filled = true;
+    if (executed.oco_partner != 0) {
+      // Партнёр по OCO уменьшается на исполненное количество и снимается, когда обнулится.
+      for (Order& other : orders_) {
+        if (other.id == executed.oco_partner) {
+          other.remaining -= quantity;
+          if (other.remaining <= 0) {
+            other.id = 0;
+          }
+        }
+      }
+    }
+    fill(executed, fill_price, quantity, time);
+  }
+
+  if (any_filled) {
+    orders_.erase(std::remove_if(orders_.begin(), orders_.end(),
+                                 [](const Order& order) { return order.id == 0; }),
+                  orders_.end());
+  }
+
+  track_excursion(prices.last);
+}
+
+/// @note Вызывается до и после исполнений, чтобы экстремум тика учитывался и в закрываемой, и в только что открытой позиции.
+void Backtester::track_excursion(double last) {
+  if (position_ == 0) {
+    return;
+  }
+  const double open_pl = open_profit_loss(last);
+  trade_.max_open_profit = (std::max)(trade_.max_open_profit, open_pl);
+  trade_.max_open_loss = (std::min)(trade_.max_open_loss, open_pl);
+}
+
+/// @note Присоединённая пара создаётся на исполненное количество: цель — лимитная, стоп — стоп-заявка, связанные как OCO. Частичные исполнения получают собственные пары.
+void Backtester::fill(const Order& order, double price, int quantity, Timestamp time) {
+  const OrderRequest& request = order.request;
+  const int sign = request.side == OrderSide::kBuy ? 1 : -1;
+  apply_fill(sign * quantity, price, time);
+
+  if (order.attached || (request.target_offset <= 0.0 && request.stop_offset <= 0.0)) {
+    return;
+  }
+  OrderRequest child;
+  child.side = request.side == OrderSide::kBuy ? OrderSide::kSell : OrderSide::kBuy;
+  child.quantity = quantity;
+
+  OrderId target = 0;
+  OrderId stop = 0;
+  if (request.target_offset > 0.0) {
+    child.type = OrderType::kLimit;
+    child.price = price + sign * request.target_offset;
+    target = add_order(child, true);
+  }
+  if (request.stop_offset > 0.0) {
+    child.type = OrderType::kStop;
+    child.price = price - sign * request.stop_offset;
+    stop = add_order(child, true);
+  }
+  if (target != 0 && stop != 0) {
+    pending_[pending_.size() - 2].oco_partner = stop;
+    pending_.back().oco_partner = target;
+  }
+}
+
+/// @note Разворот делится на закрытие текущей сделки и открытие новой на остаток.
+void Backtester::apply_fill(int signed_quantity, double price, Timestamp time) {
+  while (signed_quantity != 0) {
+    if (position_ == 0 || (position_ > 0) == (signed_quantity > 0)) {
+      // Открытие или наращивание позиции.
+      if (position_ == 0) {
+        trade_ = BacktestTrade{};
+        exit_value_ = 0.0;
+        trade_.open_time = time;
+        trade_.direction = signed_quantity > 0 ? 1 : -1;
+      }
+      const int quantity = std::abs(signed_quantity);
+      const int open_quantity = std::abs(position_);
+      trade_.average_entry_price =
+          (trade_.average_entry_price * open_quantity + price * quantity) / (open_quantity + quantity);
+      trade_.entry_quantity += quantity;
+      trade_.commission += quantity * options_.commission_per_contract;
+      position_ += signed_quantity;
+      trade_.max_open_quantity = (std::max)(trade_.max_open_quantity, std::abs(position_));
+      return;
+    }
+
+    // Частичное или полное закрытие.
+    const int closing = (std::min)(std::abs(signed_quantity), std::abs(position_));
+    const int direction = position_ > 0 ? 1 : -1;
+    trade_.profit_loss += (price - trade_.average_entry_price) * direction * closing * options_.point_value;
+    exit_value_ += price * closing;
+    trade_.exit_quantity += closing;
+    trade_.commission += closing * options_.commission_per_contract;
+    position_ -= direction * closing;
+    signed_quantity += direction * closing;
+    if (position_ == 0) {
+      close_trade(time);
+    }
+  }
+}
+
+/// @note Присоединённые заявки принадлежат закрытой сделке и снимаются здесь же, а не по flat в конце тика: иначе при
+/// развороте старый стоп остался бы жить против новой позиции. Активные помечаются нулевым id и удаляются проходом
+/// `process_tick`, ещё не перенесённые из `pending_` — сразу.
+void Backtester::close_trade(Timestamp time) {
+  trade_.close_time = time;
+  trade_.average_exit_price = exit_value_ / trade_.exit_quantity;
+  trades_.push_back(trade_);
+  statistics_.add(trade_);
+
+  for (Order& order : orders_) {
+    if (order.attached) {
+      order.id = 0;
+    }
+  }
+  pending_.erase(std::remove_if(pending_.begin(), pending_.end(),
+                                [](const Order& order) { return order.attached; }),
+                 pending_.end());
+}
+
+void Backtester::set_fill_model(const DepthFillModel* model) noexcept {
+  fill_model_ = model;
+  depth_bar_ = 0;
+}
+
+void Backtester::reset() {
+  depth_bar_ = 0;
+  orders_.clear();
+  pending_.clear();
+  trades_.clear();
+  statistics_.reset();
+  trade_ = BacktestTrade{};
+  exit_value_ = 0.0;
+  position_ = 0;
+  next_id_ = 1;
+}
+
+}  // namespace sierra::core
@@ -0,0 +1,193 @@
+#include "sierra/core/call_recording.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace sierra::core {
+
+namespace {
+
+constexpr std::uint32_t kRecordMarker = 0x4c4c4143;  // "CALL"
+// Пределы, за которыми файл считается повреждённым, а не огромным.
+constexpr std::uint32_t kMaxStudyName = 4096;
+constexpr std::uint32_t kMaxBaseArrays = 256;
+constexpr std::uint32_t kMaxPairs = 1u << 16;
+constexpr std::int32_t kMaxArraySize = 1 << 30;
+
+struct RecordFixed {
+  std::uint32_t marker;
+  std::uint32_t flags;
+  std::int32_t index;
+  std::int32_t array_size;
+  std::int32_t update_start_index;
+  std::int32_t slice_start;
+  std::uint32_t input_count;
+  std::uint32_t persistent_int_count;
+  std::uint32_t persistent_double_count;
+  std::uint32_t reserved;
+  std::uint64_t output_digest;
+};
+
+}  // namespace
+
+std::uint64_t digest_floats(const float* data, std::size_t count, std::uint64_t seed) noexcept {
+  std::uint64_t hash = seed;
+  for (std::size_t i = 0; i < count; ++i) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &data[i], sizeof(bits));
+    for (int shift = 0; shift < 32; shift += 8) {
+      hash ^= (bits >> shift) & 0xffu;
+      hash *= 0x100000001b3ULL;
+    }
+  }
+  return hash;
+}
+
+CallRecordWriter::CallRecordWriter(const std::string& path, const CallRecordingHeader& header)
+    : path_(path), out_(path, std::ios::binary | std::ios::trunc), base_arrays_(header.base_arrays) {
+  if (!out_) {
+    throw std::runtime_error("CallRecordWriter: cannot create " + path);
+  }
+  if (header.base_arrays == 0 || header.base_arrays > kMaxBaseArrays || header.study.size() > kMaxStudyName) {
+    throw std::invalid_argument("CallRecordWriter: invalid header");
+  }
+  const std::uint32_t magic = CallRecordingHeader::kMagic;
+  const std::uint16_t version = CallRecordingHeader::kVersion;
+  const std::uint16_t unused = 0;
+  const auto name_length = static_cast<std::uint32_t>(header.study.size());
+  put(&magic, sizeof(magic));
+  put(&version, sizeof(version));
+  put(&unused, sizeof(unused));
+  put(&header.base_arrays, sizeof(header.base_arrays));
+  put(&header.tick_size, sizeof(header.tick_size));
+  put(&name_length, sizeof(name_length));
+  put(header.study.data(), header.study.size());
+}
+
+void CallRecordWriter::write(const RecordedCall& call) {
+  if (call.slice_start < 0 || call.array_size < 0 || call.array_size > kMaxArraySize ||
+      call.base.size() != base_arrays_ * call.slice_size() || call.date_times.size() != call.slice_size()) {
+    throw std::invalid_argument("CallRecordWriter: call slice does not match its bounds");
+  }
+  const RecordFixed fixed{kRecordMarker,
+                          call.flags,
+                          call.index,
+                          call.array_size,
+                          call.update_start_index,
+                          call.slice_start,
+                          static_cast<std::uint32_t>(call.inputs.size()),
+                          static_cast<std::uint32_t>(call.persistent_ints.size()),
+                          static_cast<std::uint32_t>(call.persistent_doubles.size()),
+                          0,
+                          call.output_digest};
+  put(&fixed, sizeof(fixed));
+  // Пары пишутся по полям: у std::pair<int32_t, double> есть выравнивание внутри.
+  for (const auto& input : call.inputs) {
+    put(&input.first, sizeof(input.first));
+    put(&input.second, sizeof(input.second));
+  }
+  for (const auto& value : call.persistent_ints) {
+    put(&value.first, sizeof(value.first));
+    put(&value.second, sizeof(value.second));
+  }
+  for (const auto& value : call.persistent_doubles) {
+    put(&value.first, sizeof(value.first));
+    put(&value.second, sizeof(value.second));
+  }
+  put(call.date_times.data(), call.date_times.size() * sizeof(std::int64_t));
+  put(call.base.data(), call.base.size() * sizeof(float));
+  ++calls_;
+}
+
+void CallRecordWriter::close() {
+  if (!out_.is_open()) {
+    return;
+  }
+  out_.close();
+  if (!out_) {
+    throw std::runtime_error("CallRecordWriter: write failed for " + path_);
+  }
+}
+
+void CallRecordWriter::put(const void* data, std::size_t size) {
+  out_.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+  if (!out_) {
+    throw std::runtime_error("CallRecordWriter: write failed for " + path_);
+  }
+  bytes_ += size;
+}
+
+CallRecordReader::CallRecordReader(const std::string& path) : path_(path), in_(path, std::ios::binary) {
+  if (!in_) {
+    throw std::runtime_error("CallRecordReader: cannot open " + path);
+  }
+  std::uint32_t magic = 0;
+  std::uint16_t version = 0;
+  std::uint16_t unused = 0;
+  std::uint32_t name_length = 0;
+  get(&magic, sizeof(magic));
+  get(&version, sizeof(version));
+  get(&unused, sizeof(unused));
+  get(&header_.base_arrays, sizeof(header_.base_arrays));
+  get(&header_.tick_size, sizeof(header_.tick_size));
+  get(&name_length, sizeof(name_length));
+  if (magic != CallRecordingHeader::kMagic || version != CallRecordingHeader::kVersion ||
+      header_.base_arrays == 0 || header_.base_arrays > kMaxBaseArrays || name_length > kMaxStudyName) {
+    throw std::runtime_error("CallRecordReader: " + path + " is not a call recording");
+  }
+  header_.study.resize(name_length);
+  get(&header_.study[0], name_length);
+}
+
+bool CallRecordReader::next(RecordedCall& call) {
+  RecordFixed fixed{};
+  in_.read(reinterpret_cast<char*>(&fixed), sizeof(fixed));
+  if (in_.gcount() == 0 && in_.eof()) {
+    return false;
+  }
+  if (!in_) {
+    throw std::runtime_error("CallRecordReader: truncated call in " + path_);
+  }
+  if (fixed.marker != kRecordMarker || fixed.array_size < 0 || fixed.array_size > kMaxArraySize ||
+      fixed.slice_start < 0 || fixed.slice_start > fixed.array_size || fixed.input_count > kMaxPairs ||
+      fixed.persistent_int_count > kMaxPairs || fixed.persistent_double_count > kMaxPairs) {
+    throw std::runtime_error("CallRecordReader: corrupt call in " + path_);
+  }
+  call.flags = fixed.flags;
+  call.index = fixed.index;
+  call.array_size = fixed.array_size;
+  call.update_start_index = fixed.update_start_index;
+  call.slice_start = fixed.slice_start;
+  call.output_digest = fixed.output_digest;
+
+  call.inputs.resize(fixed.input_count);
+  for (auto& input : call.inputs) {
+    get(&input.first, sizeof(input.first));
+    get(&input.second, sizeof(input.second));
+  }
+  call.persistent_ints.resize(fixed.persistent_int_count);
+  for (auto& value : call.persistent_ints) {
+    get(&value.first, sizeof(value.first));
+    get(&value.second, sizeof(value.second));
+  }
+  call.persistent_doubles.resize(fixed.persistent_double_count);
+  for (auto& value : call.persistent_doubles) {
+    get(&value.first, sizeof(value.first));
+    get(&value.second, sizeof(value.second));
+  }
+  const std::size_t slice = call.slice_size();
+  call.date_times.resize(slice);
+  call.base.resize(slice * header_.base_arrays);
+  get(call.date_times.data(), slice * sizeof(std::int64_t));
+  get(call.base.data(), call.base.size() * sizeof(float));
+  return true;
+}
+
+void CallRecordReader::get(void* data, std::size_t size) {
+  in_.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+  if (static_cast<std::size_t>(in_.gcount()) != size) {
+    throw std::runtime_error("CallRecordReader: truncated call in " + path_);
+  }
+}
+
+}  // namespace sierra::core
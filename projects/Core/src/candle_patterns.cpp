@@ -0,0 +1,1319 @@
+#include "sierra/core/candle_patterns.hpp"
+
+#include "sierra/core/trace.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define SIERRA_CORE_HAS_SSE2 1
+#include <emmintrin.h>
+#else
+#define SIERRA_CORE_HAS_SSE2 0
+#endif
+
+namespace sierra::core {
+
+namespace {
+
+constexpr std::size_t kWordBars = 64;
+constexpr int kStrengthBars = 5;        ///< `k_Body_NUM_OF_CANDLES` и `k_Candle_NUM_OF_CANDLES`.
+constexpr std::ptrdiff_t kLookback = 5; ///< Самый ранний бар, который читает модель: среднее тел до `i - 5`.
+constexpr float kTrendUp = 1.0f;        ///< `CANDLESTICK_TREND_UP`.
+constexpr float kTrendDown = -1.0f;
+
+constexpr double percent(double value) noexcept { return value / 100.0; }
+
+inline std::size_t clamp_index(std::ptrdiff_t index, std::size_t count) noexcept {
+  if (index < 0) {
+    return 0;
+  }
+  return (std::min)(static_cast<std::size_t>(index), count - 1);
+}
+
+/**
+ * @brief `DetermineTrendForCandlestickPatterns` после поиска экстремумов: регрессия `SC_HL_AVG` до бара `last`.
+ * @note Суммы по x и знаменатель наклона от бара не зависят и считаются один раз, теми же операциями, что в цикле
+ * исследования, поэтому результат тот же бит в бит.
+ */
+class TrendRegression {
+ public:
+  TrendRegression(const CandleSeries& bars, const CandlePatternSettings& settings) noexcept
+      : bars_(bars), settings_(settings), length_(static_cast<int>(settings.trend_bars)) {
+    for (int offset = 1; offset <= length_; ++offset) {
+      sumx_ += -offset;
+      sumxx_ += offset * offset;
+    }
+    denominator_ = static_cast<double>(length_) * sumxx_ - sumx_ * sumx_;
+  }
+
+  /// @param range `double(highest) - double(lowest)` окна `price_range_bars`.
+  float direction(std::ptrdiff_t last, double range) const noexcept {
+    double sumy = 0.0;
+    double sumxy = 0.0;
+    const bool inside = last - length_ + 1 >= 0;
+    for (int offset = 1; offset <= length_; ++offset) {
+      const std::ptrdiff_t index = last - (offset - 1);
+      const double value = bars_.hl_avg[inside ? static_cast<std::size_t>(index) : clamp_index(index, bars_.count)];
+      sumy += value;
+      sumxy += -offset * value;
+    }
+    const double slope = (static_cast<double>(length_) * sumxy - sumx_ * sumy) / denominator_;
+    const double corrected = slope / (range * settings_.price_range_multiplier);
+    if (corrected > 1.0) {
+      return kTrendUp;
+    }
+    return corrected < -1.0 ? kTrendDown : 0.0f;
+  }
+
+  /// @brief `direction(last, range[last])` для `last` из `[0, count)` в `out[last]`.
+  /// @note Бары с полным окном регрессии идут парами в SSE2 теми же операциями в том же порядке, без ветвлений.
+  void directions(const double* range, std::size_t count, float* out) const noexcept;
+
+ private:
+  const CandleSeries& bars_;
+  const CandlePatternSettings& settings_;
+  int length_;
+  double sumx_ = 0.0;
+  double sumxx_ = 0.0;
+  double denominator_ = 0.0;
+};
+
+void TrendRegression::directions(const double* range, std::size_t count, float* out) const noexcept {
+  std::size_t last = 0;
+  for (; last < count && last + 1 < static_cast<std::size_t>(length_); ++last) {
+    out[last] = direction(static_cast<std::ptrdiff_t>(last), range[last]);
+  }
+#if SIERRA_CORE_HAS_SSE2
+  const __m128d length = _mm_set1_pd(static_cast<double>(length_));
+  const __m128d sumx = _mm_set1_pd(sumx_);
+  const __m128d denominator = _mm_set1_pd(denominator_);
+  const __m128d multiplier = _mm_set1_pd(settings_.price_range_multiplier);
+  const __m128d up = _mm_set1_pd(kTrendUp);
+  const __m128d down = _mm_set1_pd(kTrendDown);
+  for (; last + 2 <= count; last += 2) {
+    __m128d sumy = _mm_setzero_pd();
+    __m128d sumxy = _mm_setzero_pd();
+    for (int offset = 1; offset <= length_; ++offset) {
+      const float* values = bars_.hl_avg + (last - static_cast<std::size_t>(offset - 1));
+      const __m128d value =
+          _mm_cvtps_pd(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(values)));
+      sumy = _mm_add_pd(sumy, value);
+      sumxy = _mm_add_pd(sumxy, _mm_mul_pd(_mm_set1_pd(static_cast<double>(-offset)), value));
+    }
+    const __m128d slope = _mm_div_pd(_mm_sub_pd(_mm_mul_pd(length, sumxy), _mm_mul_pd(sumx, sumy)), denominator);
+    const __m128d corrected = _mm_div_pd(slope, _mm_mul_pd(_mm_loadu_pd(range + last), multiplier));
+    const __m128d trend = _mm_or_pd(_mm_and_pd(_mm_cmpgt_pd(corrected, _mm_set1_pd(1.0)), up),
+                                    _mm_and_pd(_mm_cmplt_pd(corrected, _mm_set1_pd(-1.0)), down));
+    _mm_storel_pi(reinterpret_cast<__m64*>(out + last), _mm_cvtpd_ps(trend));
+  }
+#endif
+  for (; last < count; ++last) {
+    out[last] = direction(static_cast<std::ptrdiff_t>(last), range[last]);
+  }
+}
+
+/// @brief Функции `Is*` из `Studies4.cpp` с индексами, зажатыми в `[0, count)`, как у массивов Sierra Chart.
+class Reference {
+ public:
+  Reference(const CandleSeries& bars, const float* trend, const CandlePatternSettings& settings) noexcept
+      : bars_(bars), trend_(trend), settings_(settings) {}
+
+  bool find(CandlePattern pattern, std::ptrdiff_t i) const noexcept {
+    switch (pattern) {
+      case CandlePattern::kNone:
+        return false;
+      case CandlePattern::kHammer:
+        return trend(i, kTrendDown) && hammer_shape(i);
+      case CandlePattern::kHangingMan:
+        return trend(i, kTrendUp) && hammer_shape(i);
+      case CandlePattern::kBullishEngulfing:
+        return trend(i, kTrendDown) && black(i - 1) && white(i) && high(i) > high(i - 1) && low(i) < low(i - 1) &&
+               close(i) > open(i - 1) && open(i) < close(i - 1);
+      case CandlePattern::kBearishEngulfing:
+        return trend(i, kTrendUp) && white(i - 1) && black(i) && high(i) > high(i - 1) && low(i) < low(i - 1) &&
+               open(i) > close(i - 1) && close(i) < open(i - 1);
+      case CandlePattern::kDarkCloudCover:
+        return trend(i, kTrendUp) && white(i - 1) && body_strong(i - 1) && black(i) && open(i) > high(i - 1) &&
+               close(i) < close(i - 1) - percent_of_body(i - 1, 50);
+      case CandlePattern::kPiercingLine:
+        return trend(i, kTrendDown) && black(i - 1) && white(i) && open(i) < low(i - 1) &&
+               close(i) > open(i - 1) - percent_of_body(i - 1, 50) && body_strong(i - 1);
+      case CandlePattern::kMorningStar:
+        return trend(i, kTrendDown) && black(i - 2) && body_strong(i - 2) && open(i - 1) < low(i - 2) &&
+               close(i - 1) < low(i - 2) && !body_strong(i - 1) && white(i) && body_strong(i) &&
+               open(i) < close(i - 2) && close(i) > open(i - 2) - percent_of_body(i, 50);
+      case CandlePattern::kEveningStar:
+        return trend(i, kTrendUp) && white(i - 2) && body_strong(i - 2) && open(i - 1) > high(i - 2) &&
+               close(i - 1) > low(i - 2) && !body_strong(i - 1) && black(i) && open(i) > close(i - 2) &&
+               close(i) < close(i - 2) - percent_of_body(i - 2, 50) && body_strong(i);
+      case CandlePattern::kMorningDojiStar:
+        return trend(i, kTrendDown) && black(i - 2) && body_strong(i - 2) && high(i - 1) < close(i - 2) &&
+               doji(i - 1) && white(i) && open(i) < close(i - 2) &&
+               close(i) > open(i - 2) - percent_of_body(i - 2, 50) && body_strong(i);
+      case CandlePattern::kEveningDojiStar:
+        return trend(i, kTrendUp) && white(i - 2) && body_strong(i - 2) && open(i - 1) > high(i - 2) &&
+               doji(i - 1) && black(i) && open(i) > close(i - 2) && body_strong(i);
+      case CandlePattern::kBullishAbandonedBaby:
+        return trend(i, kTrendDown) && black(i - 2) && body_strong(i - 2) && open(i - 1) < low(i - 2) &&
+               doji(i - 1) && white(i) && open(i) < close(i - 2) &&
+               close(i) > open(i - 2) - percent_of_body(i - 2, 50) && body_strong(i) && low(i - 2) > high(i - 1) &&
+               low(i) > high(i - 1);
+      case CandlePattern::kBearishAbandonedBaby:
+        return trend(i, kTrendUp) && white(i - 2) && body_strong(i - 2) && open(i - 1) > high(i - 2) &&
+               doji(i - 1) && black(i) && open(i) > close(i - 2) &&
+               close(i) < close(i - 2) - percent_of_body(i - 2, 50) && body_strong(i) && high(i - 2) < low(i - 1) &&
+               high(i) < low(i - 1);
+      case CandlePattern::kShootingStar:
+        return trend(i, kTrendUp) && !body_strong(i) && star_shape(i) &&
+               upper_wick(i) >= percent_of_body(i, 300) && lower_wick_small(i, 7);
+      case CandlePattern::kInvertedHammer:
+        return trend(i, kTrendDown) && !body_strong(i) && star_shape(i) && !doji(i) &&
+               upper_wick(i) <= percent_of_body(i, 200) && lower_wick_small(i, 7);
+      case CandlePattern::kBearishHarami:
+        return trend(i, kTrendUp) && harami_body(i, false);
+      case CandlePattern::kBullishHarami:
+        return trend(i, kTrendDown) && harami_body(i, true);
+      case CandlePattern::kBearishHaramiCross:
+        return trend(i, kTrendUp) && body_strong(i - 1) && doji(i) &&
+               (open(i - 1) > close(i - 1) ? open(i - 1) > close(i) && close(i - 1) < close(i)
+                                           : close(i - 1) >= close(i) && open(i - 1) <= close(i));
+      case CandlePattern::kBullishHaramiCross:
+        return trend(i, kTrendDown) && body_strong(i - 1) && doji(i) &&
+               (open(i - 1) > close(i - 1) ? open(i - 1) > close(i) && close(i - 1) < close(i)
+                                           : close(i - 1) > close(i) && open(i - 1) < close(i));
+      case CandlePattern::kTweezerTop:
+        return trend(i, kTrendUp) && near_equal(high(i), high(i - 1), i, 7) && body_strong(i - 1) && !body_strong(i);
+      case CandlePattern::kTweezerBottom:
+        return trend(i, kTrendDown) && near_equal(low(i), low(i - 1), i, 7) && body_strong(i - 1) &&
+               !body_strong(i);
+      case CandlePattern::kBearishBeltHoldLine:
+        return trend(i, kTrendUp) && black(i) && body_strong(i) && near_equal(high(i), open(i), i, 7);
+      case CandlePattern::kBullishBeltHoldLine:
+        return trend(i, kTrendDown) && white(i) && body_strong(i) && near_equal(low(i), open(i), i, 7);
+      case CandlePattern::kTwoCrows:
+        return trend(i, kTrendUp) && white(i - 2) && body_strong(i - 2) && black(i - 1) && black(i) &&
+               close(i - 2) < close(i - 1) && open(i - 1) <= open(i) && close(i - 1) >= close(i) &&
+               close(i) > close(i - 2);
+      case CandlePattern::kThreeBlackCrows:
+        return trend(i, kTrendUp) && black(i - 2) && black(i - 1) && black(i) && close(i - 2) > close(i - 1) &&
+               close(i - 1) > close(i) && open(i - 1) <= open(i - 2) && open(i - 1) >= close(i - 2) &&
+               open(i) <= open(i - 1) && open(i) >= close(i - 1);
+      case CandlePattern::kBearishCounterattackLine:
+        return trend(i, kTrendUp) && near_equal(close(i), close(i - 1), i, 7) && white(i - 1) &&
+               body_strong(i - 1) && black(i) && body_strong(i);
+      case CandlePattern::kBullishCounterattackLine:
+        return trend(i, kTrendDown) && near_equal(close(i), close(i - 1), i, 7) && black(i - 1) &&
+               body_strong(i - 1) && white(i) && body_strong(i);
+      case CandlePattern::kThreeInsideUp:
+        return trend(i, kTrendDown) && white(i) && close(i) > close(i - 1) &&
+               find(CandlePattern::kBullishHarami, i - 1);
+      case CandlePattern::kThreeOutsideUp:
+        return trend(i, kTrendDown) && white(i) && close(i) > close(i - 1) &&
+               find(CandlePattern::kBullishEngulfing, i - 1);
+      case CandlePattern::kThreeInsideDown:
+        return trend(i, kTrendUp) && black(i) && close(i) < close(i - 1) && find(CandlePattern::kBearishHarami, i - 1);
+      case CandlePattern::kThreeOutsideDown:
+        return trend(i, kTrendUp) && black(i) && close(i) < close(i - 1) &&
+               find(CandlePattern::kBearishEngulfing, i - 1);
+      case CandlePattern::kKicker:
+        return black(i - 1) && shaven(i - 1) && white(i) && shaven(i) && body_strong(i - 1) && body_strong(i) &&
+               open(i - 1) < open(i);
+      case CandlePattern::kKicking:
+        return white(i - 1) && shaven(i - 1) && black(i) && shaven(i) && body_strong(i - 1) && body_strong(i) &&
+               open(i) < open(i - 1);
+      case CandlePattern::kThreeWhiteSoldiers:
+        return trend(i, kTrendDown) && white(i) && white(i - 1) && white(i - 2) && opens_in_body(i) &&
+               opens_in_body(i - 1) && upper_wick_small(i, 7) && upper_wick_small(i - 1, 7) &&
+               upper_wick_small(i - 2, 7);
+      case CandlePattern::kAdvanceBlock:
+        return trend(i, kTrendUp) && white(i) && white(i - 1) && white(i - 2) && opens_in_body(i) &&
+               opens_in_body(i - 1) && body_length(i) < body_length(i - 1) &&
+               body_length(i - 1) < body_length(i - 2);
+      case CandlePattern::kDeliberation:
+        return trend(i, kTrendUp) && white(i) && white(i - 1) && white(i - 2) && opens_in_body(i - 1) &&
+               body_strong(i - 1) && !body_strong(i);
+      case CandlePattern::kBearishTriStar:
+        return trend(i, kTrendUp) && doji(i) && doji(i - 1) && doji(i - 2) && open(i - 1) > close(i) &&
+               open(i - 1) > close(i - 2);
+      case CandlePattern::kBullishTriStar:
+        return trend(i, kTrendDown) && doji(i) && doji(i - 1) && doji(i - 2) && open(i - 1) < close(i) &&
+               open(i - 1) < close(i - 2);
+      case CandlePattern::kUniqueThreeRiverBottom:
+        return trend(i, kTrendDown) && black(i - 2) && body_strong(i - 2) && find(CandlePattern::kHammer, i - 1) &&
+               low(i - 1) < low(i) && low(i - 1) < low(i - 2) && white(i) && !body_strong(i) &&
+               open(i) < open(i - 1) && open(i) < close(i - 1);
+      case CandlePattern::kBearishDojiStar:
+        return trend(i, kTrendUp) && white(i - 1) && body_strong(i - 1) && doji(i) && close(i) > high(i - 1) &&
+               upper_wick(i) <= percent_of_candle(i - 1, 25) && lower_wick(i) <= percent_of_candle(i - 1, 25);
+      case CandlePattern::kBullishDojiStar:
+        return trend(i, kTrendDown) && black(i - 1) && body_strong(i - 1) && doji(i) && close(i) < low(i - 1) &&
+               upper_wick(i) <= percent_of_candle(i - 1, 25) && lower_wick(i) <= percent_of_candle(i - 1, 25);
+      case CandlePattern::kBearishDragonflyDoji:
+        return trend(i, kTrendUp) && doji(i) && upper_wick_small(i, 7) && candle_strong(i);
+      case CandlePattern::kBullishDragonflyDoji:
+        return trend(i, kTrendDown) && doji(i) && upper_wick_small(i, 7) && candle_strong(i);
+      case CandlePattern::kBearishGravestoneDoji:
+        return trend(i, kTrendUp) && white(i - 1) && doji(i) && lower_wick_small(i, 7) && candle_strong(i) &&
+               open(i) > high(i - 1);
+      case CandlePattern::kBullishGravestoneDoji:
+        return trend(i, kTrendDown) && black(i - 1) && doji(i) && lower_wick_small(i, 7) && candle_strong(i) &&
+               low(i - 1) < high(i);
+      case CandlePattern::kBearishLongLeggedDoji:
+        return trend(i, kTrendUp) && long_legged(i) && body_top(i) > high(i - 1);
+      case CandlePattern::kBullishLongLeggedDoji:
+        return trend(i, kTrendDown) && long_legged(i) && body_top(i) < low(i - 1);
+      case CandlePattern::kBearishSideBySideWhiteLines:
+        return trend(i, kTrendDown) && white(i) && white(i - 1) && black(i - 2) && low(i - 2) > high(i - 1) &&
+               near_equal(open(i - 1), open(i), i, 14) &&
+               near_equal(candle_length(i), candle_length(i - 1), i, 14);
+      case CandlePattern::kBullishSideBySideWhiteLines:
+        return trend(i, kTrendUp) && white(i) && white(i - 1) && white(i - 2) && low(i - 1) > high(i - 2) &&
+               near_equal(close(i - 1), close(i), i, 7) && near_equal(open(i - 1), open(i), i, 7) &&
+               high(i) > high(i - 1);
+      case CandlePattern::kFallingThreeMethods:
+        return trend(i, kTrendDown) && body_strong(i - 4) && black(i - 4) && !body_strong(i - 1) &&
+               !body_strong(i - 2) && !body_strong(i - 3) && ohlc_avg(i - 3) < ohlc_avg(i - 2) &&
+               ohlc_avg(i - 2) < ohlc_avg(i - 1) && high(i - 3) < high(i - 4) && high(i - 2) < high(i - 4) &&
+               high(i - 1) < high(i - 4) && low(i - 3) > low(i - 4) && low(i - 2) > low(i - 4) &&
+               low(i - 1) > low(i - 4) && body_strong(i) && black(i) && near_equal(open(i), close(i - 1), i, 30) &&
+               close(i) < close(i - 4);
+      case CandlePattern::kRisingThreeMethods:
+        return trend(i, kTrendUp) && body_strong(i - 4) && white(i - 4) && !body_strong(i - 1) &&
+               !body_strong(i - 2) && !body_strong(i - 3) && ohlc_avg(i - 3) > ohlc_avg(i - 2) &&
+               ohlc_avg(i - 2) > ohlc_avg(i - 1) && high(i - 3) <= high(i - 4) && high(i - 2) <= high(i - 4) &&
+               high(i - 1) <= high(i - 4) && low(i - 3) >= low(i - 4) && low(i - 2) >= low(i - 4) &&
+               low(i - 1) >= low(i - 4) && body_strong(i) && white(i) && close(i) > close(i - 4);
+      case CandlePattern::kBearishSeparatingLines:
+        return trend(i, kTrendDown) && near_equal(open(i), open(i - 1), i, 5) && white(i - 1) != white(i);
+      case CandlePattern::kBullishSeparatingLines:
+        return trend(i, kTrendUp) && near_equal(open(i), open(i - 1), i, 5) && white(i - 1) != white(i);
+      case CandlePattern::kDownsideTasukiGap:
+        return trend(i, kTrendDown) && white(i) && black(i - 1) && black(i - 2) && body_strong(i - 1) &&
+               body_strong(i - 2) && low(i - 2) > high(i - 1) && open(i) > close(i - 1) && open(i) < open(i - 1) &&
+               close(i) > high(i - 1) && close(i) < low(i - 2);
+      case CandlePattern::kUpsideTasukiGap:
+        return trend(i, kTrendUp) && black(i) && white(i - 1) && white(i - 2) && body_strong(i - 1) &&
+               body_strong(i - 2) && high(i - 2) < low(i - 1) && open(i) > open(i - 1) && open(i) < close(i - 1) &&
+               close(i) > high(i - 2) && close(i) < low(i - 1);
+      case CandlePattern::kBearishThreeLineStrike:
+        return trend(i, kTrendDown) && white(i) && black(i - 1) && black(i - 2) && black(i - 3) &&
+               body_strong(i - 1) && body_strong(i - 2) && body_strong(i - 3) && open(i) < close(i - 1) &&
+               close(i) > open(i - 3);
+      case CandlePattern::kBullishThreeLineStrike:
+        return trend(i, kTrendUp) && black(i) && white(i - 1) && white(i - 2) && white(i - 3) &&
+               body_strong(i - 1) && body_strong(i - 2) && body_strong(i - 3) && open(i) > close(i - 1) &&
+               close(i) < open(i - 3);
+      case CandlePattern::kDownsideGapThreeMethods:
+        return trend(i, kTrendDown) && white(i) && black(i - 1) && black(i - 2) && body_strong(i - 1) &&
+               body_strong(i - 2) && low(i - 2) > high(i - 1) && open(i) > close(i - 1) && open(i) < open(i - 1) &&
+               close(i) > low(i - 2);
+      case CandlePattern::kUpsideGapThreeMethods:
+        return trend(i, kTrendUp) && black(i) && white(i - 1) && white(i - 2) && body_strong(i - 1) &&
+               body_strong(i - 2) && high(i - 2) < low(i - 1) && open(i) > open(i - 1) && open(i) < close(i - 1) &&
+               close(i) < high(i - 2);
+      case CandlePattern::kOnNeck:
+        return trend(i, kTrendDown) && black(i - 1) && body_strong(i - 1) && white(i) &&
+               near_equal(close(i), low(i - 1), i, 15);
+      case CandlePattern::kInNeck:
+        return trend(i, kTrendDown) && black(i - 1) && body_strong(i - 1) && white(i) && low(i - 1) > open(i) &&
+               close(i) >= close(i - 1) &&
+               (near_equal(close(i), close(i - 1), i, 15) ||
+                close(i) - close(i - 1) < percent_of_candle(i, 15));
+      case CandlePattern::kBearishThrusting:
+        return trend(i, kTrendDown) && black(i - 1) && white(i) && low(i - 1) > open(i) &&
+               low(i - 1) - open(i) > percent_of_candle(i, 10) && close(i) > close(i - 1) &&
+               close(i) < close(i - 1) + (open(i - 1) - close(i - 1)) / 2;
+      case CandlePattern::kMatHold:
+        return mat_hold(i);
+      case CandlePattern::kDoji:
+        return doji(i);
+      case CandlePattern::kBullishEngulfingBodyOnly:
+        return trend(i, kTrendDown) && black(i - 1) && white(i) && close(i) > open(i - 1) && open(i) < close(i - 1);
+      case CandlePattern::kBearishEngulfingBodyOnly:
+        return trend(i, kTrendUp) && white(i - 1) && black(i) && open(i) > close(i - 1) && close(i) < open(i - 1);
+    }
+    return false;
+  }
+
+ private:
+  float open(std::ptrdiff_t i) const noexcept { return bars_.open[clamp_index(i, bars_.count)]; }
+  float high(std::ptrdiff_t i) const noexcept { return bars_.high[clamp_index(i, bars_.count)]; }
+  float low(std::ptrdiff_t i) const noexcept { return bars_.low[clamp_index(i, bars_.count)]; }
+  float close(std::ptrdiff_t i) const noexcept { return bars_.close[clamp_index(i, bars_.count)]; }
+  float ohlc_avg(std::ptrdiff_t i) const noexcept { return bars_.ohlc_avg[clamp_index(i, bars_.count)]; }
+
+  bool trend(std::ptrdiff_t i, float direction) const noexcept {
+    return !settings_.use_trend_detection || trend_[clamp_index(i, bars_.count)] == direction;
+  }
+
+  float candle_length(std::ptrdiff_t i) const noexcept { return high(i) - low(i); }
+  float body_length(std::ptrdiff_t i) const noexcept { return std::fabs(open(i) - close(i)); }
+  float body_top(std::ptrdiff_t i) const noexcept { return close(i) > open(i) ? close(i) : open(i); }
+  float body_bottom(std::ptrdiff_t i) const noexcept { return close(i) < open(i) ? close(i) : open(i); }
+  double upper_wick(std::ptrdiff_t i) const noexcept {
+    return static_cast<double>(high(i)) - static_cast<double>(body_top(i));
+  }
+  double lower_wick(std::ptrdiff_t i) const noexcept {
+    return static_cast<double>(body_bottom(i)) - static_cast<double>(low(i));
+  }
+  double percent_of_candle(std::ptrdiff_t i, double value) const noexcept {
+    return static_cast<double>(candle_length(i)) * percent(value);
+  }
+  double percent_of_body(std::ptrdiff_t i, double value) const noexcept {
+    return static_cast<double>(body_length(i)) * value / 100.0;
+  }
+
+  bool white(std::ptrdiff_t i) const noexcept { return close(i) > open(i); }
+  bool black(std::ptrdiff_t i) const noexcept { return close(i) < open(i); }
+  bool doji(std::ptrdiff_t i) const noexcept { return body_length(i) <= percent_of_candle(i, 5); }
+
+  bool body_strong(std::ptrdiff_t i) const noexcept {
+    float average = 0;
+    for (int k = 1; k <= kStrengthBars; ++k) {
+      average += body_length(i - k);
+    }
+    average /= kStrengthBars;
+    return body_length(i) > average;
+  }
+
+  bool candle_strong(std::ptrdiff_t i) const noexcept {
+    float average = 0;
+    for (int k = 1; k <= kStrengthBars; ++k) {
+      average += candle_length(i - k);
+    }
+    average /= kStrengthBars;
+    return candle_length(i) > average * 1.0;
+  }
+
+  bool near_equal(double first, double second, std::ptrdiff_t i, double value) const noexcept {
+    return std::fabs(first - second) < percent_of_candle(i, value);
+  }
+  bool upper_wick_small(std::ptrdiff_t i, double value) const noexcept {
+    return upper_wick(i) < percent_of_candle(i, value);
+  }
+  bool lower_wick_small(std::ptrdiff_t i, double value) const noexcept {
+    return lower_wick(i) < percent_of_candle(i, value);
+  }
+  /// @brief Обе тени меньше 7% свечи (бары Kicker и Kicking).
+  bool shaven(std::ptrdiff_t i) const noexcept { return upper_wick_small(i, 7) && lower_wick_small(i, 7); }
+  /// @brief Открытие внутри тела предыдущего бара (Three White Soldiers, Advance Block, Deliberation).
+  bool opens_in_body(std::ptrdiff_t i) const noexcept { return open(i) <= close(i - 1) && open(i) >= open(i - 1); }
+
+  bool hammer_shape(std::ptrdiff_t i) const noexcept {
+    return high(i) - open(i) < open(i) - low(i) && high(i) - close(i) < close(i) - low(i) && open(i) != close(i) &&
+           lower_wick(i) < percent_of_candle(i, 200) && upper_wick_small(i, 7);
+  }
+
+  bool star_shape(std::ptrdiff_t i) const noexcept {
+    return high(i) - open(i) > open(i) - low(i) && high(i) - close(i) > close(i) - low(i);
+  }
+
+  bool long_legged(std::ptrdiff_t i) const noexcept {
+    return doji(i) && candle_strong(i) && std::fabs(lower_wick(i) - upper_wick(i)) < percent_of_candle(i, 10);
+  }
+
+  /// @brief Тело бара внутри тела предыдущего; у бычьей модели при открытии ниже закрытия сравнение `>=`.
+  bool harami_body(std::ptrdiff_t i, bool bullish) const noexcept {
+    if (!body_strong(i - 1) || doji(i) || body_strong(i)) {
+      return false;
+    }
+    const float open1 = open(i - 1);
+    const float close1 = close(i - 1);
+    if (open1 > close1) {
+      return open(i) > close(i) ? open1 >= open(i) && close1 <= close(i) : open1 >= close(i) && close1 <= open(i);
+    }
+    const bool down = bullish ? open(i) >= close(i) : open(i) > close(i);
+    return down ? close1 >= open(i) && open1 <= close(i) : close1 >= close(i) && open1 <= open(i);
+  }
+
+  bool mat_hold(std::ptrdiff_t i) const noexcept {
+    if (!white(i) || !(open(i) > close(i - 1)) || !body_strong(i) || !(close(i - 2) > close(i - 1)) ||
+        body_strong(i - 1) || body_strong(i - 2) || !trend(i, kTrendUp)) {
+      return false;
+    }
+    std::ptrdiff_t first = 0;
+    if (body_strong(i - 3) && white(i - 3)) {
+      first = 3;
+    } else if (body_strong(i - 4) && white(i - 4)) {
+      first = 4;
+    } else {
+      return false;
+    }
+    if (!(close(i) > close(i - first)) || !(low(i - first + 1) > high(i - first)) || !black(i - first + 1)) {
+      return false;
+    }
+    if (high(i - 1) > high(i - first) || low(i - 1) < low(i - first)) {
+      return false;
+    }
+    for (std::ptrdiff_t k = 2; k < first; ++k) {
+      if (body_strong(i - k) || close(i - k) < close(i - k + 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const CandleSeries& bars_;
+  const float* trend_;
+  const CandlePatternSettings& settings_;
+};
+
+#if SIERRA_CORE_HAS_SSE2
+/// @brief Четыре бара: `float` столбцов, `double` для сравнений с процентами свечи, маски сравнений.
+struct F4 {
+  __m128 v;
+};
+struct D4 {
+  __m128d low;
+  __m128d high;
+};
+struct M4 {
+  __m128 v;
+};
+
+inline F4 load(const float* values) noexcept { return {_mm_loadu_ps(values)}; }
+inline F4 splat(float value) noexcept { return {_mm_set1_ps(value)}; }
+inline F4 operator+(F4 a, F4 b) noexcept { return {_mm_add_ps(a.v, b.v)}; }
+inline F4 operator-(F4 a, F4 b) noexcept { return {_mm_sub_ps(a.v, b.v)}; }
+inline F4 operator/(F4 a, F4 b) noexcept { return {_mm_div_ps(a.v, b.v)}; }
+inline F4 abs(F4 a) noexcept { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)}; }
+/// @brief Макросы Windows `max(a, b)`/`min(a, b)`: `maxps`/`minps` так же возвращают `b` при NaN.
+inline F4 windows_max(F4 a, F4 b) noexcept { return {_mm_max_ps(a.v, b.v)}; }
+inline F4 windows_min(F4 a, F4 b) noexcept { return {_mm_min_ps(a.v, b.v)}; }
+inline M4 operator<(F4 a, F4 b) noexcept { return {_mm_cmplt_ps(a.v, b.v)}; }
+inline M4 operator>(F4 a, F4 b) noexcept { return {_mm_cmpgt_ps(a.v, b.v)}; }
+inline M4 operator==(F4 a, F4 b) noexcept { return {_mm_cmpeq_ps(a.v, b.v)}; }
+inline M4 operator!=(F4 a, F4 b) noexcept { return {_mm_cmpneq_ps(a.v, b.v)}; }
+/// @brief Хотя бы одно значение пары — NaN.
+inline M4 unordered(F4 a, F4 b) noexcept { return {_mm_cmpunord_ps(a.v, b.v)}; }
+
+inline D4 widen(F4 a) noexcept { return {_mm_cvtps_pd(a.v), _mm_cvtps_pd(_mm_movehl_ps(a.v, a.v))}; }
+inline D4 splat(double value) noexcept { return {_mm_set1_pd(value), _mm_set1_pd(value)}; }
+inline D4 operator-(D4 a, D4 b) noexcept { return {_mm_sub_pd(a.low, b.low), _mm_sub_pd(a.high, b.high)}; }
+inline D4 operator*(D4 a, D4 b) noexcept { return {_mm_mul_pd(a.low, b.low), _mm_mul_pd(a.high, b.high)}; }
+inline D4 abs(D4 a) noexcept {
+  const __m128d sign = _mm_set1_pd(-0.0);
+  return {_mm_andnot_pd(sign, a.low), _mm_andnot_pd(sign, a.high)};
+}
+/// @brief Маски двух пар `double` в одну маску четырёх дорожек: младшие половины 64-битных масок.
+inline M4 merge(__m128d low, __m128d high) noexcept {
+  return {_mm_shuffle_ps(_mm_castpd_ps(low), _mm_castpd_ps(high), _MM_SHUFFLE(2, 0, 2, 0))};
+}
+inline M4 operator<(D4 a, D4 b) noexcept { return merge(_mm_cmplt_pd(a.low, b.low), _mm_cmplt_pd(a.high, b.high)); }
+inline M4 operator<=(D4 a, D4 b) noexcept { return merge(_mm_cmple_pd(a.low, b.low), _mm_cmple_pd(a.high, b.high)); }
+inline M4 operator>(D4 a, D4 b) noexcept { return merge(_mm_cmpgt_pd(a.low, b.low), _mm_cmpgt_pd(a.high, b.high)); }
+inline M4 operator>=(D4 a, D4 b) noexcept { return merge(_mm_cmpge_pd(a.low, b.low), _mm_cmpge_pd(a.high, b.high)); }
+
+inline M4 operator&(M4 a, M4 b) noexcept { return {_mm_and_ps(a.v, b.v)}; }
+inline M4 operator|(M4 a, M4 b) noexcept { return {_mm_or_ps(a.v, b.v)}; }
+
+/// @brief Маски 16 баров (четыре группы) в 16 бит: упаковка до байтов и `movemask`.
+inline std::uint64_t pack_bits(M4 a, M4 b, M4 c, M4 d) noexcept {
+  const __m128i low = _mm_packs_epi32(_mm_castps_si128(a.v), _mm_castps_si128(b.v));
+  const __m128i high = _mm_packs_epi32(_mm_castps_si128(c.v), _mm_castps_si128(d.v));
+  return static_cast<std::uint64_t>(_mm_movemask_epi8(_mm_packs_epi16(low, high)));
+}
+#else
+struct F4 {
+  float v[4];
+};
+struct D4 {
+  double v[4];
+};
+struct M4 {
+  std::uint32_t v[4];
+};
+
+template <typename Out, typename In, typename Op>
+inline Out lanewise(const In& a, const In& b, Op op) noexcept {
+  Out out{};
+  for (int k = 0; k < 4; ++k) {
+    out.v[k] = op(a.v[k], b.v[k]);
+  }
+  return out;
+}
+
+template <typename In, typename Op>
+inline M4 compare(const In& a, const In& b, Op op) noexcept {
+  M4 out{};
+  for (int k = 0; k < 4; ++k) {
+    out.v[k] = op(a.v[k], b.v[k]) ? ~std::uint32_t{0} : 0;
+  }
+  return out;
+}
+
+inline F4 load(const float* values) noexcept { return {{values[0], values[1], values[2], values[3]}}; }
+inline F4 splat(float value) noexcept { return {{value, value, value, value}}; }
+inline F4 operator+(F4 a, F4 b) noexcept { return lanewise<F4>(a, b, [](float x, float y) { return x + y; }); }
+inline F4 operator-(F4 a, F4 b) noexcept { return lanewise<F4>(a, b, [](float x, float y) { return x - y; }); }
+inline F4 operator/(F4 a, F4 b) noexcept { return lanewise<F4>(a, b, [](float x, float y) { return x / y; }); }
+inline F4 abs(F4 a) noexcept { return lanewise<F4>(a, a, [](float x, float) { return std::fabs(x); }); }
+inline F4 windows_max(F4 a, F4 b) noexcept {
+  return lanewise<F4>(a, b, [](float x, float y) { return x > y ? x : y; });
+}
+inline F4 windows_min(F4 a, F4 b) noexcept {
+  return lanewise<F4>(a, b, [](float x, float y) { return x < y ? x : y; });
+}
+inline M4 operator<(F4 a, F4 b) noexcept { return compare(a, b, [](float x, float y) { return x < y; }); }
+inline M4 operator>(F4 a, F4 b) noexcept { return compare(a, b, [](float x, float y) { return x > y; }); }
+inline M4 operator==(F4 a, F4 b) noexcept { return compare(a, b, [](float x, float y) { return x == y; }); }
+inline M4 operator!=(F4 a, F4 b) noexcept { return compare(a, b, [](float x, float y) { return x != y; }); }
+inline M4 unordered(F4 a, F4 b) noexcept {
+  return compare(a, b, [](float x, float y) { return std::isnan(x) || std::isnan(y); });
+}
+
+inline D4 widen(F4 a) noexcept { return {{a.v[0], a.v[1], a.v[2], a.v[3]}}; }
+inline D4 splat(double value) noexcept { return {{value, value, value, value}}; }
+inline D4 operator-(D4 a, D4 b) noexcept { return lanewise<D4>(a, b, [](double x, double y) { return x - y; }); }
+inline D4 operator*(D4 a, D4 b) noexcept { return lanewise<D4>(a, b, [](double x, double y) { return x * y; }); }
+inline D4 abs(D4 a) noexcept { return lanewise<D4>(a, a, [](double x, double) { return std::fabs(x); }); }
+inline M4 operator<(D4 a, D4 b) noexcept { return compare(a, b, [](double x, double y) { return x < y; }); }
+inline M4 operator<=(D4 a, D4 b) noexcept { return compare(a, b, [](double x, double y) { return x <= y; }); }
+inline M4 operator>(D4 a, D4 b) noexcept { return compare(a, b, [](double x, double y) { return x > y; }); }
+inline M4 operator>=(D4 a, D4 b) noexcept { return compare(a, b, [](double x, double y) { return x >= y; }); }
+
+inline M4 operator&(M4 a, M4 b) noexcept {
+  return lanewise<M4>(a, b, [](std::uint32_t x, std::uint32_t y) { return x & y; });
+}
+inline M4 operator|(M4 a, M4 b) noexcept {
+  return lanewise<M4>(a, b, [](std::uint32_t x, std::uint32_t y) { return x | y; });
+}
+
+inline std::uint64_t pack_bits(M4 a, M4 b, M4 c, M4 d) noexcept {
+  std::uint64_t bits = 0;
+  const M4* groups[4] = {&a, &b, &c, &d};
+  for (int bar = 0; bar < 16; ++bar) {
+    bits |= static_cast<std::uint64_t>(groups[bar / 4]->v[bar % 4] & 1u) << bar;
+  }
+  return bits;
+}
+#endif
+
+/// @brief Столбцы слова из 64 баров: указатели на первый бар, читаются `[-kLookback, 64)`.
+struct Window {
+  const float* open;
+  const float* high;
+  const float* low;
+  const float* close;
+  const float* ohlc_avg;
+  const float* trend;  ///< `[0, 64)`; `nullptr` — тренд выключен.
+};
+
+/// @brief Копия слова с индексами, зажатыми в `[0, count)`: первые бары и хвост ряда.
+struct PaddedWord {
+  static constexpr std::size_t kBars = kLookback + kWordBars;
+  float open[kBars];
+  float high[kBars];
+  float low[kBars];
+  float close[kBars];
+  float ohlc_avg[kBars];
+  float trend[kWordBars];
+
+  Window fill(const CandleSeries& bars, const float* trend_column, std::ptrdiff_t begin) noexcept {
+    for (std::size_t k = 0; k < kBars; ++k) {
+      const std::size_t index = clamp_index(begin - kLookback + static_cast<std::ptrdiff_t>(k), bars.count);
+      open[k] = bars.open[index];
+      high[k] = bars.high[index];
+      low[k] = bars.low[index];
+      close[k] = bars.close[index];
+      ohlc_avg[k] = bars.ohlc_avg[index];
+    }
+    for (std::size_t k = 0; k < kWordBars && trend_column != nullptr; ++k) {
+      trend[k] = trend_column[clamp_index(begin + static_cast<std::ptrdiff_t>(k), bars.count)];
+    }
+    return {open + kLookback,     high + kLookback,
+            low + kLookback,      close + kLookback,
+            ohlc_avg + kLookback, trend_column != nullptr ? trend : nullptr};
+  }
+};
+
+/**
+ * @brief Сравнения, из которых собираются модели; бит `i` слова — сравнение на баре `i`.
+ * @note Суффикс `N` — сравнение с баром `i - N`; то же сравнение двух более ранних баров — сдвиг слова. Нестрогие
+ * сравнения цен (`<=`, `>=`) — отрицание строгих: без NaN это то же самое, а бары с NaN поблизости пересчитываются
+ * эталоном (`kNaN`). Сравнения с процентами тела и свечи идут в `double` и стоят подряд, от `kDoji`.
+ */
+enum Test : std::size_t {
+  kUp,
+  kDown,
+  kNaN,  ///< NaN в Open, High, Low или Close.
+  kWhite,
+  kBlack,
+  kStrong,
+  kCandleStrong,
+  kHammerBar,  ///< Тени молота относительно открытия и закрытия, тело ненулевое.
+  kStarBar,    ///< Обе тени от тела вверх длиннее, чем вниз.
+  kShrinks,    ///< Тело меньше тела предыдущего бара.
+  kAvgRises,   ///< `SC_OHLC_AVG` выше, чем у предыдущего бара.
+  kAvgFalls,
+  kHighAboveHigh1,
+  kHighBelowHigh1,
+  kLowBelowLow1,
+  kLowAboveLow1,
+  kCloseAboveOpen1,
+  kCloseBelowOpen1,
+  kOpenBelowClose1,
+  kOpenAboveClose1,
+  kOpenAboveOpen1,
+  kOpenBelowOpen1,
+  kCloseAboveClose1,
+  kCloseBelowClose1,
+  kOpenAboveHigh1,
+  kOpenBelowLow1,
+  kCloseAboveHigh1,
+  kCloseBelowLow1,
+  kCloseAboveLow1,
+  kHighBelowClose1,
+  kHighAboveLow1,
+  kTopAboveHigh1,
+  kTopBelowLow1,
+  kLowAboveHigh1,
+  kHighBelowLow1,
+  kThrustClose,
+  kOpenBelowClose2,
+  kOpenAboveClose2,
+  kCloseAboveClose2,
+  kCloseAboveHigh2,
+  kCloseBelowLow2,
+  kCloseAboveLow2,
+  kCloseBelowHigh2,
+  kHighAboveHigh2,
+  kHighBelowHigh2,
+  kLowBelowLow2,
+  kLowAboveLow2,
+  kCloseAboveOpen3,
+  kCloseBelowOpen3,
+  kCloseAboveClose3,
+  kHighAboveHigh3,
+  kHighBelowHigh3,
+  kLowBelowLow3,
+  kLowAboveLow3,
+  kCloseAboveClose4,
+  kCloseBelowClose4,
+  kDoji,
+  kUpperSmall,  ///< Верхняя тень меньше 7% свечи.
+  kLowerSmall,
+  kHammerWick,  ///< Нижняя тень короче двух свечей.
+  kLongUpperWick,
+  kShortUpperWick,
+  kHighNearOpen,
+  kLowNearOpen,
+  kLongLegged,
+  kDarkCloud,  ///< Закрытие ниже середины тела предыдущего бара.
+  kPiercing,
+  kHighNearHigh1,
+  kLowNearLow1,
+  kCloseNearClose1,
+  kOpenNearOpen1,
+  kOpenNearOpen1Tight,  ///< В пределах 5% свечи.
+  kOpenNearOpen1Wide,   ///< В пределах 14% свечи.
+  kCandleNearCandle1,
+  kDojiStarWicks,  ///< Обе тени не длиннее четверти предыдущей свечи.
+  kOpenNearClose1,
+  kCloseNearLow1,
+  kInNeckClose,
+  kThrustGap,     ///< Открытие ниже минимума предыдущего бара больше чем на 10% свечи.
+  kMorningClose,  ///< Закрытие выше середины тела `i - 2` по своему телу.
+  kAboveBearStar,
+  kBelowBullStar,
+  kTestCount,
+};
+
+constexpr std::size_t kPercentTests = kTestCount - kDoji;
+
+/// @brief Четыре бара группы: столбцы от первого бара и тело, общее для нескольких сравнений.
+struct Group {
+  Group(const Window& w, std::size_t at) noexcept
+      : open(w.open + at), high(w.high + at), low(w.low + at), close(w.close + at), ohlc_avg(w.ohlc_avg + at),
+        trend(w.trend != nullptr ? w.trend + at : nullptr), body(abs(o(0) - c(0))) {}
+
+  F4 o(int k) const noexcept { return load(open - k); }
+  F4 h(int k) const noexcept { return load(high - k); }
+  F4 l(int k) const noexcept { return load(low - k); }
+  F4 c(int k) const noexcept { return load(close - k); }
+
+  const float* open;
+  const float* high;
+  const float* low;
+  const float* close;
+  const float* ohlc_avg;
+  const float* trend;
+  F4 body;
+};
+
+/// @brief Сумма `b[-1] + … + b[-5]` в порядке `IsBodyStrong`, делённая на 5 во `float`.
+template <typename Length>
+inline F4 strength_average(Length length) noexcept {
+  F4 sum = length(1);
+  for (int k = 2; k <= kStrengthBars; ++k) {
+    sum = sum + length(k);
+  }
+  return sum / splat(static_cast<float>(kStrengthBars));
+}
+
+/// @brief Сравнения 16 баров блока (четыре группы), ужатые `pack_bits` в биты `block` … `block + 15` слова.
+template <typename Predicate>
+inline void pack_test(std::uint64_t* bits, Test test, const Group* g, std::size_t block, Predicate predicate) noexcept {
+  bits[test] |= pack_bits(predicate(g[0]), predicate(g[1]), predicate(g[2]), predicate(g[3])) << block;
+}
+
+/// @brief Сравнения внутри бара: цвет, сила тела и свечи, форма теней и тренд.
+void compare_bar(const Group* g, std::size_t block, std::uint64_t* bits) noexcept {
+  const auto put = [&](Test test, auto predicate) { pack_test(bits, test, g, block, predicate); };
+  if (g[0].trend != nullptr) {
+    put(kUp, [](const Group& x) { return load(x.trend) == splat(kTrendUp); });
+    put(kDown, [](const Group& x) { return load(x.trend) == splat(kTrendDown); });
+  }
+  put(kNaN, [](const Group& x) { return unordered(x.o(0), x.h(0)) | unordered(x.l(0), x.c(0)); });
+  put(kWhite, [](const Group& x) { return x.c(0) > x.o(0); });
+  put(kBlack, [](const Group& x) { return x.c(0) < x.o(0); });
+  put(kStrong, [](const Group& x) {
+    return x.body > strength_average([&](int k) { return abs(x.o(k) - x.c(k)); });
+  });
+  put(kCandleStrong, [](const Group& x) {
+    return x.h(0) - x.l(0) > strength_average([&](int k) { return x.h(k) - x.l(k); });
+  });
+  put(kHammerBar, [](const Group& x) {
+    const F4 o0 = x.o(0), h0 = x.h(0), l0 = x.l(0), c0 = x.c(0);
+    return (h0 - o0 < o0 - l0) & (h0 - c0 < c0 - l0) & (o0 != c0);
+  });
+  put(kStarBar, [](const Group& x) {
+    const F4 o0 = x.o(0), h0 = x.h(0), l0 = x.l(0), c0 = x.c(0);
+    return (h0 - o0 > o0 - l0) & (h0 - c0 > c0 - l0);
+  });
+  put(kShrinks, [](const Group& x) { return x.body < abs(x.o(1) - x.c(1)); });
+  put(kAvgRises, [](const Group& x) { return load(x.ohlc_avg - 1) < load(x.ohlc_avg); });
+  put(kAvgFalls, [](const Group& x) { return load(x.ohlc_avg - 1) > load(x.ohlc_avg); });
+}
+
+/// @brief Сравнения цен бара с ценами предыдущего.
+void compare_previous(const Group* g, std::size_t block, std::uint64_t* bits) noexcept {
+  const auto put = [&](Test test, auto predicate) { pack_test(bits, test, g, block, predicate); };
+  put(kHighAboveHigh1, [](const Group& x) { return x.h(0) > x.h(1); });
+  put(kHighBelowHigh1, [](const Group& x) { return x.h(0) < x.h(1); });
+  put(kLowBelowLow1, [](const Group& x) { return x.l(0) < x.l(1); });
+  put(kLowAboveLow1, [](const Group& x) { return x.l(0) > x.l(1); });
+  put(kCloseAboveOpen1, [](const Group& x) { return x.c(0) > x.o(1); });
+  put(kCloseBelowOpen1, [](const Group& x) { return x.c(0) < x.o(1); });
+  put(kOpenBelowClose1, [](const Group& x) { return x.o(0) < x.c(1); });
+  put(kOpenAboveClose1, [](const Group& x) { return x.o(0) > x.c(1); });
+  put(kOpenAboveOpen1, [](const Group& x) { return x.o(0) > x.o(1); });
+  put(kOpenBelowOpen1, [](const Group& x) { return x.o(0) < x.o(1); });
+  put(kCloseAboveClose1, [](const Group& x) { return x.c(0) > x.c(1); });
+  put(kCloseBelowClose1, [](const Group& x) { return x.c(0) < x.c(1); });
+  put(kOpenAboveHigh1, [](const Group& x) { return x.o(0) > x.h(1); });
+  put(kOpenBelowLow1, [](const Group& x) { return x.o(0) < x.l(1); });
+  put(kCloseAboveHigh1, [](const Group& x) { return x.c(0) > x.h(1); });
+  put(kCloseBelowLow1, [](const Group& x) { return x.c(0) < x.l(1); });
+  put(kCloseAboveLow1, [](const Group& x) { return x.c(0) > x.l(1); });
+  put(kHighBelowClose1, [](const Group& x) { return x.h(0) < x.c(1); });
+  put(kHighAboveLow1, [](const Group& x) { return x.h(0) > x.l(1); });
+  put(kTopAboveHigh1, [](const Group& x) { return windows_max(x.c(0), x.o(0)) > x.h(1); });
+  put(kTopBelowLow1, [](const Group& x) { return windows_max(x.c(0), x.o(0)) < x.l(1); });
+  put(kLowAboveHigh1, [](const Group& x) { return x.l(0) > x.h(1); });
+  put(kHighBelowLow1, [](const Group& x) { return x.h(0) < x.l(1); });
+  put(kThrustClose, [](const Group& x) { return x.c(0) < x.c(1) + (x.o(1) - x.c(1)) / splat(2.0f); });
+}
+
+/// @brief Сравнения с барами `i - 2` … `i - 4`.
+void compare_earlier(const Group* g, std::size_t block, std::uint64_t* bits) noexcept {
+  const auto put = [&](Test test, auto predicate) { pack_test(bits, test, g, block, predicate); };
+  put(kOpenBelowClose2, [](const Group& x) { return x.o(0) < x.c(2); });
+  put(kOpenAboveClose2, [](const Group& x) { return x.o(0) > x.c(2); });
+  put(kCloseAboveClose2, [](const Group& x) { return x.c(0) > x.c(2); });
+  put(kCloseAboveHigh2, [](const Group& x) { return x.c(0) > x.h(2); });
+  put(kCloseBelowLow2, [](const Group& x) { return x.c(0) < x.l(2); });
+  put(kCloseAboveLow2, [](const Group& x) { return x.c(0) > x.l(2); });
+  put(kCloseBelowHigh2, [](const Group& x) { return x.c(0) < x.h(2); });
+  put(kHighAboveHigh2, [](const Group& x) { return x.h(0) > x.h(2); });
+  put(kHighBelowHigh2, [](const Group& x) { return x.h(0) < x.h(2); });
+  put(kLowBelowLow2, [](const Group& x) { return x.l(0) < x.l(2); });
+  put(kLowAboveLow2, [](const Group& x) { return x.l(0) > x.l(2); });
+  put(kCloseAboveOpen3, [](const Group& x) { return x.c(0) > x.o(3); });
+  put(kCloseBelowOpen3, [](const Group& x) { return x.c(0) < x.o(3); });
+  put(kCloseAboveClose3, [](const Group& x) { return x.c(0) > x.c(3); });
+  put(kHighAboveHigh3, [](const Group& x) { return x.h(0) > x.h(3); });
+  put(kHighBelowHigh3, [](const Group& x) { return x.h(0) < x.h(3); });
+  put(kLowBelowLow3, [](const Group& x) { return x.l(0) < x.l(3); });
+  put(kLowAboveLow3, [](const Group& x) { return x.l(0) > x.l(3); });
+  put(kCloseAboveClose4, [](const Group& x) { return x.c(0) > x.c(4); });
+  put(kCloseBelowClose4, [](const Group& x) { return x.c(0) < x.c(4); });
+}
+
+/**
+ * @brief Сравнения с процентами тела и свечи в `double`, как `PercentOfCandleLength` и `PercentOfBodySize`.
+ * @note Расширенные цены, разности и доли свечи группы считаются один раз для всех сравнений; маски копятся по
+ * группам и ужимаются в конце блока.
+ */
+void compare_percent(const Group* g, std::size_t block, std::uint64_t* bits) noexcept {
+  M4 found[kPercentTests][4];
+  for (std::size_t k = 0; k < 4; ++k) {
+    const Group& x = g[k];
+    const auto put = [&](Test test, M4 mask) { found[test - kDoji][k] = mask; };
+    const F4 narrow_o0 = x.o(0), narrow_c0 = x.c(0), narrow_o2 = x.o(2), narrow_c2 = x.c(2);
+    const D4 o0 = widen(narrow_o0), h0 = widen(x.h(0)), l0 = widen(x.l(0)), c0 = widen(narrow_c0);
+    const D4 o1 = widen(x.o(1)), h1 = widen(x.h(1)), l1 = widen(x.l(1)), c1 = widen(x.c(1));
+    const F4 candle = x.h(0) - x.l(0);
+    const F4 candle1 = x.h(1) - x.l(1);
+    const D4 wide_candle = widen(candle);
+    const D4 wide_body = widen(x.body);
+    const auto of_candle = [&](double value) { return wide_candle * splat(percent(value)); };
+    const D4 candle7 = of_candle(7), candle14 = of_candle(14), candle15 = of_candle(15);
+    const D4 upper = h0 - widen(windows_max(narrow_c0, narrow_o0));
+    const D4 lower = widen(windows_min(narrow_c0, narrow_o0)) - l0;
+    const D4 half = splat(0.5);
+
+    put(kDoji, wide_body <= of_candle(5));
+    put(kUpperSmall, upper < candle7);
+    put(kLowerSmall, lower < candle7);
+    put(kHammerWick, lower < of_candle(200));
+    put(kLongUpperWick, upper >= wide_body * splat(3.0));
+    put(kShortUpperWick, upper <= wide_body * splat(2.0));
+    put(kHighNearOpen, abs(h0 - o0) < candle7);
+    put(kLowNearOpen, abs(l0 - o0) < candle7);
+    put(kLongLegged, abs(lower - upper) < of_candle(10));
+
+    const D4 half_body1 = widen(abs(x.o(1) - x.c(1))) * half;
+    put(kDarkCloud, c0 < c1 - half_body1);
+    put(kPiercing, c0 > o1 - half_body1);
+    put(kHighNearHigh1, abs(h0 - h1) < candle7);
+    put(kLowNearLow1, abs(l0 - l1) < candle7);
+    const D4 close_gap = abs(c0 - c1);
+    put(kCloseNearClose1, close_gap < candle7);
+    const D4 open_gap = abs(o0 - o1);
+    put(kOpenNearOpen1, open_gap < candle7);
+    put(kOpenNearOpen1Tight, open_gap < of_candle(5));
+    put(kOpenNearOpen1Wide, open_gap < candle14);
+    put(kCandleNearCandle1, abs(wide_candle - widen(candle1)) < candle14);
+    const D4 quarter1 = widen(candle1) * splat(percent(25));
+    put(kDojiStarWicks, (upper <= quarter1) & (lower <= quarter1));
+    put(kOpenNearClose1, abs(o0 - c1) < of_candle(30));
+    put(kCloseNearLow1, abs(c0 - l1) < candle15);
+    put(kInNeckClose, (close_gap < candle15) | (widen(narrow_c0 - x.c(1)) < candle15));
+    put(kThrustGap, widen(x.l(1) - narrow_o0) > of_candle(10));
+
+    const D4 o2 = widen(narrow_o2);
+    const D4 half_body2 = widen(abs(narrow_o2 - narrow_c2)) * half;
+    put(kMorningClose, c0 > o2 - wide_body * half);
+    put(kAboveBearStar, c0 > o2 - half_body2);
+    put(kBelowBullStar, c0 < widen(narrow_c2) - half_body2);
+  }
+  for (std::size_t test = 0; test < kPercentTests; ++test) {
+    bits[kDoji + test] |= pack_bits(found[test][0], found[test][1], found[test][2], found[test][3]) << block;
+  }
+}
+
+/// @brief Все сравнения 64 баров окна: по 16 баров за шаг, четыре группы SSE2.
+void compare_word(const Window& w, std::uint64_t* bits) noexcept {
+  std::fill(bits, bits + kTestCount, std::uint64_t{0});
+  for (std::size_t block = 0; block < kWordBars; block += 16) {
+    const Group g[4] = {{w, block}, {w, block + 4}, {w, block + 8}, {w, block + 12}};
+    compare_bar(g, block, bits);
+    compare_previous(g, block, bits);
+    compare_earlier(g, block, bits);
+    compare_percent(g, block, bits);
+  }
+  if (w.trend == nullptr) {
+    bits[kUp] = ~std::uint64_t{0};
+    bits[kDown] = ~std::uint64_t{0};
+  }
+}
+
+/// @brief Слова сравнений текущих 64 баров и предыдущих; `back(t, k)` — сравнение на баре `i - k`.
+struct Tests {
+  std::uint64_t now[kTestCount];
+  std::uint64_t before[kTestCount];
+
+  std::uint64_t operator()(Test test) const noexcept { return now[test]; }
+  std::uint64_t back(Test test, unsigned k) const noexcept {
+    return now[test] << k | before[test] >> (kWordBars - k);
+  }
+};
+
+/**
+ * @brief Все модели 64 баров: слово модели `p` — `found[p - 1]`, бит `i` — бар `i`.
+ * @param previous Слова моделей предыдущих 64 баров: Three Inside/Outside и River Bottom читают модель бара `i - 1`.
+ */
+void find_patterns(const Tests& t, const std::uint64_t* previous, std::uint64_t* found) noexcept {
+  const auto put = [&](CandlePattern pattern, std::uint64_t bits) {
+    found[static_cast<std::size_t>(pattern) - 1] = bits;
+  };
+  const auto back_pattern = [&](CandlePattern pattern) {
+    const auto index = static_cast<std::size_t>(pattern) - 1;
+    return found[index] << 1 | previous[index] >> (kWordBars - 1);
+  };
+  const std::uint64_t up = t(kUp), down = t(kDown);
+  const std::uint64_t white = t(kWhite), white1 = t.back(kWhite, 1), white2 = t.back(kWhite, 2);
+  const std::uint64_t white3 = t.back(kWhite, 3), white4 = t.back(kWhite, 4);
+  const std::uint64_t black = t(kBlack), black1 = t.back(kBlack, 1), black2 = t.back(kBlack, 2);
+  const std::uint64_t black3 = t.back(kBlack, 3), black4 = t.back(kBlack, 4);
+  const std::uint64_t strong = t(kStrong), strong1 = t.back(kStrong, 1), strong2 = t.back(kStrong, 2);
+  const std::uint64_t strong3 = t.back(kStrong, 3), strong4 = t.back(kStrong, 4);
+  const std::uint64_t doji = t(kDoji), doji1 = t.back(kDoji, 1), doji2 = t.back(kDoji, 2);
+  const std::uint64_t upper_small = t(kUpperSmall), lower_small = t(kLowerSmall);
+
+  const std::uint64_t hammer_bar = t(kHammerBar) & t(kHammerWick) & upper_small;
+  put(CandlePattern::kHammer, down & hammer_bar);
+  put(CandlePattern::kHangingMan, up & hammer_bar);
+
+  const std::uint64_t bullish_engulfing_body = black1 & white & t(kCloseAboveOpen1) & t(kOpenBelowClose1);
+  const std::uint64_t bearish_engulfing_body = white1 & black & t(kOpenAboveClose1) & t(kCloseBelowOpen1);
+  const std::uint64_t outside = t(kHighAboveHigh1) & t(kLowBelowLow1);
+  put(CandlePattern::kBullishEngulfing, down & bullish_engulfing_body & outside);
+  put(CandlePattern::kBearishEngulfing, up & bearish_engulfing_body & outside);
+  put(CandlePattern::kBullishEngulfingBodyOnly, down & bullish_engulfing_body);
+  put(CandlePattern::kBearishEngulfingBodyOnly, up & bearish_engulfing_body);
+
+  put(CandlePattern::kDarkCloudCover, up & white1 & strong1 & black & t(kOpenAboveHigh1) & t(kDarkCloud));
+  put(CandlePattern::kPiercingLine, down & black1 & white & t(kOpenBelowLow1) & t(kPiercing) & strong1);
+
+  // Звёзды: большое тело два бара назад, маленькое или доджи между ними.
+  const std::uint64_t bear_star_base = down & black2 & strong2 & white & strong & t(kOpenBelowClose2);
+  const std::uint64_t bull_star_base = up & white2 & strong2 & black & strong & t(kOpenAboveClose2);
+  const std::uint64_t gap_below2 = t.back(kOpenBelowLow1, 1);  // o1 < l2
+  const std::uint64_t gap_above2 = t.back(kOpenAboveHigh1, 1); // o1 > h2
+  put(CandlePattern::kMorningStar,
+      bear_star_base & gap_below2 & t.back(kCloseBelowLow1, 1) & ~strong1 & t(kMorningClose));
+  put(CandlePattern::kEveningStar,
+      bull_star_base & gap_above2 & t.back(kCloseAboveLow1, 1) & ~strong1 & t(kBelowBullStar));
+  put(CandlePattern::kMorningDojiStar, bear_star_base & t.back(kHighBelowClose1, 1) & doji1 & t(kAboveBearStar));
+  put(CandlePattern::kEveningDojiStar, bull_star_base & gap_above2 & doji1);
+  put(CandlePattern::kBullishAbandonedBaby, bear_star_base & gap_below2 & doji1 & t(kAboveBearStar) &
+                                                t.back(kHighBelowLow1, 1) & t(kLowAboveHigh1));
+  put(CandlePattern::kBearishAbandonedBaby, bull_star_base & gap_above2 & doji1 & t(kBelowBullStar) &
+                                                t.back(kLowAboveHigh1, 1) & t(kHighBelowLow1));
+
+  const std::uint64_t star_shape = ~strong & t(kStarBar) & lower_small;
+  put(CandlePattern::kShootingStar, up & star_shape & t(kLongUpperWick));
+  put(CandlePattern::kInvertedHammer, down & star_shape & ~doji & t(kShortUpperWick));
+
+  // Харами: тело внутри тела предыдущего бара; бычья при открытии ниже закрытия сравнивает `>=`.
+  const std::uint64_t harami_base = strong1 & ~doji & ~strong;
+  const std::uint64_t inside_falling1 = (black & ~t(kOpenAboveOpen1) & ~t(kCloseBelowClose1)) |
+                                        (~black & ~t(kCloseAboveOpen1) & ~t(kOpenBelowClose1));
+  const std::uint64_t inside_rising_open = ~t(kOpenAboveClose1) & ~t(kCloseBelowOpen1);
+  const std::uint64_t inside_rising_close = ~t(kCloseAboveClose1) & ~t(kOpenBelowOpen1);
+  const auto harami = [&](std::uint64_t falling) {
+    return (black1 & inside_falling1) | (~black1 & ((falling & inside_rising_open) | (~falling & inside_rising_close)));
+  };
+  put(CandlePattern::kBearishHarami, up & harami_base & harami(black));
+  put(CandlePattern::kBullishHarami, down & harami_base & harami(~white));
+  const std::uint64_t cross_base = strong1 & doji;
+  const std::uint64_t cross_falling1 = black1 & t(kCloseBelowOpen1) & t(kCloseAboveClose1);
+  put(CandlePattern::kBearishHaramiCross,
+      up & cross_base & (cross_falling1 | (~black1 & ~t(kCloseAboveClose1) & ~t(kCloseBelowOpen1))));
+  put(CandlePattern::kBullishHaramiCross,
+      down & cross_base & (cross_falling1 | (~black1 & t(kCloseBelowClose1) & t(kCloseAboveOpen1))));
+
+  put(CandlePattern::kTweezerTop, up & t(kHighNearHigh1) & strong1 & ~strong);
+  put(CandlePattern::kTweezerBottom, down & t(kLowNearLow1) & strong1 & ~strong);
+  put(CandlePattern::kBearishBeltHoldLine, up & black & strong & t(kHighNearOpen));
+  put(CandlePattern::kBullishBeltHoldLine, down & white & strong & t(kLowNearOpen));
+  put(CandlePattern::kTwoCrows, up & white2 & strong2 & black1 & black & t.back(kCloseAboveClose1, 1) &
+                                    ~t(kOpenBelowOpen1) & ~t(kCloseAboveClose1) & t(kCloseAboveClose2));
+  put(CandlePattern::kThreeBlackCrows, up & black2 & black1 & black & t.back(kCloseBelowClose1, 1) &
+                                           t(kCloseBelowClose1) & ~t.back(kOpenAboveOpen1, 1) &
+                                           ~t.back(kOpenBelowClose1, 1) & ~t(kOpenAboveOpen1) &
+                                           ~t(kOpenBelowClose1));
+  put(CandlePattern::kBearishCounterattackLine, up & t(kCloseNearClose1) & white1 & strong1 & black & strong);
+  put(CandlePattern::kBullishCounterattackLine, down & t(kCloseNearClose1) & black1 & strong1 & white & strong);
+
+  // Подтверждение моделей предыдущего бара; их собственный тренд уже в их словах.
+  const std::uint64_t rises = down & white & t(kCloseAboveClose1);
+  const std::uint64_t falls = up & black & t(kCloseBelowClose1);
+  put(CandlePattern::kThreeInsideUp, rises & back_pattern(CandlePattern::kBullishHarami));
+  put(CandlePattern::kThreeOutsideUp, rises & back_pattern(CandlePattern::kBullishEngulfing));
+  put(CandlePattern::kThreeInsideDown, falls & back_pattern(CandlePattern::kBearishHarami));
+  put(CandlePattern::kThreeOutsideDown, falls & back_pattern(CandlePattern::kBearishEngulfing));
+
+  const std::uint64_t kick = upper_small & lower_small & t.back(kUpperSmall, 1) & t.back(kLowerSmall, 1) &
+                             strong1 & strong;
+  put(CandlePattern::kKicker, kick & black1 & white & t(kOpenAboveOpen1));
+  put(CandlePattern::kKicking, kick & white1 & black & t(kOpenBelowOpen1));
+
+  const std::uint64_t three_white = white & white1 & white2;
+  const std::uint64_t opens_in_body = ~t(kOpenAboveClose1) & ~t(kOpenBelowOpen1);
+  const std::uint64_t opens_in_body1 = ~t.back(kOpenAboveClose1, 1) & ~t.back(kOpenBelowOpen1, 1);
+  put(CandlePattern::kThreeWhiteSoldiers, down & three_white & opens_in_body & opens_in_body1 & upper_small &
+                                              t.back(kUpperSmall, 1) & t.back(kUpperSmall, 2));
+  put(CandlePattern::kAdvanceBlock,
+      up & three_white & opens_in_body & opens_in_body1 & t(kShrinks) & t.back(kShrinks, 1));
+  put(CandlePattern::kDeliberation, up & three_white & opens_in_body1 & strong1 & ~strong);
+  const std::uint64_t three_doji = doji & doji1 & doji2;
+  put(CandlePattern::kBearishTriStar, up & three_doji & t(kCloseBelowOpen1) & t.back(kOpenAboveClose1, 1));
+  put(CandlePattern::kBullishTriStar, down & three_doji & t(kCloseAboveOpen1) & t.back(kOpenBelowClose1, 1));
+  put(CandlePattern::kUniqueThreeRiverBottom, down & black2 & strong2 & back_pattern(CandlePattern::kHammer) &
+                                                  t(kLowAboveLow1) & t.back(kLowBelowLow1, 1) & white & ~strong &
+                                                  t(kOpenBelowOpen1) & t(kOpenBelowClose1));
+
+  // Модели доджи.
+  const std::uint64_t doji_star = doji & strong1 & t(kDojiStarWicks);
+  put(CandlePattern::kBearishDojiStar, up & doji_star & white1 & t(kCloseAboveHigh1));
+  put(CandlePattern::kBullishDojiStar, down & doji_star & black1 & t(kCloseBelowLow1));
+  const std::uint64_t dragonfly = doji & upper_small & t(kCandleStrong);
+  put(CandlePattern::kBearishDragonflyDoji, up & dragonfly);
+  put(CandlePattern::kBullishDragonflyDoji, down & dragonfly);
+  const std::uint64_t gravestone = doji & lower_small & t(kCandleStrong);
+  put(CandlePattern::kBearishGravestoneDoji, up & gravestone & white1 & t(kOpenAboveHigh1));
+  put(CandlePattern::kBullishGravestoneDoji, down & gravestone & black1 & t(kHighAboveLow1));
+  const std::uint64_t long_legged = doji & t(kCandleStrong) & t(kLongLegged);
+  put(CandlePattern::kBearishLongLeggedDoji, up & long_legged & t(kTopAboveHigh1));
+  put(CandlePattern::kBullishLongLeggedDoji, down & long_legged & t(kTopBelowLow1));
+
+  put(CandlePattern::kBearishSideBySideWhiteLines, down & white & white1 & black2 & t.back(kHighBelowLow1, 1) &
+                                                       t(kOpenNearOpen1Wide) & t(kCandleNearCandle1));
+  put(CandlePattern::kBullishSideBySideWhiteLines, up & three_white & t.back(kLowAboveHigh1, 1) &
+                                                       t(kCloseNearClose1) & t(kOpenNearOpen1) & t(kHighAboveHigh1));
+
+  // Три метода: большое тело четыре бара назад и три слабых бара внутри его диапазона.
+  const std::uint64_t three_weak = ~strong1 & ~strong2 & ~strong3 & strong4 & strong;
+  put(CandlePattern::kFallingThreeMethods,
+      down & three_weak & black4 & t.back(kAvgRises, 2) & t.back(kAvgRises, 1) & t.back(kHighBelowHigh1, 3) &
+          t.back(kHighBelowHigh2, 2) & t.back(kHighBelowHigh3, 1) & t.back(kLowAboveLow1, 3) &
+          t.back(kLowAboveLow2, 2) & t.back(kLowAboveLow3, 1) & black & t(kOpenNearClose1) & t(kCloseBelowClose4));
+  put(CandlePattern::kRisingThreeMethods,
+      up & three_weak & white4 & t.back(kAvgFalls, 2) & t.back(kAvgFalls, 1) & ~t.back(kHighAboveHigh1, 3) &
+          ~t.back(kHighAboveHigh2, 2) & ~t.back(kHighAboveHigh3, 1) & ~t.back(kLowBelowLow1, 3) &
+          ~t.back(kLowBelowLow2, 2) & ~t.back(kLowBelowLow3, 1) & white & t(kCloseAboveClose4));
+
+  const std::uint64_t separating = t(kOpenNearOpen1Tight) & (white1 ^ white);
+  put(CandlePattern::kBearishSeparatingLines, down & separating);
+  put(CandlePattern::kBullishSeparatingLines, up & separating);
+
+  // Разрывы после двух сильных баров.
+  const std::uint64_t gap_down = down & white & black1 & black2 & strong1 & strong2 & t.back(kHighBelowLow1, 1) &
+                                 t(kOpenAboveClose1) & t(kOpenBelowOpen1);
+  const std::uint64_t gap_up = up & black & white1 & white2 & strong1 & strong2 & t.back(kLowAboveHigh1, 1) &
+                               t(kOpenAboveOpen1) & t(kOpenBelowClose1);
+  put(CandlePattern::kDownsideTasukiGap, gap_down & t(kCloseAboveHigh1) & t(kCloseBelowLow2));
+  put(CandlePattern::kUpsideTasukiGap, gap_up & t(kCloseAboveHigh2) & t(kCloseBelowLow1));
+  put(CandlePattern::kBearishThreeLineStrike, down & white & black1 & black2 & black3 & strong1 & strong2 &
+                                                  strong3 & t(kOpenBelowClose1) & t(kCloseAboveOpen3));
+  put(CandlePattern::kBullishThreeLineStrike, up & black & white1 & white2 & white3 & strong1 & strong2 & strong3 &
+                                                  t(kOpenAboveClose1) & t(kCloseBelowOpen3));
+  put(CandlePattern::kDownsideGapThreeMethods, gap_down & t(kCloseAboveLow2));
+  put(CandlePattern::kUpsideGapThreeMethods, gap_up & t(kCloseBelowHigh2));
+
+  // Шея и вбивание: белый бар после чёрного.
+  const std::uint64_t neck = down & black1 & white;
+  put(CandlePattern::kOnNeck, neck & strong1 & t(kCloseNearLow1));
+  put(CandlePattern::kInNeck, neck & strong1 & t(kOpenBelowLow1) & ~t(kCloseBelowClose1) & t(kInNeckClose));
+  put(CandlePattern::kBearishThrusting,
+      neck & t(kOpenBelowLow1) & t(kThrustGap) & t(kCloseAboveClose1) & t(kThrustClose));
+
+  const std::uint64_t mat_base =
+      up & white & t(kOpenAboveClose1) & strong & t.back(kCloseBelowClose1, 1) & ~strong1 & ~strong2;
+  const std::uint64_t from3 = strong3 & white3;
+  const std::uint64_t from4 = ~from3 & strong4 & white4;
+  const std::uint64_t inside3 = ~t.back(kHighAboveHigh2, 1) & ~t.back(kLowBelowLow2, 1);
+  const std::uint64_t inside4 = ~t.back(kHighAboveHigh3, 1) & ~t.back(kLowBelowLow3, 1);
+  put(CandlePattern::kMatHold,
+      mat_base & ((from3 & t(kCloseAboveClose3) & t.back(kLowAboveHigh1, 2) & black2 & inside3) |
+                  (from4 & t(kCloseAboveClose4) & t.back(kLowAboveHigh1, 3) & black3 & inside4 & ~strong3 &
+                   ~t.back(kCloseAboveClose1, 2))));
+  put(CandlePattern::kDoji, doji);
+}
+
+/// @brief Транспонирование 64×64 бит на месте: бит `j` слова `k` переходит в бит `k` слова `j`.
+/// @note Обмен блоков половинного размера шесть раз; в SSE2 — по два слова за операцию.
+void transpose(std::uint64_t* words) noexcept {
+  std::uint64_t mask = 0x00000000FFFFFFFFULL;
+  for (unsigned width = 32; width != 0; width >>= 1, mask ^= mask << width) {
+#if SIERRA_CORE_HAS_SSE2
+    const __m128i lanes_mask = _mm_set1_epi64x(static_cast<long long>(mask));
+    const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(width));
+    if (width >= 2) {
+      for (unsigned base = 0; base < kWordBars; base += 2 * width) {
+        for (unsigned k = base; k < base + width; k += 2) {
+          auto* first = reinterpret_cast<__m128i*>(words + k);
+          auto* second = reinterpret_cast<__m128i*>(words + k + width);
+          const __m128i a = _mm_loadu_si128(first);
+          const __m128i b = _mm_loadu_si128(second);
+          const __m128i swap = _mm_and_si128(_mm_xor_si128(_mm_srl_epi64(a, shift), b), lanes_mask);
+          _mm_storeu_si128(first, _mm_xor_si128(a, _mm_sll_epi64(swap, shift)));
+          _mm_storeu_si128(second, _mm_xor_si128(b, swap));
+        }
+      }
+      continue;
+    }
+    // Соседние слова: пары (k, k + 1) двух регистров переставляются в (k, k + 2) и (k + 1, k + 3).
+    for (unsigned k = 0; k < kWordBars; k += 4) {
+      auto* first = reinterpret_cast<__m128i*>(words + k);
+      auto* second = reinterpret_cast<__m128i*>(words + k + 2);
+      const __m128i x = _mm_loadu_si128(first);
+      const __m128i y = _mm_loadu_si128(second);
+      __m128i even = _mm_unpacklo_epi64(x, y);
+      __m128i odd = _mm_unpackhi_epi64(x, y);
+      const __m128i swap = _mm_and_si128(_mm_xor_si128(_mm_srli_epi64(even, 1), odd), lanes_mask);
+      even = _mm_xor_si128(even, _mm_slli_epi64(swap, 1));
+      odd = _mm_xor_si128(odd, swap);
+      _mm_storeu_si128(first, _mm_unpacklo_epi64(even, odd));
+      _mm_storeu_si128(second, _mm_unpackhi_epi64(even, odd));
+    }
+#else
+    for (unsigned base = 0; base < kWordBars; base += 2 * width) {
+      for (unsigned k = base; k < base + width; ++k) {
+        const std::uint64_t swap = ((words[k] >> width) ^ words[k + width]) & mask;
+        words[k] ^= swap << width;
+        words[k + width] ^= swap;
+      }
+    }
+#endif
+  }
+}
+
+}  // namespace
+
+float candle_trend(const CandleSeries& bars, const CandlePatternSettings& settings, std::size_t index) noexcept {
+  const std::ptrdiff_t last = static_cast<std::ptrdiff_t>(index) - 1;
+  const auto length = static_cast<std::ptrdiff_t>(settings.price_range_bars);
+  float highest = -FLT_MAX;
+  float lowest = FLT_MAX;
+  for (std::ptrdiff_t source = last; source > last - length && source >= 0; --source) {
+    if (bars.high[source] > highest) {
+      highest = bars.high[source];
+    }
+    if (bars.low[source] < lowest) {
+      lowest = bars.low[source];
+    }
+  }
+  return TrendRegression(bars, settings).direction(last, static_cast<double>(highest) - static_cast<double>(lowest));
+}
+
+bool is_candle_pattern(const CandleSeries& bars, const float* trend, const CandlePatternSettings& settings,
+                       CandlePattern pattern, std::size_t index) noexcept {
+  return Reference(bars, trend, settings).find(pattern, static_cast<std::ptrdiff_t>(index));
+}
+
+CandlePatternEngine::CandlePatternEngine(const CandlePatternSettings& settings) : settings_(settings) {
+  if (settings_.trend_bars == 0 || settings_.price_range_bars == 0) {
+    throw std::invalid_argument("CandlePatternEngine trend and price range lengths must be positive");
+  }
+}
+
+/// @note Экстремумы окна — блоки ван Херка по `price_range_bars`: суффикс блока начала окна и префикс блока его
+/// конца, одно сравнение на бар. Равные значения уступают более позднему бару, как `>` в обратном обходе
+/// `sc.GetHighest`; NaN не проходит ни одно сравнение и пропускается, как там же. Регрессия считается вторым
+/// проходом по готовым размахам (`TrendRegression::directions`).
+void CandlePatternEngine::build_trend(const CandleSeries& bars) {
+  const std::size_t count = bars.count;
+  const std::size_t length = settings_.price_range_bars;
+  suffix_high_.resize(count);
+  suffix_low_.resize(count);
+  for (std::size_t begin = 0; begin < count; begin += length) {
+    float high = -FLT_MAX;
+    float low = FLT_MAX;
+    for (std::size_t i = (std::min)(count, begin + length); i-- > begin;) {
+      high = bars.high[i] > high ? bars.high[i] : high;
+      low = bars.low[i] < low ? bars.low[i] : low;
+      suffix_high_[i] = high;
+      suffix_low_[i] = low;
+    }
+  }
+  range_.resize(count);
+  float high = -FLT_MAX;
+  float low = FLT_MAX;
+  std::size_t block_left = 0;
+  for (std::size_t last = 0; last + 1 < count; ++last) {
+    if (block_left == 0) {
+      high = -FLT_MAX;
+      low = FLT_MAX;
+      block_left = length;
+    }
+    --block_left;
+    high = bars.high[last] >= high ? bars.high[last] : high;
+    low = bars.low[last] <= low ? bars.low[last] : low;
+    float highest = high;
+    float lowest = low;
+    if (last + 1 > length) {
+      const std::size_t first = last + 1 - length;
+      highest = suffix_high_[first] > high ? suffix_high_[first] : high;
+      lowest = suffix_low_[first] < low ? suffix_low_[first] : low;
+    }
+    range_[last] = static_cast<double>(highest) - static_cast<double>(lowest);
+  }
+  trend_.resize(count);
+  const TrendRegression regression(bars, settings_);
+  trend_[0] = regression.direction(-1, static_cast<double>(-FLT_MAX) - static_cast<double>(FLT_MAX));
+  regression.directions(range_.data(), count - 1, trend_.data() + 1);
+}
+
+void CandlePatternEngine::evaluate(const CandleSeries& bars) {
+  SIERRA_TRACE_SCOPE("core", "candle_patterns");
+  const std::size_t count = bars.count;
+  masks_.resize(count);
+  high_masks_.resize(count);
+  if (count == 0) {
+    return;
+  }
+  const float* trend = nullptr;
+  if (settings_.use_trend_detection) {
+    build_trend(bars);
+    trend = trend_.data();
+  }
+
+  const Reference reference(bars, trend, settings_);
+  PaddedWord padded;
+  Tests tests;
+  std::uint64_t found[kCandlePatternCount];
+  std::uint64_t previous[kCandlePatternCount] = {};
+  // Бары до нулевого читают бар 0: слова такого окна одинаковы, и предыдущее слово совпадает с текущим.
+  compare_word(padded.fill(bars, trend, -static_cast<std::ptrdiff_t>(kWordBars)), tests.now);
+  std::copy(tests.now, tests.now + kTestCount, tests.before);
+  find_patterns(tests, previous, found);
+  std::copy(found, found + kCandlePatternCount, previous);
+
+  for (std::size_t begin = 0; begin < count; begin += kWordBars) {
+    const std::size_t valid = (std::min)(kWordBars, count - begin);
+    std::copy(tests.now, tests.now + kTestCount, tests.before);
+    const Window window =
+        begin >= static_cast<std::size_t>(kLookback) && valid == kWordBars
+            ? Window{bars.open + begin,  bars.high + begin,     bars.low + begin,
+                     bars.close + begin, bars.ohlc_avg + begin, trend != nullptr ? trend + begin : nullptr}
+            : padded.fill(bars, trend, static_cast<std::ptrdiff_t>(begin));
+    compare_word(window, tests.now);
+    find_patterns(tests, previous, found);
+    std::copy(found, found + kCandlePatternCount, previous);
+
+    const std::uint64_t high = found[kCandleMaskPatterns];
+    for (std::size_t bit = 0; bit < valid; ++bit) {
+      high_masks_[begin + bit] = high >> bit & 1;
+    }
+    transpose(found);
+    std::copy(found, found + valid, masks_.data() + begin);
+
+    // NaN рядом с баром: нестрогие сравнения не равны отрицанию строгих, такие бары считает эталон.
+    std::uint64_t unordered_bars = tests(kNaN);
+    for (unsigned k = 1; k <= static_cast<unsigned>(kLookback); ++k) {
+      unordered_bars |= tests.back(kNaN, k);
+    }
+    unordered_bars &= valid == kWordBars ? ~std::uint64_t{0} : (std::uint64_t{1} << valid) - 1;
+    for (std::size_t bit = 0; unordered_bars != 0; ++bit, unordered_bars >>= 1) {
+      if ((unordered_bars & 1) == 0) {
+        continue;
+      }
+      const auto index = static_cast<std::ptrdiff_t>(begin + bit);
+      std::uint64_t mask[2] = {};
+      for (std::size_t number = 1; number <= kCandlePatternCount; ++number) {
+        const auto pattern = static_cast<CandlePattern>(number);
+        mask[candle_mask_word(pattern)] |= reference.find(pattern, index) ? candle_mask_bit(pattern) : 0;
+      }
+      masks_[begin + bit] = mask[0];
+      high_masks_[begin + bit] = mask[1];
+    }
+  }
+}
+
+bool CandlePatternEngine::contains(CandlePattern pattern, std::size_t index) const noexcept {
+  const auto number = static_cast<std::size_t>(pattern);
+  if (index >= masks_.size() || number == 0) {
+    return false;
+  }
+  const std::uint64_t mask = candle_mask_word(pattern) == 0 ? masks_[index] : high_masks_[index];
+  return (mask & candle_mask_bit(pattern)) != 0;
+}
+
+}  // namespace sierra::core
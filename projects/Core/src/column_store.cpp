@@ -0,0 +1,306 @@
+#include "sierra/core/column_store.hpp"
+
+#include "sierra/core/trace.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sierra::core {
+
+namespace {
+
+constexpr std::uint32_t kMagic = 0x4C434353;  // "SCCL"
+constexpr std::uint32_t kVersion = 1;
+constexpr std::uint64_t kHashMultiplier = 0x9e3779b97f4a7c15ULL;
+constexpr std::uint64_t kSourceMultiplier = 0xd6e8feb86659fd93ULL;
+
+/// @brief Заголовок файла столбца (64 байта); за ним блоки `{хеш истории, значения[kChunkBars]}`.
+struct FileHeader {
+  std::uint32_t magic = kMagic;
+  std::uint32_t version = kVersion;
+  std::uint32_t chunk_bars = static_cast<std::uint32_t>(ColumnStore::kChunkBars);
+  std::uint32_t reserved = 0;
+  std::uint64_t key_hash = 0;
+  char reserve[40] = {};
+};
+
+static_assert(sizeof(FileHeader) == 64, "FileHeader layout is part of the file format");
+
+constexpr std::size_t kRecordBytes = sizeof(std::uint64_t) + ColumnStore::kChunkBars * sizeof(float);
+
+std::uint64_t record_offset(std::size_t chunk) noexcept { return sizeof(FileHeader) + chunk * kRecordBytes; }
+
+std::uint64_t finalize(std::uint64_t hash) noexcept {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+/// @brief Шаг полосы хеша: обратим при фиксированном баре, поэтому изменение бара не может погаснуть дальше.
+/// @note Бар сворачивается в одно слово до цепочки умножений полосы: в цепочке одно умножение на бар.
+inline void mix(std::uint64_t& lane, std::int64_t time, float source) noexcept {
+  std::uint32_t bits;
+  std::memcpy(&bits, &source, sizeof(bits));
+  lane = (lane ^ (static_cast<std::uint64_t>(time) + bits * kSourceMultiplier)) * kHashMultiplier;
+}
+
+void fnv(std::uint64_t& hash, const void* data, std::size_t size) noexcept {
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3ULL;
+  }
+}
+
+/// @brief Файл, отображённый в память только для чтения; `data == nullptr`, если файла нет.
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+    file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                        nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) {
+      file_ = nullptr;
+      return;
+    }
+    LARGE_INTEGER length{};
+    GetFileSizeEx(file_, &length);
+    size_ = static_cast<std::size_t>(length.QuadPart);
+    if (size_ > 0) {
+      mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (mapping_ != nullptr) {
+        data_ = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+      }
+    }
+#else
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+      return;
+    }
+    struct stat info {};
+    if (::fstat(fd_, &info) == 0) {
+      size_ = static_cast<std::size_t>(info.st_size);
+    }
+    if (size_ > 0) {
+      void* view = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+      if (view != MAP_FAILED) {
+        data_ = view;
+        ::madvise(data_, size_, MADV_SEQUENTIAL);
+      }
+    }
+#endif
+  }
+
+  ~MappedFile() {
+#ifdef _WIN32
+    if (data_ != nullptr) {
+      UnmapViewOfFile(data_);
+    }
+    if (mapping_ != nullptr) {
+      CloseHandle(mapping_);
+    }
+    if (file_ != nullptr) {
+      CloseHandle(file_);
+    }
+#else
+    if (data_ != nullptr) {
+      ::munmap(data_, size_);
+    }
+    if (fd_ >= 0) {
+      ::close(fd_);
+    }
+#endif
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const unsigned char* data() const noexcept { return static_cast<const unsigned char*>(data_); }
+  std::size_t size() const noexcept { return data_ != nullptr ? size_ : 0; }
+
+ private:
+  void* data_ = nullptr;
+  std::size_t size_ = 0;
+#ifdef _WIN32
+  HANDLE file_ = nullptr;
+  HANDLE mapping_ = nullptr;
+#else
+  int fd_ = -1;
+#endif
+};
+
+/// @brief Время блока, запрошенное у графика в переиспользуемый буфер.
+struct BufferedTimes {
+  const ColumnStore::BarTimes& bar_times;
+  std::vector<std::int64_t>& scratch;
+
+  const std::int64_t* operator()(std::size_t first) const {
+    scratch.resize(ColumnStore::kChunkBars);
+    bar_times(first, ColumnStore::kChunkBars, scratch.data());
+    return scratch.data();
+  }
+};
+
+}  // namespace
+
+/// @note Четыре независимые полосы по барам `i % 4`, чтобы умножения шли параллельно.
+std::uint64_t hash_bars(const std::int64_t* times, const float* sources, std::size_t count,
+                        std::uint64_t seed) noexcept {
+  std::uint64_t lanes[4] = {seed, seed ^ 0x243f6a8885a308d3ULL, seed ^ 0x13198a2e03707344ULL,
+                            seed ^ 0xa4093822299f31d0ULL};
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    mix(lanes[0], times[i], sources[i]);
+    mix(lanes[1], times[i + 1], sources[i + 1]);
+    mix(lanes[2], times[i + 2], sources[i + 2]);
+    mix(lanes[3], times[i + 3], sources[i + 3]);
+  }
+  for (; i < count; ++i) {
+    mix(lanes[i & 3], times[i], sources[i]);
+  }
+  std::uint64_t hash = lanes[0];
+  for (int lane = 1; lane < 4; ++lane) {
+    hash = (hash ^ finalize(lanes[lane])) * kHashMultiplier;
+  }
+  return finalize(hash ^ count);
+}
+
+std::uint64_t persistent_hash(const ColumnKey& key) noexcept {
+  std::uint64_t hash = kBarHashSeed;
+  for (const std::string* text : {&key.symbol, &key.study}) {
+    const std::uint64_t length = text->size();
+    fnv(hash, &length, sizeof(length));
+    fnv(hash, text->data(), text->size());
+  }
+  fnv(hash, &key.bar_period_seconds, sizeof(key.bar_period_seconds));
+  for (const double parameter : key.parameters) {
+    fnv(hash, &parameter, sizeof(parameter));
+  }
+  fnv(hash, &key.version, sizeof(key.version));
+  return hash;
+}
+
+ColumnStore::ColumnStore(std::string path, std::uint64_t key_hash) : path_(std::move(path)), key_hash_(key_hash) {}
+
+std::size_t ColumnStore::load(const std::int64_t* times, const float* sources, std::size_t bars, float* output) {
+  return load_chunks([times](std::size_t first) { return times + first; }, sources, bars, output);
+}
+
+std::size_t ColumnStore::load(const BarTimes& bar_times, const float* sources, std::size_t bars, float* output,
+                              std::vector<std::int64_t>& scratch) {
+  return load_chunks(BufferedTimes{bar_times, scratch}, sources, bars, output);
+}
+
+template <typename ChunkTimes>
+std::size_t ColumnStore::load_chunks(const ChunkTimes& chunk_times, const float* sources, std::size_t bars,
+                                     float* output) {
+  SIERRA_TRACE_SCOPE("core", "ColumnStore::load");
+  hashes_.clear();
+  synced_ = false;
+  const MappedFile file(path_);
+  FileHeader header;
+  if (file.size() < sizeof(header)) {
+    return 0;
+  }
+  std::memcpy(&header, file.data(), sizeof(header));
+  if (header.magic != kMagic || header.version != kVersion || header.chunk_bars != kChunkBars ||
+      header.key_hash != key_hash_) {
+    return 0;
+  }
+  const std::size_t file_chunks = (file.size() - sizeof(header)) / kRecordBytes;
+  const std::size_t chunks = (std::min)(file_chunks, bars / kChunkBars);
+  std::uint64_t hash = kBarHashSeed;
+  for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+    const unsigned char* record = file.data() + record_offset(chunk);
+    const std::size_t first = chunk * kChunkBars;
+    hash = hash_bars(chunk_times(first), sources + first, kChunkBars, hash);
+    std::uint64_t stored;
+    std::memcpy(&stored, record, sizeof(stored));
+    if (stored != hash) {
+      break;  // бар блока изменён: этот и следующие блоки посчитаются заново
+    }
+    std::memcpy(output + first, record + sizeof(stored), kChunkBars * sizeof(float));
+    hashes_.push_back(hash);
+  }
+  synced_ = hashes_.size() == file_chunks && file.size() == record_offset(file_chunks);
+  return stored_bars();
+}
+
+std::size_t ColumnStore::store(const std::int64_t* times, const float* sources, const float* values,
+                               std::size_t bars) {
+  return store_chunks([times](std::size_t first) { return times + first; }, sources, values, bars);
+}
+
+std::size_t ColumnStore::store(const BarTimes& bar_times, const float* sources, const float* values, std::size_t bars,
+                               std::vector<std::int64_t>& scratch) {
+  return store_chunks(BufferedTimes{bar_times, scratch}, sources, values, bars);
+}
+
+template <typename ChunkTimes>
+std::size_t ColumnStore::store_chunks(const ChunkTimes& chunk_times, const float* sources, const float* values,
+                                      std::size_t bars) {
+  if (!needs_store(bars)) {
+    return stored_bars();
+  }
+  SIERRA_TRACE_SCOPE("core", "ColumnStore::store");
+  synced_ = false;
+  std::fstream out;
+  if (hashes_.empty()) {
+    out.open(path_, std::ios::binary | std::ios::out | std::ios::trunc);
+    FileHeader header;
+    header.key_hash = key_hash_;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  } else {
+    // Лишние блоки — от изменённой истории или другой длины графика.
+    std::filesystem::resize_file(path_, record_offset(hashes_.size()));
+    out.open(path_, std::ios::binary | std::ios::in | std::ios::out);
+    out.seekp(static_cast<std::streamoff>(record_offset(hashes_.size())));
+  }
+  if (!out) {
+    throw std::runtime_error("ColumnStore: cannot open " + path_);
+  }
+  std::uint64_t hash = hashes_.empty() ? kBarHashSeed : hashes_.back();
+  for (std::size_t chunk = hashes_.size(); chunk < bars / kChunkBars; ++chunk) {
+    const std::size_t first = chunk * kChunkBars;
+    hash = hash_bars(chunk_times(first), sources + first, kChunkBars, hash);
+    out.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+    out.write(reinterpret_cast<const char*>(values + first), kChunkBars * sizeof(float));
+    if (!out) {
+      throw std::runtime_error("ColumnStore: write failed for " + path_);
+    }
+    hashes_.push_back(hash);
+  }
+  out.flush();
+  if (!out) {
+    throw std::runtime_error("ColumnStore: write failed for " + path_);
+  }
+  synced_ = true;
+  return stored_bars();
+}
+
+void ColumnStore::invalidate(std::size_t bar) noexcept {
+  if (bar < stored_bars()) {
+    hashes_.resize(bar / kChunkBars);
+    synced_ = false;
+  }
+}
+
+}  // namespace sierra::core
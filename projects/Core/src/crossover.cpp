@@ -0,0 +1,213 @@
+#include "sierra/core/crossover.hpp"
+
+#include "sierra/core/trace.hpp"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define SIERRA_CORE_HAS_SSE2 1
+#include <emmintrin.h>
+#else
+#define SIERRA_CORE_HAS_SSE2 0
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace sierra::core {
+
+namespace {
+
+constexpr std::size_t kWordBars = 64;
+
+inline unsigned lowest_bit(std::uint64_t word) noexcept {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward64(&index, word);
+  return static_cast<unsigned>(index);
+#else
+  return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+}
+
+inline std::size_t popcount(std::uint64_t word) noexcept {
+#if defined(_MSC_VER)
+  // Без инструкции POPCNT, чтобы не требовать её от процессора.
+  word -= (word >> 1) & 0x5555555555555555ULL;
+  word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+  word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+  return static_cast<std::size_t>((word * 0x0101010101010101ULL) >> 56);
+#else
+  return static_cast<std::size_t>(__builtin_popcountll(word));
+#endif
+}
+
+/// @brief Второй ряд: столбец или уровень, одинаковый на всех барах.
+struct Column {
+  const float* values;
+  float at(std::size_t index) const noexcept { return values[index]; }
+};
+
+struct Level {
+  float value;
+  float at(std::size_t) const noexcept { return value; }
+};
+
+/// @brief Дословно `sc.CrossOver`: поиск неравных значений назад не дальше `kCrossLookback` баров и не раньше бара 0.
+template <typename Second>
+CrossDirection cross_at(const float* first, Second second, std::size_t index) noexcept {
+  std::size_t prior = index == 0 ? 0 : index - 1;
+  float x1 = first[prior];
+  float y1 = second.at(prior);
+  const float x2 = first[index];
+  const float y2 = second.at(index);
+  if (x2 != y2) {
+    while (x1 == y1 && prior > 0 && prior + kCrossLookback > index) {
+      --prior;
+      x1 = first[prior];
+      y1 = second.at(prior);
+    }
+  }
+  if (x1 > y1 && x2 < y2) {
+    return CrossDirection::kFromTop;
+  }
+  if (x1 < y1 && x2 > y2) {
+    return CrossDirection::kFromBottom;
+  }
+  return CrossDirection::kNone;
+}
+
+/// @brief Сравнения баров одного слова; у NaN все три бита нулевые.
+struct WordCompare {
+  std::uint64_t greater = 0;
+  std::uint64_t less = 0;
+  std::uint64_t equal = 0;
+};
+
+#if SIERRA_CORE_HAS_SSE2
+inline __m128 load_second(const Column& second, std::size_t index) noexcept {
+  return _mm_loadu_ps(second.values + index);
+}
+
+inline __m128 load_second(const Level& second, std::size_t) noexcept { return _mm_set1_ps(second.value); }
+
+/// @brief 16 бит из четырёх масок сравнения по четыре бара (насыщающая упаковка сохраняет 0 и -1).
+inline std::uint64_t pack_bits(__m128 a, __m128 b, __m128 c, __m128 d) noexcept {
+  const __m128i low = _mm_packs_epi32(_mm_castps_si128(a), _mm_castps_si128(b));
+  const __m128i high = _mm_packs_epi32(_mm_castps_si128(c), _mm_castps_si128(d));
+  return static_cast<std::uint64_t>(_mm_movemask_epi8(_mm_packs_epi16(low, high)));
+}
+#endif
+
+template <typename Second>
+WordCompare compare_word(const float* first, Second second, std::size_t begin, std::size_t bars) noexcept {
+  WordCompare word;
+  std::size_t i = 0;
+#if SIERRA_CORE_HAS_SSE2
+  // 16 баров за шаг: четыре маски сравнения ужимаются до байтов, и один movemask даёт 16 бит.
+  for (; i + 16 <= bars; i += 16) {
+    __m128 x[4];
+    __m128 y[4];
+    for (std::size_t k = 0; k < 4; ++k) {
+      x[k] = _mm_loadu_ps(first + begin + i + 4 * k);
+      y[k] = load_second(second, begin + i + 4 * k);
+    }
+    word.greater |= pack_bits(_mm_cmpgt_ps(x[0], y[0]), _mm_cmpgt_ps(x[1], y[1]), _mm_cmpgt_ps(x[2], y[2]),
+                              _mm_cmpgt_ps(x[3], y[3])) << i;
+    word.less |= pack_bits(_mm_cmplt_ps(x[0], y[0]), _mm_cmplt_ps(x[1], y[1]), _mm_cmplt_ps(x[2], y[2]),
+                           _mm_cmplt_ps(x[3], y[3])) << i;
+    word.equal |= pack_bits(_mm_cmpeq_ps(x[0], y[0]), _mm_cmpeq_ps(x[1], y[1]), _mm_cmpeq_ps(x[2], y[2]),
+                            _mm_cmpeq_ps(x[3], y[3])) << i;
+  }
+#endif
+  for (; i < bars; ++i) {
+    const float x = first[begin + i];
+    const float y = second.at(begin + i);
+    word.greater |= static_cast<std::uint64_t>(x > y) << i;
+    word.less |= static_cast<std::uint64_t>(x < y) << i;
+    word.equal |= static_cast<std::uint64_t>(x == y) << i;
+  }
+  return word;
+}
+
+/**
+ * @brief Бит `i` — «ближайший бар до `i` с неравными значениями дал `state`» без ограничения глубины.
+ * @param carry То же для первого бара слова (состояние последнего бара предыдущего слова).
+ * @note Рекуррентность `s[i] = state[i] | (equal[i] & s[i - 1])` — цепочка переносов сложения `state + (state |
+ * equal)`: бит `state` порождает перенос, бит `equal` его пропускает, NaN и противоположное сравнение гасят.
+ */
+inline std::uint64_t previous_state(std::uint64_t state, std::uint64_t equal, std::uint64_t carry) noexcept {
+  const std::uint64_t propagate = state | equal;
+  return (state + propagate + carry) ^ state ^ propagate;
+}
+
+template <typename Second>
+void cross_masks(const float* first, Second second, std::size_t count, CrossMasks& masks) {
+  const std::size_t words = (count + kWordBars - 1) / kWordBars;
+  masks.from_bottom.assign(words, 0);
+  masks.from_top.assign(words, 0);
+  std::uint64_t below = 0;  // ближайший неравный бар до слова: первый ряд ниже
+  std::uint64_t above = 0;
+  std::uint64_t equal_before = 0;  // последний бар предыдущего слова: ряды равны
+  for (std::size_t w = 0; w < words; ++w) {
+    const std::size_t begin = w * kWordBars;
+    const WordCompare word = compare_word(first, second, begin, (std::min)(kWordBars, count - begin));
+    const std::uint64_t was_below = previous_state(word.less, word.equal, below);
+    const std::uint64_t was_above = previous_state(word.greater, word.equal, above);
+    std::uint64_t from_bottom = word.greater & was_below;
+    std::uint64_t from_top = word.less & was_above;
+
+    // События после равного бара: неравный бар мог оказаться дальше, чем смотрит sc.CrossOver.
+    std::uint64_t after_equal = (from_bottom | from_top) & ((word.equal << 1) | equal_before);
+    while (after_equal != 0) {
+      const unsigned bit = lowest_bit(after_equal);
+      after_equal &= after_equal - 1;
+      if (cross_at(first, second, begin + bit) == CrossDirection::kNone) {
+        from_bottom &= ~(std::uint64_t{1} << bit);
+        from_top &= ~(std::uint64_t{1} << bit);
+      }
+    }
+    masks.from_bottom[w] = from_bottom;
+    masks.from_top[w] = from_top;
+
+    below = (word.less | (word.equal & was_below)) >> 63;
+    above = (word.greater | (word.equal & was_above)) >> 63;
+    equal_before = word.equal >> 63;
+  }
+}
+
+}  // namespace
+
+CrossDirection cross_over(const float* first, const float* second, std::size_t index) noexcept {
+  return cross_at(first, Column{second}, index);
+}
+
+void crossover_masks(const float* first, const float* second, std::size_t count, CrossMasks& masks) {
+  SIERRA_TRACE_SCOPE("core", "crossover_masks");
+  cross_masks(first, Column{second}, count, masks);
+}
+
+void threshold_masks(const float* values, float level, std::size_t count, CrossMasks& masks) {
+  SIERRA_TRACE_SCOPE("core", "threshold_masks");
+  cross_masks(values, Level{level}, count, masks);
+}
+
+std::size_t count_events(const std::vector<std::uint64_t>& mask) noexcept {
+  std::size_t events = 0;
+  for (const std::uint64_t word : mask) {
+    events += popcount(word);
+  }
+  return events;
+}
+
+void extract_events(const std::vector<std::uint64_t>& mask, std::vector<std::size_t>& indices) {
+  indices.reserve(indices.size() + count_events(mask));
+  for (std::size_t w = 0; w < mask.size(); ++w) {
+    for (std::uint64_t word = mask[w]; word != 0; word &= word - 1) {
+      indices.push_back(w * kWordBars + lowest_bit(word));
+    }
+  }
+}
+
+}  // namespace sierra::core
@@ -0,0 +1,134 @@
+#include "sierra/core/cumulative_delta.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace sierra::core {
+
+CumulativeDeltaEngine::CumulativeDeltaEngine(CumulativeDeltaOptions options) : options_(options) {}
+
+/// @note Открытие бара совпадает с ACSIL: `Open` равен закрытию предыдущего бара либо 0 после сброса.
+void CumulativeDeltaEngine::start_bar(bool new_session) {
+  const bool count_reset =
+      options_.reset_bar_count != 0 && bars_since_reset_ >= options_.reset_bar_count;
+  if (bars_.empty() || (new_session && options_.reset_at_session) || count_reset) {
+    cumulative_ = 0.0;
+    bars_since_reset_ = 0;
+  }
+  ++bars_since_reset_;
+
+  checkpoint_ = Checkpoint{cumulative_, last_price_, last_direction_, bars_since_reset_};
+  bars_.push_back(DeltaBar{cumulative_, cumulative_, cumulative_, cumulative_});
+  bar_has_trades_ = false;
+}
+
+/// @note Как и в ACSIL, High/Low строятся только по значениям после сделок, а Open зажимается в их диапазон.
+void CumulativeDeltaEngine::add_trade(const TradeRecord& trade) {
+  if (bars_.empty()) {
+    throw std::logic_error("CumulativeDeltaEngine::start_bar must be called before add_trade");
+  }
+
+  cumulative_ += contribution(trade);
+  DeltaBar& bar = bars_.back();
+  if (bar_has_trades_) {
+    bar.high = (std::max)(bar.high, cumulative_);
+    bar.low = (std::min)(bar.low, cumulative_);
+  } else {
+    bar.high = cumulative_;
+    bar.low = cumulative_;
+    bar_has_trades_ = true;
+  }
+  bar.close = cumulative_;
+  bar.open = (std::min)((std::max)(checkpoint_.base, bar.low), bar.high);
+}
+
+void CumulativeDeltaEngine::rollback_last_bar() {
+  if (bars_.empty()) {
+    return;
+  }
+  cumulative_ = checkpoint_.base;
+  last_price_ = checkpoint_.last_price;
+  last_direction_ = checkpoint_.last_direction;
+  bars_since_reset_ = checkpoint_.bars_since_reset;
+  bars_.back() = DeltaBar{cumulative_, cumulative_, cumulative_, cumulative_};
+  bar_has_trades_ = false;
+}
+
+void CumulativeDeltaEngine::reset() {
+  bars_.clear();
+  checkpoint_ = Checkpoint{};
+  cumulative_ = 0.0;
+  last_price_ = 0.0f;
+  last_direction_ = 0;
+  bars_since_reset_ = 0;
+  bar_has_trades_ = false;
+}
+
+void CumulativeDeltaEngine::save(SnapshotWriter& writer) const {
+  writer.put(kSnapshotVersion);
+  writer.put(options_.source);
+  writer.put(options_.reset_at_session);
+  writer.put<std::uint64_t>(options_.reset_bar_count);
+  writer.put_vector(bars_);
+  writer.put(checkpoint_);
+  writer.put(cumulative_);
+  writer.put(last_price_);
+  writer.put(last_direction_);
+  writer.put<std::uint64_t>(bars_since_reset_);
+  writer.put(bar_has_trades_);
+}
+
+bool CumulativeDeltaEngine::restore(SnapshotReader& reader) {
+  if (reader.get<std::uint32_t>() != kSnapshotVersion || reader.get<DeltaSource>() != options_.source ||
+      reader.get<bool>() != options_.reset_at_session ||
+      reader.get<std::uint64_t>() != options_.reset_bar_count) {
+    return false;
+  }
+  std::vector<DeltaBar> bars;
+  reader.get_vector(bars);
+  const auto checkpoint = reader.get<Checkpoint>();
+  const auto cumulative = reader.get<double>();
+  const auto last_price = reader.get<float>();
+  const auto last_direction = reader.get<int>();
+  const auto bars_since_reset = reader.get<std::uint64_t>();
+  const auto bar_has_trades = reader.get<bool>();
+  bars_ = std::move(bars);
+  checkpoint_ = checkpoint;
+  cumulative_ = cumulative;
+  last_price_ = last_price;
+  last_direction_ = last_direction;
+  bars_since_reset_ = static_cast<std::size_t>(bars_since_reset);
+  bar_has_trades_ = bar_has_trades;
+  return true;
+}
+
+/// @note Для тикового объёма направление сделки без изменения цены наследуется от предыдущей (zero-tick rule).
+double CumulativeDeltaEngine::contribution(const TradeRecord& trade) {
+  switch (options_.source) {
+    case DeltaSource::kVolume:
+      if (trade.side == TradeSide::kAsk) {
+        return static_cast<double>(trade.volume);
+      }
+      return trade.side == TradeSide::kBid ? -static_cast<double>(trade.volume) : 0.0;
+    case DeltaSource::kTrades:
+      if (trade.side == TradeSide::kAsk) {
+        return 1.0;
+      }
+      return trade.side == TradeSide::kBid ? -1.0 : 0.0;
+    case DeltaSource::kTickVolume: {
+      if (last_price_ != 0.0f) {
+        if (trade.price > last_price_) {
+          last_direction_ = 1;
+        } else if (trade.price < last_price_) {
+          last_direction_ = -1;
+        }
+      }
+      last_price_ = trade.price;
+      return static_cast<double>(last_direction_) * trade.volume;
+    }
+  }
+  return 0.0;
+}
+
+}  // namespace sierra::core
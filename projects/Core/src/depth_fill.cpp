@@ -0,0 +1,140 @@
+#include "sierra/core/depth_fill.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace sierra::core {
+
+DepthBook::DepthBook(double tick_size) : tick_size_(tick_size) {
+  if (!(tick_size > 0.0)) {
+    throw std::invalid_argument("DepthBook tick size must be positive");
+  }
+}
+
+void DepthBook::add_bar(std::int64_t start_time, int lowest_tick_index,
+                        const std::vector<DepthLevel>& levels) {
+  Bar bar;
+  bar.start_time = start_time;
+  bar.lowest_tick_index = lowest_tick_index;
+  bar.offset = static_cast<std::uint32_t>(levels_.size());
+  bar.count = static_cast<std::uint32_t>(levels.size());
+  bars_.push_back(bar);
+  levels_.insert(levels_.end(), levels.begin(), levels.end());
+}
+
+int DepthBook::tick_index(double price) const noexcept {
+  return static_cast<int>(std::lround(price / tick_size_));
+}
+
+std::size_t DepthBook::locate(std::int64_t time, std::size_t hint) const noexcept {
+  if (bars_.empty()) {
+    return 0;
+  }
+  std::size_t index = (std::min)(hint, bars_.size() - 1);
+  while (index > 0 && bars_[index].start_time > time) {
+    --index;
+  }
+  while (index + 1 < bars_.size() && bars_[index + 1].start_time <= time) {
+    ++index;
+  }
+  return index;
+}
+
+const DepthLevel* DepthBook::level(std::size_t bar, double price) const noexcept {
+  if (bar >= bars_.size()) {
+    return nullptr;
+  }
+  const Bar& entry = bars_[bar];
+  const int offset = tick_index(price) - entry.lowest_tick_index;
+  if (offset < 0 || static_cast<std::uint32_t>(offset) >= entry.count) {
+    return nullptr;
+  }
+  return &levels_[entry.offset + static_cast<std::uint32_t>(offset)];
+}
+
+DepthFillModel::DepthFillModel(const DepthBook& book, DepthFillOptions options)
+    : book_(book), options_(options) {}
+
+double DepthFillModel::initial_queue(OrderSide side, double price, std::size_t bar) const noexcept {
+  const DepthLevel* level = book_.level(bar, price);
+  if (level == nullptr) {
+    return 0.0;
+  }
+  const std::uint32_t displayed = side == OrderSide::kBuy ? level->last_bid : level->last_ask;
+  return options_.queue_fraction_ahead * displayed;
+}
+
+/// @note Сделка «сквозь» цену заявки исполняет остаток целиком; сделка на цене заявки сначала съедает очередь, излишек идёт в исполнение.
+int DepthFillModel::limit_fill(OrderSide side, double price, int remaining, double& queue_ahead,
+                               const ScidRecord& tick, std::size_t bar) const noexcept {
+  const bool buy = side == OrderSide::kBuy;
+  const double half_tick = book_.tick_size() * 0.5;
+
+  if (!tick.is_tick()) {
+    const bool through = buy ? tick.low < price - half_tick : tick.high > price + half_tick;
+    return through ? remaining : 0;
+  }
+
+  const double last = tick.close;
+  if (buy ? last < price - half_tick : last > price + half_tick) {
+    return remaining;
+  }
+
+  // Видимый объём уровня сократился — часть очереди перед нами отменилась.
+  if (const DepthLevel* level = book_.level(bar, price)) {
+    const std::uint32_t displayed = buy ? level->last_bid : level->last_ask;
+    queue_ahead = (std::min)(queue_ahead, static_cast<double>(displayed));
+  }
+
+  if (std::fabs(last - price) > half_tick) {
+    return 0;
+  }
+  // Нашу сторону исполняют агрессоры противоположной: продажи по Bid для покупки и наоборот.
+  // Без разбивки по сторонам считаем, что весь объём сделки пришёлся на нашу сторону.
+  const bool classified = tick.bid_volume != 0 || tick.ask_volume != 0;
+  const std::uint32_t traded =
+      classified ? (buy ? tick.bid_volume : tick.ask_volume) : tick.total_volume;
+  queue_ahead -= static_cast<double>(traded);
+  if (queue_ahead >= 0.0) {
+    return 0;
+  }
+  const int filled = (std::min)(remaining, static_cast<int>(std::floor(-queue_ahead)));
+  queue_ahead = 0.0;
+  return filled;
+}
+
+/// @note Если на лучшем уровне q контрактов, заявка Q проходит L = ceil(Q / q) уровней; средний сдвиг в тиках = (q·(L−1)(L−2)/2 + (L−1)·(Q − (L−1)·q)) / Q.
+double DepthFillModel::market_price(OrderSide side, int quantity, const ScidRecord& tick,
+                                    std::size_t bar) const noexcept {
+  const bool buy = side == OrderSide::kBuy;
+  double touch = tick.close;
+  if (tick.is_tick()) {
+    const float quote = buy ? tick.high : tick.low;
+    if (quote > 0.0f) {
+      touch = quote;
+    }
+  }
+  if (quantity <= 1) {
+    return touch;
+  }
+
+  double per_level = options_.default_level_quantity;
+  if (const DepthLevel* level = book_.level(bar, touch)) {
+    const std::uint32_t displayed = buy ? level->last_ask : level->last_bid;
+    if (displayed > 0) {
+      per_level = displayed;
+    }
+  }
+  per_level = (std::max)(per_level, 1.0);
+
+  const double total = quantity;
+  const double levels = std::ceil(total / per_level);
+  const double full = levels - 1.0;
+  const double offset_ticks =
+      (per_level * full * (full - 1.0) / 2.0 + full * (total - full * per_level)) / total;
+  const double shift = offset_ticks * book_.tick_size();
+  return buy ? touch + shift : touch - shift;
+}
+
+}  // namespace sierra::core
@@ -0,0 +1,68 @@
+#include "sierra/core/epoch_domain.hpp"
+
+#include <thread>
+
+namespace sierra::core {
+
+EpochDomain::~EpochDomain() {
+  for (const Retired& retired : retired_) {
+    retired.deleter(retired.object);
+  }
+}
+
+/// @note Эпоха в слоте публикуется до того, как читатель загрузит защищаемый указатель (seq_cst): писатель,
+/// который после замены указателя увидел слот свободным, уже не может встретить этого читателя со старым указателем.
+EpochDomain::Guard EpochDomain::pin() noexcept {
+  for (;;) {
+    for (std::size_t i = 0; i < kMaxReaders; ++i) {
+      std::uint64_t expected = kIdle;
+      if (slots_[i].epoch.load(std::memory_order_relaxed) == kIdle &&
+          slots_[i].epoch.compare_exchange_strong(expected, epoch_.load())) {
+        return Guard(this, i);
+      }
+    }
+    std::this_thread::yield();
+  }
+}
+
+void EpochDomain::retire(void* object, void (*deleter)(void*)) {
+  // Читатели, закрепившие эпоху не меньше новой, загрузили указатель уже после замены.
+  const std::uint64_t epoch = epoch_.fetch_add(1) + 1;
+  std::lock_guard<std::mutex> lock(mutex_);
+  retired_.push_back(Retired{object, deleter, epoch});
+  reclaim_locked();
+}
+
+std::size_t EpochDomain::reclaim() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return reclaim_locked();
+}
+
+std::size_t EpochDomain::pending() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return retired_.size();
+}
+
+std::size_t EpochDomain::reclaim_locked() {
+  std::uint64_t oldest = UINT64_MAX;
+  for (const Slot& slot : slots_) {
+    const std::uint64_t epoch = slot.epoch.load();
+    if (epoch != kIdle && epoch < oldest) {
+      oldest = epoch;
+    }
+  }
+  std::size_t freed = 0;
+  for (std::size_t i = 0; i < retired_.size();) {
+    if (retired_[i].epoch <= oldest) {
+      retired_[i].deleter(retired_[i].object);
+      retired_[i] = retired_.back();
+      retired_.pop_back();
+      ++freed;
+    } else {
+      ++i;
+    }
+  }
+  return freed;
+}
+
+}  // namespace sierra::core
@@ -0,0 +1,65 @@
+#include "sierra/core/latency_histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sierra::core {
+
+void LatencyHistogram::merge(const LatencyHistogram& other) noexcept {
+  for (std::size_t i = 0; i < kBucketCount; ++i) {
+    counts_[i] += other.counts_[i];
+  }
+  count_ += other.count_;
+  sum_ += other.sum_;
+  min_ = (std::min)(min_, other.min_);
+  max_ = (std::max)(max_, other.max_);
+}
+
+void LatencyHistogram::reset() noexcept {
+  counts_.fill(0);
+  count_ = 0;
+  sum_ = 0;
+  min_ = UINT64_MAX;
+  max_ = 0;
+}
+
+/// @note Ранг считается как `ceil(q * count)`, поэтому `q = 0` и `q = 1` дают точные минимум и максимум.
+std::uint64_t LatencyHistogram::quantile(double q) const noexcept {
+  if (count_ == 0) {
+    return 0;
+  }
+  if (!(q > 0.0)) {
+    return min_;
+  }
+  if (q >= 1.0) {
+    return max_;
+  }
+  const auto rank = (std::max)(std::uint64_t{1},
+                               static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count_))));
+  std::uint64_t seen = 0;
+  for (std::size_t i = 0; i < kBucketCount; ++i) {
+    seen += counts_[i];
+    if (seen >= rank) {
+      const std::uint64_t middle = bucket_lower(i) + bucket_width(i) / 2;
+      return (std::min)((std::max)(middle, min_), max_);
+    }
+  }
+  return max_;
+}
+
+std::uint64_t LatencyHistogram::bucket_lower(std::size_t bucket) noexcept {
+  if (bucket < 2 * kSubBuckets) {
+    return bucket;
+  }
+  const auto shift = static_cast<int>(bucket / kSubBuckets) - 1;
+  return (bucket % kSubBuckets + kSubBuckets) << shift;
+}
+
+std::uint64_t LatencyHistogram::bucket_width(std::size_t bucket) noexcept {
+  if (bucket < 2 * kSubBuckets) {
+    return 1;
+  }
+  return std::uint64_t{1} << (static_cast<int>(bucket / kSubBuckets) - 1);
+}
+
+}  // namespace sierra::core
@@ -0,0 +1,107 @@
+#include "sierra/core/monte_carlo.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace sierra::core {
+
+namespace {
+
+constexpr std::uint64_t kGoldenGamma = 0x9E3779B97F4A7C15ull;
+/// Пути, которые считаются одновременно в массивах кривых.
+constexpr std::size_t kLanes = 8;
+/// Путей в одной задаче пула; фиксировано, чтобы разбиение не зависело от числа потоков.
+constexpr std::size_t kPathsPerTask = 1024;
+
+std::uint64_t mix64(std::uint64_t z) noexcept {
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+/// @brief Равномерный индекс в `[0, n)` из старших 32 бит (умножение со сдвигом вместо деления).
+std::size_t bounded(std::uint64_t random, std::uint64_t n) noexcept {
+  return static_cast<std::size_t>(((random >> 32) * n) >> 32);
+}
+
+/// @brief Моделирует пути `[first, last)` и накапливает их в отчёте.
+void simulate(const std::vector<double>& profits, const MonteCarloOptions& options, std::size_t draws,
+              std::size_t first, std::size_t last, MonteCarloReport& report) {
+  const double* trade = profits.data();
+  const std::uint64_t n = profits.size();
+  const std::uint64_t seed = mix64(options.seed);
+
+  for (std::size_t block = first; block < last; block += kLanes) {
+    const std::size_t lanes = (std::min)(kLanes, last - block);
+    std::uint64_t stream[kLanes];
+    double equity[kLanes] = {};
+    double peak[kLanes] = {};
+    double drawdown[kLanes] = {};
+    double low[kLanes] = {};
+    for (std::size_t l = 0; l < kLanes; ++l) {
+      stream[l] = seed ^ mix64(block + l);
+    }
+
+    for (std::size_t j = 0; j < draws; ++j) {
+      for (std::size_t l = 0; l < kLanes; ++l) {
+        equity[l] += trade[bounded(counter_random(stream[l], j), n)];
+        peak[l] = (std::max)(peak[l], equity[l]);
+        drawdown[l] = (std::min)(drawdown[l], equity[l] - peak[l]);
+        low[l] = (std::min)(low[l], equity[l]);
+      }
+    }
+
+    for (std::size_t l = 0; l < lanes; ++l) {
+      report.max_drawdown.add(drawdown[l]);
+      report.final_profit.add(equity[l]);
+      if (options.starting_capital + low[l] <= options.ruin_capital) {
+        ++report.ruined_paths;
+      }
+    }
+    report.paths += lanes;
+  }
+}
+
+}  // namespace
+
+std::uint64_t counter_random(std::uint64_t stream, std::uint64_t counter) noexcept {
+  return mix64(stream + (counter + 1) * kGoldenGamma);
+}
+
+std::vector<double> net_profits(const std::vector<BacktestTrade>& trades) {
+  std::vector<double> result;
+  result.reserve(trades.size());
+  for (const auto& trade : trades) {
+    result.push_back(trade.profit_loss - trade.commission);
+  }
+  return result;
+}
+
+MonteCarloReport monte_carlo(const std::vector<double>& profits, const MonteCarloOptions& options,
+                             ThreadPool& pool) {
+  if (profits.empty() || profits.size() > 0xFFFFFFFFull) {
+    throw std::invalid_argument("monte_carlo requires between 1 and 2^32 trades");
+  }
+  const std::size_t draws = options.trades_per_path == 0 ? profits.size() : options.trades_per_path;
+  const std::size_t tasks = (options.paths + kPathsPerTask - 1) / kPathsPerTask;
+
+  std::vector<MonteCarloReport> partial(tasks, MonteCarloReport(options.relative_accuracy));
+  for (std::size_t t = 0; t < tasks; ++t) {
+    pool.submit([&, t] {
+      const std::size_t first = t * kPathsPerTask;
+      simulate(profits, options, draws, first, (std::min)(options.paths, first + kPathsPerTask), partial[t]);
+    });
+  }
+  pool.wait_idle();
+
+  MonteCarloReport report(options.relative_accuracy);
+  for (const auto& part : partial) {
+    report.max_drawdown.merge(part.max_drawdown);
+    report.final_profit.merge(part.final_profit);
+    report.paths += part.paths;
+    report.ruined_paths += part.ruined_paths;
+  }
+  return report;
+}
+
+}  // namespace sierra::core
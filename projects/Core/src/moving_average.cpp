@@ -1,5 +1,8 @@
 #include "sierra/core/moving_average.hpp"
 
+#include "sierra/core/trace.hpp"
+
+#include <algorithm>
 #include <limits>
 #include <stdexcept>
 
@@ -9,6 +12,7 @@ namespace sierra::core {
 /// @note Использует «скользящую сумму» для линейного вычисления.
 /// @warning Период 0 недопустим — функция выбрасывает исключение.
 std::vector<double> moving_average(const std::vector<double>& input, std::size_t period) {
+  SIERRA_TRACE_SCOPE("core", "moving_average");
   if (period == 0) {
     throw std::invalid_argument("moving_average period must be greater than zero");
   }
@@ -33,4 +37,99 @@ std::vector<double> moving_average(const std::vector<double>& input, std::size_t
   return output;
 }
 
+/// @note Сумма окна строится заново от `first - period`, поэтому ошибка округления не накапливается между вызовами.
+void moving_average(const float* input, std::size_t size, std::size_t period, std::size_t first, float* output) {
+  SIERRA_TRACE_SCOPE("core", "moving_average");
+  if (period == 0) {
+    throw std::invalid_argument("moving_average period must be greater than zero");
+  }
+  if (first >= size) {
+    return;
+  }
+
+  const std::size_t window_start = first >= period ? first - period : 0;
+  double running_sum = 0.0;
+  for (std::size_t i = window_start; i < first; ++i) {
+    running_sum += input[i];
+  }
+  for (std::size_t i = first; i < size; ++i) {
+    running_sum += input[i];
+    if (i >= period) {
+      running_sum -= input[i - period];
+    }
+    output[i] = i + 1 >= period ? static_cast<float>(running_sum / static_cast<double>(period))
+                                : std::numeric_limits<float>::quiet_NaN();
+  }
+}
+
+MovingAverageEngine::MovingAverageEngine(const MovingAverageConfig& config) {
+  reset(config);
+}
+
+void MovingAverageEngine::reset(const MovingAverageConfig& config) {
+  if (config.period == 0) {
+    throw std::invalid_argument("moving_average period must be greater than zero");
+  }
+  config_ = config;
+  sum_ = 0.0;
+  committed_ = 0;
+}
+
+void MovingAverageEngine::save(SnapshotWriter& writer) const {
+  writer.put(kSnapshotVersion);
+  writer.put<std::uint64_t>(config_.period);
+  writer.put(sum_);
+  writer.put<std::uint64_t>(committed_);
+}
+
+bool MovingAverageEngine::restore(SnapshotReader& reader) {
+  if (reader.get<std::uint32_t>() != kSnapshotVersion || reader.get<std::uint64_t>() != config_.period) {
+    return false;
+  }
+  const auto sum = reader.get<double>();
+  const auto committed = reader.get<std::uint64_t>();
+  sum_ = sum;
+  committed_ = static_cast<std::size_t>(committed);
+  return true;
+}
+
+void MovingAverageEngine::rewind(const float* input, std::size_t to) {
+  const std::size_t period = config_.period;
+  sum_ = 0.0;
+  for (std::size_t i = to >= period ? to - period : 0; i < to; ++i) {
+    sum_ += input[i];
+  }
+  committed_ = to;
+}
+
+void MovingAverageEngine::update(const float* input, std::size_t size, std::size_t first, float* output) {
+  SIERRA_TRACE_SCOPE("core", "MovingAverageEngine::update");
+  if (size == 0) {
+    sum_ = 0.0;
+    committed_ = 0;
+    return;
+  }
+  const std::size_t last = size - 1;
+  if (first != committed_ || committed_ > last) {
+    rewind(input, (std::min)(first, last));
+  }
+
+  const std::size_t period = config_.period;
+  const double divisor = static_cast<double>(period);
+  for (std::size_t i = committed_; i < last; ++i) {
+    sum_ += input[i];
+    if (i >= period) {
+      sum_ -= input[i - period];
+    }
+    output[i] = i + 1 >= period ? static_cast<float>(sum_ / divisor) : std::numeric_limits<float>::quiet_NaN();
+  }
+  committed_ = last;
+
+  double window = sum_ + input[last];
+  if (last >= period) {
+    window -= input[last - period];
+  }
+  output[last] = last + 1 >= period ? static_cast<float>(window / divisor) : std::numeric_limits<float>::quiet_NaN();
+}
+
 }  // namespace sierra::core
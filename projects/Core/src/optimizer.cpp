@@ -0,0 +1,267 @@
+#include "sierra/core/optimizer.hpp"
+
+#include "sierra/core/moving_average.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace sierra::core {
+
+namespace {
+
+/// @brief Количество узлов сетки в диапазоне.
+std::size_t steps_of(const ParameterRange& range) {
+  if (range.step <= 0.0) {
+    throw std::invalid_argument("ParameterRange step must be positive: " + range.name);
+  }
+  if (range.last < range.first) {
+    return 0;
+  }
+  return static_cast<std::size_t>(std::floor((range.last - range.first) / range.step + 1e-9)) + 1;
+}
+
+bool better(const OptimizationResult& lhs, const OptimizationResult& rhs) {
+  return lhs.objective > rhs.objective;
+}
+
+}  // namespace
+
+std::vector<ParameterSet> grid_search(const std::vector<ParameterRange>& ranges) {
+  std::vector<std::size_t> sizes;
+  std::size_t total = ranges.empty() ? 0 : 1;
+  for (const auto& range : ranges) {
+    sizes.push_back(steps_of(range));
+    total *= sizes.back();
+  }
+
+  std::vector<ParameterSet> result;
+  result.reserve(total);
+  std::vector<std::size_t> position(ranges.size(), 0);
+  for (std::size_t n = 0; n < total; ++n) {
+    ParameterSet set(ranges.size());
+    for (std::size_t i = 0; i < ranges.size(); ++i) {
+      set[i] = ranges[i].first + ranges[i].step * static_cast<double>(position[i]);
+    }
+    result.push_back(std::move(set));
+    // Последний параметр меняется быстрее всех.
+    for (std::size_t i = ranges.size(); i-- > 0;) {
+      if (++position[i] < sizes[i]) {
+        break;
+      }
+      position[i] = 0;
+    }
+  }
+  return result;
+}
+
+std::vector<ParameterSet> random_search(const std::vector<ParameterRange>& ranges, std::size_t count,
+                                        std::uint64_t seed) {
+  std::vector<std::size_t> sizes;
+  for (const auto& range : ranges) {
+    sizes.push_back(steps_of(range));
+    if (sizes.back() == 0) {
+      return {};
+    }
+  }
+  std::mt19937_64 rng(seed);
+  std::vector<ParameterSet> result(count, ParameterSet(ranges.size()));
+  for (auto& set : result) {
+    for (std::size_t i = 0; i < ranges.size(); ++i) {
+      const std::size_t node = static_cast<std::size_t>(rng() % sizes[i]);
+      set[i] = ranges[i].first + ranges[i].step * static_cast<double>(node);
+    }
+  }
+  return result;
+}
+
+ResultTable::ResultTable(std::size_t capacity) : capacity_(capacity) {}
+
+/// @note Худший из хранимых результатов лежит в вершине min-кучи, поэтому вставка — O(log capacity).
+void ResultTable::offer(OptimizationResult result) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++evaluated_;
+  if (capacity_ == 0) {
+    return;
+  }
+  if (best_.size() < capacity_) {
+    best_.push_back(std::move(result));
+    std::push_heap(best_.begin(), best_.end(), better);
+  } else if (better(result, best_.front())) {
+    std::pop_heap(best_.begin(), best_.end(), better);
+    best_.back() = std::move(result);
+    std::push_heap(best_.begin(), best_.end(), better);
+  }
+}
+
+std::vector<OptimizationResult> ResultTable::ranked() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<OptimizationResult> copy = best_;
+  std::sort(copy.begin(), copy.end(), better);
+  return copy;
+}
+
+std::size_t ResultTable::evaluated() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return evaluated_;
+}
+
+IndicatorCache::IndicatorCache(std::vector<float> prices, std::size_t capacity)
+    : prices_(std::move(prices)), capacity_((std::max)(std::size_t{1}, capacity)) {}
+
+std::shared_ptr<const std::vector<float>> IndicatorCache::moving_average(std::size_t period) {
+  std::promise<Column> promise;
+  std::shared_future<Column> future;
+  bool owner = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = averages_.find(period);
+    if (it == averages_.end()) {
+      future = promise.get_future().share();
+      recent_.push_front(period);
+      averages_.emplace(period, Entry{future, recent_.begin()});
+      ++computed_;
+      owner = true;
+      if (averages_.size() > capacity_) {
+        // Ждущие вытесненный столбец держат свою копию future и получат его как обычно.
+        averages_.erase(recent_.back());
+        recent_.pop_back();
+      }
+    } else {
+      future = it->second.column;
+      recent_.splice(recent_.begin(), recent_, it->second.recent);
+    }
+  }
+
+  if (owner) {
+    try {
+      auto column = std::make_shared<std::vector<float>>(prices_.size());
+      sierra::core::moving_average(prices_.data(), prices_.size(), period, 0, column->data());
+      promise.set_value(std::move(column));
+    } catch (...) {
+      promise.set_exception(std::current_exception());
+    }
+  }
+  return future.get();
+}
+
+std::size_t IndicatorCache::computed_count() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return computed_;
+}
+
+std::size_t IndicatorCache::resident_count() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return averages_.size();
+}
+
+void optimize(const std::vector<ParameterSet>& candidates, const Evaluator& evaluate, ThreadPool& pool,
+              ResultTable& table) {
+  for (const auto& candidate : candidates) {
+    pool.submit([&evaluate, &table, &candidate] { table.offer(evaluate(candidate)); });
+  }
+  pool.wait_idle();
+}
+
+namespace {
+
+/// @brief Стратегия разворота по знаку разницы средних.
+struct CrossoverStrategy {
+  const std::vector<float>& fast;
+  const std::vector<float>& slow;
+  std::size_t index = 0;
+  int state = 0;
+
+  void on_tick(Backtester& backtester, const ScidRecord&) {
+    const float f = fast[index];
+    const float s = slow[index];
+    ++index;
+    if (std::isnan(f) || std::isnan(s) || f == s) {
+      return;
+    }
+    const int desired = f > s ? 1 : -1;
+    if (desired == state) {
+      return;
+    }
+    OrderRequest request;
+    request.side = desired > 0 ? OrderSide::kBuy : OrderSide::kSell;
+    request.quantity = state == 0 ? 1 : 2;
+    backtester.submit(request);
+    state = desired;
+  }
+};
+
+}  // namespace
+
+OptimizationResult evaluate_ma_crossover(const ScidRecord* ticks, std::size_t count,
+                                         IndicatorCache& cache, std::size_t fast_period,
+                                         std::size_t slow_period, const BacktestOptions& options) {
+  return evaluate_ma_crossover_range(ticks, 0, count, cache, fast_period, slow_period, options);
+}
+
+/// @note Открытая на конце диапазона позиция закрывается по котировке последнего тика, чтобы результаты соседних диапазонов можно было складывать.
+OptimizationResult evaluate_ma_crossover_range(const ScidRecord* ticks, std::size_t begin,
+                                               std::size_t end, IndicatorCache& cache,
+                                               std::size_t fast_period, std::size_t slow_period,
+                                               const BacktestOptions& options) {
+  const auto fast_column = cache.moving_average(fast_period);
+  const auto slow_column = cache.moving_average(slow_period);
+  const std::vector<float>& fast = *fast_column;
+  const std::vector<float>& slow = *slow_column;
+  if (begin > end || fast.size() < end || slow.size() < end) {
+    throw std::invalid_argument("evaluate_ma_crossover: cache is shorter than tick range");
+  }
+
+  OptimizationResult result;
+  result.parameters = {static_cast<double>(fast_period), static_cast<double>(slow_period)};
+  if (begin == end) {
+    return result;
+  }
+
+  Backtester backtester(options);
+  CrossoverStrategy strategy{fast, slow, begin};
+  backtester.run(ticks + begin, end - begin, strategy);
+  backtester.flatten();
+  backtester.process_tick(ticks[end - 1]);
+
+  result.statistics = backtester.statistics();
+  result.net_profit = result.statistics.net_profit();
+  result.trade_count = result.statistics.total_trades;
+  result.objective = result.net_profit;
+  return result;
+}
+
+OptimizationResult continue_ma_crossover_range(const ScidRecord* ticks, std::size_t begin, std::size_t end,
+                                               IndicatorCache& cache, std::size_t fast_period,
+                                               std::size_t slow_period, Backtester& account) {
+  const auto fast_column = cache.moving_average(fast_period);
+  const auto slow_column = cache.moving_average(slow_period);
+  const std::vector<float>& fast = *fast_column;
+  const std::vector<float>& slow = *slow_column;
+  if (begin > end || fast.size() < end || slow.size() < end) {
+    throw std::invalid_argument("continue_ma_crossover_range: cache is shorter than tick range");
+  }
+
+  OptimizationResult result;
+  result.parameters = {static_cast<double>(fast_period), static_cast<double>(slow_period)};
+  if (begin == end) {
+    result.statistics = account.statistics();
+    return result;
+  }
+
+  const std::size_t trades_before = account.statistics().total_trades;
+  const double before = account.statistics().net_profit() +
+                        account.open_profit_loss(begin > 0 ? ticks[begin - 1].close : ticks[begin].close);
+  CrossoverStrategy strategy{fast, slow, begin, account.position() > 0 ? 1 : (account.position() < 0 ? -1 : 0)};
+  account.run(ticks + begin, end - begin, strategy);
+  account.process_tick(ticks[end - 1]);
+
+  result.statistics = account.statistics();
+  result.net_profit = result.statistics.net_profit() + account.open_profit_loss(ticks[end - 1].close) - before;
+  result.trade_count = result.statistics.total_trades - trades_before;
+  result.objective = result.net_profit;
+  return result;
+}
+
+}  // namespace sierra::core
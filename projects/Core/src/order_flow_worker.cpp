@@ -0,0 +1,125 @@
+#include "sierra/core/order_flow_worker.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <limits>
+
+namespace sierra::core {
+
+namespace {
+
+constexpr std::size_t kBatchSize = 256;
+
+/// @brief Учитывает одну сделку в метриках.
+void accumulate(OrderFlowMetrics& metrics, const TradeRecord& trade) {
+  ++metrics.trade_count;
+  switch (trade.side) {
+    case TradeSide::kBid:
+      metrics.bid_volume += trade.volume;
+      break;
+    case TradeSide::kAsk:
+      metrics.ask_volume += trade.volume;
+      break;
+    default:
+      metrics.unclassified_volume += trade.volume;
+      break;
+  }
+  metrics.volume_price_sum += static_cast<double>(trade.price) * trade.volume;
+  metrics.last_sequence = trade.sequence;
+}
+
+}  // namespace
+
+double OrderFlowMetrics::vwap() const noexcept {
+  const std::uint64_t volume = bid_volume + ask_volume + unclassified_volume;
+  if (volume == 0) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  return volume_price_sum / static_cast<double>(volume);
+}
+
+OrderFlowWorker::OrderFlowWorker(std::size_t capacity)
+    : ring_(capacity), thread_([this] { run(); }) {}
+
+OrderFlowWorker::~OrderFlowWorker() {
+  stop_.store(true, std::memory_order_release);
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    wake_ = true;
+  }
+  wakeup_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+OrderFlowMetrics OrderFlowWorker::snapshot() const {
+  std::lock_guard<std::mutex> lock(metrics_mutex_);
+  OrderFlowMetrics copy = metrics_;
+  copy.dropped = dropped_.load(std::memory_order_relaxed);
+  return copy;
+}
+
+/// @note Каждая принятая сделка учитывается в `trade_count`, поэтому ждать нужно, пока счётчик догонит `pushed_`.
+void OrderFlowWorker::drain() const {
+  const std::uint64_t target = pushed_.load(std::memory_order_acquire);
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    wake_ = true;
+  }
+  wakeup_.notify_one();
+  std::unique_lock<std::mutex> lock(metrics_mutex_);
+  metrics_updated_.wait(lock, [&] { return metrics_.trade_count >= target; });
+}
+
+/// @note Очередь разбирается без мьютекса; он берётся только для пачки со сделками, поэтому `snapshot` не видит
+/// частично учтённую пачку, а простой не трогает мьютекс метрик.
+void OrderFlowWorker::run() {
+  std::array<TradeRecord, kBatchSize> batch{};
+  std::chrono::microseconds pause = kPollInterval;
+  for (;;) {
+    const bool stopping = stop_.load(std::memory_order_acquire);
+    const std::size_t count = ring_.pop_bulk(batch.data(), batch.size());
+    if (count != 0) {
+      {
+        std::lock_guard<std::mutex> lock(metrics_mutex_);
+        for (std::size_t i = 0; i < count; ++i) {
+          accumulate(metrics_, batch[i]);
+        }
+      }
+      metrics_updated_.notify_all();
+      pause = kPollInterval;
+      continue;
+    }
+    if (stopping) {
+      return;
+    }
+    wait_for_work(pause);
+    pause = (std::min)(pause * 2, kMaxPause);
+  }
+}
+
+/// @note Сделка, положенная между пустым проходом и установкой флага простоя, ждёт до конца паузы, но не теряется.
+void OrderFlowWorker::wait_for_work(std::chrono::microseconds pause) {
+  std::unique_lock<std::mutex> lock(wake_mutex_);
+  if (pause >= kIdleInterval) {
+    idle_.store(true, std::memory_order_relaxed);
+  }
+  wakeup_.wait_for(lock, pause, [&] { return wake_; });
+  wake_ = false;
+  idle_.store(false, std::memory_order_relaxed);
+}
+
+void OrderFlowWorker::wake_idle() const noexcept {
+  if (!idle_.exchange(false, std::memory_order_relaxed)) {
+    return;  // поток уже разбужен
+  }
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    wake_ = true;
+  }
+  wakeup_.notify_one();
+}
+
+}  // namespace sierra::core
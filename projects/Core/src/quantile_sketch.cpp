@@ -0,0 +1,137 @@
+#include "sierra/core/quantile_sketch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace sierra::core {
+
+namespace {
+
+/// Модули меньше порога учитываются как ноль, чтобы не заводить корзины для денормализованных чисел.
+constexpr double kMinIndexable = 1e-9;
+
+}  // namespace
+
+void QuantileSketch::Store::add(int index, std::uint64_t count) {
+  if (counts.empty()) {
+    offset = index;
+    counts.push_back(count);
+    return;
+  }
+  if (index < offset) {
+    counts.insert(counts.begin(), static_cast<std::size_t>(offset - index), 0);
+    offset = index;
+  } else if (index >= offset + static_cast<int>(counts.size())) {
+    counts.resize(static_cast<std::size_t>(index - offset) + 1, 0);
+  }
+  counts[static_cast<std::size_t>(index - offset)] += count;
+}
+
+QuantileSketch::QuantileSketch(double relative_accuracy) : accuracy_(relative_accuracy) {
+  if (!(relative_accuracy > 0.0 && relative_accuracy < 1.0)) {
+    throw std::invalid_argument("QuantileSketch relative accuracy must be in (0, 1)");
+  }
+  gamma_ = (1.0 + relative_accuracy) / (1.0 - relative_accuracy);
+  log_gamma_ = std::log(gamma_);
+}
+
+int QuantileSketch::index_of(double magnitude) const noexcept {
+  return static_cast<int>(std::ceil(std::log(magnitude) / log_gamma_));
+}
+
+/// @note Середина корзины в смысле относительной погрешности: `2γ^i / (γ + 1)` отстоит от обеих границ не более чем на `α`.
+double QuantileSketch::value_of(int index) const noexcept {
+  return 2.0 * std::pow(gamma_, index) / (gamma_ + 1.0);
+}
+
+void QuantileSketch::add(double value) {
+  if (std::isnan(value)) {
+    return;
+  }
+  if (value >= kMinIndexable) {
+    positive_.add(index_of(value), 1);
+  } else if (value <= -kMinIndexable) {
+    negative_.add(index_of(-value), 1);
+  } else {
+    ++zero_count_;
+  }
+  min_ = count_ == 0 ? value : (std::min)(min_, value);
+  max_ = count_ == 0 ? value : (std::max)(max_, value);
+  ++count_;
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+  if (other.accuracy_ != accuracy_) {
+    throw std::invalid_argument("QuantileSketch::merge requires equal relative accuracy");
+  }
+  if (other.count_ == 0) {
+    return;
+  }
+  for (std::size_t i = 0; i < other.positive_.counts.size(); ++i) {
+    if (other.positive_.counts[i] != 0) {
+      positive_.add(other.positive_.offset + static_cast<int>(i), other.positive_.counts[i]);
+    }
+  }
+  for (std::size_t i = 0; i < other.negative_.counts.size(); ++i) {
+    if (other.negative_.counts[i] != 0) {
+      negative_.add(other.negative_.offset + static_cast<int>(i), other.negative_.counts[i]);
+    }
+  }
+  zero_count_ += other.zero_count_;
+  min_ = count_ == 0 ? other.min_ : (std::min)(min_, other.min_);
+  max_ = count_ == 0 ? other.max_ : (std::max)(max_, other.max_);
+  count_ += other.count_;
+}
+
+/// @note Корзины обходятся по возрастанию значений: отрицательные от больших модулей к меньшим, затем ноль и положительные.
+double QuantileSketch::quantile(double q) const {
+  if (count_ == 0) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  q = (std::min)((std::max)(q, 0.0), 1.0);
+  if (q == 0.0) {
+    return min_;
+  }
+  if (q == 1.0) {
+    return max_;
+  }
+
+  const double rank = q * static_cast<double>(count_ - 1);
+  double seen = 0.0;
+  double result = max_;
+  bool found = false;
+  for (std::size_t i = negative_.counts.size(); i-- > 0 && !found;) {
+    seen += static_cast<double>(negative_.counts[i]);
+    if (seen > rank) {
+      result = -value_of(negative_.offset + static_cast<int>(i));
+      found = true;
+    }
+  }
+  if (!found) {
+    seen += static_cast<double>(zero_count_);
+    if (seen > rank) {
+      result = 0.0;
+      found = true;
+    }
+  }
+  for (std::size_t i = 0; i < positive_.counts.size() && !found; ++i) {
+    seen += static_cast<double>(positive_.counts[i]);
+    if (seen > rank) {
+      result = value_of(positive_.offset + static_cast<int>(i));
+      found = true;
+    }
+  }
+  return (std::min)((std::max)(result, min_), max_);
+}
+
+double QuantileSketch::min() const noexcept {
+  return count_ == 0 ? std::numeric_limits<double>::quiet_NaN() : min_;
+}
+
+double QuantileSketch::max() const noexcept {
+  return count_ == 0 ? std::numeric_limits<double>::quiet_NaN() : max_;
+}
+
+}  // namespace sierra::core
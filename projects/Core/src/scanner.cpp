@@ -0,0 +1,335 @@
+#include "sierra/core/scanner.hpp"
+
+#include "sierra/core/trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+
+namespace sierra::core {
+
+namespace {
+
+constexpr double kMaxPeriod = 100000.0;
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+/// @brief Разбор условия слева направо; `pos_` — первый непрочитанный символ.
+class ConditionParser {
+ public:
+  explicit ConditionParser(const std::string& text) : text_(text) {}
+
+  ScanCondition parse() {
+    ScanCondition condition;
+    condition.left = operand();
+    skip_spaces();
+    if (pos_ < text_.size() && (text_[pos_] == '<' || text_[pos_] == '>')) {
+      condition.comparison = text_[pos_] == '<' ? ScanComparison::kLess : ScanComparison::kGreater;
+      ++pos_;
+    } else {
+      fail("expected '<' or '>'");
+    }
+    condition.right = operand();
+    skip_spaces();
+    if (pos_ != text_.size()) {
+      fail("unexpected trailing text");
+    }
+    return condition;
+  }
+
+ private:
+  ScanOperand operand() {
+    skip_spaces();
+    std::string word;
+    while (pos_ < text_.size() && std::isalpha(static_cast<unsigned char>(text_[pos_])) != 0) {
+      word += static_cast<char>(std::tolower(static_cast<unsigned char>(text_[pos_++])));
+    }
+    if (word.empty()) {
+      return {ScanSeries::kConstant, number()};
+    }
+    if (word == "close") {
+      return {ScanSeries::kClose, 0.0};
+    }
+    if (word != "sma" && word != "rsi") {
+      fail("unknown series '" + word + "'");
+    }
+    expect('(');
+    const double period = number();
+    expect(')');
+    if (period < 1.0 || period > kMaxPeriod || period != std::floor(period)) {
+      fail("period must be an integer in [1, 100000]");
+    }
+    return {word == "sma" ? ScanSeries::kSma : ScanSeries::kRsi, period};
+  }
+
+  double number() {
+    skip_spaces();
+    const char* begin = text_.c_str() + pos_;
+    char* end = nullptr;
+    const double value = std::strtod(begin, &end);
+    if (end == begin || !std::isfinite(value)) {
+      fail("expected a number");
+    }
+    pos_ += static_cast<std::size_t>(end - begin);
+    return value;
+  }
+
+  void expect(char symbol) {
+    skip_spaces();
+    if (pos_ >= text_.size() || text_[pos_] != symbol) {
+      fail(std::string("expected '") + symbol + "'");
+    }
+    ++pos_;
+  }
+
+  void skip_spaces() {
+    while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_])) != 0) {
+      ++pos_;
+    }
+  }
+
+  [[noreturn]] void fail(const std::string& reason) const {
+    throw std::invalid_argument("scan condition \"" + text_ + "\": " + reason);
+  }
+
+  const std::string& text_;
+  std::size_t pos_ = 0;
+};
+
+double simple_average(const std::vector<OhlcBar>& bars, std::size_t period) {
+  if (bars.size() < period) {
+    return kNaN;
+  }
+  double sum = 0.0;
+  for (std::size_t i = bars.size() - period; i < bars.size(); ++i) {
+    sum += bars[i].close;
+  }
+  return sum / static_cast<double>(period);
+}
+
+double wilder_rsi(const std::vector<OhlcBar>& bars, std::size_t period) {
+  if (bars.size() <= period) {
+    return kNaN;
+  }
+  const double weight = static_cast<double>(period);
+  double gain = 0.0;
+  double loss = 0.0;
+  for (std::size_t i = 1; i <= period; ++i) {
+    const double change = bars[i].close - bars[i - 1].close;
+    gain += (std::max)(change, 0.0);
+    loss += (std::max)(-change, 0.0);
+  }
+  gain /= weight;
+  loss /= weight;
+  for (std::size_t i = period + 1; i < bars.size(); ++i) {
+    const double change = bars[i].close - bars[i - 1].close;
+    gain = (gain * (weight - 1.0) + (std::max)(change, 0.0)) / weight;
+    loss = (loss * (weight - 1.0) + (std::max)(-change, 0.0)) / weight;
+  }
+  if (loss == 0.0) {
+    return gain == 0.0 ? 50.0 : 100.0;
+  }
+  return 100.0 - 100.0 / (1.0 + gain / loss);
+}
+
+/// @brief Номер операнда в `columns` или -1 для числа.
+int column_of(const std::vector<ScanOperand>& columns, const ScanOperand& operand) {
+  const auto found = std::find(columns.begin(), columns.end(), operand);
+  return found == columns.end() ? -1 : static_cast<int>(found - columns.begin());
+}
+
+struct CompiledCondition {
+  int left;
+  int right;
+  ScanComparison comparison;
+  double left_constant;
+  double right_constant;
+};
+
+/// @brief Читает и проверяет один символ; возвращает байт файла.
+std::size_t scan_file(const std::string& path, const std::vector<ScanOperand>& columns,
+                      const std::vector<CompiledCondition>& conditions, std::int64_t period,
+                      std::vector<OhlcBar>& bars, ScanRow& row) {
+  SIERRA_TRACE_SCOPE("core", "scan_file");
+  row.symbol = std::filesystem::path(path).stem().string();
+  std::size_t bytes = 0;
+  try {
+    const ScidFile file(path);
+    bytes = file.byte_size();
+    aggregate_bars(file.records(), file.size(), period, bars);
+  } catch (const std::exception& error) {
+    row.error = error.what();
+    return bytes;
+  }
+  row.bars = bars.size();
+  if (!bars.empty()) {
+    row.last_time = bars.back().time;
+  }
+  row.values.resize(columns.size());
+  for (std::size_t column = 0; column < columns.size(); ++column) {
+    row.values[column] = scan_value(bars, columns[column]);
+  }
+  row.matched = !bars.empty();
+  for (const auto& condition : conditions) {
+    const double left = condition.left < 0 ? condition.left_constant : row.values[condition.left];
+    const double right = condition.right < 0 ? condition.right_constant : row.values[condition.right];
+    // Сравнение с NaN (мало баров) ложно, поэтому символ без истории не проходит.
+    row.matched = row.matched && (condition.comparison == ScanComparison::kLess ? left < right : left > right);
+  }
+  return bytes;
+}
+
+void write_number(std::ostream& out, double value) {
+  if (std::isnan(value)) {
+    return;  // пустое поле: значению не хватило баров
+  }
+  char text[32];
+  std::snprintf(text, sizeof(text), "%.10g", value);
+  out << text;
+}
+
+}  // namespace
+
+ScanCondition parse_scan_condition(const std::string& text) { return ConditionParser(text).parse(); }
+
+std::string to_string(const ScanOperand& operand) {
+  char text[48];
+  switch (operand.series) {
+    case ScanSeries::kClose:
+      return "close";
+    case ScanSeries::kSma:
+      std::snprintf(text, sizeof(text), "sma(%.0f)", operand.value);
+      return text;
+    case ScanSeries::kRsi:
+      std::snprintf(text, sizeof(text), "rsi(%.0f)", operand.value);
+      return text;
+    case ScanSeries::kConstant:
+      break;
+  }
+  std::snprintf(text, sizeof(text), "%g", operand.value);
+  return text;
+}
+
+/// @note Граница текущего бара держится в переменной, поэтому деление на период — только при открытии бара.
+void aggregate_bars(const ScidRecord* records, std::size_t count, std::int64_t period_microseconds,
+                    std::vector<OhlcBar>& bars) {
+  if (period_microseconds <= 0) {
+    throw std::invalid_argument("aggregate_bars period must be positive");
+  }
+  bars.clear();
+  std::int64_t end = (std::numeric_limits<std::int64_t>::min)();
+  for (std::size_t i = 0; i < count; ++i) {
+    const ScidRecord& record = records[i];
+    const double close = record.close;
+    const double high = record.is_tick() ? close : record.high;
+    const double low = record.is_tick() ? close : record.low;
+    if (record.date_time >= end) {
+      const std::int64_t offset =
+          (record.date_time % period_microseconds + period_microseconds) % period_microseconds;
+      const std::int64_t start = record.date_time - offset;
+      end = start + period_microseconds;
+      bars.push_back({Timestamp::from_microseconds(start), record.is_tick() ? close : record.open, high, low, close,
+                      static_cast<double>(record.total_volume)});
+      continue;
+    }
+    OhlcBar& bar = bars.back();
+    bar.high = (std::max)(bar.high, high);
+    bar.low = (std::min)(bar.low, low);
+    bar.close = close;
+    bar.volume += static_cast<double>(record.total_volume);
+  }
+}
+
+double scan_value(const std::vector<OhlcBar>& bars, const ScanOperand& operand) {
+  switch (operand.series) {
+    case ScanSeries::kClose:
+      return bars.empty() ? kNaN : bars.back().close;
+    case ScanSeries::kSma:
+      return simple_average(bars, static_cast<std::size_t>(operand.value));
+    case ScanSeries::kRsi:
+      return wilder_rsi(bars, static_cast<std::size_t>(operand.value));
+    case ScanSeries::kConstant:
+      break;
+  }
+  return operand.value;
+}
+
+std::size_t ScanReport::matched() const noexcept {
+  return static_cast<std::size_t>(
+      std::count_if(rows.begin(), rows.end(), [](const ScanRow& row) { return row.matched; }));
+}
+
+ScanReport scan_symbols(const std::vector<std::string>& paths, const std::vector<ScanCondition>& conditions,
+                        const ScanOptions& options, ThreadPool& pool) {
+  SIERRA_TRACE_SCOPE("core", "scan_symbols");
+  if (options.bar_period_seconds <= 0) {
+    throw std::invalid_argument("scan_symbols bar period must be positive");
+  }
+  ScanReport report;
+  for (const auto& condition : conditions) {
+    for (const ScanOperand* operand : {&condition.left, &condition.right}) {
+      if (operand->series != ScanSeries::kConstant && column_of(report.columns, *operand) < 0) {
+        report.columns.push_back(*operand);
+      }
+    }
+  }
+  std::vector<CompiledCondition> compiled;
+  for (const auto& condition : conditions) {
+    compiled.push_back({column_of(report.columns, condition.left), column_of(report.columns, condition.right),
+                        condition.comparison, condition.left.value, condition.right.value});
+  }
+
+  report.rows.resize(paths.size());
+  const std::int64_t period = options.bar_period_seconds * kMicrosecondsPerSecond;
+  std::atomic<std::size_t> next{0};
+  std::atomic<std::size_t> bytes{0};
+  const auto started = std::chrono::steady_clock::now();
+  // Задача на поток, а не на файл: очередь путей — общий счётчик, буфер баров живёт в задаче.
+  const std::size_t workers = (std::min)(pool.size(), paths.size());
+  for (std::size_t worker = 0; worker < workers; ++worker) {
+    pool.submit([&] {
+      std::vector<OhlcBar> bars;
+      std::size_t read = 0;
+      for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed); i < paths.size();
+           i = next.fetch_add(1, std::memory_order_relaxed)) {
+        read += scan_file(paths[i], report.columns, compiled, period, bars, report.rows[i]);
+      }
+      bytes.fetch_add(read, std::memory_order_relaxed);
+    });
+  }
+  pool.wait_idle();
+  report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+  report.bytes = bytes.load(std::memory_order_relaxed);
+  return report;
+}
+
+void write_scan_table(std::ostream& out, const ScanReport& report, bool matched_only) {
+  out << "symbol,bars";
+  for (const auto& column : report.columns) {
+    out << ',' << to_string(column);
+  }
+  out << ",matched,error\n";
+  for (const auto& row : report.rows) {
+    if (matched_only && !row.matched) {
+      continue;
+    }
+    out << row.symbol << ',' << row.bars;
+    for (std::size_t column = 0; column < report.columns.size(); ++column) {
+      out << ',';
+      if (column < row.values.size()) {
+        write_number(out, row.values[column]);
+      }
+    }
+    out << ',' << (row.matched ? 1 : 0) << ',' << row.error << '\n';
+  }
+}
+
+}  // namespace sierra::core
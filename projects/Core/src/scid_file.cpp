@@ -0,0 +1,122 @@
+#include "sierra/core/scid_file.hpp"
+
+#include "sierra/core/trace.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sierra::core {
+
+/// @note Файл отображается целиком; записи начинаются сразу после заголовка размера `header_size`.
+ScidFile::ScidFile(const std::string& path) {
+  SIERRA_TRACE_SCOPE("core", "ScidFile::open");
+#ifdef _WIN32
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error("ScidFile: cannot open " + path);
+  }
+  file_handle_ = file;
+  LARGE_INTEGER length{};
+  GetFileSizeEx(file, &length);
+  byte_size_ = static_cast<std::size_t>(length.QuadPart);
+  if (byte_size_ >= sizeof(ScidHeader)) {
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping != nullptr) {
+      mapping_handle_ = mapping;
+      view_ = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    }
+  }
+#else
+  fd_ = ::open(path.c_str(), O_RDONLY);
+  if (fd_ < 0) {
+    throw std::runtime_error("ScidFile: cannot open " + path);
+  }
+  struct stat info {};
+  if (::fstat(fd_, &info) == 0) {
+    byte_size_ = static_cast<std::size_t>(info.st_size);
+  }
+  if (byte_size_ >= sizeof(ScidHeader)) {
+    void* view = ::mmap(nullptr, byte_size_, PROT_READ, MAP_SHARED, fd_, 0);
+    if (view != MAP_FAILED) {
+      view_ = view;
+      ::madvise(view_, byte_size_, MADV_SEQUENTIAL);
+    }
+  }
+#endif
+
+  if (view_ == nullptr) {
+    close();
+    throw std::runtime_error("ScidFile: cannot map " + path);
+  }
+
+  ScidHeader header;
+  std::memcpy(&header, view_, sizeof(header));
+  if (header.file_type_unique_header_id != ScidHeader::kUniqueHeaderId ||
+      header.record_size != sizeof(ScidRecord) || header.header_size > byte_size_) {
+    close();
+    throw std::runtime_error("ScidFile: invalid header in " + path);
+  }
+
+  const auto* base = static_cast<const unsigned char*>(view_);
+  records_ = reinterpret_cast<const ScidRecord*>(base + header.header_size);
+  size_ = (byte_size_ - header.header_size) / sizeof(ScidRecord);
+}
+
+ScidFile::~ScidFile() { close(); }
+
+void ScidFile::close() noexcept {
+#ifdef _WIN32
+  if (view_ != nullptr) {
+    UnmapViewOfFile(view_);
+  }
+  if (mapping_handle_ != nullptr) {
+    CloseHandle(mapping_handle_);
+  }
+  if (file_handle_ != nullptr) {
+    CloseHandle(file_handle_);
+  }
+  mapping_handle_ = nullptr;
+  file_handle_ = nullptr;
+#else
+  if (view_ != nullptr) {
+    ::munmap(view_, byte_size_);
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+  fd_ = -1;
+#endif
+  view_ = nullptr;
+  records_ = nullptr;
+  size_ = 0;
+}
+
+void write_scid(const std::string& path, const std::vector<ScidRecord>& records) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("write_scid: cannot create " + path);
+  }
+  const ScidHeader header;
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(records.data()),
+            static_cast<std::streamsize>(records.size() * sizeof(ScidRecord)));
+  if (!out) {
+    throw std::runtime_error("write_scid: write failed for " + path);
+  }
+}
+
+}  // namespace sierra::core
@@ -0,0 +1,165 @@
+#include "sierra/core/session_aggregator.hpp"
+
+#include "sierra/core/trace.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace sierra::core {
+
+namespace {
+
+/// @brief Смещение секунды от начала сессии с учётом перехода через полночь.
+int offset_from(int second, int start) {
+  const int offset = second - start;
+  return offset < 0 ? offset + static_cast<int>(kSecondsPerDay) : offset;
+}
+
+}  // namespace
+
+PivotLevels classic_pivots(const SessionPeriod& period) {
+  PivotLevels levels;
+  const double range = period.high - period.low;
+  levels.pivot = (period.high + period.low + period.close) / 3.0;
+  levels.r1 = 2.0 * levels.pivot - period.low;
+  levels.s1 = 2.0 * levels.pivot - period.high;
+  levels.r2 = levels.pivot + range;
+  levels.s2 = levels.pivot - range;
+  levels.r3 = period.high + 2.0 * (levels.pivot - period.low);
+  levels.s3 = period.low - 2.0 * (period.high - levels.pivot);
+  return levels;
+}
+
+SessionAggregator::SessionAggregator(SessionTimes times, int initial_balance_seconds)
+    : times_(times), initial_balance_seconds_(initial_balance_seconds) {
+  trading_start_second_ = times_.use_evening_session ? times_.evening_start_second
+                                                     : times_.start_second;
+  wraps_midnight_ = trading_start_second_ > times_.end_second;
+}
+
+int SessionAggregator::trading_date(Timestamp time) const noexcept {
+  const int date = time.date();
+  if (wraps_midnight_ && time.seconds_of_day() >= trading_start_second_) {
+    return date + 1;
+  }
+  return date;
+}
+
+std::size_t SessionAggregator::update(std::size_t bar_index, const OhlcBar& bar) {
+  SIERRA_TRACE_SCOPE("core", "SessionAggregator::update");
+  const std::size_t count = bar_periods_.size();
+  if (bar_index + 1 == count) {
+    // Откатываем последний бар к контрольной точке и применяем заново.
+    if (checkpoint_new_period_) {
+      periods_.pop_back();
+    } else {
+      periods_.back() = checkpoint_;
+    }
+    bar_periods_.pop_back();
+  } else if (bar_index != count) {
+    throw std::invalid_argument("SessionAggregator accepts only the next or the last bar");
+  }
+
+  apply(bar_index, bar);
+  return bar_periods_.back();
+}
+
+void SessionAggregator::apply(std::size_t bar_index, const OhlcBar& bar) {
+  const int date = trading_date(bar.time);
+  checkpoint_new_period_ = periods_.empty() || periods_.back().trading_date != date;
+  if (checkpoint_new_period_) {
+    SessionPeriod period;
+    period.trading_date = date;
+    period.first_bar = bar_index;
+    period.open = bar.open;
+    period.high = bar.high;
+    period.low = bar.low;
+    period.ib_high = std::numeric_limits<double>::quiet_NaN();
+    period.ib_low = std::numeric_limits<double>::quiet_NaN();
+    periods_.push_back(period);
+  } else {
+    checkpoint_ = periods_.back();
+  }
+
+  SessionPeriod& period = periods_.back();
+  period.last_bar = bar_index;
+  period.high = (std::max)(period.high, bar.high);
+  period.low = (std::min)(period.low, bar.low);
+  period.close = bar.close;
+  period.volume += bar.volume;
+
+  if (initial_balance_seconds_ > 0 && !period.ib_complete) {
+    const int second = bar.time.seconds_of_day();
+    const int session_length = offset_from(times_.end_second, times_.start_second);
+    const int offset = offset_from(second, times_.start_second);
+    if (offset <= session_length) {
+      if (offset < initial_balance_seconds_) {
+        period.ib_high = std::isnan(period.ib_high) ? bar.high : (std::max)(period.ib_high, bar.high);
+        period.ib_low = std::isnan(period.ib_low) ? bar.low : (std::min)(period.ib_low, bar.low);
+      } else {
+        period.ib_complete = true;
+      }
+    }
+  }
+
+  bar_periods_.push_back(static_cast<std::uint32_t>(periods_.size() - 1));
+}
+
+void SessionAggregator::reset() {
+  periods_.clear();
+  bar_periods_.clear();
+  checkpoint_ = SessionPeriod{};
+  checkpoint_new_period_ = false;
+}
+
+void SessionAggregator::save(SnapshotWriter& writer) const {
+  writer.put(kSnapshotVersion);
+  writer.put(times_);
+  writer.put(initial_balance_seconds_);
+  writer.put_vector(periods_);
+  writer.put_vector(bar_periods_);
+  writer.put(checkpoint_);
+  writer.put(checkpoint_new_period_);
+}
+
+bool SessionAggregator::restore(SnapshotReader& reader) {
+  if (reader.get<std::uint32_t>() != kSnapshotVersion) {
+    return false;
+  }
+  const auto times = reader.get<SessionTimes>();
+  if (times.start_second != times_.start_second || times.end_second != times_.end_second ||
+      times.evening_start_second != times_.evening_start_second ||
+      times.evening_end_second != times_.evening_end_second ||
+      times.use_evening_session != times_.use_evening_session ||
+      reader.get<int>() != initial_balance_seconds_) {
+    return false;
+  }
+  std::vector<SessionPeriod> periods;
+  std::vector<std::uint32_t> bar_periods;
+  reader.get_vector(periods);
+  reader.get_vector(bar_periods);
+  const auto checkpoint = reader.get<SessionPeriod>();
+  const auto checkpoint_new_period = reader.get<bool>();
+  for (const std::uint32_t period : bar_periods) {
+    if (period >= periods.size()) {
+      throw std::runtime_error("SessionAggregator::restore: bar refers to a missing period");
+    }
+  }
+  periods_ = std::move(periods);
+  bar_periods_ = std::move(bar_periods);
+  checkpoint_ = checkpoint;
+  checkpoint_new_period_ = checkpoint_new_period;
+  return true;
+}
+
+const SessionPeriod* SessionAggregator::prior(std::size_t back) const noexcept {
+  if (back >= periods_.size()) {
+    return nullptr;
+  }
+  return &periods_[periods_.size() - 1 - back];
+}
+
+}  // namespace sierra::core
@@ -0,0 +1,151 @@
+#include "sierra/core/shared_column_cache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iterator>
+
+namespace sierra::core {
+
+namespace {
+
+/// Начальная ёмкость блока столбца в барах.
+constexpr std::size_t kInitialCapacity = 1024;
+
+void combine(std::size_t& seed, std::size_t value) noexcept {
+  seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+}  // namespace
+
+std::size_t ColumnKeyHash::operator()(const ColumnKey& key) const noexcept {
+  std::size_t seed = std::hash<std::string>{}(key.symbol);
+  combine(seed, std::hash<std::int32_t>{}(key.bar_period_seconds));
+  combine(seed, std::hash<std::string>{}(key.study));
+  for (const double parameter : key.parameters) {
+    combine(seed, std::hash<double>{}(parameter));
+  }
+  combine(seed, std::hash<std::int64_t>{}(key.first_bar_time));
+  combine(seed, std::hash<std::uint32_t>{}(key.version));
+  return seed;
+}
+
+/// @brief Блок столбца: массивы фиксированной ёмкости и опубликованная длина.
+struct SharedColumn::Block {
+  explicit Block(std::size_t bars)
+      : capacity(bars),
+        values(std::make_unique<float[]>(bars)),
+        times(std::make_unique<std::int64_t[]>(bars)),
+        sources(std::make_unique<float[]>(bars)) {}
+
+  std::size_t capacity;
+  std::atomic<std::size_t> size{0};
+  std::unique_ptr<float[]> values;
+  std::unique_ptr<std::int64_t[]> times;
+  std::unique_ptr<float[]> sources;
+};
+
+SharedColumn::SharedColumn(std::shared_ptr<EpochDomain> domain) : domain_(std::move(domain)) {}
+
+SharedColumn::~SharedColumn() { delete block_.load(); }
+
+void SharedColumn::destroy(void* block) { delete static_cast<Block*>(block); }
+
+SharedColumn::View SharedColumn::read(const EpochDomain::Guard&) const noexcept {
+  const Block* block = block_.load();
+  if (block == nullptr) {
+    return View{};
+  }
+  return View{block->values.get(), block->times.get(), block->sources.get(),
+              block->size.load(std::memory_order_acquire)};
+}
+
+bool SharedColumn::append(std::size_t from, const float* values, const std::int64_t* times, const float* sources,
+                          std::size_t count) {
+  std::lock_guard<std::mutex> lock(writer_);
+  Block* block = block_.load(std::memory_order_relaxed);
+  const std::size_t size = block != nullptr ? block->size.load(std::memory_order_relaxed) : 0;
+  if (size != from) {
+    return false;
+  }
+  if (count == 0) {
+    return true;
+  }
+  if (block == nullptr || size + count > block->capacity) {
+    block = grow(block, (std::max)(kInitialCapacity, (std::max)(size + count, size * 2)));
+  }
+  // Бары за опубликованной длиной читатели не трогают, поэтому пишем в блок на месте.
+  std::memcpy(block->values.get() + size, values, count * sizeof(float));
+  std::memcpy(block->times.get() + size, times, count * sizeof(std::int64_t));
+  std::memcpy(block->sources.get() + size, sources, count * sizeof(float));
+  block->size.store(size + count, std::memory_order_release);
+  size_.store(size + count, std::memory_order_release);
+  return true;
+}
+
+void SharedColumn::reserve(std::size_t bars) {
+  std::lock_guard<std::mutex> lock(writer_);
+  Block* block = block_.load(std::memory_order_relaxed);
+  if (block == nullptr || bars > block->capacity) {
+    grow(block, bars);
+  }
+}
+
+/// @note Вызывается под `writer_`; старый блок освобождается через эпохи.
+SharedColumn::Block* SharedColumn::grow(Block* block, std::size_t capacity) {
+  const std::size_t size = block != nullptr ? block->size.load(std::memory_order_relaxed) : 0;
+  auto grown = std::make_unique<Block>(capacity);
+  if (block != nullptr) {
+    std::memcpy(grown->values.get(), block->values.get(), size * sizeof(float));
+    std::memcpy(grown->times.get(), block->times.get(), size * sizeof(std::int64_t));
+    std::memcpy(grown->sources.get(), block->sources.get(), size * sizeof(float));
+  }
+  grown->size.store(size, std::memory_order_relaxed);
+  Block* published = grown.release();
+  block_.store(published);
+  if (block != nullptr) {
+    domain_->retire(block, &SharedColumn::destroy);
+  }
+  return published;
+}
+
+std::size_t SharedColumn::memory_bytes() const noexcept {
+  const EpochDomain::Guard guard = domain_->pin();
+  const Block* block = block_.load();
+  return block != nullptr ? block->capacity * (sizeof(float) * 2 + sizeof(std::int64_t)) : 0;
+}
+
+SharedColumnCache::SharedColumnCache() : domain_(std::make_shared<EpochDomain>()) {}
+
+std::shared_ptr<SharedColumn> SharedColumnCache::acquire(const ColumnKey& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto it = columns_.begin(); it != columns_.end();) {
+    it = it->second.expired() ? columns_.erase(it) : std::next(it);
+  }
+  std::weak_ptr<SharedColumn>& slot = columns_[key];
+  std::shared_ptr<SharedColumn> column = slot.lock();
+  if (column == nullptr) {
+    column = std::make_shared<SharedColumn>(domain_);
+    slot = column;
+  }
+  return column;
+}
+
+std::size_t SharedColumnCache::columns() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return static_cast<std::size_t>(std::count_if(columns_.begin(), columns_.end(),
+                                                [](const auto& entry) { return !entry.second.expired(); }));
+}
+
+std::size_t SharedColumnCache::memory_bytes() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::size_t bytes = 0;
+  for (const auto& entry : columns_) {
+    if (const auto column = entry.second.lock()) {
+      bytes += column->memory_bytes();
+    }
+  }
+  return bytes;
+}
+
+}  // namespace sierra::core
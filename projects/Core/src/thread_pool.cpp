@@ -0,0 +1,129 @@
+#include "sierra/core/thread_pool.hpp"
+
+#include "sierra/core/trace.hpp"
+
+#include <algorithm>
+
+namespace sierra::core {
+
+namespace {
+
+/// @brief Пул и индекс очереди текущего потока; у внешних потоков — `nullptr`.
+thread_local const ThreadPool* tls_pool = nullptr;
+thread_local std::size_t tls_index = 0;
+
+}  // namespace
+
+ThreadPool::ThreadPool(std::size_t threads) {
+  if (threads == 0) {
+    threads = (std::max)(1u, std::thread::hardware_concurrency());
+  }
+  queues_.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  threads_.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    threads_.emplace_back([this, i] { worker_loop(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    idle_.wait(lock, [this] { return unfinished_ == 0; });
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void ThreadPool::submit(Task task) {
+  const std::size_t index = tls_pool == this
+                                ? tls_index
+                                : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+  {
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    queues_[index]->tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    ++queued_;
+    ++unfinished_;
+  }
+  wake_.notify_one();
+}
+
+void ThreadPool::wait_idle() {
+  std::unique_lock<std::mutex> lock(state_mutex_);
+  idle_.wait(lock, [this] { return unfinished_ == 0; });
+  if (error_) {
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+/// @note Сначала своя очередь с конца, затем обход чужих очередей с начала.
+bool ThreadPool::take(std::size_t index, Task& task) {
+  {
+    Queue& own = *queues_[index];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      return true;
+    }
+  }
+  for (std::size_t offset = 1; offset < queues_.size(); ++offset) {
+    Queue& victim = *queues_[(index + offset) % queues_.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      steals_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::worker_loop(std::size_t index) {
+  tls_pool = this;
+  tls_index = index;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(state_mutex_);
+      wake_.wait(lock, [this] { return stop_ || queued_ > 0; });
+      if (stop_ && queued_ == 0) {
+        return;
+      }
+      // Резервируем одну задачу: после этого она гарантированно лежит в какой-то очереди.
+      --queued_;
+    }
+
+    Task task;
+    while (!take(index, task)) {
+      std::this_thread::yield();
+    }
+
+    try {
+      SIERRA_TRACE_SCOPE("core", "ThreadPool task");
+      task();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(state_mutex_);
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    if (--unfinished_ == 0) {
+      idle_.notify_all();
+    }
+  }
+}
+
+}  // namespace sierra::core
@@ -0,0 +1,31 @@
+#include "sierra/core/tick_clock.hpp"
+
+namespace sierra::core {
+
+namespace {
+
+template <typename Clock>
+std::int64_t now_ns() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+}  // namespace
+
+TickCalibration::TickCalibration() noexcept
+    : anchor_ticks_(read_ticks()),
+      anchor_steady_ns_(now_ns<std::chrono::steady_clock>()),
+      anchor_system_ns_(now_ns<std::chrono::system_clock>()) {}
+
+void TickCalibration::update() noexcept {
+  const std::int64_t ticks = read_ticks();
+  const std::int64_t steady = now_ns<std::chrono::steady_clock>();
+  if (ticks > anchor_ticks_ && steady > anchor_steady_ns_) {
+    ns_per_tick_ = static_cast<double>(steady - anchor_steady_ns_) / static_cast<double>(ticks - anchor_ticks_);
+  }
+}
+
+std::int64_t TickCalibration::to_system_ns(std::int64_t ticks) const noexcept {
+  return anchor_system_ns_ + static_cast<std::int64_t>(to_nanoseconds(ticks - anchor_ticks_));
+}
+
+}  // namespace sierra::core
@@ -0,0 +1,129 @@
+#include "sierra/core/timestamp.hpp"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define SIERRA_CORE_HAS_SSE2 1
+#include <emmintrin.h>
+#else
+#define SIERRA_CORE_HAS_SSE2 0
+#endif
+
+namespace sierra::core {
+
+namespace {
+
+/// @brief Скалярная раскладка одного значения — эталон для SIMD-ветки.
+inline void decompose_one(std::int64_t value, std::int32_t& date, std::int32_t& seconds,
+                          std::uint8_t& weekday) {
+  const Timestamp stamp = Timestamp::from_microseconds(value);
+  date = stamp.date();
+  seconds = stamp.seconds_of_day();
+  weekday = static_cast<std::uint8_t>(stamp.day_of_week());
+}
+
+#if SIERRA_CORE_HAS_SSE2
+/// @brief Переводит два неотрицательных int64 (< 2^52) в double без AVX-512.
+/// @note Трюк с «магическим» числом 2^52: мантисса принимает целое напрямую.
+inline __m128d small_int64_to_double(__m128i value) {
+  const __m128i magic_bits = _mm_set1_epi64x(0x4330000000000000LL);
+  const __m128d magic = _mm_set1_pd(4503599627370496.0);
+  return _mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(value, magic_bits)), magic);
+}
+#endif
+
+}  // namespace
+
+void to_microseconds(const double* days, std::size_t count, std::int64_t* out) {
+  for (std::size_t i = 0; i < count; ++i) {
+    out[i] = Timestamp::from_days(days[i]).microseconds();
+  }
+}
+
+/// @note Дата и день недели у блока из четырёх значений общие, если блок целиком внутри одного дня; секунды считаются делением в double, которое для смещений внутри суток точно.
+void decompose_calendar(const std::int64_t* microseconds, std::size_t count, std::int32_t* date,
+                        std::int32_t* seconds, std::uint8_t* weekday) {
+  std::size_t i = 0;
+#if SIERRA_CORE_HAS_SSE2
+  std::int64_t day_start = -1;
+  std::int32_t day_date = 0;
+  std::uint8_t day_weekday = 0;
+  const __m128d inverse_scale = _mm_set1_pd(static_cast<double>(kMicrosecondsPerSecond));
+
+  for (; i + 4 <= count; i += 4) {
+    const std::int64_t first = microseconds[i];
+    const std::int64_t last = microseconds[i + 3];
+    if (first < day_start || first >= day_start + kMicrosecondsPerDay) {
+      if (first < 0) {
+        for (std::size_t k = 0; k < 4; ++k) {
+          decompose_one(microseconds[i + k], date[i + k], seconds[i + k], weekday[i + k]);
+        }
+        continue;
+      }
+      const Timestamp stamp = Timestamp::from_microseconds(first);
+      day_date = stamp.date();
+      day_weekday = static_cast<std::uint8_t>(stamp.day_of_week());
+      day_start = static_cast<std::int64_t>(day_date) * kMicrosecondsPerDay;
+    }
+
+    const std::int64_t day_end = day_start + kMicrosecondsPerDay;
+    bool same_day = last >= day_start && last < day_end;
+    for (std::size_t k = 1; same_day && k < 3; ++k) {
+      same_day = microseconds[i + k] >= day_start && microseconds[i + k] < day_end;
+    }
+    if (!same_day) {
+      for (std::size_t k = 0; k < 4; ++k) {
+        decompose_one(microseconds[i + k], date[i + k], seconds[i + k], weekday[i + k]);
+      }
+      continue;
+    }
+
+    const __m128i base = _mm_set1_epi64x(day_start);
+    const __m128i low = _mm_sub_epi64(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(microseconds + i)), base);
+    const __m128i high = _mm_sub_epi64(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(microseconds + i + 2)), base);
+    const __m128i seconds_low =
+        _mm_cvttpd_epi32(_mm_div_pd(small_int64_to_double(low), inverse_scale));
+    const __m128i seconds_high =
+        _mm_cvttpd_epi32(_mm_div_pd(small_int64_to_double(high), inverse_scale));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(seconds + i),
+                     _mm_unpacklo_epi64(seconds_low, seconds_high));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(date + i), _mm_set1_epi32(day_date));
+    std::memset(weekday + i, day_weekday, 4);
+  }
+#endif
+  for (; i < count; ++i) {
+    decompose_one(microseconds[i], date[i], seconds[i], weekday[i]);
+  }
+}
+
+/// @note Для сессии через полночь маска — объединение двух полуинтервалов, для обычной — пересечение.
+void session_mask(const std::int32_t* seconds, std::size_t count, int start_second, int end_second,
+                  std::uint8_t* mask) {
+  const bool overnight = end_second < start_second;
+  std::size_t i = 0;
+#if SIERRA_CORE_HAS_SSE2
+  const __m128i start_minus_one = _mm_set1_epi32(start_second - 1);
+  const __m128i end_plus_one = _mm_set1_epi32(end_second + 1);
+  for (; i + 4 <= count; i += 4) {
+    const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(seconds + i));
+    const __m128i after_start = _mm_cmpgt_epi32(value, start_minus_one);
+    const __m128i before_end = _mm_cmplt_epi32(value, end_plus_one);
+    const __m128i inside = overnight ? _mm_or_si128(after_start, before_end)
+                                     : _mm_and_si128(after_start, before_end);
+    const int bits = _mm_movemask_ps(_mm_castsi128_ps(inside));
+    for (int k = 0; k < 4; ++k) {
+      mask[i + static_cast<std::size_t>(k)] = static_cast<std::uint8_t>((bits >> k) & 1);
+    }
+  }
+#endif
+  for (; i < count; ++i) {
+    const bool after_start = seconds[i] >= start_second;
+    const bool before_end = seconds[i] <= end_second;
+    mask[i] = static_cast<std::uint8_t>(overnight ? (after_start || before_end)
+                                                  : (after_start && before_end));
+  }
+}
+
+}  // namespace sierra::core
@@ -0,0 +1,115 @@
+#include "sierra/core/timestamp_aligner.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+namespace sierra::core {
+
+TimestampAligner::TimestampAligner(std::size_t source_count)
+    : mappings_(source_count), sources_(source_count) {}
+
+std::size_t TimestampAligner::update(TimeColumn destination,
+                                     const std::vector<TimeColumn>& sources) {
+  if (sources.size() != mappings_.size()) {
+    throw std::invalid_argument("TimestampAligner source count mismatch");
+  }
+  if (destination.size < mapped_) {
+    reset();
+  }
+
+  const std::size_t last = mapped_ == 0 ? 0 : mapped_ - 1;
+  std::size_t first_changed = last;
+  for (std::size_t s = 0; s < sources.size(); ++s) {
+    const TimeColumn& source = sources[s];
+    SourceState& state = sources_[s];
+    std::vector<int>& mapping = mappings_[s];
+    mapping.resize(destination.size, kNoMatch);
+
+    std::size_t start = last;
+    if (source.size < state.size || (state.size != 0 && source.data[0] != state.first)) {
+      start = 0;
+    } else if (source.size > state.size) {
+      // Бары раньше первого нового бара источника его не видят: их сопоставление не меняется.
+      const std::int64_t* end = destination.data + last;
+      start = static_cast<std::size_t>(std::lower_bound(destination.data, end, source.data[state.size]) -
+                                        destination.data);
+    }
+    state.size = source.size;
+    state.first = source.size != 0 ? source.data[0] : 0;
+    first_changed = (std::min)(first_changed, start);
+
+    // Курсор продолжает с индекса, найденного для бара перед точкой пересчёта.
+    std::size_t cursor = 0;
+    bool matched = false;
+    if (start > 0 && mapping[start - 1] != kNoMatch) {
+      cursor = static_cast<std::size_t>(mapping[start - 1]);
+      matched = true;
+    }
+
+    for (std::size_t d = start; d < destination.size; ++d) {
+      const std::int64_t time = destination.data[d];
+      if (!matched) {
+        if (source.size == 0 || source.data[0] > time) {
+          mapping[d] = kNoMatch;
+          continue;
+        }
+        matched = true;
+      }
+      while (cursor + 1 < source.size && source.data[cursor + 1] <= time) {
+        ++cursor;
+      }
+      mapping[d] = static_cast<int>(cursor);
+    }
+  }
+
+  mapped_ = destination.size;
+  return first_changed;
+}
+
+void TimestampAligner::reset() {
+  for (auto& mapping : mappings_) {
+    mapping.clear();
+  }
+  for (auto& state : sources_) {
+    state = SourceState{};
+  }
+  mapped_ = 0;
+}
+
+std::vector<int> parse_chart_numbers(std::string_view text) {
+  std::vector<int> numbers;
+  std::size_t pos = 0;
+  while (pos <= text.size()) {
+    const std::size_t comma = text.find(',', pos);
+    const std::size_t end = comma == std::string_view::npos ? text.size() : comma;
+
+    int value = 0;
+    bool has_digits = false;
+    bool valid = true;
+    bool negative = false;
+    for (std::size_t i = pos; i < end; ++i) {
+      const char ch = text[i];
+      if (std::isdigit(static_cast<unsigned char>(ch))) {
+        value = value * 10 + (ch - '0');
+        has_digits = true;
+      } else if (ch == '-' && !has_digits && !negative) {
+        negative = true;
+      } else if (!std::isspace(static_cast<unsigned char>(ch))) {
+        valid = false;
+        break;
+      }
+    }
+    if (valid && has_digits) {
+      numbers.push_back(negative ? -value : value);
+    }
+
+    if (comma == std::string_view::npos) {
+      break;
+    }
+    pos = comma + 1;
+  }
+  return numbers;
+}
+
+}  // namespace sierra::core
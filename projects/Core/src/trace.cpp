@@ -0,0 +1,144 @@
+#include "sierra/core/trace.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+
+namespace sierra::core {
+
+namespace {
+
+/// Очередь, в которую текущий поток пишет интервалы; сборщик живёт до выгрузки модуля.
+thread_local void* t_trace_buffer = nullptr;
+
+/// @brief Экранирует строку для JSON (кавычки, обратная косая черта, управляющие символы).
+void append_json_string(const char* text, std::string& out) {
+  out += '"';
+  for (const char* cursor = text != nullptr ? text : ""; *cursor != '\0'; ++cursor) {
+    const char c = *cursor;
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+      out += escaped;
+    } else {
+      out += c;
+    }
+  }
+  out += '"';
+}
+
+}  // namespace
+
+TraceRecorder& TraceRecorder::instance() {
+  static TraceRecorder recorder;
+  return recorder;
+}
+
+void TraceRecorder::start(std::size_t per_thread_capacity) {
+  if (per_thread_capacity == 0) {
+    throw std::invalid_argument("TraceRecorder capacity must be greater than zero");
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  TraceEvent discarded;
+  for (const auto& buffer : buffers_) {
+    while (buffer->ring.try_pop(discarded)) {
+    }
+  }
+  capacity_ = per_thread_capacity;
+  dropped_.store(0, std::memory_order_relaxed);
+  origin_ = read_ticks();
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void TraceRecorder::record(const char* category, const char* name, std::int64_t start,
+                           std::int64_t end) noexcept {
+  Buffer* buffer = current_buffer();
+  if (buffer == nullptr || !buffer->ring.try_push(TraceEvent{category, name, start, end})) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+/// @note Очередь закреплена за `std::thread::id` и переживает поток, чтобы его интервалы попали в выгрузку.
+TraceRecorder::Buffer* TraceRecorder::current_buffer() noexcept {
+  if (t_trace_buffer != nullptr) {
+    return static_cast<Buffer*>(t_trace_buffer);
+  }
+  const std::thread::id self = std::this_thread::get_id();
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto& buffer : buffers_) {
+    if (buffer->owner == self) {
+      t_trace_buffer = buffer.get();
+      return buffer.get();
+    }
+  }
+  try {
+    auto buffer = std::make_unique<Buffer>(capacity_, static_cast<std::uint32_t>(buffers_.size()));
+    buffer->owner = self;
+    buffers_.push_back(std::move(buffer));
+  } catch (...) {
+    return nullptr;
+  }
+  t_trace_buffer = buffers_.back().get();
+  return buffers_.back().get();
+}
+
+std::size_t TraceRecorder::write_chrome_json(std::ostream& out) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  clock_.update();
+
+  std::string text = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  const auto separator = [&] {
+    if (!first) {
+      text += ",\n";
+    }
+    first = false;
+  };
+  char number[128];
+  std::size_t written = 0;
+  for (const auto& buffer : buffers_) {
+    separator();
+    std::snprintf(number, sizeof(number),
+                  "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+                  static_cast<unsigned>(buffer->thread), static_cast<unsigned>(buffer->thread));
+    text += number;
+
+    TraceEvent event;
+    while (buffer->ring.try_pop(event)) {
+      separator();
+      text += "{\"name\":";
+      append_json_string(event.name, text);
+      text += ",\"cat\":";
+      append_json_string(event.category, text);
+      const double ts = clock_.to_nanoseconds(event.start - origin_) / 1000.0;
+      const double dur = clock_.to_nanoseconds((std::max)(event.end - event.start, std::int64_t{0})) / 1000.0;
+      std::snprintf(number, sizeof(number), ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}", ts, dur,
+                    static_cast<unsigned>(buffer->thread));
+      text += number;
+      ++written;
+    }
+  }
+  text += "]}\n";
+  out << text;
+  return written;
+}
+
+std::size_t TraceRecorder::dump(const std::string& path) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    throw std::runtime_error("TraceRecorder cannot open " + path);
+  }
+  const std::size_t written = write_chrome_json(file);
+  file.flush();
+  if (!file) {
+    throw std::runtime_error("TraceRecorder failed to write " + path);
+  }
+  return written;
+}
+
+}  // namespace sierra::core
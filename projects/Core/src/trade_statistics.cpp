@@ -0,0 +1,124 @@
+#include "sierra/core/trade_statistics.hpp"
+
+#include "sierra/core/backtester.hpp"
+
+#include <algorithm>
+
+namespace sierra::core {
+
+/// @note Просадка и рост считаются по кривой закрытой прибыли относительно её экстремумов до этой сделки, серии — по длине текущего «хвоста».
+void TradeStatistics::add(const BacktestTrade& trade) noexcept {
+  const double profit = trade.profit_loss - trade.commission;
+  const std::int64_t duration = trade.close_time.microseconds() - trade.open_time.microseconds();
+  const std::int64_t quantity = trade.exit_quantity;
+
+  total_commission += trade.commission;
+  if (trade.direction > 0) {
+    ++long_trades;
+  } else {
+    ++short_trades;
+  }
+  largest_trade_quantity = (std::max)(largest_trade_quantity, trade.max_open_quantity);
+  maximum_trade_runup = (std::max)(maximum_trade_runup, trade.max_open_profit);
+  maximum_trade_drawdown = (std::min)(maximum_trade_drawdown, trade.max_open_loss);
+
+  const double equity = net_profit() + profit;
+  maximum_drawdown = (std::min)(maximum_drawdown, equity - equity_high);
+  maximum_runup = (std::max)(maximum_runup, equity - equity_low);
+  equity_high = (std::max)(equity_high, equity);
+  equity_low = (std::min)(equity_low, equity);
+
+  if (profit > 0.0) {
+    closed_profit += profit;
+    ++winning_trades;
+    winning_quantity += quantity;
+    largest_winning_trade = (std::max)(largest_winning_trade, profit);
+    time_in_winning_trades += duration;
+    if (leading_winners == total_trades) {
+      ++leading_winners;
+    }
+    ++trailing_winners;
+    trailing_losers = 0;
+    max_consecutive_winners = (std::max)(max_consecutive_winners, trailing_winners);
+  } else if (profit < 0.0) {
+    closed_loss += profit;
+    ++losing_trades;
+    losing_quantity += quantity;
+    largest_losing_trade = (std::min)(largest_losing_trade, profit);
+    time_in_losing_trades += duration;
+    if (leading_losers == total_trades) {
+      ++leading_losers;
+    }
+    ++trailing_losers;
+    trailing_winners = 0;
+    max_consecutive_losers = (std::max)(max_consecutive_losers, trailing_losers);
+  } else {
+    trailing_winners = 0;
+    trailing_losers = 0;
+  }
+  ++total_trades;
+}
+
+/// @note Экстремумы кривой следующего участка сдвигаются на чистую прибыль этого; серии склеиваются по «хвосту» этого и «голове» следующего участка.
+void TradeStatistics::merge(const TradeStatistics& next) noexcept {
+  const double offset = net_profit();
+  maximum_drawdown = (std::min)({maximum_drawdown, next.maximum_drawdown, offset + next.equity_low - equity_high});
+  maximum_runup = (std::max)({maximum_runup, next.maximum_runup, offset + next.equity_high - equity_low});
+  equity_high = (std::max)(equity_high, offset + next.equity_high);
+  equity_low = (std::min)(equity_low, offset + next.equity_low);
+
+  max_consecutive_winners = (std::max)(
+      {max_consecutive_winners, next.max_consecutive_winners, trailing_winners + next.leading_winners});
+  max_consecutive_losers = (std::max)(
+      {max_consecutive_losers, next.max_consecutive_losers, trailing_losers + next.leading_losers});
+  if (leading_winners == total_trades) {
+    leading_winners += next.leading_winners;
+  }
+  if (leading_losers == total_trades) {
+    leading_losers += next.leading_losers;
+  }
+  trailing_winners = next.trailing_winners == next.total_trades ? trailing_winners + next.trailing_winners
+                                                                  : next.trailing_winners;
+  trailing_losers = next.trailing_losers == next.total_trades ? trailing_losers + next.trailing_losers
+                                                                : next.trailing_losers;
+
+  closed_profit += next.closed_profit;
+  closed_loss += next.closed_loss;
+  total_commission += next.total_commission;
+  maximum_trade_runup = (std::max)(maximum_trade_runup, next.maximum_trade_runup);
+  maximum_trade_drawdown = (std::min)(maximum_trade_drawdown, next.maximum_trade_drawdown);
+  total_trades += next.total_trades;
+  winning_trades += next.winning_trades;
+  losing_trades += next.losing_trades;
+  long_trades += next.long_trades;
+  short_trades += next.short_trades;
+  winning_quantity += next.winning_quantity;
+  losing_quantity += next.losing_quantity;
+  largest_trade_quantity = (std::max)(largest_trade_quantity, next.largest_trade_quantity);
+  largest_winning_trade = (std::max)(largest_winning_trade, next.largest_winning_trade);
+  largest_losing_trade = (std::min)(largest_losing_trade, next.largest_losing_trade);
+  time_in_winning_trades += next.time_in_winning_trades;
+  time_in_losing_trades += next.time_in_losing_trades;
+}
+
+double TradeStatistics::profit_factor() const noexcept {
+  return closed_loss == 0.0 ? 0.0 : closed_profit / -closed_loss;
+}
+
+double TradeStatistics::percent_profitable() const noexcept {
+  return total_trades == 0 ? 0.0 : static_cast<double>(winning_trades) / static_cast<double>(total_trades);
+}
+
+double TradeStatistics::average_trade() const noexcept {
+  return total_trades == 0 ? 0.0 : net_profit() / static_cast<double>(total_trades);
+}
+
+double TradeStatistics::average_winner() const noexcept {
+  return winning_trades == 0 ? 0.0 : closed_profit / static_cast<double>(winning_trades);
+}
+
+double TradeStatistics::average_loser() const noexcept {
+  return losing_trades == 0 ? 0.0 : closed_loss / static_cast<double>(losing_trades);
+}
+
+}  // namespace sierra::core
@@ -0,0 +1,109 @@
+#include "sierra/core/walk_forward.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+
+namespace sierra::core {
+
+WalkForwardReport walk_forward(std::size_t tick_count, const std::vector<ParameterSet>& candidates,
+                               const SegmentEvaluator& evaluate, const OutOfSampleEvaluator& run_out_of_sample,
+                               const WalkForwardOptions& options, ThreadPool& pool) {
+  if (options.segment_ticks == 0 || options.train_segments == 0 || options.test_segments == 0) {
+    throw std::invalid_argument("walk_forward window sizes must be greater than zero");
+  }
+  if (options.carry_position && !run_out_of_sample) {
+    throw std::invalid_argument("walk_forward carry_position requires an out-of-sample evaluator");
+  }
+
+  using Clock = std::chrono::steady_clock;
+  const auto wall_start = Clock::now();
+
+  WalkForwardReport report;
+  const std::size_t segment_count = tick_count / options.segment_ticks;
+  const std::size_t window = options.train_segments + options.test_segments;
+  if (candidates.empty() || segment_count < window) {
+    return report;
+  }
+  const std::size_t fold_count = (segment_count - window) / options.test_segments + 1;
+  const std::size_t used_segments = (fold_count - 1) * options.test_segments + window;
+
+  // Матрица оценок «кандидат × сегмент»: каждая ячейка пишется ровно одной задачей.
+  const std::size_t cells = candidates.size() * used_segments;
+  std::vector<double> scores(cells, 0.0);
+  std::vector<double> seconds(cells, 0.0);
+  for (std::size_t c = 0; c < candidates.size(); ++c) {
+    for (std::size_t s = 0; s < used_segments; ++s) {
+      pool.submit([&, c, s] {
+        const auto start = Clock::now();
+        const std::size_t begin = s * options.segment_ticks;
+        scores[c * used_segments + s] = evaluate(candidates[c], begin, begin + options.segment_ticks);
+        seconds[c * used_segments + s] =
+            std::chrono::duration<double>(Clock::now() - start).count();
+      });
+    }
+  }
+  pool.wait_idle();
+
+  std::size_t attributed = 0;  // сегменты [0, attributed) уже учтены предыдущими фолдами
+  for (std::size_t k = 0; k < fold_count; ++k) {
+    const std::size_t first = k * options.test_segments;
+    const std::size_t train_last = first + options.train_segments;
+    const std::size_t test_last = train_last + options.test_segments;
+
+    WalkForwardFold fold;
+    fold.train_begin = first * options.segment_ticks;
+    fold.train_end = train_last * options.segment_ticks;
+    fold.test_begin = fold.train_end;
+    fold.test_end = test_last * options.segment_ticks;
+
+    double best = -std::numeric_limits<double>::infinity();
+    std::size_t best_index = 0;
+    for (std::size_t c = 0; c < candidates.size(); ++c) {
+      double total = 0.0;
+      for (std::size_t s = first; s < train_last; ++s) {
+        total += scores[c * used_segments + s];
+      }
+      if (total > best) {
+        best = total;
+        best_index = c;
+      }
+    }
+    fold.best_parameters = candidates[best_index];
+    fold.train_objective = best;
+    for (std::size_t s = train_last; s < test_last; ++s) {
+      fold.flat_test_objective += scores[best_index * used_segments + s];
+    }
+
+    const std::size_t fresh = test_last - (std::max)(attributed, first);
+    fold.evaluated_segments = fresh * candidates.size();
+    fold.reused_segments = window * candidates.size() - fold.evaluated_segments;
+    for (std::size_t c = 0; c < candidates.size(); ++c) {
+      for (std::size_t s = (std::max)(attributed, first); s < test_last; ++s) {
+        fold.seconds += seconds[c * used_segments + s];
+      }
+    }
+    if (fold.seconds > 0.0) {
+      fold.ticks_per_second =
+          static_cast<double>(fold.evaluated_segments * options.segment_ticks) / fold.seconds;
+    }
+    attributed = test_last;
+
+    report.flat_test_objective += fold.flat_test_objective;
+    report.folds.push_back(std::move(fold));
+  }
+
+  // Окна проверки идут встык, поэтому последовательный прогон сшивает их в одну непрерывную торговлю.
+  for (auto& fold : report.folds) {
+    fold.test_objective = options.carry_position
+                              ? run_out_of_sample(fold.best_parameters, fold.test_begin, fold.test_end)
+                              : fold.flat_test_objective;
+    report.total_test_objective += fold.test_objective;
+  }
+
+  report.wall_seconds = std::chrono::duration<double>(Clock::now() - wall_start).count();
+  return report;
+}
+
+}  // namespace sierra::core
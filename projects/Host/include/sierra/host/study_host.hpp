@@ -0,0 +1,155 @@
+#pragma once
+
+#include "SierraChart.h"
+
+#include "sierra/core/call_recording.hpp"
+#include "sierra/core/quantile_sketch.hpp"
+#include "sierra/core/scid_file.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sierra::host {
+
+/// @brief Функция исследования ACSIL (`scsf_*`).
+using StudyFunction = void (*)(SCStudyInterfaceRef);
+
+/// @brief Счётчики глобальных `operator new`/`delete` процесса.
+struct AllocationCounters {
+  std::uint64_t count = 0;
+  std::uint64_t bytes = 0;
+  std::uint64_t frees = 0;  ///< Освобождения ненулевых указателей.
+};
+
+/// @brief Текущие значения счётчиков выделений.
+/// @note Считаются все потоки процесса; заменённые операторы находятся в allocation_counter.cpp.
+AllocationCounters allocation_counters() noexcept;
+
+/// @brief Статистика вызовов функции исследования за одну фазу.
+struct CallReport {
+  explicit CallReport(std::string phase_name = {}, double relative_accuracy = 0.01)
+      : phase(std::move(phase_name)), nanoseconds(relative_accuracy) {}
+
+  std::string phase;
+  std::size_t calls = 0;
+  double total_nanoseconds = 0.0;
+  core::QuantileSketch nanoseconds;  ///< Время одного вызова.
+  std::uint64_t allocations = 0;
+  std::uint64_t allocated_bytes = 0;
+  std::uint64_t deallocations = 0;
+
+  /// @brief Среднее время вызова в наносекундах.
+  double mean_nanoseconds() const noexcept {
+    return calls == 0 ? 0.0 : total_nanoseconds / static_cast<double>(calls);
+  }
+
+  /// @brief Добавляет вызовы отчёта той же фазы (например, другого графика).
+  void merge(const CallReport& other) {
+    calls += other.calls;
+    total_nanoseconds += other.total_nanoseconds;
+    nanoseconds.merge(other.nanoseconds);
+    allocations += other.allocations;
+    allocated_bytes += other.allocated_bytes;
+    deallocations += other.deallocations;
+  }
+};
+
+/**
+ * @brief Headless-хост, который вызывает `scsf_*` так же, как Sierra Chart: SetDefaults, полный пересчёт и
+ * обновления последнего бара в реальном времени.
+ * @note Хост владеет буферами баров и подграфиков, а окна `s_sc` (`BaseDataIn`, `Close`, `Subgraph[].Data`, …)
+ * перенаправляет на них после каждого изменения размера. Память выделяется только для подграфиков, которым
+ * исследование задало `Name` в SetDefaults, — как и Sierra Chart, хост не рисует остальные.
+ * При `AutoLoop = 1` функция вызывается для каждого индекса от `UpdateStartIndex` до `ArraySize - 1`,
+ * при `AutoLoop = 0` — один раз с `Index = ArraySize - 1`. Выставленный исследованием `sc.FlagFullRecalculate`, как
+ * в Sierra Chart, превращает следующее обновление в полный пересчёт.
+ * @warning Время и выделения памяти замеряются только вокруг вызова исследования; работа хоста в отчёт не входит.
+ */
+class StudyHost {
+ public:
+  /// @param study Функция исследования.
+  /// @param relative_accuracy Точность квантилей времени вызова.
+  explicit StudyHost(StudyFunction study, double relative_accuracy = 0.01);
+
+  StudyHost(const StudyHost&) = delete;
+  StudyHost& operator=(const StudyHost&) = delete;
+
+  /// @brief Интерфейс исследования (для ручной настройки полей перед вызовами).
+  s_sc& sc() noexcept { return sc_; }
+
+  /// @brief Вызывает функцию с `SetDefaults = 1` и выделяет буферы именованных подграфиков.
+  CallReport set_defaults();
+
+  /// @brief Задаёт значение входа с учётом пределов, объявленных исследованием.
+  /// @warning При индексе вне `[0, SC_INPUTS_AVAILABLE)` выбрасывает `std::out_of_range`.
+  void set_input(int index, double value);
+
+  /// @brief Заменяет историю графика; подграфики обнуляются.
+  /// @param bars Бары в порядке времени (`ScidRecord` с заполненным `open`).
+  void load(std::vector<core::ScidRecord> bars);
+
+  /// @brief Полный пересчёт: `IsFullRecalculation = 1`, `UpdateStartIndex = 0`.
+  CallReport full_recalculation();
+
+  /// @brief Обновление текущего бара в реальном времени (новая сделка внутри бара).
+  /// @warning Без загруженных баров выбрасывает `std::logic_error`.
+  void update_last_bar(const core::ScidRecord& bar, CallReport& report);
+
+  /// @brief Новый бар в реальном времени; предыдущий бар пересчитывается вместе с ним.
+  void append_bar(const core::ScidRecord& bar, CallReport& report);
+
+  /**
+   * @brief Повторяет вызов, записанный `sierra::acsil::CallCapture`: срез баров, входы, persistent-значения и поля
+   * вызова берутся из записи, затем функция вызывается ровно один раз.
+   * @return Совпал ли отпечаток выходов (`sierra::acsil::SubgraphDigest`) с записанным.
+   * @warning Срез должен содержать `NUM_BASE_GRAPH_ARRAYS` массивов, а номера входов — лежать в
+   * `[0, SC_INPUTS_AVAILABLE)`; иначе выбрасывается `std::invalid_argument`.
+   */
+  bool replay(const core::RecordedCall& call, CallReport& report);
+
+  /// @brief Вызов с `LastCallToFunction = 1` при удалении исследования.
+  CallReport last_call();
+
+  /**
+   * @brief Замена DLL (`sc.FreeDLL = 1`, «Release DLL» / «Allow Load DLLs»): вызов с `LastCallToFunction = 1`,
+   * затем полный пересчёт уже загруженной истории.
+   * @param keep_outputs Оставить значения подграфиков до замены; `false` — обнулить их, как `full_recalculation`.
+   */
+  CallReport reload(bool keep_outputs);
+
+  /// @brief Сообщения, добавленные исследованием через `AddMessageToLog`.
+  const std::vector<std::string>& messages() const noexcept { return sc_.MockMessageLog; }
+
+  /// @brief Количество баров графика.
+  std::size_t size() const noexcept { return times_.size(); }
+
+ private:
+  void invoke(CallReport& report);
+  void run_update(int start, CallReport& report);
+  void clear_outputs();
+  void set_bar(std::size_t index, const core::ScidRecord& bar);
+  void resize(std::size_t size);
+  void attach();
+
+  StudyFunction study_;
+  double accuracy_;
+  s_sc sc_;
+  std::vector<float> base_[NUM_BASE_GRAPH_ARRAYS];
+  std::vector<SCDateTime> times_;
+  std::vector<int> active_subgraphs_;
+  std::vector<std::vector<float>> subgraph_data_;  ///< Для каждого активного подграфика: Data и Arrays[].
+};
+
+/// @brief Переносит сделку (или бар) в текущий бар: High/Low, Close, объёмы.
+void merge_into_bar(core::ScidRecord& bar, const core::ScidRecord& update) noexcept;
+
+/// @brief Бар из одной записи `.scid`: тиковые записи превращаются в бар O = H = L = C.
+core::ScidRecord to_bar(const core::ScidRecord& record) noexcept;
+
+/// @brief Детерминированные минутные бары случайного блуждания с шагом тика 0.25.
+std::vector<core::ScidRecord> synthetic_bars(std::size_t count, std::uint64_t seed = 1);
+
+}  // namespace sierra::host
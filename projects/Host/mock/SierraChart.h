@@ -0,0 +1,420 @@
+#pragma once
+
+/**
+ * @file SierraChart.h
+ * @brief Минимальная замена заголовка Sierra Chart SDK для headless-хоста SierraStudy.Host.
+ * @note Повторяет только ту часть интерфейса `s_sc`, которой пользуется обёртка: имена, типы и семантику
+ * полей SDK. Методы, которые в SDK являются указателями на функции хоста, здесь — обычные функции-члены;
+ * синтаксис вызова `sc.Method(...)` от этого не меняется. Поля и методы с префиксом `Mock` в SDK нет —
+ * через них хост (`sierra::host::StudyHost`) заполняет данные.
+ * @warning Не подключайте этот заголовок вместе с настоящим SDK: каталог `mock` должен стоять в пути
+ * включений первым только при сборке хоста.
+ */
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#define SC_DLL_VERSION 2000
+
+#define SCDLLEXPORT extern "C"
+#define SCDLLCALL
+
+#define SCSFExport SCDLLEXPORT void SCDLLCALL
+
+#define SCDLLName(DLLName)                                                   \
+  SCDLLEXPORT int SCDLLCALL scdll_DLLVersion() { return SC_DLL_VERSION; }    \
+  SCDLLEXPORT const char* SCDLLCALL scdll_DLLName() { return DLLName; }
+
+#ifndef RGB
+#define RGB(r, g, b)                                                                  \
+  (static_cast<unsigned int>(static_cast<unsigned char>(r)) |                        \
+   (static_cast<unsigned int>(static_cast<unsigned char>(g)) << 8) |                 \
+   (static_cast<unsigned int>(static_cast<unsigned char>(b)) << 16))
+#endif
+
+const int SC_OPEN = 0;
+const int SC_HIGH = 1;
+const int SC_LOW = 2;
+const int SC_LAST = 3;
+const int SC_VOLUME = 4;
+const int SC_NUM_TRADES = 5;
+const int SC_OHLC = 6;
+const int SC_HLC = 7;
+const int SC_HL = 8;
+const int SC_BIDVOL = 9;
+const int SC_ASKVOL = 10;
+const int NUM_BASE_GRAPH_ARRAYS = SC_ASKVOL + 1;
+
+const int SC_SUBGRAPHS_AVAILABLE = 60;
+const int SC_INPUTS_AVAILABLE = 128;
+/// Дополнительных массивов `Subgraph[].Arrays[]` на один подграфик.
+const int SC_SUBGRAPH_EXTRA_ARRAYS = 12;
+
+const int SC_TS_BID = 1;
+const int SC_TS_ASK = 2;
+const int SC_TS_BIDASKVALUES = 6;
+
+enum SubgraphDrawStyles {
+  DRAWSTYLE_LINE = 1,
+  DRAWSTYLE_BAR,
+  DRAWSTYLE_POINT,
+  DRAWSTYLE_DASH,
+  DRAWSTYLE_HIDDEN,
+  DRAWSTYLE_IGNORE,
+  DRAWSTYLE_STAIR_STEP,
+  DRAWSTYLE_SQUARE,
+  DRAWSTYLE_STAR,
+  DRAWSTYLE_ARROW_UP,
+  DRAWSTYLE_ARROW_DOWN,
+};
+
+/// @brief Строка SDK поверх `std::string`.
+class SCString {
+ public:
+  SCString() = default;
+  SCString(const char* text) : value_(text != nullptr ? text : "") {}
+  SCString(const std::string& text) : value_(text) {}
+
+  SCString& operator=(const char* text) {
+    value_ = text != nullptr ? text : "";
+    return *this;
+  }
+
+  const char* GetChars() const { return value_.c_str(); }
+  int GetLength() const { return static_cast<int>(value_.size()); }
+  bool IsEmpty() const { return value_.empty(); }
+  SCString& Append(const char* text) {
+    value_ += text != nullptr ? text : "";
+    return *this;
+  }
+  bool operator==(const char* text) const { return value_ == (text != nullptr ? text : ""); }
+  bool operator!=(const char* text) const { return !(*this == text); }
+
+ private:
+  std::string value_;
+};
+
+/// @brief Момент времени SDK: целые микросекунды от 1899-12-30, как в `SCDateTime` 64-битных версий.
+class SCDateTime {
+ public:
+  static constexpr std::int64_t kMicrosecondsPerDay = 86400000000LL;
+
+  SCDateTime() = default;
+  explicit SCDateTime(double days)
+      : value_(static_cast<std::int64_t>(days * static_cast<double>(kMicrosecondsPerDay) +
+                                         (days >= 0.0 ? 0.5 : -0.5))) {}
+
+  double GetAsDouble() const {
+    return static_cast<double>(value_) / static_cast<double>(kMicrosecondsPerDay);
+  }
+  std::int64_t GetInternalDateTime() const { return value_; }
+  void SetInternalDateTime(std::int64_t value) { value_ = value; }
+
+  bool operator==(const SCDateTime& other) const { return value_ == other.value_; }
+  bool operator!=(const SCDateTime& other) const { return value_ != other.value_; }
+  bool operator<(const SCDateTime& other) const { return value_ < other.value_; }
+
+ private:
+  std::int64_t value_ = 0;
+};
+
+typedef SCDateTime SCDateTimeMS;
+
+/**
+ * @brief Невладеющее окно на массив SDK (`c_ArrayWrapper`).
+ * @note Как и в SDK, индекс вне диапазона не падает, а прижимается к границам массива; у пустого массива
+ * возвращается служебный элемент.
+ */
+template <typename T>
+class c_ArrayWrapper {
+ public:
+  T& operator[](int index) { return ElementAt(index); }
+  const T& operator[](int index) const { return const_cast<c_ArrayWrapper*>(this)->ElementAt(index); }
+  T& ElementAt(int index) {
+    if (data_ == nullptr || size_ == 0) {
+      return default_;
+    }
+    index = index < 0 ? 0 : (index >= size_ ? size_ - 1 : index);
+    return data_[index];
+  }
+  int GetArraySize() const { return size_; }
+  T* GetPointer() { return data_; }
+  const T* GetPointer() const { return data_; }
+
+  /// @brief Перенаправляет окно на буфер хоста.
+  void MockAttach(T* data, int size) {
+    data_ = data;
+    size_ = data != nullptr ? size : 0;
+  }
+
+ private:
+  T* data_ = nullptr;
+  int size_ = 0;
+  T default_{};
+};
+
+typedef c_ArrayWrapper<float> SCFloatArray;
+typedef SCFloatArray& SCFloatArrayRef;
+typedef c_ArrayWrapper<SCDateTime> SCDateTimeArray;
+typedef SCDateTimeArray& SCDateTimeArrayRef;
+
+/// @brief Фиксированный набор окон (`SCFloatArrayArray` и `BaseData[]` в SDK).
+template <int N>
+class c_FloatArrayArray {
+ public:
+  SCFloatArray& operator[](int index) { return arrays_[clamp(index)]; }
+  const SCFloatArray& operator[](int index) const { return arrays_[clamp(index)]; }
+  int GetArraySize() const { return N; }
+
+ private:
+  static int clamp(int index) { return index < 0 ? 0 : (index >= N ? N - 1 : index); }
+  SCFloatArray arrays_[N];
+};
+
+struct s_SCSubgraph_260 {
+  SCString Name;
+  unsigned int PrimaryColor = 0;
+  unsigned int SecondaryColor = 0;
+  std::uint16_t DrawStyle = 0;
+  std::uint16_t LineWidth = 0;
+  int DrawZeros = 0;
+  SCFloatArray Data;
+  c_FloatArrayArray<SC_SUBGRAPH_EXTRA_ARRAYS> Arrays;
+
+  float& operator[](int index) { return Data[index]; }
+  operator SCFloatArray&() { return Data; }
+};
+typedef s_SCSubgraph_260& SCSubgraphRef;
+
+/// @brief Входной параметр исследования; значение хранится в одном поле, как объединение в SDK.
+struct s_SCInput_145 {
+  SCString Name;
+
+  void SetInt(int value) { number_ = value; }
+  int GetInt() const { return static_cast<int>(number_); }
+  void SetIntLimits(int minimum, int maximum) {
+    min_ = minimum;
+    max_ = maximum;
+  }
+  void SetFloat(float value) { number_ = value; }
+  float GetFloat() const { return static_cast<float>(number_); }
+  void SetFloatLimits(float minimum, float maximum) {
+    min_ = minimum;
+    max_ = maximum;
+  }
+  void SetDouble(double value) { number_ = value; }
+  double GetDouble() const { return number_; }
+  void SetYesNo(int value) { number_ = value != 0 ? 1.0 : 0.0; }
+  int GetYesNo() const { return number_ != 0.0 ? 1 : 0; }
+  int GetBoolean() const { return GetYesNo(); }
+  void SetInputDataIndex(int index) { number_ = index; }
+  int GetInputDataIndex() const { return GetInt(); }
+  void SetCustomInputIndex(int index) { number_ = index; }
+  int GetIndex() const { return GetInt(); }
+  void SetCustomInputStrings(const char*) {}
+  void SetString(const char* text) { text_ = text; }
+  const char* GetString() const { return text_.GetChars(); }
+
+  /// @brief Присваивает значение с учётом пределов, заданных исследованием.
+  void MockSet(double value) {
+    if (min_ < max_) {
+      value = value < min_ ? min_ : (value > max_ ? max_ : value);
+    }
+    number_ = value;
+  }
+
+ private:
+  double number_ = 0.0;
+  double min_ = 0.0;
+  double max_ = 0.0;
+  SCString text_;
+};
+typedef s_SCInput_145& SCInputRef;
+
+/// @brief Запись ленты сделок (поля, которые читает обёртка).
+struct s_TimeAndSales {
+  SCDateTimeMS DateTime;
+  float Price = 0.0f;
+  unsigned int Volume = 0;
+  float Bid = 0.0f;
+  float Ask = 0.0f;
+  unsigned int BidSize = 0;
+  unsigned int AskSize = 0;
+  unsigned int Sequence = 0;
+  char UnbundledTradeIndicator = 0;
+  int Type = 0;
+  unsigned int TotalBidDepth = 0;
+  unsigned int TotalAskDepth = 0;
+
+  s_TimeAndSales& operator*=(float multiplier) {
+    Price *= multiplier;
+    Bid *= multiplier;
+    Ask *= multiplier;
+    return *this;
+  }
+};
+
+/// @brief Копия ленты сделок, которую заполняет `sc.GetTimeAndSales`.
+class c_SCTimeAndSalesArray {
+ public:
+  int Size() const { return static_cast<int>(records_.size()); }
+  const s_TimeAndSales& operator[](int index) const { return records_[static_cast<std::size_t>(index)]; }
+  void MockAssign(const std::vector<s_TimeAndSales>& records) { records_ = records; }
+
+ private:
+  std::vector<s_TimeAndSales> records_;
+};
+
+/// @brief Сводки стакана по барам графика.
+class c_ACSILDepthBars {
+ public:
+  /// @brief Объёмы одного ценового уровня бара.
+  struct MockLevel {
+    int max_bid = 0;
+    int max_ask = 0;
+    int last_bid = 0;
+    int last_ask = 0;
+  };
+
+  float GetTickSize() { return tick_size_; }
+  int NumBars() { return static_cast<int>(bars_.size()); }
+  char DepthDataExistsAt(int barIndex) { return bar(barIndex) != nullptr && !bar(barIndex)->levels.empty(); }
+  int GetBarLowestPriceTickIndex(int barIndex) { return bar(barIndex) != nullptr ? bar(barIndex)->lowest : 0; }
+  int GetBarHighestPriceTickIndex(int barIndex) {
+    const Bar* b = bar(barIndex);
+    return b != nullptr ? b->lowest + static_cast<int>(b->levels.size()) - 1 : -1;
+  }
+  int GetMaxBidQuantity(int barIndex, int tickIndex) { return level(barIndex, tickIndex).max_bid; }
+  int GetMaxAskQuantity(int barIndex, int tickIndex) { return level(barIndex, tickIndex).max_ask; }
+  int GetLastBidQuantity(int barIndex, int tickIndex) { return level(barIndex, tickIndex).last_bid; }
+  int GetLastAskQuantity(int barIndex, int tickIndex) { return level(barIndex, tickIndex).last_ask; }
+  float TickIndexToPrice(int priceTickIndex) { return origin_ + static_cast<float>(priceTickIndex) * tick_size_; }
+
+  void MockSetTickSize(float tickSize) { tick_size_ = tickSize; }
+  /// @brief Цена индекса 0: индексы Sierra Chart не обязаны совпадать с `price / tick_size`.
+  void MockSetTickIndexOrigin(float price) { origin_ = price; }
+  /// @brief Добавляет бар со сплошным диапазоном уровней начиная с `lowest`; пустой диапазон — бар без данных.
+  void MockAddBar(int lowest, std::vector<MockLevel> levels) { bars_.push_back(Bar{lowest, std::move(levels)}); }
+
+ private:
+  struct Bar {
+    int lowest = 0;
+    std::vector<MockLevel> levels;
+  };
+
+  Bar* bar(int barIndex) {
+    return barIndex >= 0 && barIndex < NumBars() ? &bars_[static_cast<std::size_t>(barIndex)] : nullptr;
+  }
+  MockLevel level(int barIndex, int tickIndex) {
+    const Bar* b = bar(barIndex);
+    if (b == nullptr || tickIndex < b->lowest || tickIndex - b->lowest >= static_cast<int>(b->levels.size())) {
+      return MockLevel{};
+    }
+    return b->levels[static_cast<std::size_t>(tickIndex - b->lowest)];
+  }
+
+  float tick_size_ = 0.0f;
+  float origin_ = 0.0f;
+  std::vector<Bar> bars_;
+};
+
+/**
+ * @brief Интерфейс исследования, передаваемый в каждую функцию `scsf_*`.
+ * @note Ценовые массивы (`Open`, `Close`, …) — окна на те же буферы, что и `BaseDataIn[]`; их перенаправляет хост.
+ */
+struct s_sc {
+  // Управление вызовом.
+  int SetDefaults = 0;
+  int LastCallToFunction = 0;
+  int IsFullRecalculation = 0;
+  int AutoLoop = 0;
+  int Index = 0;
+  int CurrentIndex = 0;
+  int ArraySize = 0;
+  int UpdateStartIndex = 0;
+  int DataStartIndex = 0;
+  int UpdateAlways = 0;
+  int FlagFullRecalculate = 0;
+  int FreeDLL = 0;
+  int GraphRegion = 0;
+  int DrawZeros = 0;
+
+  // Описание.
+  SCString GraphName;
+  SCString StudyDescription;
+  SCString TextInput;
+  SCString TextInputName;
+  SCString Symbol = "MOCK";
+  int SecondsPerBar = 60;
+  int ChartNumber = 1;
+  int StudyGraphInstanceID = 1;
+  int MenuEventID = 0;
+  float TickSize = 0.25f;
+  float RealTimePriceMultiplier = 1.0f;
+
+  // Данные графика.
+  c_FloatArrayArray<NUM_BASE_GRAPH_ARRAYS> BaseDataIn;
+  c_FloatArrayArray<NUM_BASE_GRAPH_ARRAYS> BaseData;
+  SCDateTimeArray BaseDateTimeIn;
+  SCFloatArray Open;
+  SCFloatArray High;
+  SCFloatArray Low;
+  SCFloatArray Close;
+  SCFloatArray Volume;
+  SCFloatArray NumberOfTrades;
+  SCFloatArray BidVolume;
+  SCFloatArray AskVolume;
+
+  s_SCSubgraph_260 Subgraph[SC_SUBGRAPHS_AVAILABLE];
+  s_SCInput_145 Input[SC_INPUTS_AVAILABLE];
+
+  void AddMessageToLog(const char* message, int showLog) {
+    (void)showLog;
+    MockMessageLog.emplace_back(message != nullptr ? message : "");
+  }
+  void AddMessageToLog(const SCString& message, int showLog) { AddMessageToLog(message.GetChars(), showLog); }
+
+  int& GetPersistentInt(int key) { return MockPersistentInt[key]; }
+  void SetPersistentInt(int key, int value) { MockPersistentInt[key] = value; }
+  float& GetPersistentFloat(int key) { return MockPersistentFloat[key]; }
+  void SetPersistentFloat(int key, float value) { MockPersistentFloat[key] = value; }
+  double& GetPersistentDouble(int key) { return MockPersistentDouble[key]; }
+  void SetPersistentDouble(int key, double value) { MockPersistentDouble[key] = value; }
+  std::int64_t& GetPersistentInt64(int key) { return MockPersistentInt64[key]; }
+  void SetPersistentInt64(int key, std::int64_t value) { MockPersistentInt64[key] = value; }
+  void*& GetPersistentPointer(int key) { return MockPersistentPointer[key]; }
+  void SetPersistentPointer(int key, void* value) { MockPersistentPointer[key] = value; }
+
+  int AddACSChartShortcutMenuItem(int chartNumber, const char* menuText) {
+    (void)chartNumber;
+    MockMenuItems[MockNextMenuID] = menuText != nullptr ? menuText : "";
+    return MockNextMenuID++;
+  }
+  int RemoveACSChartShortcutMenuItem(int chartNumber, int menuID) {
+    (void)chartNumber;
+    return MockMenuItems.erase(menuID) != 0 ? 1 : 0;
+  }
+
+  SCString DataFilesFolder() { return MockDataFilesFolder; }
+
+  void GetTimeAndSales(c_SCTimeAndSalesArray& records) { records.MockAssign(MockTimeAndSales); }
+  c_ACSILDepthBars* GetMarketDepthBars() { return MockDepthBars; }
+
+  // Состояние хоста, которого нет в SDK.
+  std::vector<std::string> MockMessageLog;
+  std::map<int, int> MockPersistentInt;
+  std::map<int, float> MockPersistentFloat;
+  std::map<int, double> MockPersistentDouble;
+  std::map<int, std::int64_t> MockPersistentInt64;
+  std::map<int, void*> MockPersistentPointer;
+  SCString MockDataFilesFolder = "Data";  // каталог данных Sierra Chart относительно рабочего каталога хоста
+  std::vector<s_TimeAndSales> MockTimeAndSales;
+  c_ACSILDepthBars* MockDepthBars = nullptr;
+  std::map<int, std::string> MockMenuItems;  // пункты контекстного меню графика по MenuID
+  int MockNextMenuID = 1;
+};
+
+typedef s_sc& SCStudyInterfaceRef;
+#define SCStudyGraphRef SCStudyInterfaceRef
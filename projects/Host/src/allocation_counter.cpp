@@ -0,0 +1,69 @@
+#include "sierra/host/study_host.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/// @file allocation_counter.cpp
+/// @brief Заменяет глобальные `operator new`/`delete` хоста, чтобы считать выделения внутри вызовов исследования.
+/// @note Выровненные варианты (`std::align_val_t`) не заменяются и в счётчики не попадают.
+
+namespace {
+
+std::atomic<std::uint64_t> g_allocations{0};
+std::atomic<std::uint64_t> g_allocated_bytes{0};
+std::atomic<std::uint64_t> g_frees{0};
+
+void* counted_allocate(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void counted_free(void* memory) noexcept {
+  if (memory != nullptr) {
+    g_frees.fetch_add(1, std::memory_order_relaxed);
+    std::free(memory);
+  }
+}
+
+}  // namespace
+
+namespace sierra::host {
+
+AllocationCounters allocation_counters() noexcept {
+  return AllocationCounters{g_allocations.load(std::memory_order_relaxed),
+                            g_allocated_bytes.load(std::memory_order_relaxed),
+                            g_frees.load(std::memory_order_relaxed)};
+}
+
+}  // namespace sierra::host
+
+void* operator new(std::size_t size) { return counted_allocate(size); }
+void* operator new[](std::size_t size) { return counted_allocate(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  try {
+    return counted_allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  try {
+    return counted_allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void operator delete(void* memory) noexcept { counted_free(memory); }
+void operator delete[](void* memory) noexcept { counted_free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { counted_free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { counted_free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { counted_free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { counted_free(memory); }
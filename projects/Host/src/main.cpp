@@ -0,0 +1,353 @@
+#include "sierra/acsil/column_cache.hpp"
+#include "sierra/acsil/study.hpp"
+#include "sierra/host/study_host.hpp"
+
+#include "sierra/core/call_recording.hpp"
+#include "sierra/core/scanner.hpp"
+#include "sierra/core/trace.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct StudyEntry {
+  const char* name;
+  sierra::host::StudyFunction function;
+};
+
+/// Исследования обёртки, которые умеет запускать хост.
+const StudyEntry kStudies[] = {
+    {"MovingAverage", scsf_SierraStudyMovingAverage},
+};
+
+struct Options {
+  std::string study = "MovingAverage";
+  std::size_t bars = 20000;
+  std::string scid;
+  std::size_t updates = 1000;
+  std::size_t ticks_per_bar = 10;
+  std::size_t charts = 1;
+  std::vector<std::pair<int, double>> inputs;
+  bool show_log = false;
+  bool reload = false;
+  std::string trace;
+  std::string replay;
+  std::string scan;
+  std::vector<sierra::core::ScanCondition> conditions;
+  std::int64_t bar_seconds = sierra::core::kSecondsPerDay;
+  bool all_rows = false;
+};
+
+void print_usage() {
+  std::printf(
+      "usage: SierraStudy.Host [options]\n"
+      "  --study NAME          study to run (");
+  for (const auto& entry : kStudies) {
+    std::printf(" %s", entry.name);
+  }
+  std::printf(
+      " )\n"
+      "  --bars N              history bars for the full recalculation (default 20000)\n"
+      "  --scid PATH           take bars and live updates from a .scid file instead of synthetic data\n"
+      "  --updates N           live updates after the full recalculation (default 1000)\n"
+      "  --ticks-per-bar K     live updates per bar: every K-th update starts a new bar (default 10)\n"
+      "  --charts N            run N identical charts of the same symbol side by side (default 1)\n"
+      "  --input I=VALUE       set sc.Input[I] after SetDefaults (repeatable; ignored with --replay)\n"
+      "  --replay PATH         replay calls recorded with the chart menu \"SierraStudy: Start Capture\"\n"
+      "  --reload              replace the DLL after the live updates (last call, then full recalculation\n"
+      "                        with subgraph arrays kept, as Release DLL / Allow Load DLLs do)\n"
+      "  --scan DIR            screen every .scid file in DIR instead of running a study\n"
+      "  --when CONDITION      scan condition such as \"close > sma(200)\" or \"rsi(14) < 30\" (repeatable)\n"
+      "  --bar-seconds N       scan bar period (default 86400)\n"
+      "  --all                 print every scanned symbol, not only matches\n"
+      "  --log                 print messages added with AddMessageToLog\n"
+      "  --trace PATH          write Chrome trace JSON of the whole run (needs a build with SIERRA_TRACE)\n");
+}
+
+Options parse(int argc, char** argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const auto value = [&]() -> std::string {
+      if (i + 1 >= argc) {
+        throw std::invalid_argument("missing value for " + arg);
+      }
+      return argv[++i];
+    };
+    if (arg == "--study") {
+      options.study = value();
+    } else if (arg == "--bars") {
+      options.bars = std::stoull(value());
+    } else if (arg == "--scid") {
+      options.scid = value();
+    } else if (arg == "--updates") {
+      options.updates = std::stoull(value());
+    } else if (arg == "--ticks-per-bar") {
+      options.ticks_per_bar = (std::max)(std::size_t{1}, static_cast<std::size_t>(std::stoull(value())));
+    } else if (arg == "--charts") {
+      options.charts = (std::max)(std::size_t{1}, static_cast<std::size_t>(std::stoull(value())));
+    } else if (arg == "--input") {
+      const std::string text = value();
+      const auto separator = text.find('=');
+      if (separator == std::string::npos) {
+        throw std::invalid_argument("--input expects INDEX=VALUE");
+      }
+      options.inputs.emplace_back(std::stoi(text.substr(0, separator)), std::stod(text.substr(separator + 1)));
+    } else if (arg == "--replay") {
+      options.replay = value();
+    } else if (arg == "--scan") {
+      options.scan = value();
+    } else if (arg == "--when") {
+      options.conditions.push_back(sierra::core::parse_scan_condition(value()));
+    } else if (arg == "--bar-seconds") {
+      options.bar_seconds = std::stoll(value());
+    } else if (arg == "--all") {
+      options.all_rows = true;
+    } else if (arg == "--trace") {
+      options.trace = value();
+    } else if (arg == "--reload") {
+      options.reload = true;
+    } else if (arg == "--log") {
+      options.show_log = true;
+    } else if (arg == "--help" || arg == "-h") {
+      print_usage();
+      std::exit(0);
+    } else {
+      throw std::invalid_argument("unknown option " + arg);
+    }
+  }
+  return options;
+}
+
+/// @brief История и поток обновлений: первые `bars` записей — история, остальные приходят в реальном времени.
+std::vector<sierra::core::ScidRecord> load_records(const Options& options) {
+  if (options.scid.empty()) {
+    return sierra::host::synthetic_bars(options.bars + options.updates);
+  }
+  const sierra::core::ScidFile file(options.scid);
+  return std::vector<sierra::core::ScidRecord>(file.records(), file.records() + file.size());
+}
+
+void print_report(const sierra::host::CallReport& report) {
+  const double calls = report.calls == 0 ? 1.0 : static_cast<double>(report.calls);
+  std::printf("%-20s %10zu %12.3f %10.3f %10.3f %10.3f %10.3f %12.2f %12.1f\n", report.phase.c_str(),
+              report.calls, report.total_nanoseconds / 1e6, report.mean_nanoseconds() / 1e3,
+              report.nanoseconds.quantile(0.5) / 1e3, report.nanoseconds.quantile(0.99) / 1e3,
+              report.nanoseconds.max() / 1e3, static_cast<double>(report.allocations) / calls,
+              static_cast<double>(report.allocated_bytes) / calls);
+}
+
+void print_reports(const std::vector<sierra::host::CallReport>& reports) {
+  std::printf("%-20s %10s %12s %10s %10s %10s %10s %12s %12s\n", "phase", "calls", "total ms", "mean us",
+              "p50 us", "p99 us", "max us", "allocs/call", "bytes/call");
+  for (const auto& report : reports) {
+    print_report(report);
+  }
+}
+
+void start_trace(const Options& options) {
+  if (options.trace.empty()) {
+    return;
+  }
+  if (!SIERRA_TRACE) {
+    std::fprintf(stderr, "SierraStudy.Host: trace spans are compiled out; rebuild with SIERRA_ENABLE_TRACE\n");
+  }
+  sierra::core::TraceRecorder::instance().start();
+}
+
+/// @brief Выгружает трассировку и печатает журнал исследования, если они запрошены.
+void finish(const Options& options, const sierra::host::StudyHost& host) {
+  if (!options.trace.empty()) {
+    auto& recorder = sierra::core::TraceRecorder::instance();
+    const std::size_t spans = recorder.dump(options.trace);
+    std::printf("trace: %zu spans written to %s (dropped %llu)\n", spans, options.trace.c_str(),
+                static_cast<unsigned long long>(recorder.dropped()));
+  }
+  if (options.show_log) {
+    for (const auto& message : host.messages()) {
+      std::printf("[log] %s\n", message.c_str());
+    }
+  }
+}
+
+/// @brief Полный пересчёт истории и поток обновлений из `.scid` или синтетических баров.
+/// @note С `--charts N` те же данные получают N графиков подряд, как несколько chartbook одного символа; отчёт
+/// суммирует вызовы всех графиков, а в конце печатается память общего кэша столбцов.
+int run_profile(const StudyEntry& entry, const Options& options) {
+  std::vector<sierra::core::ScidRecord> records = load_records(options);
+  const std::size_t history = records.size() - (std::min)(records.size(), options.updates);
+  std::vector<sierra::core::ScidRecord> bars;
+  bars.reserve(history);
+  for (std::size_t i = 0; i < history; ++i) {
+    bars.push_back(sierra::host::to_bar(records[i]));
+  }
+
+  start_trace(options);
+  std::vector<std::unique_ptr<sierra::host::StudyHost>> hosts;
+  sierra::host::CallReport defaults("set defaults");
+  sierra::host::CallReport full("full recalculation");
+  for (std::size_t chart = 0; chart < options.charts; ++chart) {
+    hosts.push_back(std::make_unique<sierra::host::StudyHost>(entry.function));
+    sierra::host::StudyHost& host = *hosts.back();
+    host.sc().ChartNumber = static_cast<int>(chart + 1);
+    defaults.merge(host.set_defaults());
+    for (const auto& input : options.inputs) {
+      host.set_input(input.first, input.second);
+    }
+    host.load(bars);
+    full.merge(host.full_recalculation());
+  }
+
+  sierra::host::CallReport live("live updates");
+  sierra::core::ScidRecord current = bars.empty() ? sierra::core::ScidRecord{} : bars.back();
+  for (std::size_t i = history; i < records.size(); ++i) {
+    const bool new_bar = hosts.front()->size() == 0 || (i - history + 1) % options.ticks_per_bar == 0;
+    if (new_bar) {
+      current = sierra::host::to_bar(records[i]);
+    } else {
+      sierra::host::merge_into_bar(current, records[i]);
+    }
+    for (auto& host : hosts) {
+      if (new_bar) {
+        host->append_bar(current, live);
+      } else {
+        host->update_last_bar(current, live);
+      }
+    }
+  }
+  sierra::host::CallReport reload("reload");
+  if (options.reload) {
+    for (auto& host : hosts) {
+      reload.merge(host->reload(true));
+    }
+  }
+  const std::size_t shared_columns = sierra::acsil::SharedIndicatorCache().columns();
+  const std::size_t shared_bytes = sierra::acsil::SharedIndicatorCache().memory_bytes();
+  sierra::host::CallReport last("last call");
+  for (auto& host : hosts) {
+    last.merge(host->last_call());
+  }
+
+  std::printf("study %s (AutoLoop = %d), %zu chart(s), %zu bars after %zu live updates\n", entry.name,
+              hosts.front()->sc().AutoLoop, hosts.size(), hosts.front()->size(), records.size() - history);
+  std::vector<sierra::host::CallReport> reports{defaults, full, live};
+  if (options.reload) {
+    reports.push_back(reload);
+  }
+  reports.push_back(last);
+  print_reports(reports);
+  std::printf("shared column cache: %zu column(s), %.1f KiB\n", shared_columns,
+              static_cast<double>(shared_bytes) / 1024.0);
+  finish(options, *hosts.front());
+  return 0;
+}
+
+/// @brief Повторяет записанные в Sierra Chart вызовы и сверяет выходы с записанными отпечатками.
+/// @return 0, если все выходы совпали; 3 при расхождении.
+int run_replay(const StudyEntry& entry, const Options& options) {
+  sierra::core::CallRecordReader reader(options.replay);
+  start_trace(options);
+  sierra::host::StudyHost host(entry.function);
+  std::vector<sierra::host::CallReport> reports;
+  reports.push_back(host.set_defaults());
+  if (reader.header().study != host.sc().GraphName.GetChars()) {
+    throw std::invalid_argument("recording of \"" + reader.header().study + "\" does not match study " + entry.name);
+  }
+  if (reader.header().base_arrays != NUM_BASE_GRAPH_ARRAYS) {
+    throw std::invalid_argument("recording has an unsupported number of base data arrays");
+  }
+  host.sc().TickSize = reader.header().tick_size;
+
+  sierra::host::CallReport full("replayed full");
+  sierra::host::CallReport live("replayed updates");
+  sierra::core::RecordedCall call;
+  std::size_t calls = 0;
+  std::size_t mismatches = 0;
+  while (reader.next(call)) {
+    auto& report = (call.flags & sierra::core::RecordedCall::kFullRecalculation) != 0 ? full : live;
+    if (!host.replay(call, report)) {
+      if (mismatches == 0) {
+        std::fprintf(stderr, "SierraStudy.Host: outputs of call %zu (Index %d) differ from the recording\n", calls,
+                     call.index);
+      }
+      ++mismatches;
+    }
+    ++calls;
+  }
+  reports.push_back(std::move(full));
+  reports.push_back(std::move(live));
+  reports.push_back(host.last_call());
+
+  std::printf("replay of %s: %zu calls, %zu bars, %zu output mismatches\n", options.replay.c_str(), calls,
+              host.size(), mismatches);
+  print_reports(reports);
+  finish(options, host);
+  return mismatches == 0 ? 0 : 3;
+}
+
+/// @brief Проверяет условия `--when` на всех `.scid` каталога и печатает таблицу CSV и пропускную способность.
+/// @return 0; 2, если условий нет.
+int run_scan(const Options& options) {
+  if (options.conditions.empty()) {
+    std::fprintf(stderr, "SierraStudy.Host: --scan needs at least one --when condition\n");
+    return 2;
+  }
+  std::vector<std::string> paths;
+  for (const auto& entry : std::filesystem::directory_iterator(options.scan)) {
+    if (entry.is_regular_file() && entry.path().extension() == ".scid") {
+      paths.push_back(entry.path().string());
+    }
+  }
+  std::sort(paths.begin(), paths.end());
+  start_trace(options);
+  sierra::core::ThreadPool pool;
+  sierra::core::ScanOptions scan;
+  scan.bar_period_seconds = options.bar_seconds;
+  const auto report = sierra::core::scan_symbols(paths, options.conditions, scan, pool);
+  sierra::core::write_scan_table(std::cout, report, !options.all_rows);
+  std::cout.flush();
+  std::fprintf(stderr,
+               "scan: %zu symbols, %zu matched, %.1f MiB in %.3f s (%.0f symbols/s, %.1f MiB/s, %zu threads)\n",
+               report.rows.size(), report.matched(), static_cast<double>(report.bytes) / (1024.0 * 1024.0),
+               report.seconds, report.symbols_per_second(), report.bytes_per_second() / (1024.0 * 1024.0),
+               pool.size());
+  if (!options.trace.empty()) {
+    auto& recorder = sierra::core::TraceRecorder::instance();
+    const std::size_t spans = recorder.dump(options.trace);
+    std::fprintf(stderr, "trace: %zu spans written to %s\n", spans, options.trace.c_str());
+  }
+  return 0;
+}
+
+}  // namespace
+
+/// @brief Запускает исследование обёртки вне Sierra Chart и печатает время и выделения памяти на вызов.
+/// @note С `--replay` вместо синтетического потока повторяет вызовы, записанные `CallCapture` в Sierra Chart; с
+/// `--scan` не запускает исследование, а проверяет условия по каталогу `.scid` (`sierra::core::scan_symbols`).
+int main(int argc, char** argv) {
+  try {
+    const Options options = parse(argc, argv);
+    if (!options.scan.empty()) {
+      return run_scan(options);
+    }
+    const auto entry = std::find_if(std::begin(kStudies), std::end(kStudies),
+                                    [&](const StudyEntry& e) { return options.study == e.name; });
+    if (entry == std::end(kStudies)) {
+      print_usage();
+      return 2;
+    }
+    return options.replay.empty() ? run_profile(*entry, options) : run_replay(*entry, options);
+  } catch (const std::exception& error) {
+    std::fprintf(stderr, "SierraStudy.Host: %s\n", error.what());
+    return 1;
+  }
+}
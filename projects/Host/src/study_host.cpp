@@ -0,0 +1,292 @@
+#include "sierra/host/study_host.hpp"
+
+#include "sierra/acsil/call_capture.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+
+namespace sierra::host {
+
+namespace {
+
+/// Массивов на один активный подграфик: `Data` и `Arrays[]`.
+constexpr std::size_t kArraysPerSubgraph = 1 + SC_SUBGRAPH_EXTRA_ARRAYS;
+
+}  // namespace
+
+StudyHost::StudyHost(StudyFunction study, double relative_accuracy)
+    : study_(study), accuracy_(relative_accuracy) {
+  if (study_ == nullptr) {
+    throw std::invalid_argument("StudyHost requires a study function");
+  }
+}
+
+void StudyHost::invoke(CallReport& report) {
+  const AllocationCounters before = allocation_counters();
+  const auto start = std::chrono::steady_clock::now();
+  study_(sc_);
+  const auto finish = std::chrono::steady_clock::now();
+  const AllocationCounters after = allocation_counters();
+
+  const double elapsed = static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count());
+  ++report.calls;
+  report.total_nanoseconds += elapsed;
+  report.nanoseconds.add(elapsed);
+  report.allocations += after.count - before.count;
+  report.allocated_bytes += after.bytes - before.bytes;
+  report.deallocations += after.frees - before.frees;
+}
+
+CallReport StudyHost::set_defaults() {
+  CallReport report("set defaults", accuracy_);
+  sc_.SetDefaults = 1;
+  invoke(report);
+  sc_.SetDefaults = 0;
+
+  active_subgraphs_.clear();
+  for (int i = 0; i < SC_SUBGRAPHS_AVAILABLE; ++i) {
+    if (!sc_.Subgraph[i].Name.IsEmpty()) {
+      active_subgraphs_.push_back(i);
+    }
+  }
+  subgraph_data_.assign(active_subgraphs_.size() * kArraysPerSubgraph, std::vector<float>(times_.size()));
+  attach();
+  return report;
+}
+
+void StudyHost::set_input(int index, double value) {
+  if (index < 0 || index >= SC_INPUTS_AVAILABLE) {
+    throw std::out_of_range("StudyHost input index is out of range");
+  }
+  sc_.Input[index].MockSet(value);
+}
+
+void StudyHost::load(std::vector<core::ScidRecord> bars) {
+  resize(0);
+  resize(bars.size());
+  for (std::size_t i = 0; i < bars.size(); ++i) {
+    set_bar(i, bars[i]);
+  }
+}
+
+CallReport StudyHost::full_recalculation() {
+  CallReport report("full recalculation", accuracy_);
+  clear_outputs();
+  sc_.IsFullRecalculation = 1;
+  run_update(0, report);
+  sc_.IsFullRecalculation = 0;
+  return report;
+}
+
+void StudyHost::update_last_bar(const core::ScidRecord& bar, CallReport& report) {
+  if (times_.empty()) {
+    throw std::logic_error("StudyHost::update_last_bar requires loaded bars");
+  }
+  set_bar(times_.size() - 1, bar);
+  run_update(static_cast<int>(times_.size()) - 1, report);
+}
+
+void StudyHost::append_bar(const core::ScidRecord& bar, CallReport& report) {
+  const std::size_t previous = times_.size();
+  resize(previous + 1);
+  set_bar(previous, bar);
+  run_update(previous == 0 ? 0 : static_cast<int>(previous) - 1, report);
+}
+
+bool StudyHost::replay(const core::RecordedCall& call, CallReport& report) {
+  const std::size_t slice = call.slice_size();
+  if (call.base.size() != slice * NUM_BASE_GRAPH_ARRAYS || call.date_times.size() != slice) {
+    throw std::invalid_argument("StudyHost::replay: bar slice does not match NUM_BASE_GRAPH_ARRAYS");
+  }
+  for (const auto& input : call.inputs) {
+    if (input.first < 0 || input.first >= SC_INPUTS_AVAILABLE) {
+      throw std::invalid_argument("StudyHost::replay: input index is out of range");
+    }
+  }
+
+  resize(static_cast<std::size_t>(call.array_size));
+  const auto first = static_cast<std::size_t>(call.slice_start);
+  for (std::size_t i = 0; i < slice; ++i) {
+    times_[first + i].SetInternalDateTime(call.date_times[i]);
+  }
+  for (int array = 0; array < NUM_BASE_GRAPH_ARRAYS; ++array) {
+    const auto source = call.base.begin() + static_cast<std::ptrdiff_t>(slice * static_cast<std::size_t>(array));
+    std::copy(source, source + static_cast<std::ptrdiff_t>(slice),
+              base_[array].begin() + static_cast<std::ptrdiff_t>(first));
+  }
+  for (const auto& input : call.inputs) {
+    sc_.Input[input.first].SetDouble(input.second);
+  }
+  for (const auto& value : call.persistent_ints) {
+    sc_.SetPersistentInt(value.first, value.second);
+  }
+  for (const auto& value : call.persistent_doubles) {
+    sc_.SetPersistentDouble(value.first, value.second);
+  }
+
+  const bool full = (call.flags & core::RecordedCall::kFullRecalculation) != 0;
+  if (full && call.update_start_index == 0) {
+    clear_outputs();
+  }
+  sc_.IsFullRecalculation = full ? 1 : 0;
+  sc_.UpdateStartIndex = call.update_start_index;
+  sc_.Index = sc_.CurrentIndex = call.index;
+  invoke(report);
+  sc_.IsFullRecalculation = 0;
+  return acsil::SubgraphDigest(sc_, call.update_start_index) == call.output_digest;
+}
+
+CallReport StudyHost::last_call() {
+  CallReport report("last call", accuracy_);
+  sc_.LastCallToFunction = 1;
+  invoke(report);
+  sc_.LastCallToFunction = 0;
+  return report;
+}
+
+CallReport StudyHost::reload(bool keep_outputs) {
+  CallReport report("reload", accuracy_);
+  sc_.LastCallToFunction = 1;
+  invoke(report);
+  sc_.LastCallToFunction = 0;
+  if (!keep_outputs) {
+    clear_outputs();
+  }
+  sc_.IsFullRecalculation = 1;
+  run_update(0, report);
+  sc_.IsFullRecalculation = 0;
+  return report;
+}
+
+void StudyHost::run_update(int start, CallReport& report) {
+  if (sc_.FlagFullRecalculate != 0) {
+    sc_.FlagFullRecalculate = 0;
+    clear_outputs();
+    sc_.IsFullRecalculation = 1;
+    run_update(0, report);
+    sc_.IsFullRecalculation = 0;
+    return;
+  }
+  const int size = static_cast<int>(times_.size());
+  sc_.ArraySize = size;
+  sc_.UpdateStartIndex = start;
+  if (sc_.AutoLoop == 0) {
+    sc_.Index = sc_.CurrentIndex = (std::max)(0, size - 1);
+    invoke(report);
+    return;
+  }
+  for (int index = start; index < size; ++index) {
+    sc_.Index = sc_.CurrentIndex = index;
+    invoke(report);
+  }
+}
+
+void StudyHost::clear_outputs() {
+  for (auto& data : subgraph_data_) {
+    std::fill(data.begin(), data.end(), 0.0f);
+  }
+}
+
+void StudyHost::set_bar(std::size_t index, const core::ScidRecord& bar) {
+  times_[index].SetInternalDateTime(bar.date_time);
+  base_[SC_OPEN][index] = bar.open;
+  base_[SC_HIGH][index] = bar.high;
+  base_[SC_LOW][index] = bar.low;
+  base_[SC_LAST][index] = bar.close;
+  base_[SC_VOLUME][index] = static_cast<float>(bar.total_volume);
+  base_[SC_NUM_TRADES][index] = static_cast<float>(bar.num_trades);
+  base_[SC_OHLC][index] = (bar.open + bar.high + bar.low + bar.close) / 4.0f;
+  base_[SC_HLC][index] = (bar.high + bar.low + bar.close) / 3.0f;
+  base_[SC_HL][index] = (bar.high + bar.low) / 2.0f;
+  base_[SC_BIDVOL][index] = static_cast<float>(bar.bid_volume);
+  base_[SC_ASKVOL][index] = static_cast<float>(bar.ask_volume);
+}
+
+void StudyHost::resize(std::size_t size) {
+  times_.resize(size);
+  for (auto& array : base_) {
+    array.resize(size);
+  }
+  for (auto& data : subgraph_data_) {
+    data.resize(size);
+  }
+  attach();
+}
+
+/// @note Окна переназначаются целиком: после `resize` векторы могли переехать.
+void StudyHost::attach() {
+  const int size = static_cast<int>(times_.size());
+  sc_.ArraySize = size;
+  sc_.BaseDateTimeIn.MockAttach(times_.data(), size);
+  for (int i = 0; i < NUM_BASE_GRAPH_ARRAYS; ++i) {
+    float* data = base_[i].data();
+    sc_.BaseDataIn[i].MockAttach(data, size);
+    sc_.BaseData[i].MockAttach(data, size);
+  }
+  sc_.Open.MockAttach(base_[SC_OPEN].data(), size);
+  sc_.High.MockAttach(base_[SC_HIGH].data(), size);
+  sc_.Low.MockAttach(base_[SC_LOW].data(), size);
+  sc_.Close.MockAttach(base_[SC_LAST].data(), size);
+  sc_.Volume.MockAttach(base_[SC_VOLUME].data(), size);
+  sc_.NumberOfTrades.MockAttach(base_[SC_NUM_TRADES].data(), size);
+  sc_.BidVolume.MockAttach(base_[SC_BIDVOL].data(), size);
+  sc_.AskVolume.MockAttach(base_[SC_ASKVOL].data(), size);
+
+  for (std::size_t k = 0; k < active_subgraphs_.size(); ++k) {
+    s_SCSubgraph_260& subgraph = sc_.Subgraph[active_subgraphs_[k]];
+    std::vector<float>* arrays = &subgraph_data_[k * kArraysPerSubgraph];
+    subgraph.Data.MockAttach(arrays[0].data(), size);
+    for (int j = 0; j < SC_SUBGRAPH_EXTRA_ARRAYS; ++j) {
+      subgraph.Arrays[j].MockAttach(arrays[j + 1].data(), size);
+    }
+  }
+}
+
+void merge_into_bar(core::ScidRecord& bar, const core::ScidRecord& update) noexcept {
+  const core::ScidRecord source = to_bar(update);
+  bar.high = (std::max)(bar.high, source.high);
+  bar.low = (std::min)(bar.low, source.low);
+  bar.close = source.close;
+  bar.num_trades += source.num_trades;
+  bar.total_volume += source.total_volume;
+  bar.bid_volume += source.bid_volume;
+  bar.ask_volume += source.ask_volume;
+}
+
+core::ScidRecord to_bar(const core::ScidRecord& record) noexcept {
+  core::ScidRecord bar = record;
+  if (record.is_tick()) {
+    bar.open = bar.high = bar.low = record.close;
+  }
+  return bar;
+}
+
+std::vector<core::ScidRecord> synthetic_bars(std::size_t count, std::uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::vector<core::ScidRecord> bars(count);
+  const std::int64_t start = 3'900'000'000'000'000;  // 2023 год в микросекундах SCDateTime
+  float price = 4000.0f;
+  for (std::size_t i = 0; i < count; ++i) {
+    auto& bar = bars[i];
+    bar.date_time = start + static_cast<std::int64_t>(i) * 60'000'000;
+    bar.open = price;
+    bar.high = price;
+    bar.low = price;
+    for (int step = 0; step < 4; ++step) {
+      price += 0.25f * static_cast<float>(static_cast<int>(rng() % 5) - 2);
+      bar.high = (std::max)(bar.high, price);
+      bar.low = (std::min)(bar.low, price);
+    }
+    bar.close = price;
+    bar.num_trades = 1 + static_cast<std::uint32_t>(rng() % 50);
+    bar.total_volume = bar.num_trades * (1 + static_cast<std::uint32_t>(rng() % 5));
+    bar.bid_volume = bar.total_volume / 2;
+    bar.ask_volume = bar.total_volume - bar.bid_volume;
+  }
+  return bars;
+}
+
+}  // namespace sierra::host
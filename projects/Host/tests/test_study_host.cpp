@@ -0,0 +1,654 @@
+/**
+ * @brief Тесты headless-хоста и жизненного цикла движков ядра в исследованиях обёртки.
+ * @note Исследования вызываются через `StudyHost`, как их вызывает Sierra Chart: SetDefaults, полный пересчёт, обновления в реальном времени и последний вызов.
+ */
+#include "sierra/acsil/call_timer.hpp"
+#include "sierra/acsil/column_cache.hpp"
+#include "sierra/acsil/engine_snapshot.hpp"
+#include "sierra/acsil/logger.hpp"
+#include "sierra/acsil/study.hpp"
+#include "sierra/acsil/supportFunction.hpp"
+#include "sierra/host/study_host.hpp"
+
+#include "sierra/core/moving_average.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int kEngineKey = 7;
+
+/// Движок-заглушка, считающий свои экземпляры и сбросы.
+struct CountingEngine {
+  static int live;
+  static int resets;
+
+  explicit CountingEngine(int config) : config_(config) { ++live; }
+  ~CountingEngine() { --live; }
+
+  int config() const noexcept { return config_; }
+  void reset(int config) {
+    config_ = config;
+    ++resets;
+  }
+
+  int config_;
+};
+
+int CountingEngine::live = 0;
+int CountingEngine::resets = 0;
+
+SCSFExport scsf_CountingEngineStudy(SCStudyInterfaceRef sc) {
+  if (sc.SetDefaults) {
+    sc.AutoLoop = 0;
+    sc.Subgraph[0].Name = "Value";
+    sc.Input[0].SetInt(3);
+    return;
+  }
+  auto* engine = sierra::acsil::AcquireEngine<CountingEngine>(sc, kEngineKey, sc.Input[0].GetInt());
+  if (engine == nullptr) {
+    return;
+  }
+  sc.Subgraph[0][sc.ArraySize - 1] = static_cast<float>(engine->config());
+}
+
+SCSFExport scsf_IndexRecorderStudy(SCStudyInterfaceRef sc) {
+  if (sc.SetDefaults) {
+    sc.AutoLoop = 1;
+    sc.Subgraph[0].Name = "Calls";
+    return;
+  }
+  sc.Subgraph[0][sc.Index] += 1.0f;
+}
+
+SCSFExport scsf_TimedStudy(SCStudyInterfaceRef sc) {
+  sierra::acsil::StudyCallTimer timer(sc, kEngineKey, sc.Input[0]);
+  if (sc.SetDefaults) {
+    sc.GraphName = "Timed";
+    sc.AutoLoop = 0;
+    sc.Subgraph[0].Name = "Value";
+    sc.Input[0].Name = "Latency Summary Interval (s)";
+    sc.Input[0].SetInt(sc.Input[1].GetInt());  // вход 1 — значение по умолчанию, которое задаёт тест
+    return;
+  }
+  sc.Subgraph[0][sc.ArraySize - 1] = 1.0f;
+}
+
+TEST(StudyHostTest, AutoLoopCallsEveryBarFromUpdateStartIndex) {
+  sierra::host::StudyHost host(scsf_IndexRecorderStudy);
+  host.set_defaults();
+  auto bars = sierra::host::synthetic_bars(6);
+  const auto last = bars.back();
+  bars.pop_back();
+  host.load(bars);
+
+  EXPECT_EQ(host.full_recalculation().calls, 5u);
+  sierra::host::CallReport live("live");
+  host.update_last_bar(bars.back(), live);
+  host.append_bar(last, live);
+  EXPECT_EQ(live.calls, 3u);
+
+  const SCFloatArray& calls = host.sc().Subgraph[0].Data;
+  ASSERT_EQ(calls.GetArraySize(), 6);
+  EXPECT_FLOAT_EQ(calls[0], 1.0f);
+  EXPECT_FLOAT_EQ(calls[4], 3.0f);  // пересчёт, обновление бара и пересчёт при новом баре
+  EXPECT_FLOAT_EQ(calls[5], 1.0f);
+}
+
+TEST(StudyHostTest, EngineIsCreatedResetAndFreed) {
+  CountingEngine::live = 0;
+  CountingEngine::resets = 0;
+  sierra::host::StudyHost host(scsf_CountingEngineStudy);
+  host.set_defaults();
+  host.load(sierra::host::synthetic_bars(10));
+
+  host.full_recalculation();
+  EXPECT_EQ(CountingEngine::live, 1);
+  EXPECT_EQ(CountingEngine::resets, 0);
+
+  sierra::host::CallReport live("live");
+  host.update_last_bar(sierra::host::synthetic_bars(10).back(), live);
+  EXPECT_EQ(CountingEngine::resets, 0);
+
+  host.set_input(0, 5);
+  host.update_last_bar(sierra::host::synthetic_bars(10).back(), live);
+  EXPECT_EQ(CountingEngine::resets, 1);
+  EXPECT_FLOAT_EQ(host.sc().Subgraph[0][9], 5.0f);
+
+  host.full_recalculation();
+  EXPECT_EQ(CountingEngine::resets, 2);
+  EXPECT_EQ(CountingEngine::live, 1);
+
+  host.last_call();
+  EXPECT_EQ(CountingEngine::live, 0);
+  EXPECT_EQ(host.sc().GetPersistentPointer(kEngineKey), nullptr);
+}
+
+TEST(StudyCallTimerTest, SummarizesPhasesOnLastCallAndFreesStats) {
+  sierra::host::StudyHost host(scsf_TimedStudy);
+  host.set_input(1, 60);  // интервал появляется только внутри SetDefaults
+  host.set_defaults();
+  host.load(sierra::host::synthetic_bars(10));
+  host.full_recalculation();
+  sierra::host::CallReport live("live");
+  for (int i = 0; i < 3; ++i) {
+    host.update_last_bar(sierra::host::synthetic_bars(10).back(), live);
+  }
+  EXPECT_EQ(live.allocations, 0u);
+  ASSERT_NE(host.sc().GetPersistentPointer(kEngineKey), nullptr);
+
+  const std::size_t before = host.messages().size();
+  host.last_call();
+  ASSERT_EQ(host.messages().size(), before + 1);
+  const std::string& summary = host.messages().back();
+  EXPECT_EQ(summary.rfind("Timed latency, us:", 0), 0u) << summary;
+  EXPECT_NE(summary.find("defaults n=1 "), std::string::npos) << summary;
+  EXPECT_NE(summary.find("full n=1 "), std::string::npos) << summary;
+  EXPECT_NE(summary.find("live n=3 "), std::string::npos) << summary;
+  EXPECT_EQ(host.sc().GetPersistentPointer(kEngineKey), nullptr);
+}
+
+TEST(StudyCallTimerTest, ZeroIntervalDisablesTiming) {
+  sierra::host::StudyHost host(scsf_TimedStudy);
+  host.set_defaults();
+  host.load(sierra::host::synthetic_bars(10));
+  EXPECT_EQ(host.full_recalculation().allocations, 0u);
+  EXPECT_EQ(host.sc().GetPersistentPointer(kEngineKey), nullptr);
+  const std::size_t before = host.messages().size();
+  host.last_call();
+  EXPECT_EQ(host.messages().size(), before);
+}
+
+TEST(SupportFunctionTest, TimeAndSalesSequenceAboveSignBit) {
+  sierra::host::StudyHost host(scsf_IndexRecorderStudy);
+  host.set_defaults();
+  std::vector<s_TimeAndSales> records(3);
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    records[i].Sequence = 0x80000000u + static_cast<unsigned int>(i);
+    records[i].Type = SC_TS_ASK;
+    records[i].Price = 100.0f;
+    records[i].Volume = 1;
+  }
+  host.sc().MockTimeAndSales = records;
+
+  sierra::core::OrderFlowWorker worker(16);
+  unsigned int lastSequence = 0;
+  EXPECT_EQ(sierra::acsil::PushNewTimeAndSales(host.sc(), worker, lastSequence), 3);
+  EXPECT_EQ(lastSequence, 0x80000002u);
+  EXPECT_EQ(sierra::acsil::PushNewTimeAndSales(host.sc(), worker, lastSequence), 0);
+
+  records[0].Sequence = 0x80000003u;
+  host.sc().MockTimeAndSales.push_back(records[0]);
+  EXPECT_EQ(sierra::acsil::PushNewTimeAndSales(host.sc(), worker, lastSequence), 1);
+  worker.drain();
+  EXPECT_EQ(worker.snapshot().trade_count, 4u);
+}
+
+TEST(OrderFlowStudyTest, ShowsWorkerMetricsAndFreesWorker) {
+  constexpr int kWorkerKey = 6;
+  constexpr int kSequenceKey = 6;
+  sierra::host::StudyHost host(scsf_SierraStudyOrderFlow);
+  host.set_defaults();
+  const auto records = sierra::host::synthetic_bars(10);
+  host.load(std::vector<sierra::core::ScidRecord>(records.begin(), records.end() - 1));
+  const auto trade = [](unsigned int sequence, int type, float price, unsigned int volume) {
+    s_TimeAndSales record;
+    record.Sequence = sequence;
+    record.Type = type;
+    record.Price = price;
+    record.Volume = volume;
+    return record;
+  };
+  host.sc().MockTimeAndSales = {trade(1, SC_TS_ASK, 100.0f, 3), trade(2, SC_TS_BIDASKVALUES, 0.0f, 0),
+                                trade(3, SC_TS_BID, 98.0f, 1)};
+  host.full_recalculation();
+  auto* worker = static_cast<sierra::core::OrderFlowWorker*>(host.sc().GetPersistentPointer(kWorkerKey));
+  ASSERT_NE(worker, nullptr);
+  worker->drain();
+
+  // Следующий вызов передаёт только новую сделку и выводит метрики в последний бар.
+  host.sc().MockTimeAndSales.push_back(trade(4, SC_TS_ASK, 102.0f, 1));
+  sierra::host::CallReport live("live");
+  host.append_bar(records.back(), live);
+  worker->drain();
+  host.append_bar(records.back(), live);
+  const int last = host.sc().ArraySize - 1;
+  EXPECT_EQ(host.sc().Subgraph[0].Data[last], 3.0f);
+  EXPECT_FLOAT_EQ(host.sc().Subgraph[1].Data[last], (300.0f + 98.0f + 102.0f) / 5.0f);
+  EXPECT_EQ(host.sc().Subgraph[2].Data[last], 0.0f);
+  EXPECT_EQ(worker->snapshot().trade_count, 3u);
+  EXPECT_EQ(host.sc().GetPersistentInt(kSequenceKey), 4);
+
+  host.last_call();
+  EXPECT_EQ(host.sc().GetPersistentPointer(kWorkerKey), nullptr);
+}
+
+TEST(SupportFunctionTest, DepthBookLevelsAreFoundByPrice) {
+  sierra::host::StudyHost host(scsf_IndexRecorderStudy);
+  host.set_defaults();
+  host.load(sierra::host::synthetic_bars(2));
+  c_ACSILDepthBars depthBars;
+  depthBars.MockSetTickSize(0.25f);
+  depthBars.MockSetTickIndexOrigin(4000.0f);  // индекс Sierra Chart 3 — цена 4000.75
+  depthBars.MockAddBar(3, {{10, 0, 7, 0}, {0, 20, 0, 9}});
+  depthBars.MockAddBar(0, {});
+  host.sc().MockDepthBars = &depthBars;
+
+  const sierra::core::DepthBook book = sierra::acsil::BuildDepthBook(host.sc());
+  host.sc().MockDepthBars = nullptr;
+  ASSERT_EQ(book.size(), 1u);
+  const sierra::core::DepthLevel* bid = book.level(0, 4000.75);
+  ASSERT_NE(bid, nullptr);
+  EXPECT_EQ(bid->max_bid, 10u);
+  EXPECT_EQ(bid->last_bid, 7u);
+  const sierra::core::DepthLevel* ask = book.level(0, 4001.0);
+  ASSERT_NE(ask, nullptr);
+  EXPECT_EQ(ask->max_ask, 20u);
+  EXPECT_EQ(book.level(0, 0.75), nullptr);
+  EXPECT_EQ(book.level(0, 4001.25), nullptr);
+}
+
+TEST(MovingAverageStudyTest, TraceMenuStartsAndDumpsTrace) {
+  sierra::host::StudyHost host(scsf_SierraStudyMovingAverage);
+  host.set_defaults();
+  host.load(sierra::host::synthetic_bars(100));
+  host.full_recalculation();
+  s_sc& sc = host.sc();
+#if SIERRA_TRACE
+  int startID = 0;
+  int dumpID = 0;
+  for (const auto& [id, text] : sc.MockMenuItems) {
+    if (text == "SierraStudy: Start Trace") {
+      startID = id;
+    } else if (text == "SierraStudy: Dump Trace") {
+      dumpID = id;
+    }
+  }
+  ASSERT_GT(startID, 0);
+  ASSERT_GT(dumpID, 0);
+
+  sierra::host::CallReport live("live");
+  sc.MenuEventID = startID;
+  host.update_last_bar(sierra::host::synthetic_bars(100).back(), live);
+  sc.MenuEventID = 0;
+  host.update_last_bar(sierra::host::synthetic_bars(100).back(), live);
+  sc.MenuEventID = dumpID;
+  host.update_last_bar(sierra::host::synthetic_bars(100).back(), live);
+  sc.MenuEventID = 0;
+
+  ASSERT_FALSE(host.messages().empty());
+  EXPECT_NE(host.messages().back().find("spans written to Logs/SierraStudy.trace.json"), std::string::npos)
+      << host.messages().back();
+  std::ifstream file("Logs/SierraStudy.trace.json");
+  const std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  EXPECT_NE(json.find("\"name\":\"scsf_SierraStudyMovingAverage\",\"cat\":\"acsil\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"MovingAverageEngine::update\",\"cat\":\"core\""), std::string::npos);
+  file.close();
+  std::filesystem::remove("Logs/SierraStudy.trace.json");
+#endif
+  host.last_call();
+  EXPECT_TRUE(sc.MockMenuItems.empty());
+}
+
+TEST(MovingAverageStudyTest, CapturedCallsReplayWithIdenticalOutputs) {
+  const auto records = sierra::host::synthetic_bars(260);
+  sierra::host::StudyHost host(scsf_SierraStudyMovingAverage);
+  host.set_defaults();
+  host.set_input(0, 9);
+  host.load(std::vector<sierra::core::ScidRecord>(records.begin(), records.begin() + 200));
+  host.full_recalculation();
+  s_sc& sc = host.sc();
+  int startID = 0;
+  int stopID = 0;
+  for (const auto& [id, text] : sc.MockMenuItems) {
+    if (text == "SierraStudy: Start Capture") {
+      startID = id;
+    } else if (text == "SierraStudy: Stop Capture") {
+      stopID = id;
+    }
+  }
+  ASSERT_GT(startID, 0);
+  ASSERT_GT(stopID, 0);
+
+  sierra::host::CallReport live("live");
+  sc.MenuEventID = startID;
+  host.update_last_bar(records[199], live);
+  sc.MenuEventID = 0;
+  EXPECT_EQ(sc.FlagFullRecalculate, 1);  // запись начнётся с полного пересчёта
+  sierra::core::ScidRecord current = records[199];
+  for (std::size_t i = 200; i < records.size(); ++i) {
+    if (i % 3 == 0) {
+      current = records[i];
+      host.append_bar(current, live);
+    } else {
+      current.close = records[i].close;
+      host.update_last_bar(current, live);
+    }
+  }
+  const std::vector<float> expected(sc.Subgraph[0].Data.GetPointer(),
+                                    sc.Subgraph[0].Data.GetPointer() + sc.ArraySize);
+  sc.MenuEventID = stopID;
+  host.update_last_bar(current, live);
+  sc.MenuEventID = 0;
+  const std::string path = "Logs/SierraStudy.1.1.calls.bin";
+  EXPECT_NE(host.messages().back().find("written to " + path), std::string::npos) << host.messages().back();
+  host.last_call();
+
+  sierra::core::CallRecordReader reader(path);
+  EXPECT_EQ(reader.header().study, "SierraStudy - Moving Average");
+  sierra::host::StudyHost replay(scsf_SierraStudyMovingAverage);
+  replay.set_defaults();
+  sierra::host::CallReport report("replay");
+  sierra::core::RecordedCall call;
+  std::size_t calls = 0;
+  while (reader.next(call)) {
+    EXPECT_EQ((call.flags & sierra::core::RecordedCall::kFullRecalculation) != 0, calls == 0);
+    EXPECT_TRUE(replay.replay(call, report)) << "call " << calls;
+    ++calls;
+  }
+  EXPECT_EQ(calls, records.size() - 200);  // первое обновление после «Start» стало полным пересчётом
+  EXPECT_EQ(replay.sc().Input[0].GetInt(), 9);
+  ASSERT_EQ(replay.size(), expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    const float actual = replay.sc().Subgraph[0].Data[static_cast<int>(i)];
+    EXPECT_TRUE(actual == expected[i] || (std::isnan(actual) && std::isnan(expected[i]))) << "bar " << i;
+  }
+  replay.last_call();
+
+  // Другой период после первого вызова: повтор должен заметить расхождение выходов.
+  sierra::core::CallRecordReader again(path);
+  sierra::host::StudyHost diverged(scsf_SierraStudyMovingAverage);
+  diverged.set_defaults();
+  std::size_t mismatches = 0;
+  for (calls = 0; again.next(call); ++calls) {
+    if (calls == 1) {
+      diverged.set_input(0, 5);
+    }
+    mismatches += diverged.replay(call, report) ? 0 : 1;
+  }
+  EXPECT_EQ(mismatches, calls - 1);
+  diverged.last_call();
+  std::filesystem::remove(path);
+}
+
+TEST(MovingAverageStudyTest, ChartsOfSameSymbolShareComputedHistory) {
+  const auto records = sierra::host::synthetic_bars(400);
+  std::vector<sierra::core::ScidRecord> history(records.begin(), records.begin() + 300);
+  std::vector<sierra::core::ScidRecord> edited = history;
+  edited[150].close += 1.0f;  // тот же символ и время, но другая история: кэш использовать нельзя
+
+  sierra::host::StudyHost reference(scsf_SierraStudyMovingAverage);
+  reference.set_defaults();
+  reference.set_input(0, 12);
+  reference.load(history);
+  reference.full_recalculation();
+
+  std::vector<std::unique_ptr<sierra::host::StudyHost>> charts;
+  for (const std::vector<sierra::core::ScidRecord>* bars : {&history, &history, &edited}) {
+    charts.push_back(std::make_unique<sierra::host::StudyHost>(scsf_SierraStudyMovingAverage));
+    charts.back()->set_defaults();
+    charts.back()->set_input(0, 12);
+    charts.back()->set_input(2, 1);
+    charts.back()->load(*bars);
+    charts.back()->full_recalculation();
+  }
+  EXPECT_EQ(sierra::acsil::SharedIndicatorCache().columns(), 1u);
+
+  sierra::host::CallReport live("live");
+  for (std::size_t i = 300; i < records.size(); ++i) {
+    reference.append_bar(records[i], live);
+    for (auto& chart : charts) {
+      chart->append_bar(records[i], live);
+    }
+  }
+  // Новый график открывается уже на длинной истории и берёт её из кэша.
+  sierra::host::StudyHost late(scsf_SierraStudyMovingAverage);
+  late.set_defaults();
+  late.set_input(0, 12);
+  late.set_input(2, 1);
+  late.load(records);
+  late.full_recalculation();
+
+  std::vector<float> expected(records.size());
+  std::vector<float> closes(records.size());
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    closes[i] = records[i].close;
+  }
+  sierra::core::moving_average(closes.data(), closes.size(), 12, 0, expected.data());
+  const auto same = [](float a, float b) { return a == b || (std::isnan(a) && std::isnan(b)); };
+  for (sierra::host::StudyHost* chart : {&reference, charts[0].get(), charts[1].get(), &late}) {
+    for (std::size_t i = 0; i < records.size(); ++i) {
+      const int bar = static_cast<int>(i);
+      ASSERT_TRUE(same(chart->sc().Subgraph[0].Data[bar], reference.sc().Subgraph[0].Data[bar])) << "bar " << i;
+    }
+  }
+  for (std::size_t i = 11; i < records.size(); ++i) {
+    EXPECT_NEAR(reference.sc().Subgraph[0].Data[static_cast<int>(i)], expected[i], 1e-3f) << "bar " << i;
+  }
+  // Отредактированный график посчитал свою историю сам.
+  closes[150] = edited[150].close;
+  sierra::core::moving_average(closes.data(), closes.size(), 12, 0, expected.data());
+  EXPECT_NEAR(charts[2]->sc().Subgraph[0].Data[155], expected[155], 1e-3f);
+  EXPECT_NE(charts[2]->sc().Subgraph[0].Data[155], reference.sc().Subgraph[0].Data[155]);
+
+  reference.last_call();
+  late.last_call();
+  for (auto& chart : charts) {
+    chart->last_call();
+  }
+  EXPECT_EQ(sierra::acsil::SharedIndicatorCache().columns(), 0u);
+}
+
+TEST(MovingAverageStudyTest, ReloadTakesClosedBarsFromDiskCache) {
+  constexpr std::size_t kChunk = sierra::core::ColumnStore::kChunkBars;
+  const auto records = sierra::host::synthetic_bars(kChunk * 2 + 500);
+  const std::string path = "Data/SierraStudy.Cache/SierraStudy.1.1.col";
+  const auto run = [&](const std::vector<sierra::core::ScidRecord>& bars) {
+    auto host = std::make_unique<sierra::host::StudyHost>(scsf_SierraStudyMovingAverage);
+    host->set_defaults();
+    host->set_input(0, 20);
+    host->set_input(3, 1);
+    host->load(bars);
+    host->full_recalculation();
+    return host;
+  };
+  run(records)->last_call();
+  ASSERT_EQ(std::filesystem::file_size(path), 64 + 2 * (8 + kChunk * sizeof(float)));
+
+  // Метка в значениях файла (хеш блока не меняется) показывает, что бар взят с диска, а не посчитан.
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    const float marker = 12345.0f;
+    file.seekp(64 + 8 + 100 * sizeof(float));
+    file.write(reinterpret_cast<const char*>(&marker), sizeof(marker));
+  }
+  auto reloaded = run(records);
+  EXPECT_EQ(reloaded->sc().Subgraph[0].Data[100], 12345.0f);
+
+  std::vector<float> closes(records.size());
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    closes[i] = records[i].close;
+  }
+  std::vector<float> expected(records.size());
+  sierra::core::moving_average(closes.data(), closes.size(), 20, 0, expected.data());
+  for (std::size_t i = kChunk; i < records.size(); ++i) {
+    ASSERT_NEAR(reloaded->sc().Subgraph[0].Data[static_cast<int>(i)], expected[i], 1e-3f) << "bar " << i;
+  }
+  reloaded->last_call();
+
+  // Правка бара во втором блоке: первый блок берётся из файла, остальное считается заново и перезаписывается.
+  std::vector<sierra::core::ScidRecord> edited = records;
+  edited[kChunk + 7].close += 1.0f;
+  closes[kChunk + 7] = edited[kChunk + 7].close;
+  sierra::core::moving_average(closes.data(), closes.size(), 20, 0, expected.data());
+  auto edit = run(edited);
+  EXPECT_EQ(edit->sc().Subgraph[0].Data[100], 12345.0f);
+  for (std::size_t i = kChunk; i < records.size(); ++i) {
+    ASSERT_NEAR(edit->sc().Subgraph[0].Data[static_cast<int>(i)], expected[i], 1e-3f) << "bar " << i;
+  }
+  auto again = run(edited);
+  EXPECT_EQ(again->sc().Subgraph[0].Data[kChunk + 10], edit->sc().Subgraph[0].Data[kChunk + 10]);
+  edit->last_call();
+  again->last_call();
+  std::filesystem::remove_all("Data");
+}
+
+TEST(MovingAverageStudyTest, DllReloadResumesEngineFromSnapshot) {
+  const std::filesystem::path snapshot = std::filesystem::temp_directory_path() / "SierraStudy.1.1.engine.bin";
+  const auto records = sierra::host::synthetic_bars(1000);
+  sierra::host::StudyHost host(scsf_SierraStudyMovingAverage);
+  host.set_defaults();
+  host.set_input(0, 20);
+  host.load(std::vector<sierra::core::ScidRecord>(records.begin(), records.begin() + 900));
+  host.full_recalculation();
+  const auto restored = [&host] {
+    return std::count(host.messages().begin(), host.messages().end(),
+                      "SierraStudy engine state restored after DLL reload");
+  };
+
+  // Метка в баре до окна снимка: при восстановлении история не пересчитывается.
+  host.sc().Subgraph[0].Data[100] = 12345.0f;
+  host.reload(true);
+  EXPECT_EQ(restored(), 1);
+  EXPECT_EQ(host.sc().Subgraph[0].Data[100], 12345.0f);
+  EXPECT_FALSE(std::filesystem::exists(snapshot));
+
+  sierra::host::CallReport live("live");
+  for (std::size_t i = 900; i < records.size(); ++i) {
+    host.append_bar(records[i], live);
+  }
+  std::vector<float> closes(records.size());
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    closes[i] = records[i].close;
+  }
+  std::vector<float> expected(records.size());
+  sierra::core::moving_average(closes.data(), closes.size(), 20, 0, expected.data());
+  for (std::size_t i = 880; i < records.size(); ++i) {
+    ASSERT_NEAR(host.sc().Subgraph[0].Data[static_cast<int>(i)], expected[i], 1e-3f) << "bar " << i;
+  }
+
+  // Массивы подграфиков не сохранились: снимок не подходит, история считается заново.
+  host.reload(false);
+  EXPECT_EQ(restored(), 1);
+  EXPECT_NEAR(host.sc().Subgraph[0].Data[100], expected[100], 1e-3f);
+
+  // Другой период — другой движок: снимок отвергается, хотя массивы на месте.
+  host.set_input(0, 21);
+  host.reload(true);
+  EXPECT_EQ(restored(), 1);
+  sierra::core::moving_average(closes.data(), closes.size(), 21, 0, expected.data());
+  EXPECT_NEAR(host.sc().Subgraph[0].Data[100], expected[100], 1e-3f);
+
+  // Без FreeDLL DLL не выгружается до выхода из Sierra Chart: снимок не пишется.
+  host.sc().FreeDLL = 0;
+  host.last_call();
+  EXPECT_FALSE(std::filesystem::exists(snapshot));
+  std::filesystem::remove(snapshot);
+}
+
+TEST(EngineSnapshotTest, RemovesOnlyStaleSnapshots) {
+  const std::filesystem::path folder = std::filesystem::temp_directory_path() / "SierraStudy.SnapshotTest";
+  std::filesystem::create_directories(folder);
+  const auto touch = [&folder](const char* name, std::chrono::seconds age) {
+    const std::filesystem::path path = folder / name;
+    std::ofstream(path) << "state";
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now() - age);
+    return path;
+  };
+  const auto stale = touch("SierraStudy.3.7.engine.bin", std::chrono::hours(2));
+  const auto fresh = touch("SierraStudy.3.8.engine.bin", std::chrono::seconds(0));
+  const auto foreign = touch("Other.3.9.engine.bin", std::chrono::hours(2));
+
+  EXPECT_EQ(sierra::acsil::RemoveStaleEngineSnapshots(folder, std::chrono::hours(1)), 1u);
+  EXPECT_FALSE(std::filesystem::exists(stale));
+  EXPECT_TRUE(std::filesystem::exists(fresh));
+  EXPECT_TRUE(std::filesystem::exists(foreign));
+  EXPECT_EQ(sierra::acsil::RemoveStaleEngineSnapshots(folder / "missing", std::chrono::hours(1)), 0u);
+  std::filesystem::remove_all(folder);
+}
+
+TEST(MovingAverageStudyTest, LiveUpdatesMatchCoreCalculation) {
+  sierra::host::StudyHost host(scsf_SierraStudyMovingAverage);
+  host.set_defaults();
+  host.set_input(0, 7);
+  const auto records = sierra::host::synthetic_bars(300);
+  host.load(std::vector<sierra::core::ScidRecord>(records.begin(), records.begin() + 200));
+  host.full_recalculation();
+
+  sierra::host::CallReport live("live");
+  auto current = records[199];
+  for (std::size_t i = 200; i < records.size(); ++i) {
+    if (i % 4 == 0) {
+      current = records[i];
+      host.append_bar(current, live);
+    } else {
+      sierra::host::merge_into_bar(current, records[i]);
+      host.update_last_bar(current, live);
+    }
+  }
+
+  s_sc& sc = host.sc();
+  std::vector<float> expected(static_cast<std::size_t>(sc.ArraySize));
+  sierra::core::moving_average(sc.Close.GetPointer(), expected.size(), 7, 0, expected.data());
+  EXPECT_TRUE(std::isnan(sc.Subgraph[0][5]));
+  for (std::size_t i = 6; i < expected.size(); ++i) {
+    EXPECT_NEAR(sc.Subgraph[0][static_cast<int>(i)], expected[i], 1e-3f) << "bar " << i;
+  }
+  EXPECT_EQ(live.allocations, 0u);
+}
+
+TEST(MovingAverageStudyTest, RepeatedLifecycleLeavesNoLiveAllocations) {
+  sierra::host::StudyHost host(scsf_SierraStudyMovingAverage);
+  const auto bars = sierra::host::synthetic_bars(500);
+  // Общий журнал DLL создаётся один раз на процесс и разрушается с последней ссылкой. Держим свою ссылку, чтобы он
+  // не пересоздавался в каждом цикле: тогда второй цикл выделяет только сам движок.
+  sierra::host::StudyHost loggerOwner(scsf_IndexRecorderStudy);
+  constexpr int kLoggerKey = 11;
+  sierra::acsil::AcquireLogger(loggerOwner.sc(), kLoggerKey);
+
+  for (int lifecycle = 0; lifecycle < 2; ++lifecycle) {
+    std::vector<sierra::host::CallReport> reports;
+    reports.push_back(host.set_defaults());
+    host.set_input(4, 0);  // снимок движка пишет файл и проверяется в DllReloadResumesEngineFromSnapshot
+    host.load(bars);
+    reports.push_back(host.full_recalculation());
+    // Пункты меню трассировки и захвата хранит сам Sierra Chart; мок тратит на каждый узел map и строку названия.
+    const std::uint64_t menuAllocations = 2 * host.sc().MockMenuItems.size();
+    sierra::host::CallReport live("live");
+    host.append_bar(bars.back(), live);
+    host.update_last_bar(bars.front(), live);
+    reports.push_back(live);
+    reports.push_back(host.last_call());
+
+    // Первый проход заводит слоты persistent-хранилища и одноразовые сообщения хоста.
+    if (lifecycle == 1) {
+      std::uint64_t allocations = 0;
+      std::uint64_t deallocations = 0;
+      for (const auto& report : reports) {
+        allocations += report.allocations;
+        deallocations += report.deallocations;
+      }
+      EXPECT_EQ(allocations, deallocations);
+      EXPECT_EQ(reports[1].allocations, 1u + menuAllocations);  // сам движок
+      EXPECT_EQ(reports[2].allocations, 0u);
+    }
+    for (const auto& [key, pointer] : host.sc().MockPersistentPointer) {
+      EXPECT_EQ(pointer, nullptr) << "persistent pointer " << key;
+    }
+  }
+  loggerOwner.sc().LastCallToFunction = 1;
+  EXPECT_EQ(sierra::acsil::AcquireLogger(loggerOwner.sc(), kLoggerKey), nullptr);
+}
+
+}  // namespace
@@ -0,0 +1,165 @@
+/**
+ * @brief Модульные тесты асинхронного журнала.
+ * @note Проверяем подстановку аргументов, запись из нескольких потоков с `flush`, ротацию файлов, учёт переполнения и пробуждение после простоя.
+ */
+#include "sierra/core/async_logger.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::string TempPath(const char* name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+std::vector<std::string> ReadLines(const std::string& path) {
+  std::ifstream file(path);
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(file, line);) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+void RemoveLogs(const std::string& path) {
+  std::filesystem::remove(path);
+  for (int i = 1; i <= 4; ++i) {
+    std::filesystem::remove(path + "." + std::to_string(i));
+  }
+}
+
+TEST(AsyncLoggerTest, FormatsPlaceholdersAndExtraArguments) {
+  sierra::core::LogRecord record;
+  record.format = "period={} ready={} name={} {}";
+  record.level = sierra::core::LogLevel::kWarning;
+  record.thread = 2;
+  record.count = 4;
+  record.types[0] = sierra::core::LogArgumentType::kInt;
+  record.values[0].i = -20;
+  record.types[1] = sierra::core::LogArgumentType::kBool;
+  record.values[1].u = 1;
+  record.types[2] = sierra::core::LogArgumentType::kString;
+  record.values[2].s = "MA";
+  record.types[3] = sierra::core::LogArgumentType::kDouble;
+  record.values[3].d = 0.25;
+
+  std::string text;
+  sierra::core::format_log_record(record, 0, text);
+  EXPECT_NE(text.find(" WARN  [2] period=-20 ready=true name=MA 0.25\n"), std::string::npos) << text;
+
+  record.format = "no placeholders";
+  record.count = 1;
+  text.clear();
+  sierra::core::format_log_record(record, 0, text);
+  EXPECT_NE(text.find("no placeholders -20\n"), std::string::npos) << text;
+}
+
+TEST(AsyncLoggerTest, FlushWritesRecordsFromAllThreads) {
+  const std::string path = TempPath("sierra_async_logger_threads.log");
+  RemoveLogs(path);
+  constexpr int kThreads = 4;
+  constexpr int kPerThread = 500;
+  {
+    sierra::core::AsyncLoggerOptions options;
+    options.path = path;
+    sierra::core::AsyncLogger logger(options);
+    EXPECT_FALSE(logger.log(sierra::core::LogLevel::kDebug, "filtered"));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+      threads.emplace_back([&logger, t] {
+        for (int i = 0; i < kPerThread; ++i) {
+          while (!logger.log(sierra::core::LogLevel::kInfo, "thread {} record {}", t, i)) {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    logger.flush();
+    EXPECT_EQ(logger.written(), static_cast<std::uint64_t>(kThreads * kPerThread));
+    EXPECT_EQ(ReadLines(path).size(), static_cast<std::size_t>(kThreads * kPerThread));
+
+    logger.log(sierra::core::LogLevel::kError, "last");  // главный поток зарегистрирован пятым
+  }
+  const auto lines = ReadLines(path);
+  ASSERT_EQ(lines.size(), static_cast<std::size_t>(kThreads * kPerThread + 1));
+  EXPECT_NE(lines.back().find("ERROR [4] last"), std::string::npos) << lines.back();
+  RemoveLogs(path);
+}
+
+TEST(AsyncLoggerTest, RotatesFilesBySize) {
+  const std::string path = TempPath("sierra_async_logger_rotate.log");
+  RemoveLogs(path);
+  {
+    sierra::core::AsyncLoggerOptions options;
+    options.path = path;
+    options.max_file_bytes = 1024;
+    options.max_files = 2;
+    sierra::core::AsyncLogger logger(options);
+    for (int i = 0; i < 200; ++i) {
+      logger.log(sierra::core::LogLevel::kInfo, "record {}", i);
+    }
+  }
+  EXPECT_TRUE(std::filesystem::exists(path + ".1"));
+  EXPECT_TRUE(std::filesystem::exists(path + ".2"));
+  EXPECT_FALSE(std::filesystem::exists(path + ".3"));
+  EXPECT_LE(std::filesystem::file_size(path), 1024u);
+  const auto lines = ReadLines(path);
+  ASSERT_FALSE(lines.empty());
+  EXPECT_NE(lines.back().find("record 199"), std::string::npos);
+  RemoveLogs(path);
+}
+
+TEST(AsyncLoggerTest, CountsDroppedRecordsWhenRingIsFull) {
+  const std::string path = TempPath("sierra_async_logger_dropped.log");
+  RemoveLogs(path);
+  {
+    sierra::core::AsyncLoggerOptions options;
+    options.path = path;
+    options.ring_capacity = 4;
+    options.poll_interval = std::chrono::milliseconds(1000);
+    options.idle_interval = std::chrono::hours(1);  // поток не уходит в простой, и запись его не будит
+    sierra::core::AsyncLogger logger(options);
+    std::uint64_t accepted = 0;
+    for (int i = 0; i < 64; ++i) {
+      accepted += logger.log(sierra::core::LogLevel::kInfo, "record {}", i) ? 1 : 0;
+    }
+    EXPECT_EQ(accepted + logger.dropped(), 64u);
+    EXPECT_GT(logger.dropped(), 0u);
+    logger.flush();
+    EXPECT_EQ(logger.written(), accepted);
+  }
+  RemoveLogs(path);
+}
+
+TEST(AsyncLoggerTest, FirstRecordAfterIdleWakesWriter) {
+  const std::string path = TempPath("sierra_async_logger_idle.log");
+  RemoveLogs(path);
+  {
+    sierra::core::AsyncLoggerOptions options;
+    options.path = path;
+    options.poll_interval = std::chrono::hours(1);
+    options.idle_interval = std::chrono::hours(1);
+    sierra::core::AsyncLogger logger(options);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));  // первый пустой проход — и поток спит час
+    ASSERT_TRUE(logger.log(sierra::core::LogLevel::kInfo, "after idle {}", 1));
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (logger.written() == 0 && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(logger.written(), 1u);
+  }
+  RemoveLogs(path);
+}
+
+}  // namespace
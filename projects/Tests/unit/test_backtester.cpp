@@ -0,0 +1,159 @@
+/**
+ * @brief Модульные тесты событийного бэктестера.
+ * @note Проверяем правила исполнения рыночных, лимитных и стоп-заявок, OCO-скобки, развороты со снятием старых скобок и наращивание позиции.
+ */
+#include "sierra/core/backtester.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace {
+
+using sierra::core::Backtester;
+using sierra::core::OrderRequest;
+using sierra::core::OrderSide;
+using sierra::core::OrderType;
+using sierra::core::ScidRecord;
+
+ScidRecord Tick(std::int64_t time, float price) {
+  ScidRecord tick;
+  tick.date_time = time;
+  tick.close = price;
+  tick.low = price - 0.25f;
+  tick.high = price + 0.25f;
+  tick.total_volume = 1;
+  return tick;
+}
+
+OrderRequest Request(OrderSide side, OrderType type, int quantity, double price = 0.0) {
+  OrderRequest request;
+  request.side = side;
+  request.type = type;
+  request.quantity = quantity;
+  request.price = price;
+  return request;
+}
+
+TEST(BacktesterTest, MarketOrderFillsAtNextTickAsk) {
+  Backtester backtester;
+  backtester.submit(Request(OrderSide::kBuy, OrderType::kMarket, 2));
+  backtester.process_tick(Tick(1, 100.0f));
+  EXPECT_EQ(backtester.position(), 2);
+  EXPECT_DOUBLE_EQ(backtester.average_price(), 100.25);
+
+  backtester.submit(Request(OrderSide::kSell, OrderType::kMarket, 2));
+  backtester.process_tick(Tick(2, 101.0f));
+  ASSERT_EQ(backtester.trades().size(), 1u);
+  const auto& trade = backtester.trades()[0];
+  EXPECT_EQ(trade.direction, 1);
+  EXPECT_DOUBLE_EQ(trade.average_exit_price, 100.75);
+  EXPECT_DOUBLE_EQ(trade.profit_loss, 1.0);
+}
+
+TEST(BacktesterTest, AttachedBracketActsAsOco) {
+  Backtester backtester;
+  OrderRequest entry = Request(OrderSide::kBuy, OrderType::kLimit, 1, 99.0);
+  entry.target_offset = 2.0;
+  entry.stop_offset = 1.0;
+  backtester.submit(entry);
+
+  backtester.process_tick(Tick(1, 100.0f));
+  EXPECT_EQ(backtester.position(), 0);
+  backtester.process_tick(Tick(2, 99.0f));
+  EXPECT_EQ(backtester.position(), 1);
+  backtester.process_tick(Tick(3, 100.0f));
+  EXPECT_EQ(backtester.active_orders(), 2u);
+
+  backtester.process_tick(Tick(4, 101.0f));
+  EXPECT_EQ(backtester.position(), 0);
+  EXPECT_EQ(backtester.active_orders(), 0u);
+  ASSERT_EQ(backtester.trades().size(), 1u);
+  EXPECT_DOUBLE_EQ(backtester.trades()[0].profit_loss, 2.0);
+  EXPECT_DOUBLE_EQ(backtester.trades()[0].max_open_profit, 2.0);
+}
+
+TEST(BacktesterTest, StopFillsAtWorseOfStopAndQuote) {
+  Backtester backtester;
+  backtester.submit(Request(OrderSide::kSell, OrderType::kMarket, 1));
+  backtester.process_tick(Tick(1, 50.0f));  // short по Bid 49.75
+  backtester.submit(Request(OrderSide::kBuy, OrderType::kStop, 1, 51.0));
+  backtester.process_tick(Tick(2, 52.0f));
+
+  ASSERT_EQ(backtester.trades().size(), 1u);
+  EXPECT_DOUBLE_EQ(backtester.trades()[0].average_exit_price, 52.25);
+  EXPECT_DOUBLE_EQ(backtester.trades()[0].profit_loss, -2.5);
+}
+
+TEST(BacktesterTest, ReversalClosesAndOpensOppositeTrade) {
+  Backtester backtester(sierra::core::BacktestOptions{10.0, 0.5});
+  backtester.submit(Request(OrderSide::kBuy, OrderType::kMarket, 1));
+  backtester.process_tick(Tick(1, 10.0f));
+  backtester.submit(Request(OrderSide::kBuy, OrderType::kMarket, 1));
+  backtester.process_tick(Tick(2, 12.0f));
+  EXPECT_DOUBLE_EQ(backtester.average_price(), 11.25);
+
+  backtester.submit(Request(OrderSide::kSell, OrderType::kMarket, 3));
+  backtester.process_tick(Tick(3, 12.25f));
+  EXPECT_EQ(backtester.position(), -1);
+  ASSERT_EQ(backtester.trades().size(), 1u);
+  const auto& trade = backtester.trades()[0];
+  EXPECT_EQ(trade.entry_quantity, 2);
+  EXPECT_EQ(trade.max_open_quantity, 2);
+  EXPECT_DOUBLE_EQ(trade.profit_loss, (12.0 - 11.25) * 2 * 10.0);
+  EXPECT_DOUBLE_EQ(trade.commission, 2.0);
+
+  backtester.flatten();
+  backtester.process_tick(Tick(4, 12.0f));
+  EXPECT_EQ(backtester.position(), 0);
+  EXPECT_EQ(backtester.trades().size(), 2u);
+}
+
+TEST(BacktesterTest, ReversalCancelsOldBracket) {
+  Backtester backtester;
+  OrderRequest entry = Request(OrderSide::kBuy, OrderType::kMarket, 1);
+  entry.target_offset = 5.0;
+  entry.stop_offset = 1.0;
+  backtester.submit(entry);
+  backtester.process_tick(Tick(1, 100.0f));  // long по Ask 100.25, стоп 99.25, цель 105.25
+  backtester.process_tick(Tick(2, 100.0f));
+  EXPECT_EQ(backtester.active_orders(), 2u);
+
+  backtester.submit(Request(OrderSide::kSell, OrderType::kMarket, 2));
+  backtester.process_tick(Tick(3, 100.0f));
+  EXPECT_EQ(backtester.position(), -1);
+  EXPECT_EQ(backtester.active_orders(), 0u);
+
+  // Старый защитный стоп продал бы в short и довёл позицию до -2.
+  backtester.process_tick(Tick(4, 98.0f));
+  EXPECT_EQ(backtester.position(), -1);
+  EXPECT_EQ(backtester.trades().size(), 1u);
+}
+
+struct CrossStrategy {
+  int submitted = 0;
+  void on_tick(Backtester& backtester, const ScidRecord& tick) {
+    if (backtester.position() == 0 && tick.close > 100.0f && submitted == 0) {
+      OrderRequest request;
+      request.target_offset = 1.0;
+      request.stop_offset = 1.0;
+      backtester.submit(request);
+      ++submitted;
+    }
+  }
+};
+
+TEST(BacktesterTest, RunsTemplatedStrategy) {
+  std::vector<ScidRecord> ticks;
+  const float prices[] = {99.0f, 101.0f, 101.5f, 102.5f, 103.0f};
+  for (std::size_t i = 0; i < 5; ++i) {
+    ticks.push_back(Tick(static_cast<std::int64_t>(i), prices[i]));
+  }
+  Backtester backtester;
+  CrossStrategy strategy;
+  backtester.run(ticks.data(), ticks.size(), strategy);
+  ASSERT_EQ(backtester.trades().size(), 1u);
+  EXPECT_GT(backtester.trades()[0].profit_loss, 0.0);
+}
+
+}  // namespace
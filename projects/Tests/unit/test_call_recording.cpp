@@ -0,0 +1,130 @@
+/**
+ * @brief Модульные тесты файла записи вызовов исследования.
+ * @note Файлы создаются во временном каталоге и удаляются после теста.
+ */
+#include "sierra/core/call_recording.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+std::string TempPath(const char* name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+sierra::core::RecordedCall MakeCall(std::int32_t size, std::int32_t slice_start, std::uint32_t arrays) {
+  sierra::core::RecordedCall call;
+  call.index = size - 1;
+  call.array_size = size;
+  call.update_start_index = slice_start;
+  call.slice_start = slice_start;
+  for (std::int32_t i = slice_start; i < size; ++i) {
+    call.date_times.push_back(1'000'000LL * i);
+  }
+  for (std::uint32_t a = 0; a < arrays; ++a) {
+    for (std::int32_t i = slice_start; i < size; ++i) {
+      call.base.push_back(static_cast<float>(a * 1000 + i) + 0.25f);
+    }
+  }
+  return call;
+}
+
+TEST(CallRecordingTest, RoundTripsHeaderAndCalls) {
+  const std::string path = TempPath("sierra_call_recording_roundtrip.bin");
+  sierra::core::CallRecordingHeader header;
+  header.study = "SierraStudy - Moving Average";
+  header.base_arrays = 3;
+  header.tick_size = 0.25f;
+
+  sierra::core::RecordedCall full = MakeCall(5, 0, 3);
+  full.flags = sierra::core::RecordedCall::kFullRecalculation;
+  full.inputs = {{0, 20.0}, {1, 0.0}};
+  full.persistent_ints = {{7, -3}};
+  full.persistent_doubles = {{7, 1.5}};
+  full.output_digest = 42;
+  const sierra::core::RecordedCall update = MakeCall(6, 4, 3);
+  {
+    sierra::core::CallRecordWriter writer(path, header);
+    writer.write(full);
+    writer.write(update);
+    writer.close();
+    EXPECT_EQ(writer.calls(), 2u);
+    EXPECT_EQ(writer.bytes(), std::filesystem::file_size(path));
+  }
+
+  sierra::core::CallRecordReader reader(path);
+  EXPECT_EQ(reader.header().study, header.study);
+  EXPECT_EQ(reader.header().base_arrays, 3u);
+  EXPECT_EQ(reader.header().tick_size, 0.25f);
+
+  sierra::core::RecordedCall call;
+  ASSERT_TRUE(reader.next(call));
+  EXPECT_EQ(call.flags, sierra::core::RecordedCall::kFullRecalculation);
+  EXPECT_EQ(call.array_size, 5);
+  EXPECT_EQ(call.inputs, full.inputs);
+  EXPECT_EQ(call.persistent_ints, full.persistent_ints);
+  EXPECT_EQ(call.persistent_doubles, full.persistent_doubles);
+  EXPECT_EQ(call.date_times, full.date_times);
+  EXPECT_EQ(call.base, full.base);
+  EXPECT_EQ(call.output_digest, 42u);
+
+  ASSERT_TRUE(reader.next(call));
+  EXPECT_EQ(call.slice_start, 4);
+  EXPECT_EQ(call.slice_size(), 2u);
+  EXPECT_TRUE(call.inputs.empty());
+  EXPECT_EQ(call.base, update.base);
+  EXPECT_FALSE(reader.next(call));
+  std::filesystem::remove(path);
+}
+
+TEST(CallRecordingTest, RejectsSliceThatDoesNotMatchBounds) {
+  const std::string path = TempPath("sierra_call_recording_bounds.bin");
+  sierra::core::CallRecordingHeader header;
+  header.base_arrays = 2;
+  sierra::core::CallRecordWriter writer(path, header);
+  EXPECT_THROW(writer.write(MakeCall(5, 0, 3)), std::invalid_argument);
+  writer.close();
+  std::filesystem::remove(path);
+}
+
+TEST(CallRecordingTest, TruncatedFileThrows) {
+  const std::string path = TempPath("sierra_call_recording_truncated.bin");
+  sierra::core::CallRecordingHeader header;
+  header.base_arrays = 2;
+  {
+    sierra::core::CallRecordWriter writer(path, header);
+    writer.write(MakeCall(10, 0, 2));
+  }
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+
+  sierra::core::CallRecordReader reader(path);
+  sierra::core::RecordedCall call;
+  EXPECT_THROW(reader.next(call), std::runtime_error);
+
+  {
+    std::ofstream garbage(path, std::ios::binary | std::ios::trunc);
+    garbage << "not a recording";
+  }
+  EXPECT_THROW(sierra::core::CallRecordReader{path}, std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(CallRecordingTest, DigestComparesBitPatterns) {
+  const float a[] = {1.0f, std::numeric_limits<float>::quiet_NaN(), 3.0f};
+  const float b[] = {1.0f, std::numeric_limits<float>::quiet_NaN(), 3.0f};
+  const float c[] = {1.0f, std::numeric_limits<float>::quiet_NaN(), 3.5f};
+  EXPECT_EQ(sierra::core::digest_floats(a, 3), sierra::core::digest_floats(b, 3));
+  EXPECT_NE(sierra::core::digest_floats(a, 3), sierra::core::digest_floats(c, 3));
+  EXPECT_EQ(sierra::core::digest_floats(a + 1, 2, sierra::core::digest_floats(a, 1)),
+            sierra::core::digest_floats(a, 3));
+  EXPECT_EQ(sierra::core::digest_floats(nullptr, 0), sierra::core::kDigestSeed);
+}
+
+}  // namespace
@@ -0,0 +1,211 @@
+/**
+ * @brief Модульные тесты движка свечных моделей.
+ * @note Маски движка сверяются со скалярным эталоном `is_candle_pattern` по всем 65 моделям на каждом баре:
+ * разрывы, доджи, бритые свечи и NaN, без тренда и с трендом.
+ */
+#include "sierra/core/candle_patterns.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using sierra::core::CandlePattern;
+using sierra::core::CandlePatternSettings;
+
+/// @brief Столбцы графика с усреднёнными ценами, как их считает Sierra Chart во `float`.
+struct Chart {
+  std::vector<float> open, high, low, close, hl_avg, ohlc_avg;
+
+  void add(float o, float h, float l, float c) {
+    open.push_back(o);
+    high.push_back(h);
+    low.push_back(l);
+    close.push_back(c);
+    hl_avg.push_back((h + l) / 2);
+    ohlc_avg.push_back((o + h + l + c) / 4);
+  }
+
+  sierra::core::CandleSeries series() const {
+    return {open.data(), high.data(), low.data(), close.data(), hl_avg.data(), ohlc_avg.data(), open.size()};
+  }
+};
+
+/// @brief Цены на сетке тиков из небольшого набора уровней: равные цены, разрывы, нулевые тела и тени, участки
+/// роста и падения и редкие NaN.
+Chart RandomChart(std::size_t count, unsigned seed) {
+  std::mt19937 random(seed);
+  std::uniform_int_distribution<int> percent(0, 99);
+  std::uniform_int_distribution<int> offset(-4, 4);
+  std::uniform_int_distribution<int> wick(0, 3);
+  Chart chart;
+  int level = 4000;
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::size_t phase = (i / 25) % 4;
+    level += phase == 1 ? 2 : (phase == 3 ? -2 : offset(random) / 2);
+    level += percent(random) < 15 ? 3 * offset(random) : 0;
+    const int open = level + offset(random);
+    const int close = percent(random) < 12 ? open : level + offset(random);
+    const int high = (open > close ? open : close) + (percent(random) < 40 ? 0 : wick(random));
+    const int low = (open < close ? open : close) - (percent(random) < 40 ? 0 : wick(random));
+    chart.add(0.25f * static_cast<float>(open), 0.25f * static_cast<float>(high), 0.25f * static_cast<float>(low),
+              0.25f * static_cast<float>(close));
+  }
+  for (std::size_t i = 97; i < count; i += 389) {
+    (i % 2 == 0 ? chart.close : chart.high)[i] = std::numeric_limits<float>::quiet_NaN();
+  }
+  return chart;
+}
+
+/// @brief Бары модели в тиках от уровня: open, high, low, close; модель находится на последнем баре.
+struct Motif {
+  CandlePattern pattern;
+  std::vector<std::vector<int>> bars;
+};
+
+/// @brief Многобаровые модели, которые случайный ряд почти не даёт; перед каждой — пять баров с телом в тик.
+const std::vector<Motif>& Motifs() {
+  static const std::vector<Motif> motifs = {
+      {CandlePattern::kMorningStar, {{20, 20, 10, 10}, {8, 8, 6, 7}, {9, 21, 9, 21}}},
+      {CandlePattern::kEveningStar, {{0, 10, 0, 10}, {12, 13, 12, 13}, {11, 11, 0, 0}}},
+      {CandlePattern::kMorningDojiStar, {{20, 20, 10, 10}, {8, 9, 7, 8}, {9, 20, 9, 20}}},
+      {CandlePattern::kEveningDojiStar, {{0, 10, 0, 10}, {12, 13, 11, 12}, {11, 11, 0, 0}}},
+      {CandlePattern::kBullishAbandonedBaby, {{20, 20, 10, 10}, {7, 8, 6, 7}, {9, 20, 9, 20}}},
+      {CandlePattern::kBearishAbandonedBaby, {{0, 10, 0, 10}, {13, 14, 12, 13}, {11, 11, 0, 0}}},
+      {CandlePattern::kTwoCrows, {{0, 10, 0, 10}, {14, 14, 12, 12}, {15, 15, 11, 11}}},
+      {CandlePattern::kKicker, {{10, 10, 0, 0}, {12, 22, 12, 22}}},
+      {CandlePattern::kKicking, {{10, 20, 10, 20}, {8, 8, -2, -2}}},
+      {CandlePattern::kBearishTriStar, {{5, 6, 4, 5}, {8, 9, 7, 8}, {5, 6, 4, 5}}},
+      {CandlePattern::kBullishTriStar, {{5, 6, 4, 5}, {2, 3, 1, 2}, {5, 6, 4, 5}}},
+      {CandlePattern::kUniqueThreeRiverBottom, {{20, 20, 10, 10}, {9, 10, 0, 10}, {5, 6, 4, 6}}},
+      {CandlePattern::kBearishGravestoneDoji, {{0, 2, 0, 2}, {3, 10, 3, 3}}},
+      {CandlePattern::kBearishSideBySideWhiteLines, {{20, 20, 10, 10}, {4, 8, 4, 7}, {4, 8, 4, 7}}},
+      {CandlePattern::kBullishSideBySideWhiteLines, {{0, 2, 0, 2}, {5, 8, 5, 8}, {5, 9, 5, 8}}},
+      {CandlePattern::kFallingThreeMethods, {{10, 10, 0, 0}, {2, 3, 2, 3}, {3, 4, 3, 4}, {4, 5, 4, 5}, {5, 5, -2, -2}}},
+      {CandlePattern::kRisingThreeMethods, {{0, 10, 0, 10}, {8, 8, 7, 7}, {7, 7, 6, 6}, {6, 6, 5, 5}, {5, 12, 5, 12}}},
+      {CandlePattern::kDownsideTasukiGap, {{20, 20, 10, 10}, {8, 8, 0, 0}, {4, 9, 4, 9}}},
+      {CandlePattern::kUpsideTasukiGap, {{0, 10, 0, 10}, {12, 20, 12, 20}, {16, 16, 11, 11}}},
+      {CandlePattern::kBearishThreeLineStrike, {{30, 30, 20, 20}, {22, 22, 10, 10}, {12, 12, 0, 0}, {-1, 31, -1, 31}}},
+      {CandlePattern::kBullishThreeLineStrike, {{0, 10, 0, 10}, {8, 20, 8, 20}, {18, 30, 18, 30}, {31, 31, -1, -1}}},
+      {CandlePattern::kDownsideGapThreeMethods, {{20, 20, 10, 10}, {8, 8, 0, 0}, {4, 12, 4, 12}}},
+      {CandlePattern::kUpsideGapThreeMethods, {{0, 10, 0, 10}, {12, 20, 12, 20}, {16, 16, 8, 8}}},
+      {CandlePattern::kMatHold, {{0, 10, 0, 10}, {13, 13, 11, 12}, {9, 9, 7, 8}, {9, 20, 9, 20}}},
+  };
+  return motifs;
+}
+
+/// @brief Сверяет движок с эталоном; возвращает число моделей, найденных хотя бы раз.
+std::size_t ExpectMatchesReference(const Chart& chart, const CandlePatternSettings& settings) {
+  const sierra::core::CandleSeries bars = chart.series();
+  std::vector<float> trend(bars.count);
+  for (std::size_t i = 0; i < bars.count; ++i) {
+    trend[i] = sierra::core::candle_trend(bars, settings, i);
+  }
+  sierra::core::CandlePatternEngine engine(settings);
+  engine.evaluate(bars);
+  EXPECT_EQ(engine.size(), bars.count);
+  std::size_t found = 0;
+  for (std::size_t number = 1; number <= sierra::core::kCandlePatternCount; ++number) {
+    const auto pattern = static_cast<CandlePattern>(number);
+    bool any = false;
+    for (std::size_t i = 0; i < bars.count; ++i) {
+      const bool expected = sierra::core::is_candle_pattern(bars, trend.data(), settings, pattern, i);
+      EXPECT_EQ(engine.contains(pattern, i), expected) << "pattern " << number << " bar " << i;
+      const auto& masks = sierra::core::candle_mask_word(pattern) == 0 ? engine.masks() : engine.high_masks();
+      EXPECT_EQ((masks[i] & sierra::core::candle_mask_bit(pattern)) != 0, expected);
+      any = any || expected;
+    }
+    found += any ? 1 : 0;
+  }
+  return found;
+}
+
+TEST(CandlePatternsTest, HandPickedBars) {
+  Chart chart;
+  for (int i = 0; i < 6; ++i) {
+    chart.add(100.0f, 101.0f, 99.0f, 100.5f);
+  }
+  chart.add(100.0f, 102.0f, 98.0f, 100.0f);  // доджи
+  chart.add(100.0f, 100.5f, 95.0f, 100.4f);  // молот: длинная нижняя тень, верхней почти нет
+  CandlePatternSettings settings;
+  sierra::core::CandlePatternEngine engine(settings);
+  engine.evaluate(chart.series());
+  ASSERT_EQ(engine.size(), 8u);
+  EXPECT_TRUE(engine.contains(CandlePattern::kDoji, 6));
+  EXPECT_NE(engine.masks()[6] & sierra::core::candle_mask_bit(CandlePattern::kDoji), 0u);
+  EXPECT_TRUE(engine.contains(CandlePattern::kHammer, 7));
+  EXPECT_FALSE(engine.contains(CandlePattern::kDoji, 7));
+  EXPECT_FALSE(engine.contains(CandlePattern::kNone, 7));
+  EXPECT_FALSE(engine.contains(CandlePattern::kDoji, 8));
+  EXPECT_EQ(sierra::core::candle_mask_bit(CandlePattern::kHammer), 1u);
+  EXPECT_EQ(sierra::core::candle_mask_word(CandlePattern::kBullishEngulfingBodyOnly), 0u);
+  EXPECT_EQ(sierra::core::candle_mask_bit(CandlePattern::kBullishEngulfingBodyOnly), std::uint64_t{1} << 63);
+  EXPECT_EQ(sierra::core::candle_mask_word(CandlePattern::kBearishEngulfingBodyOnly), 1u);
+  EXPECT_EQ(sierra::core::candle_mask_bit(CandlePattern::kBearishEngulfingBodyOnly), 1u);
+  EXPECT_EQ(sierra::core::candle_mask_bit(CandlePattern::kNone), 0u);
+}
+
+TEST(CandlePatternsTest, MatchesReferenceWithoutTrend) {
+  for (const std::size_t count : {std::size_t{1}, std::size_t{3}, std::size_t{7}, std::size_t{64},
+                                  std::size_t{1001}, std::size_t{6000}}) {
+    const std::size_t found = ExpectMatchesReference(RandomChart(count, 11), {});
+    if (count == 6000) {
+      EXPECT_GE(found, 50u);  // остальные модели — в PlantedMotifs
+    }
+  }
+}
+
+TEST(CandlePatternsTest, PlantedMotifs) {
+  Chart chart;
+  std::vector<std::size_t> ends;
+  for (const Motif& motif : Motifs()) {
+    for (int i = 0; i < 5; ++i) {
+      chart.add(100.0f, 100.5f, 99.75f, 100.25f);
+    }
+    for (const auto& bar : motif.bars) {
+      chart.add(100.0f + 0.25f * static_cast<float>(bar[0]), 100.0f + 0.25f * static_cast<float>(bar[1]),
+                100.0f + 0.25f * static_cast<float>(bar[2]), 100.0f + 0.25f * static_cast<float>(bar[3]));
+    }
+    ends.push_back(chart.open.size() - 1);
+  }
+  ExpectMatchesReference(chart, {});
+  sierra::core::CandlePatternEngine engine;
+  engine.evaluate(chart.series());
+  for (std::size_t m = 0; m < ends.size(); ++m) {
+    EXPECT_TRUE(engine.contains(Motifs()[m].pattern, ends[m])) << static_cast<int>(Motifs()[m].pattern);
+  }
+}
+
+TEST(CandlePatternsTest, MatchesReferenceWithTrend) {
+  CandlePatternSettings settings;
+  settings.use_trend_detection = true;
+  settings.price_range_bars = 30;
+  settings.price_range_multiplier = 0.002;
+  for (const std::size_t count : {std::size_t{1}, std::size_t{2}, std::size_t{30}, std::size_t{31},
+                                  std::size_t{4000}}) {
+    const std::size_t found = ExpectMatchesReference(RandomChart(count, 23), settings);
+    if (count == 4000) {
+      EXPECT_GE(found, 45u);
+    }
+  }
+  settings.trend_bars = 7;
+  settings.price_range_bars = 1;
+  ExpectMatchesReference(RandomChart(500, 5), settings);
+}
+
+TEST(CandlePatternsTest, RejectsEmptyWindows) {
+  CandlePatternSettings settings;
+  settings.trend_bars = 0;
+  EXPECT_THROW(sierra::core::CandlePatternEngine{settings}, std::invalid_argument);
+  settings.trend_bars = 4;
+  settings.price_range_bars = 0;
+  EXPECT_THROW(sierra::core::CandlePatternEngine{settings}, std::invalid_argument);
+}
+
+}  // namespace
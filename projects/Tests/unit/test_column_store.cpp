@@ -0,0 +1,139 @@
+/**
+ * @brief Модульные тесты файла посчитанных значений исследования.
+ * @note Файлы создаются во временном каталоге и удаляются после теста.
+ */
+#include "sierra/core/column_store.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kChunk = sierra::core::ColumnStore::kChunkBars;
+
+std::string TempPath(const char* name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+struct Bars {
+  explicit Bars(std::size_t count) : times(count), sources(count), values(count) {
+    for (std::size_t i = 0; i < count; ++i) {
+      times[i] = 1'000'000LL * static_cast<std::int64_t>(i);
+      sources[i] = 100.0f + static_cast<float>(i % 97) * 0.25f;
+      values[i] = static_cast<float>(i);
+    }
+  }
+
+  std::vector<std::int64_t> times;
+  std::vector<float> sources;
+  std::vector<float> values;
+};
+
+TEST(ColumnStoreTest, ReloadRestoresCompleteChunks) {
+  const std::string path = TempPath("sierra_column_store_reload.col");
+  const Bars bars(kChunk * 2 + kChunk / 2);
+  const std::uint64_t key = sierra::core::persistent_hash({"ESZ5", 60, "SMA", {20.0}, 0});
+  {
+    sierra::core::ColumnStore store(path, key);
+    EXPECT_TRUE(store.needs_store(bars.times.size()));
+    EXPECT_EQ(store.store(bars.times.data(), bars.sources.data(), bars.values.data(), bars.times.size()), kChunk * 2);
+    EXPECT_FALSE(store.needs_store(bars.times.size()));
+  }
+
+  sierra::core::ColumnStore reloaded(path, key);
+  std::vector<float> output(bars.times.size(), -1.0f);
+  EXPECT_EQ(reloaded.load(bars.times.data(), bars.sources.data(), bars.times.size(), output.data()), kChunk * 2);
+  EXPECT_FALSE(reloaded.needs_store(bars.times.size()));
+  EXPECT_EQ(output[kChunk * 2 - 1], bars.values[kChunk * 2 - 1]);
+  EXPECT_EQ(output[kChunk * 2], -1.0f);
+
+  // Другие параметры исследования — другой ключ: файл не используется.
+  sierra::core::ColumnStore other(path, sierra::core::persistent_hash({"ESZ5", 60, "SMA", {21.0}, 0}));
+  EXPECT_EQ(other.load(bars.times.data(), bars.sources.data(), bars.times.size(), output.data()), 0u);
+
+  // Новая версия расчёта после пересборки DLL — тоже другой ключ, хотя бары и входы те же.
+  sierra::core::ColumnStore rebuilt(path, sierra::core::persistent_hash({"ESZ5", 60, "SMA", {20.0}, 0, 2}));
+  EXPECT_NE(rebuilt.key_hash(), key);
+  EXPECT_EQ(rebuilt.load(bars.times.data(), bars.sources.data(), bars.times.size(), output.data()), 0u);
+  std::filesystem::remove(path);
+}
+
+TEST(ColumnStoreTest, EditedBarInvalidatesItsChunkAndLater) {
+  const std::string path = TempPath("sierra_column_store_edit.col");
+  Bars bars(kChunk * 3);
+  sierra::core::ColumnStore store(path, 7);
+  store.store(bars.times.data(), bars.sources.data(), bars.values.data(), bars.times.size());
+
+  bars.sources[kChunk + 5] += 0.25f;
+  std::vector<float> output(bars.times.size());
+  EXPECT_EQ(store.load(bars.times.data(), bars.sources.data(), bars.times.size(), output.data()), kChunk);
+  EXPECT_TRUE(store.needs_store(bars.times.size()));
+  bars.values[kChunk + 5] = -5.0f;
+  EXPECT_EQ(store.store(bars.times.data(), bars.sources.data(), bars.values.data(), bars.times.size()), kChunk * 3);
+  EXPECT_EQ(std::filesystem::file_size(path), 64 + 3 * (8 + kChunk * sizeof(float)));
+  EXPECT_EQ(store.load(bars.times.data(), bars.sources.data(), bars.times.size(), output.data()), kChunk * 3);
+  EXPECT_EQ(output[kChunk + 5], -5.0f);
+
+  // Правка закрытого бара в реальном времени.
+  store.invalidate(kChunk * 2 + 1);
+  EXPECT_EQ(store.stored_bars(), kChunk * 2);
+  bars.times[kChunk * 2 + 1] += 1;
+  store.store(bars.times.data(), bars.sources.data(), bars.values.data(), bars.times.size());
+  EXPECT_EQ(store.load(bars.times.data(), bars.sources.data(), bars.times.size(), output.data()), kChunk * 3);
+  std::filesystem::remove(path);
+}
+
+TEST(ColumnStoreTest, BarTimesAreRequestedOnlyForComparedChunks) {
+  const std::string path = TempPath("sierra_column_store_lazy.col");
+  std::filesystem::remove(path);
+  Bars bars(kChunk * 3 + 10);
+  std::vector<std::size_t> requested;
+  const sierra::core::ColumnStore::BarTimes barTimes = [&](std::size_t first, std::size_t count, std::int64_t* times) {
+    requested.push_back(first);
+    std::copy(bars.times.begin() + static_cast<std::ptrdiff_t>(first),
+              bars.times.begin() + static_cast<std::ptrdiff_t>(first + count), times);
+  };
+  std::vector<std::int64_t> scratch;
+  std::vector<float> output(bars.times.size());
+
+  // Файла нет: время не переводится вовсе.
+  sierra::core::ColumnStore store(path, 7);
+  EXPECT_EQ(store.load(barTimes, bars.sources.data(), bars.times.size(), output.data(), scratch), 0u);
+  EXPECT_TRUE(requested.empty());
+  EXPECT_EQ(store.store(barTimes, bars.sources.data(), bars.values.data(), bars.times.size(), scratch), kChunk * 3);
+  EXPECT_EQ(requested, (std::vector<std::size_t>{0, kChunk, kChunk * 2}));
+  EXPECT_EQ(scratch.size(), kChunk);
+
+  // Чужой ключ отсекается по заголовку.
+  requested.clear();
+  sierra::core::ColumnStore other(path, 8);
+  EXPECT_EQ(other.load(barTimes, bars.sources.data(), bars.times.size(), output.data(), scratch), 0u);
+  EXPECT_TRUE(requested.empty());
+
+  // Сверка останавливается на первом изменённом блоке.
+  bars.sources[kChunk + 5] += 0.25f;
+  EXPECT_EQ(store.load(barTimes, bars.sources.data(), bars.times.size(), output.data(), scratch), kChunk);
+  EXPECT_EQ(requested, (std::vector<std::size_t>{0, kChunk}));
+  EXPECT_EQ(output[kChunk - 1], bars.values[kChunk - 1]);
+  std::filesystem::remove(path);
+}
+
+TEST(ColumnStoreTest, HashDetectsSingleBarChanges) {
+  Bars bars(1000);
+  const std::uint64_t base = sierra::core::hash_bars(bars.times.data(), bars.sources.data(), 1000, 1);
+  EXPECT_NE(sierra::core::hash_bars(bars.times.data(), bars.sources.data(), 1000, 2), base);
+  EXPECT_NE(sierra::core::hash_bars(bars.times.data(), bars.sources.data(), 999, 1), base);
+  for (const std::size_t bar : {std::size_t{0}, std::size_t{3}, std::size_t{998}, std::size_t{999}}) {
+    bars.times[bar] ^= std::int64_t{1} << 62;
+    EXPECT_NE(sierra::core::hash_bars(bars.times.data(), bars.sources.data(), 1000, 1), base) << bar;
+    bars.times[bar] ^= std::int64_t{1} << 62;
+  }
+  EXPECT_EQ(sierra::core::hash_bars(bars.times.data(), bars.sources.data(), 1000, 1), base);
+}
+
+}  // namespace
@@ -0,0 +1,92 @@
+/**
+ * @brief Модульные тесты масок пересечений столбцов.
+ * @note Маски сверяются со скалярным `cross_over` на каждом баре: равные значения, NaN и длинные равные участки.
+ */
+#include "sierra/core/crossover.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+using sierra::core::CrossDirection;
+
+bool Bit(const std::vector<std::uint64_t>& mask, std::size_t bar) { return ((mask[bar / 64] >> (bar % 64)) & 1) != 0; }
+
+void ExpectMatchesScalar(const std::vector<float>& first, const std::vector<float>& second,
+                         const sierra::core::CrossMasks& masks) {
+  for (std::size_t bar = 0; bar < first.size(); ++bar) {
+    const CrossDirection expected = sierra::core::cross_over(first.data(), second.data(), bar);
+    ASSERT_EQ(Bit(masks.from_bottom, bar), expected == CrossDirection::kFromBottom) << "bar " << bar;
+    ASSERT_EQ(Bit(masks.from_top, bar), expected == CrossDirection::kFromTop) << "bar " << bar;
+  }
+}
+
+TEST(CrossoverTest, ScalarFollowsCrossOverLookback) {
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const std::vector<float> first = {1, 3, 2, 2, 3, 1, nan, 3, 1, 1};
+  const std::vector<float> second = {2, 2, 2, 2, 2, 2, 2, 2, 2, 2};
+  EXPECT_EQ(sierra::core::cross_over(first.data(), second.data(), 0), CrossDirection::kNone);
+  EXPECT_EQ(sierra::core::cross_over(first.data(), second.data(), 1), CrossDirection::kFromBottom);
+  EXPECT_EQ(sierra::core::cross_over(first.data(), second.data(), 3), CrossDirection::kNone);  // равны
+  EXPECT_EQ(sierra::core::cross_over(first.data(), second.data(), 4), CrossDirection::kNone);  // 3 > 2 и до равных
+  EXPECT_EQ(sierra::core::cross_over(first.data(), second.data(), 5), CrossDirection::kFromTop);
+  EXPECT_EQ(sierra::core::cross_over(first.data(), second.data(), 6), CrossDirection::kNone);  // NaN
+  EXPECT_EQ(sierra::core::cross_over(first.data(), second.data(), 7), CrossDirection::kNone);  // после NaN
+  EXPECT_EQ(sierra::core::cross_over(first.data(), second.data(), 8), CrossDirection::kFromTop);
+
+  // Равный участок: пересечение видно через 99 равных баров, но не через 100.
+  for (const std::size_t run : {std::size_t{99}, std::size_t{100}}) {
+    std::vector<float> line(run + 2, 2.0f);
+    line.front() = 1.0f;
+    line.back() = 3.0f;
+    const std::vector<float> level(line.size(), 2.0f);
+    const auto expected = run < sierra::core::kCrossLookback ? CrossDirection::kFromBottom : CrossDirection::kNone;
+    EXPECT_EQ(sierra::core::cross_over(line.data(), level.data(), line.size() - 1), expected) << run;
+  }
+}
+
+TEST(CrossoverTest, MasksMatchScalarOnEveryBar) {
+  std::mt19937 random(7);
+  std::uniform_int_distribution<int> step(-2, 2);
+  std::uniform_int_distribution<int> event(0, 99);
+  for (const std::size_t count : {std::size_t{1}, std::size_t{63}, std::size_t{64}, std::size_t{1000},
+                                  std::size_t{4099}}) {
+    std::vector<float> first(count);
+    std::vector<float> second(count);
+    float a = 0.0f;
+    float b = 0.0f;
+    for (std::size_t i = 0; i < count; ++i) {
+      // Целые шаги: ряды часто равны, а иногда стоят равными дольше, чем смотрит sc.CrossOver.
+      const bool flat = (i / 150) % 5 == 3;
+      a += flat ? 0.0f : static_cast<float>(step(random));
+      b = flat ? a : b + static_cast<float>(step(random));
+      first[i] = event(random) == 0 ? std::numeric_limits<float>::quiet_NaN() : a;
+      second[i] = b;
+    }
+    sierra::core::CrossMasks masks;
+    sierra::core::crossover_masks(first.data(), second.data(), count, masks);
+    ASSERT_EQ(masks.from_bottom.size(), (count + 63) / 64);
+    ExpectMatchesScalar(first, second, masks);
+
+    sierra::core::threshold_masks(first.data(), 1.0f, count, masks);
+    ExpectMatchesScalar(first, std::vector<float>(count, 1.0f), masks);
+  }
+}
+
+TEST(CrossoverTest, ExtractsEventIndices) {
+  std::vector<std::uint64_t> mask(3, 0);
+  mask[0] = (std::uint64_t{1} << 5) | (std::uint64_t{1} << 63);
+  mask[2] = 1;
+  EXPECT_EQ(sierra::core::count_events(mask), 3u);
+  std::vector<std::size_t> indices = {7};
+  sierra::core::extract_events(mask, indices);
+  EXPECT_EQ(indices, (std::vector<std::size_t>{7, 5, 63, 128}));
+}
+
+}  // namespace
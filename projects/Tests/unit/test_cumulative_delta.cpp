@@ -0,0 +1,125 @@
+/**
+ * @brief Модульные тесты движка кумулятивной дельты.
+ * @note Сверяем OHLC с формулами `CumulativeDelta*_S`, сбросы по сессии и счётчику баров, а также откат бара.
+ */
+#include "sierra/core/cumulative_delta.hpp"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+namespace {
+
+using sierra::core::CumulativeDeltaEngine;
+using sierra::core::CumulativeDeltaOptions;
+using sierra::core::DeltaSource;
+using sierra::core::TradeRecord;
+using sierra::core::TradeSide;
+
+TradeRecord Trade(float price, std::uint32_t volume, TradeSide side) {
+  TradeRecord trade;
+  trade.price = price;
+  trade.volume = volume;
+  trade.side = side;
+  return trade;
+}
+
+TEST(CumulativeDeltaTest, BuildsVolumeDeltaOhlc) {
+  CumulativeDeltaEngine engine(CumulativeDeltaOptions{DeltaSource::kVolume, true, 0});
+  engine.start_bar(true);
+  engine.add_trade(Trade(10.0f, 5, TradeSide::kAsk));
+  engine.add_trade(Trade(10.0f, 8, TradeSide::kBid));
+  engine.start_bar(false);
+  engine.add_trade(Trade(10.0f, 4, TradeSide::kAsk));
+
+  ASSERT_EQ(engine.size(), 2u);
+  const auto& first = engine.bars()[0];
+  EXPECT_DOUBLE_EQ(first.open, 0.0);
+  EXPECT_DOUBLE_EQ(first.high, 5.0);
+  EXPECT_DOUBLE_EQ(first.low, -3.0);
+  EXPECT_DOUBLE_EQ(first.close, -3.0);
+
+  const auto& second = engine.bars()[1];
+  EXPECT_DOUBLE_EQ(second.open, 1.0);  // Open зажат в [Low, High] = [1, 1].
+  EXPECT_DOUBLE_EQ(second.close, 1.0);
+}
+
+TEST(CumulativeDeltaTest, ResetsAtSessionAndBarCount) {
+  CumulativeDeltaEngine session(CumulativeDeltaOptions{DeltaSource::kTrades, true, 0});
+  session.start_bar(true);
+  session.add_trade(Trade(1.0f, 1, TradeSide::kAsk));
+  session.start_bar(true);
+  EXPECT_DOUBLE_EQ(session.value(), 0.0);
+
+  CumulativeDeltaEngine counted(CumulativeDeltaOptions{DeltaSource::kTrades, false, 2});
+  for (int i = 0; i < 3; ++i) {
+    counted.start_bar(false);
+    counted.add_trade(Trade(1.0f, 1, TradeSide::kAsk));
+  }
+  EXPECT_DOUBLE_EQ(counted.bars()[1].close, 2.0);
+  EXPECT_DOUBLE_EQ(counted.bars()[2].close, 1.0);
+}
+
+TEST(CumulativeDeltaTest, TickVolumeUsesZeroTickRule) {
+  CumulativeDeltaEngine engine(CumulativeDeltaOptions{DeltaSource::kTickVolume, true, 0});
+  engine.start_bar(true);
+  engine.add_trade(Trade(10.0f, 3, TradeSide::kUnknown));
+  engine.add_trade(Trade(11.0f, 2, TradeSide::kUnknown));
+  engine.add_trade(Trade(11.0f, 4, TradeSide::kUnknown));
+  engine.add_trade(Trade(10.5f, 1, TradeSide::kUnknown));
+  EXPECT_DOUBLE_EQ(engine.value(), 5.0);
+}
+
+TEST(CumulativeDeltaTest, RollbackRestoresBarStartState) {
+  CumulativeDeltaEngine engine(CumulativeDeltaOptions{DeltaSource::kTickVolume, true, 0});
+  engine.start_bar(true);
+  engine.add_trade(Trade(10.0f, 1, TradeSide::kUnknown));
+  engine.add_trade(Trade(11.0f, 2, TradeSide::kUnknown));
+  engine.start_bar(false);
+  engine.add_trade(Trade(12.0f, 7, TradeSide::kUnknown));
+
+  engine.rollback_last_bar();
+  EXPECT_DOUBLE_EQ(engine.value(), 2.0);
+  engine.add_trade(Trade(9.0f, 5, TradeSide::kUnknown));
+  EXPECT_DOUBLE_EQ(engine.bars()[1].close, -3.0);
+  EXPECT_DOUBLE_EQ(engine.bars()[1].open, -3.0);
+}
+
+TEST(CumulativeDeltaTest, SnapshotRestoresBarsAndRollbackPoint) {
+  const CumulativeDeltaOptions options{DeltaSource::kTickVolume, false, 3};
+  CumulativeDeltaEngine engine(options);
+  engine.start_bar(true);
+  engine.add_trade(Trade(10.0f, 1, TradeSide::kUnknown));
+  engine.start_bar(false);
+  engine.add_trade(Trade(11.0f, 2, TradeSide::kUnknown));
+  sierra::core::SnapshotWriter writer;
+  engine.save(writer);
+
+  CumulativeDeltaEngine restored(options);
+  sierra::core::SnapshotReader reader(writer.bytes());
+  ASSERT_TRUE(restored.restore(reader));
+  EXPECT_EQ(reader.remaining(), 0u);
+  for (CumulativeDeltaEngine* target : {&engine, &restored}) {
+    target->rollback_last_bar();
+    target->add_trade(Trade(11.0f, 4, TradeSide::kUnknown));
+    target->start_bar(false);
+    target->add_trade(Trade(11.0f, 3, TradeSide::kUnknown));
+  }
+  ASSERT_EQ(restored.size(), engine.size());
+  for (std::size_t i = 0; i < engine.size(); ++i) {
+    EXPECT_DOUBLE_EQ(restored.bars()[i].close, engine.bars()[i].close) << i;
+  }
+  EXPECT_DOUBLE_EQ(restored.value(), engine.value());
+
+  CumulativeDeltaEngine other(CumulativeDeltaOptions{DeltaSource::kVolume, false, 3});
+  sierra::core::SnapshotReader again(writer.bytes());
+  EXPECT_FALSE(other.restore(again));
+  EXPECT_EQ(other.size(), 0u);
+}
+
+TEST(CumulativeDeltaTest, ThrowsWhenTradeArrivesBeforeBar) {
+  CumulativeDeltaEngine engine(CumulativeDeltaOptions{});
+  EXPECT_THROW(engine.add_trade(Trade(1.0f, 1, TradeSide::kAsk)), std::logic_error);
+}
+
+}  // namespace
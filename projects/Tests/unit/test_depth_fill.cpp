@@ -0,0 +1,105 @@
+/**
+ * @brief Модульные тесты модели исполнения по сводкам стакана.
+ * @note Проверяем поиск уровней, позицию в очереди, частичные исполнения и влияние рыночной заявки на цену.
+ */
+#include "sierra/core/depth_fill.hpp"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using sierra::core::Backtester;
+using sierra::core::DepthBook;
+using sierra::core::DepthFillModel;
+using sierra::core::DepthLevel;
+using sierra::core::OrderRequest;
+using sierra::core::OrderSide;
+using sierra::core::OrderType;
+using sierra::core::ScidRecord;
+
+constexpr double kTick = 0.25;
+
+DepthBook MakeBook() {
+  DepthBook book(kTick);
+  // Бар 0 с времени 0: уровни 99.50..100.50 (индексы 398..402).
+  std::vector<DepthLevel> levels(5);
+  for (auto& level : levels) {
+    level.last_bid = 10;
+    level.last_ask = 10;
+    level.max_bid = 20;
+    level.max_ask = 20;
+  }
+  book.add_bar(0, 398, levels);
+  levels[2].last_ask = 4;  // 100.00
+  book.add_bar(100, 398, levels);
+  return book;
+}
+
+ScidRecord Trade(std::int64_t time, float price, std::uint32_t bid_volume, std::uint32_t ask_volume) {
+  ScidRecord tick;
+  tick.date_time = time;
+  tick.close = price;
+  tick.low = price;
+  tick.high = price + static_cast<float>(kTick);
+  tick.bid_volume = bid_volume;
+  tick.ask_volume = ask_volume;
+  tick.total_volume = bid_volume + ask_volume;
+  return tick;
+}
+
+TEST(DepthFillTest, LocatesBarsAndLevels) {
+  const DepthBook book = MakeBook();
+  EXPECT_EQ(book.locate(50, 0), 0u);
+  EXPECT_EQ(book.locate(150, 0), 1u);
+  EXPECT_EQ(book.locate(10, 1), 0u);
+  ASSERT_NE(book.level(1, 100.0), nullptr);
+  EXPECT_EQ(book.level(1, 100.0)->last_ask, 4u);
+  EXPECT_EQ(book.level(1, 101.0), nullptr);
+  EXPECT_THROW(DepthBook(0.0), std::invalid_argument);
+}
+
+TEST(DepthFillTest, LimitOrderWaitsForQueueAndFillsPartially) {
+  const DepthBook book = MakeBook();
+  const DepthFillModel model(book);
+  double queue = model.initial_queue(OrderSide::kBuy, 100.0, 0);
+  EXPECT_DOUBLE_EQ(queue, 10.0);
+
+  EXPECT_EQ(model.limit_fill(OrderSide::kBuy, 100.0, 5, queue, Trade(1, 100.0f, 6, 0), 0), 0);
+  EXPECT_DOUBLE_EQ(queue, 4.0);
+  EXPECT_EQ(model.limit_fill(OrderSide::kBuy, 100.0, 5, queue, Trade(2, 100.0f, 7, 0), 0), 3);
+  EXPECT_EQ(model.limit_fill(OrderSide::kBuy, 100.0, 2, queue, Trade(3, 99.75f, 1, 0), 0), 2);
+}
+
+TEST(DepthFillTest, MarketOrderWalksLevels) {
+  const DepthBook book = MakeBook();
+  const DepthFillModel model(book);
+  // Ask 100.00 с 4 контрактами: 10 контрактов = 4 @ +0, 4 @ +1 тик, 2 @ +2 тика.
+  const ScidRecord tick = Trade(150, 99.75f, 1, 0);
+  EXPECT_DOUBLE_EQ(model.market_price(OrderSide::kBuy, 10, tick, 1), 100.0 + kTick * 8.0 / 10.0);
+  EXPECT_DOUBLE_EQ(model.market_price(OrderSide::kBuy, 1, tick, 1), 100.0);
+}
+
+TEST(DepthFillTest, BacktesterUsesQueueModel) {
+  const DepthBook book = MakeBook();
+  const DepthFillModel model(book);
+  Backtester backtester;
+  backtester.set_fill_model(&model);
+
+  OrderRequest request;
+  request.type = OrderType::kLimit;
+  request.price = 100.0;
+  request.quantity = 4;
+  backtester.submit(request);
+
+  backtester.process_tick(Trade(1, 100.0f, 12, 0));  // очередь 10, излишек 2
+  EXPECT_EQ(backtester.position(), 2);
+  EXPECT_EQ(backtester.active_orders(), 1u);
+  backtester.process_tick(Trade(2, 100.0f, 5, 0));
+  EXPECT_EQ(backtester.position(), 4);
+  EXPECT_EQ(backtester.active_orders(), 0u);
+}
+
+}  // namespace
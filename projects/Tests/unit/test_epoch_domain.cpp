@@ -0,0 +1,89 @@
+/**
+ * @brief Модульные тесты отложенного освобождения по эпохам.
+ * @note Проверяем, что закреплённый читатель удерживает объект, а после открепления объект освобождается.
+ */
+#include "sierra/core/epoch_domain.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_freed = 0;
+
+void CountFree(void* object) {
+  delete static_cast<int*>(object);
+  ++g_freed;
+}
+
+TEST(EpochDomainTest, PinnedReaderDefersReclamation) {
+  g_freed = 0;
+  sierra::core::EpochDomain domain;
+  {
+    const auto guard = domain.pin();
+    domain.retire(new int(1), &CountFree);
+    EXPECT_EQ(g_freed, 0);
+    EXPECT_EQ(domain.pending(), 1u);
+  }
+  EXPECT_EQ(domain.reclaim(), 1u);
+  EXPECT_EQ(g_freed, 1);
+
+  // Читатель, закрепившийся после замены, старый объект не держит.
+  domain.retire(new int(2), &CountFree);
+  const auto late = domain.pin();
+  domain.retire(new int(3), &CountFree);
+  EXPECT_EQ(g_freed, 2);
+  EXPECT_EQ(domain.pending(), 1u);
+}
+
+TEST(EpochDomainTest, DestructorFreesPendingObjects) {
+  g_freed = 0;
+  {
+    sierra::core::EpochDomain domain;
+    const auto guard = domain.pin();
+    domain.retire(new int(1), &CountFree);
+    domain.retire(new int(2), &CountFree);
+  }
+  EXPECT_EQ(g_freed, 2);
+}
+
+TEST(EpochDomainTest, ReadersNeverSeeFreedValue) {
+  struct Box {
+    std::atomic<int> value;
+  };
+  sierra::core::EpochDomain domain;
+  std::atomic<Box*> current{new Box{{0}}};
+  std::atomic<bool> done{false};
+  std::atomic<int> bad{0};
+
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 4; ++r) {
+    readers.emplace_back([&] {
+      while (!done.load()) {
+        const auto guard = domain.pin();
+        const Box* box = current.load();
+        if (box->value.load() < 0) {
+          bad.fetch_add(1);
+        }
+      }
+    });
+  }
+  for (int i = 1; i <= 20000; ++i) {
+    Box* old = current.exchange(new Box{{i}});
+    domain.retire(old, [](void* object) {
+      static_cast<Box*>(object)->value.store(-1);  // «отравляем», прежде чем освободить
+      delete static_cast<Box*>(object);
+    });
+  }
+  done.store(true);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(bad.load(), 0);
+  delete current.load();
+}
+
+}  // namespace
@@ -0,0 +1,79 @@
+/**
+ * @brief Модульные тесты гистограммы задержек.
+ * @note Проверяем непрерывность корзин, относительную точность квантилей, объединение и сброс.
+ */
+#include "sierra/core/latency_histogram.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+using sierra::core::LatencyHistogram;
+
+TEST(LatencyHistogramTest, BucketsAreContiguousAndCoverValues) {
+  std::size_t expected = 0;
+  for (std::size_t bucket = 0; bucket < LatencyHistogram::kBucketCount; ++bucket) {
+    const std::uint64_t lower = LatencyHistogram::bucket_lower(bucket);
+    ASSERT_EQ(LatencyHistogram::bucket_of(lower), bucket);
+    ASSERT_EQ(LatencyHistogram::bucket_of(lower + LatencyHistogram::bucket_width(bucket) - 1), bucket);
+    ++expected;
+    if (bucket + 1 < LatencyHistogram::kBucketCount) {
+      ASSERT_EQ(lower + LatencyHistogram::bucket_width(bucket), LatencyHistogram::bucket_lower(bucket + 1));
+    }
+  }
+  EXPECT_EQ(expected, LatencyHistogram::kBucketCount);
+  EXPECT_EQ(LatencyHistogram::bucket_of(UINT64_MAX), LatencyHistogram::kBucketCount - 1);
+}
+
+TEST(LatencyHistogramTest, QuantilesStayWithinRelativeAccuracy) {
+  std::mt19937_64 rng(42);
+  std::lognormal_distribution<double> latency(8.0, 1.5);
+  std::vector<std::uint64_t> values(100000);
+  LatencyHistogram histogram;
+  for (auto& value : values) {
+    value = static_cast<std::uint64_t>(latency(rng));
+    histogram.record(value);
+  }
+  std::sort(values.begin(), values.end());
+
+  EXPECT_EQ(histogram.count(), values.size());
+  EXPECT_EQ(histogram.min(), values.front());
+  EXPECT_EQ(histogram.max(), values.back());
+  EXPECT_EQ(histogram.quantile(0.0), values.front());
+  EXPECT_EQ(histogram.quantile(1.0), values.back());
+  const double tolerance = 1.0 / static_cast<double>(LatencyHistogram::kSubBuckets);
+  for (double q : {0.5, 0.9, 0.99, 0.999}) {
+    const auto exact = static_cast<double>(values[static_cast<std::size_t>(q * values.size()) - 1]);
+    EXPECT_NEAR(static_cast<double>(histogram.quantile(q)), exact, exact * tolerance) << "q=" << q;
+  }
+}
+
+TEST(LatencyHistogramTest, MergeMatchesSingleHistogramAndResetClears) {
+  LatencyHistogram whole;
+  LatencyHistogram first;
+  LatencyHistogram second;
+  for (std::uint64_t value = 1; value <= 5000; value += 7) {
+    whole.record(value);
+    (value % 2 == 0 ? first : second).record(value);
+  }
+  first.merge(second);
+  EXPECT_EQ(first.count(), whole.count());
+  EXPECT_EQ(first.min(), whole.min());
+  EXPECT_EQ(first.max(), whole.max());
+  EXPECT_DOUBLE_EQ(first.mean(), whole.mean());
+  EXPECT_EQ(first.quantile(0.5), whole.quantile(0.5));
+  EXPECT_EQ(first.quantile(0.99), whole.quantile(0.99));
+
+  first.reset();
+  EXPECT_EQ(first.count(), 0u);
+  EXPECT_EQ(first.min(), 0u);
+  EXPECT_EQ(first.max(), 0u);
+  EXPECT_EQ(first.quantile(0.5), 0u);
+}
+
+}  // namespace
@@ -0,0 +1,69 @@
+/**
+ * @brief Модульные тесты бутстрэп-моделирования сделок.
+ * @note Проверяем воспроизводимость при разном числе потоков и крайние случаи просадки и разорения.
+ */
+#include "sierra/core/monte_carlo.hpp"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using sierra::core::counter_random;
+using sierra::core::monte_carlo;
+using sierra::core::MonteCarloOptions;
+using sierra::core::ThreadPool;
+
+TEST(MonteCarloTest, CounterRandomIsStateless) {
+  EXPECT_EQ(counter_random(42, 7), counter_random(42, 7));
+  EXPECT_NE(counter_random(42, 7), counter_random(42, 8));
+  EXPECT_NE(counter_random(42, 7), counter_random(43, 7));
+}
+
+TEST(MonteCarloTest, ResultDoesNotDependOnThreadCount) {
+  const std::vector<double> profits = {120.0, -80.0, 45.0, -30.0, 200.0, -150.0, 10.0};
+  MonteCarloOptions options;
+  options.paths = 5000;
+  options.trades_per_path = 50;
+  options.starting_capital = 500.0;
+  options.ruin_capital = 0.0;
+  options.seed = 11;
+
+  ThreadPool single(1);
+  ThreadPool many(4);
+  const auto lhs = monte_carlo(profits, options, single);
+  const auto rhs = monte_carlo(profits, options, many);
+  EXPECT_EQ(lhs.paths, 5000u);
+  EXPECT_EQ(lhs.ruined_paths, rhs.ruined_paths);
+  for (double q : {0.05, 0.5, 0.95}) {
+    EXPECT_DOUBLE_EQ(lhs.max_drawdown.quantile(q), rhs.max_drawdown.quantile(q));
+    EXPECT_DOUBLE_EQ(lhs.final_profit.quantile(q), rhs.final_profit.quantile(q));
+  }
+  EXPECT_GT(lhs.risk_of_ruin(), 0.0);
+  EXPECT_LT(lhs.risk_of_ruin(), 1.0);
+  EXPECT_LE(lhs.max_drawdown.max(), 0.0);
+}
+
+TEST(MonteCarloTest, HandlesDegenerateSamples) {
+  ThreadPool pool(2);
+  MonteCarloOptions options;
+  options.paths = 100;
+  options.starting_capital = 5.0;
+  options.ruin_capital = 0.0;
+
+  const auto winners = monte_carlo({1.0, 2.0}, options, pool);
+  EXPECT_DOUBLE_EQ(winners.max_drawdown.min(), 0.0);
+  EXPECT_EQ(winners.ruined_paths, 0u);
+
+  options.trades_per_path = 10;
+  const auto losers = monte_carlo({-1.0}, options, pool);
+  EXPECT_DOUBLE_EQ(losers.final_profit.quantile(0.5), -10.0);
+  EXPECT_DOUBLE_EQ(losers.max_drawdown.max(), -10.0);
+  EXPECT_DOUBLE_EQ(losers.risk_of_ruin(), 1.0);
+
+  EXPECT_THROW(monte_carlo({}, options, pool), std::invalid_argument);
+}
+
+}  // namespace
@@ -7,6 +7,7 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 #include <vector>
@@ -30,4 +31,98 @@ TEST(MovingAverageTest, ThrowsOnZeroPeriod) {
   EXPECT_THROW(sierra::core::moving_average(input, 0), std::invalid_argument);
 }
 
+TEST(MovingAverageTest, RangeUpdateMatchesFullCalculation) {
+  const std::vector<float> input{4.0f, 8.0f, 6.0f, 2.0f, 10.0f, 12.0f, 3.0f};
+  std::vector<float> full(input.size());
+  sierra::core::moving_average(input.data(), input.size(), 3, 0, full.data());
+
+  std::vector<float> partial(input.size(), -1.0f);
+  sierra::core::moving_average(input.data(), input.size(), 3, 5, partial.data());
+
+  EXPECT_TRUE(std::isnan(full[1]));
+  EXPECT_FLOAT_EQ(full[2], 6.0f);
+  EXPECT_FLOAT_EQ(partial[4], -1.0f);
+  for (std::size_t i = 5; i < input.size(); ++i) {
+    EXPECT_FLOAT_EQ(partial[i], full[i]);
+  }
+  EXPECT_THROW(sierra::core::moving_average(input.data(), input.size(), 0, 0, partial.data()),
+               std::invalid_argument);
+}
+
+TEST(MovingAverageTest, EngineFollowsLiveUpdatesAndRewinds) {
+  std::vector<float> input{4.0f, 8.0f, 6.0f, 2.0f, 10.0f};
+  std::vector<float> output(input.size());
+  sierra::core::MovingAverageEngine engine(sierra::core::MovingAverageConfig{3});
+  engine.update(input.data(), input.size(), 0, output.data());
+  EXPECT_EQ(engine.committed_bars(), 4u);
+  EXPECT_TRUE(std::isnan(output[1]));
+  EXPECT_FLOAT_EQ(output[4], 6.0f);
+
+  // Сделка внутри последнего бара, затем новый бар.
+  input.back() = 16.0f;
+  engine.update(input.data(), input.size(), input.size() - 1, output.data());
+  EXPECT_FLOAT_EQ(output[4], 8.0f);
+  input.push_back(1.0f);
+  output.push_back(0.0f);
+  engine.update(input.data(), input.size(), input.size() - 2, output.data());
+  EXPECT_EQ(engine.committed_bars(), 5u);
+
+  std::vector<float> expected(input.size());
+  sierra::core::moving_average(input.data(), input.size(), 3, 0, expected.data());
+  for (std::size_t i = 2; i < input.size(); ++i) {
+    EXPECT_FLOAT_EQ(output[i], expected[i]);
+  }
+
+  // Исправление закрытого бара откатывает сумму окна.
+  input[3] = 20.0f;
+  engine.update(input.data(), input.size(), 3, output.data());
+  sierra::core::moving_average(input.data(), input.size(), 3, 0, expected.data());
+  for (std::size_t i = 2; i < input.size(); ++i) {
+    EXPECT_FLOAT_EQ(output[i], expected[i]);
+  }
+
+  // Новый движок с заполненным до first выходом (например, из общего кэша) не трогает начало.
+  sierra::core::MovingAverageEngine fresh(sierra::core::MovingAverageConfig{3});
+  std::vector<float> tail(input.size(), -1.0f);
+  fresh.update(input.data(), input.size(), 4, tail.data());
+  EXPECT_EQ(fresh.committed_bars(), input.size() - 1);
+  EXPECT_EQ(tail[3], -1.0f);
+  for (std::size_t i = 4; i < input.size(); ++i) {
+    EXPECT_FLOAT_EQ(tail[i], expected[i]);
+  }
+
+  EXPECT_THROW(engine.reset(sierra::core::MovingAverageConfig{0}), std::invalid_argument);
+}
+
+TEST(MovingAverageTest, EngineSnapshotResumesWithoutRewind) {
+  std::vector<float> input{4.0f, 8.0f, 6.0f, 2.0f, 10.0f, 12.0f};
+  std::vector<float> output(input.size());
+  sierra::core::MovingAverageEngine engine(sierra::core::MovingAverageConfig{3});
+  engine.update(input.data(), input.size(), 0, output.data());
+  sierra::core::SnapshotWriter writer;
+  engine.save(writer);
+
+  // Начало входа испорчено: восстановленный движок не должен его перечитывать.
+  input.push_back(7.0f);
+  output.push_back(0.0f);
+  std::vector<float> expected(input.size());
+  sierra::core::moving_average(input.data(), input.size(), 3, 0, expected.data());
+  std::fill(input.begin(), input.begin() + 2, 1000.0f);
+
+  sierra::core::MovingAverageEngine restored(sierra::core::MovingAverageConfig{3});
+  sierra::core::SnapshotReader reader(writer.bytes());
+  ASSERT_TRUE(restored.restore(reader));
+  EXPECT_EQ(restored.committed_bars(), 5u);
+  restored.update(input.data(), input.size(), 5, output.data());
+  EXPECT_FLOAT_EQ(output[5], expected[5]);
+  EXPECT_FLOAT_EQ(output[6], expected[6]);
+
+  sierra::core::MovingAverageEngine other(sierra::core::MovingAverageConfig{4});
+  sierra::core::SnapshotReader again(writer.bytes());
+  EXPECT_FALSE(other.restore(again));
+  EXPECT_EQ(other.committed_bars(), 0u);
+  sierra::core::SnapshotReader truncated(writer.bytes().data(), writer.bytes().size() - 1);
+  EXPECT_THROW(restored.restore(truncated), std::runtime_error);
+}
+
 }  // namespace
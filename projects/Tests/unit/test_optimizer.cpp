@@ -0,0 +1,112 @@
+/**
+ * @brief Модульные тесты параллельного оптимизатора параметров.
+ * @note Проверяем перебор сетки, случайный поиск, ранжирование и совместное использование столбцов индикаторов.
+ */
+#include "sierra/core/optimizer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using sierra::core::ParameterRange;
+
+TEST(OptimizerTest, GridSearchEnumeratesCartesianProduct) {
+  const auto sets = sierra::core::grid_search(
+      {ParameterRange{"fast", 5.0, 15.0, 5.0}, ParameterRange{"slow", 20.0, 30.0, 10.0}});
+  ASSERT_EQ(sets.size(), 6u);
+  EXPECT_EQ(sets[0], (sierra::core::ParameterSet{5.0, 20.0}));
+  EXPECT_EQ(sets[1], (sierra::core::ParameterSet{5.0, 30.0}));
+  EXPECT_EQ(sets[5], (sierra::core::ParameterSet{15.0, 30.0}));
+  EXPECT_THROW(sierra::core::grid_search({ParameterRange{"bad", 1.0, 2.0, 0.0}}),
+               std::invalid_argument);
+}
+
+TEST(OptimizerTest, RandomSearchIsReproducibleAndOnGrid) {
+  const std::vector<ParameterRange> ranges{ParameterRange{"p", 2.0, 10.0, 2.0}};
+  const auto first = sierra::core::random_search(ranges, 50, 7);
+  EXPECT_EQ(first, sierra::core::random_search(ranges, 50, 7));
+  for (const auto& set : first) {
+    EXPECT_EQ(std::fmod(set[0], 2.0), 0.0);
+    EXPECT_GE(set[0], 2.0);
+    EXPECT_LE(set[0], 10.0);
+  }
+}
+
+TEST(OptimizerTest, RanksResultsAndKeepsTopK) {
+  sierra::core::ThreadPool pool(4);
+  sierra::core::ResultTable table(3);
+  const auto candidates = sierra::core::grid_search({ParameterRange{"x", 0.0, 99.0, 1.0}});
+  sierra::core::optimize(
+      candidates,
+      [](const sierra::core::ParameterSet& set) {
+        sierra::core::OptimizationResult result;
+        result.parameters = set;
+        result.objective = -std::abs(set[0] - 42.0);
+        return result;
+      },
+      pool, table);
+
+  EXPECT_EQ(table.evaluated(), 100u);
+  const auto ranked = table.ranked();
+  ASSERT_EQ(ranked.size(), 3u);
+  EXPECT_DOUBLE_EQ(ranked[0].parameters[0], 42.0);
+  EXPECT_DOUBLE_EQ(ranked[0].objective, 0.0);
+  EXPECT_DOUBLE_EQ(ranked[2].objective, -1.0);
+}
+
+TEST(OptimizerTest, SharesIndicatorColumnsAcrossParameterSets) {
+  std::vector<sierra::core::ScidRecord> ticks(2000);
+  std::vector<float> closes(ticks.size());
+  for (std::size_t i = 0; i < ticks.size(); ++i) {
+    const float price = 100.0f + static_cast<float>(10.0 * std::sin(static_cast<double>(i) / 50.0));
+    ticks[i].date_time = static_cast<std::int64_t>(i);
+    ticks[i].close = price;
+    closes[i] = price;
+  }
+  sierra::core::IndicatorCache cache(closes);
+  sierra::core::ThreadPool pool(4);
+  sierra::core::ResultTable table(5);
+
+  const auto candidates = sierra::core::grid_search(
+      {ParameterRange{"fast", 5.0, 20.0, 5.0}, ParameterRange{"slow", 40.0, 100.0, 20.0}});
+  sierra::core::optimize(
+      candidates,
+      [&](const sierra::core::ParameterSet& set) {
+        return sierra::core::evaluate_ma_crossover(ticks.data(), ticks.size(), cache,
+                                                   static_cast<std::size_t>(set[0]),
+                                                   static_cast<std::size_t>(set[1]), {});
+      },
+      pool, table);
+
+  EXPECT_EQ(table.evaluated(), candidates.size());
+  EXPECT_EQ(cache.computed_count(), 8u);  // 4 быстрых + 4 медленных вместо 32
+  EXPECT_GT(table.ranked().front().trade_count, 0u);
+}
+
+TEST(OptimizerTest, IndicatorCacheEvictsLeastRecentlyUsedColumn) {
+  std::vector<float> closes(100);
+  for (std::size_t i = 0; i < closes.size(); ++i) {
+    closes[i] = static_cast<float>(i);
+  }
+  sierra::core::IndicatorCache cache(closes, 2);
+  const auto held = cache.moving_average(3);
+  EXPECT_FLOAT_EQ((*held)[10], 9.0f);
+  EXPECT_TRUE(std::isnan((*held)[1]));
+  cache.moving_average(5);
+  cache.moving_average(3);  // период 3 снова последний, вытесняется 5
+  cache.moving_average(7);
+  EXPECT_EQ(cache.computed_count(), 3u);
+  EXPECT_EQ(cache.resident_count(), 2u);
+
+  cache.moving_average(5);  // вытесняет 3, но выданный столбец остаётся живым
+  EXPECT_EQ(cache.computed_count(), 4u);
+  EXPECT_FLOAT_EQ((*held)[99], 98.0f);
+  EXPECT_EQ(cache.moving_average(3)->size(), closes.size());
+  EXPECT_EQ(cache.computed_count(), 5u);
+}
+
+}  // namespace
@@ -0,0 +1,72 @@
+/**
+ * @brief Модульные тесты фонового обработчика ленты сделок.
+ * @note Проверяем классификацию объёма по сторонам, VWAP и учёт отброшенных сделок.
+ */
+#include "sierra/core/order_flow_worker.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace {
+
+sierra::core::TradeRecord MakeTrade(float price, std::uint32_t volume, sierra::core::TradeSide side,
+                                    std::uint32_t sequence) {
+  sierra::core::TradeRecord trade;
+  trade.price = price;
+  trade.volume = volume;
+  trade.side = side;
+  trade.sequence = sequence;
+  return trade;
+}
+
+TEST(OrderFlowWorkerTest, AccumulatesVolumeBySide) {
+  sierra::core::OrderFlowWorker worker(64);
+  worker.push(MakeTrade(100.0f, 3, sierra::core::TradeSide::kAsk, 1));
+  worker.push(MakeTrade(99.0f, 1, sierra::core::TradeSide::kBid, 2));
+  worker.push(MakeTrade(100.0f, 2, sierra::core::TradeSide::kUnknown, 3));
+  worker.drain();
+
+  const auto metrics = worker.snapshot();
+  EXPECT_EQ(metrics.trade_count, 3u);
+  EXPECT_EQ(metrics.ask_volume, 3u);
+  EXPECT_EQ(metrics.bid_volume, 1u);
+  EXPECT_EQ(metrics.unclassified_volume, 2u);
+  EXPECT_EQ(metrics.delta(), 2);
+  EXPECT_EQ(metrics.last_sequence, 3u);
+  EXPECT_DOUBLE_EQ(metrics.vwap(), (300.0 + 99.0 + 200.0) / 6.0);
+}
+
+TEST(OrderFlowWorkerTest, ProcessesLongStreamInOrder) {
+  sierra::core::OrderFlowWorker worker(128);
+  for (std::uint32_t i = 1; i <= 50000; ++i) {
+    while (!worker.push(MakeTrade(10.0f, 1, sierra::core::TradeSide::kAsk, i))) {
+    }
+  }
+  worker.drain();
+
+  const auto metrics = worker.snapshot();
+  EXPECT_EQ(metrics.trade_count, 50000u);
+  EXPECT_EQ(metrics.last_sequence, 50000u);
+}
+
+TEST(OrderFlowWorkerTest, PushWakesIdleWorker) {
+  sierra::core::OrderFlowWorker worker(8);
+  // Пустые проходы доводят паузу до kMaxPause: поток ждёт на условной переменной.
+  std::this_thread::sleep_for(3 * sierra::core::OrderFlowWorker::kMaxPause);
+  const auto start = std::chrono::steady_clock::now();
+  worker.push(MakeTrade(100.0f, 1, sierra::core::TradeSide::kAsk, 1));
+  while (worker.snapshot().trade_count == 0) {
+    std::this_thread::yield();
+  }
+  EXPECT_LT(std::chrono::steady_clock::now() - start, sierra::core::OrderFlowWorker::kMaxPause / 2);
+}
+
+TEST(OrderFlowWorkerTest, ReportsNaNVwapWithoutTrades) {
+  sierra::core::OrderFlowWorker worker(8);
+  EXPECT_TRUE(std::isnan(worker.snapshot().vwap()));
+}
+
+}  // namespace
@@ -0,0 +1,69 @@
+/**
+ * @brief Модульные тесты потокового скетча квантилей.
+ * @note Сверяем оценки с точными квантилями отсортированной выборки и проверяем, что объединение частей не меняет результат.
+ */
+#include "sierra/core/quantile_sketch.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using sierra::core::QuantileSketch;
+
+double ExactQuantile(std::vector<double> values, double q) {
+  std::sort(values.begin(), values.end());
+  return values[static_cast<std::size_t>(q * static_cast<double>(values.size() - 1))];
+}
+
+TEST(QuantileSketchTest, StaysWithinRelativeAccuracy) {
+  std::mt19937 rng(3);
+  std::normal_distribution<double> dist(0.0, 1000.0);
+  std::vector<double> values(20000);
+  QuantileSketch sketch(0.01);
+  for (auto& value : values) {
+    value = dist(rng);
+    sketch.add(value);
+  }
+  for (double q : {0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99}) {
+    const double exact = ExactQuantile(values, q);
+    EXPECT_NEAR(sketch.quantile(q), exact, std::abs(exact) * 0.01 + 1e-9) << q;
+  }
+  EXPECT_EQ(sketch.count(), values.size());
+  EXPECT_DOUBLE_EQ(sketch.quantile(0.0), *std::min_element(values.begin(), values.end()));
+  EXPECT_DOUBLE_EQ(sketch.quantile(1.0), *std::max_element(values.begin(), values.end()));
+}
+
+TEST(QuantileSketchTest, MergeEqualsSingleSketch) {
+  QuantileSketch whole;
+  QuantileSketch left;
+  QuantileSketch right;
+  for (int i = -500; i <= 1500; ++i) {
+    const double value = i * 0.37;
+    whole.add(value);
+    (i % 3 == 0 ? left : right).add(value);
+  }
+  left.merge(right);
+  for (double q = 0.0; q <= 1.0; q += 0.1) {
+    EXPECT_DOUBLE_EQ(left.quantile(q), whole.quantile(q));
+  }
+  EXPECT_EQ(left.count(), whole.count());
+  EXPECT_THROW(left.merge(QuantileSketch(0.02)), std::invalid_argument);
+}
+
+TEST(QuantileSketchTest, HandlesEmptyAndZeroValues) {
+  QuantileSketch sketch;
+  EXPECT_TRUE(std::isnan(sketch.quantile(0.5)));
+  sketch.add(0.0);
+  sketch.add(0.0);
+  sketch.add(5.0);
+  EXPECT_DOUBLE_EQ(sketch.quantile(0.5), 0.0);
+  EXPECT_THROW(QuantileSketch(0.0), std::invalid_argument);
+}
+
+}  // namespace
@@ -0,0 +1,148 @@
+/**
+ * @brief Модульные тесты сканера символов по файлам `.scid`.
+ * @note Файлы создаются во временном каталоге и удаляются после теста.
+ */
+#include "sierra/core/scanner.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::int64_t kDay = sierra::core::kMicrosecondsPerDay;
+
+std::string TempPath(const std::string& name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+/// Дневные бары с заданными закрытиями; у каждого дня два тика, последний — закрытие.
+std::vector<sierra::core::ScidRecord> DailyTicks(const std::vector<float>& closes) {
+  std::vector<sierra::core::ScidRecord> records;
+  for (std::size_t day = 0; day < closes.size(); ++day) {
+    sierra::core::ScidRecord tick;
+    tick.date_time = (45000 + static_cast<std::int64_t>(day)) * kDay + 10 * 3600 * 1000000LL;
+    tick.close = closes[day] - 1.0f;
+    tick.total_volume = 1;
+    records.push_back(tick);
+    tick.date_time += 3600 * 1000000LL;
+    tick.close = closes[day];
+    records.push_back(tick);
+  }
+  return records;
+}
+
+TEST(ScannerTest, ParsesConditions) {
+  const auto above = sierra::core::parse_scan_condition("close > sma(200)");
+  EXPECT_EQ(above.left.series, sierra::core::ScanSeries::kClose);
+  EXPECT_EQ(above.comparison, sierra::core::ScanComparison::kGreater);
+  EXPECT_EQ(above.right.series, sierra::core::ScanSeries::kSma);
+  EXPECT_EQ(above.right.value, 200.0);
+
+  const auto oversold = sierra::core::parse_scan_condition("RSI(14)<30.5");
+  EXPECT_EQ(oversold.left.series, sierra::core::ScanSeries::kRsi);
+  EXPECT_EQ(oversold.comparison, sierra::core::ScanComparison::kLess);
+  EXPECT_EQ(oversold.right.series, sierra::core::ScanSeries::kConstant);
+  EXPECT_EQ(oversold.right.value, 30.5);
+  EXPECT_EQ(sierra::core::to_string(oversold.left), "rsi(14)");
+
+  for (const char* bad : {"close", "close = 5", "ema(5) > 1", "sma(0) > 1", "sma(2.5) > 1", "close > 1 x"}) {
+    EXPECT_THROW(sierra::core::parse_scan_condition(bad), std::invalid_argument) << bad;
+  }
+}
+
+TEST(ScannerTest, AggregatesTicksAndBarsToPeriod) {
+  std::vector<sierra::core::ScidRecord> records(4);
+  records[0] = {kDay + 100, 0.0f, 11.0f, 9.0f, 10.0f, 1, 2, 0, 0};  // тик: high/low — Ask/Bid
+  records[1] = {kDay + 200, 10.0f, 14.0f, 8.0f, 12.0f, 1, 3, 0, 0};  // бар
+  records[2] = {2 * kDay + 5, 0.0f, 0.0f, 0.0f, 20.0f, 1, 1, 0, 0};
+  records[3] = {2 * kDay + 1, 0.0f, 0.0f, 0.0f, 21.0f, 1, 1, 0, 0};  // не по порядку: в текущий бар
+  std::vector<sierra::core::OhlcBar> bars;
+  sierra::core::aggregate_bars(records.data(), records.size(), kDay, bars);
+  ASSERT_EQ(bars.size(), 2u);
+  EXPECT_EQ(bars[0].time.microseconds(), kDay);
+  EXPECT_DOUBLE_EQ(bars[0].open, 10.0);
+  EXPECT_DOUBLE_EQ(bars[0].high, 14.0);
+  EXPECT_DOUBLE_EQ(bars[0].low, 8.0);
+  EXPECT_DOUBLE_EQ(bars[0].close, 12.0);
+  EXPECT_DOUBLE_EQ(bars[0].volume, 5.0);
+  EXPECT_DOUBLE_EQ(bars[1].close, 21.0);
+  EXPECT_THROW(sierra::core::aggregate_bars(records.data(), records.size(), 0, bars), std::invalid_argument);
+}
+
+TEST(ScannerTest, UnbundledTradeMarkersAreNotPrices) {
+  using sierra::core::ScidRecord;
+  std::vector<ScidRecord> records(3);
+  records[0] = {kDay + 100, ScidRecord::kFirstSubTradeOpen, 10.25f, 10.0f, 10.0f, 1, 2, 0, 0};
+  records[1] = {kDay + 100, 0.0f, 10.25f, 10.0f, 10.25f, 1, 1, 0, 0};
+  records[2] = {kDay + 100, ScidRecord::kLastSubTradeOpen, 10.5f, 10.25f, 10.5f, 1, 3, 0, 0};
+  std::vector<sierra::core::OhlcBar> bars;
+  sierra::core::aggregate_bars(records.data(), records.size(), kDay, bars);
+  ASSERT_EQ(bars.size(), 1u);
+  EXPECT_DOUBLE_EQ(bars[0].open, 10.0);
+  EXPECT_DOUBLE_EQ(bars[0].high, 10.5);
+  EXPECT_DOUBLE_EQ(bars[0].low, 10.0);
+  EXPECT_DOUBLE_EQ(bars[0].close, 10.5);
+}
+
+TEST(ScannerTest, IndicatorValuesOnLastBar) {
+  std::vector<sierra::core::OhlcBar> bars(4);
+  const double closes[] = {10.0, 11.0, 10.5, 12.0};
+  for (std::size_t i = 0; i < bars.size(); ++i) {
+    bars[i].close = closes[i];
+  }
+  EXPECT_DOUBLE_EQ(sierra::core::scan_value(bars, {sierra::core::ScanSeries::kSma, 2}), 11.25);
+  EXPECT_TRUE(std::isnan(sierra::core::scan_value(bars, {sierra::core::ScanSeries::kSma, 5})));
+  // Изменения +1, -0.5: средние 0.5 и 0.25, затем сглаживание Уайлдера с +1.5.
+  const double gain = (0.5 * 1.0 + 1.5) / 2.0;
+  const double loss = (0.25 * 1.0 + 0.0) / 2.0;
+  EXPECT_NEAR(sierra::core::scan_value(bars, {sierra::core::ScanSeries::kRsi, 2}),
+              100.0 - 100.0 / (1.0 + gain / loss), 1e-12);
+  EXPECT_TRUE(std::isnan(sierra::core::scan_value(bars, {sierra::core::ScanSeries::kRsi, 4})));
+}
+
+TEST(ScannerTest, ScansSymbolsInParallel) {
+  std::vector<float> rising(30);
+  std::vector<float> falling(30);
+  for (std::size_t i = 0; i < rising.size(); ++i) {
+    rising[i] = 100.0f + static_cast<float>(i);
+    falling[i] = 100.0f - static_cast<float>(i);
+  }
+  const std::vector<std::string> paths = {TempPath("SCANUP.scid"), TempPath("SCANDOWN.scid"),
+                                          TempPath("SCANSHORT.scid"), TempPath("SCANMISSING.scid")};
+  sierra::core::write_scid(paths[0], DailyTicks(rising));
+  sierra::core::write_scid(paths[1], DailyTicks(falling));
+  sierra::core::write_scid(paths[2], DailyTicks({100.0f, 101.0f}));
+
+  sierra::core::ThreadPool pool(3);
+  const auto report = sierra::core::scan_symbols(
+      paths, {sierra::core::parse_scan_condition("close < sma(20)"), sierra::core::parse_scan_condition("rsi(14) < 30")},
+      {}, pool);
+  ASSERT_EQ(report.rows.size(), 4u);
+  ASSERT_EQ(report.columns.size(), 3u);  // close, sma(20), rsi(14)
+  EXPECT_EQ(report.rows[0].symbol, "SCANUP");
+  EXPECT_EQ(report.rows[0].bars, 30u);
+  EXPECT_FALSE(report.rows[0].matched);
+  EXPECT_TRUE(report.rows[1].matched);
+  EXPECT_DOUBLE_EQ(report.rows[1].values[1], (90.0 + 71.0) / 2.0);
+  EXPECT_DOUBLE_EQ(report.rows[1].values[2], 0.0);
+  EXPECT_FALSE(report.rows[2].matched);  // истории не хватает на средние
+  EXPECT_FALSE(report.rows[3].error.empty());
+  EXPECT_EQ(report.matched(), 1u);
+  EXPECT_EQ(report.bytes, 3 * 56u + (60 + 60 + 4) * 40u);
+
+  std::ostringstream table;
+  sierra::core::write_scan_table(table, report, true);
+  EXPECT_EQ(table.str(), "symbol,bars,close,sma(20),rsi(14),matched,error\nSCANDOWN,30,71,80.5,0,1,\n");
+  for (const auto& path : paths) {
+    std::remove(path.c_str());
+  }
+}
+
+}  // namespace
@@ -0,0 +1,72 @@
+/**
+ * @brief Модульные тесты чтения файлов `.scid` через отображение в память.
+ * @note Файлы создаются во временном каталоге и удаляются после теста.
+ */
+#include "sierra/core/scid_file.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+std::string TempPath(const char* name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+TEST(ScidFileTest, RoundTripsRecords) {
+  std::vector<sierra::core::ScidRecord> records(3);
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    records[i].date_time = static_cast<std::int64_t>(i) * 1000;
+    records[i].close = 100.0f + static_cast<float>(i);
+    records[i].total_volume = static_cast<std::uint32_t>(i + 1);
+  }
+  const std::string path = TempPath("sierra_scid_roundtrip.scid");
+  sierra::core::write_scid(path, records);
+
+  {
+    sierra::core::ScidFile file(path);
+    ASSERT_EQ(file.size(), 3u);
+    EXPECT_EQ(file.byte_size(), 56u + 3u * 40u);
+    EXPECT_FLOAT_EQ(file.records()[2].close, 102.0f);
+    EXPECT_EQ(file.records()[1].date_time, 1000);
+  }
+  std::remove(path.c_str());
+}
+
+TEST(ScidFileTest, RejectsInvalidHeader) {
+  const std::string path = TempPath("sierra_scid_invalid.scid");
+  {
+    std::ofstream out(path, std::ios::binary);
+    const std::vector<char> garbage(128, 'x');
+    out.write(garbage.data(), static_cast<std::streamsize>(garbage.size()));
+  }
+  EXPECT_THROW(sierra::core::ScidFile file(path), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(ScidFileTest, ThrowsOnMissingFile) {
+  EXPECT_THROW(sierra::core::ScidFile file(TempPath("sierra_scid_missing.scid")), std::runtime_error);
+}
+
+TEST(ScidFileTest, ClassifiesUnbundledTradesAsTicks) {
+  using sierra::core::ScidRecord;
+  ScidRecord record;
+  record.close = 100.0f;
+  EXPECT_TRUE(record.is_tick());
+  EXPECT_FALSE(record.is_unbundled_trade());
+  for (const float marker : {ScidRecord::kFirstSubTradeOpen, ScidRecord::kLastSubTradeOpen}) {
+    record.open = marker;
+    EXPECT_TRUE(record.is_tick());
+    EXPECT_TRUE(record.is_unbundled_trade());
+  }
+  record.open = 99.0f;
+  EXPECT_FALSE(record.is_tick());
+  EXPECT_FALSE(record.is_unbundled_trade());
+}
+
+}  // namespace
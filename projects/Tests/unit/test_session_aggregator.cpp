@@ -0,0 +1,130 @@
+/**
+ * @brief Модульные тесты агрегатора торговых дней.
+ * @note Проверяем отнесение баров к торговой дате (в том числе ночные сессии), OHLC, Initial Balance, пивоты и пересчёт последнего бара.
+ */
+#include "sierra/core/session_aggregator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+using sierra::core::kMicrosecondsPerDay;
+using sierra::core::kMicrosecondsPerSecond;
+using sierra::core::OhlcBar;
+using sierra::core::SessionAggregator;
+using sierra::core::SessionTimes;
+using sierra::core::Timestamp;
+
+constexpr int kDate = 45306;
+
+OhlcBar Bar(int date, int hour, int minute, double low, double high, double close) {
+  OhlcBar bar;
+  bar.time = Timestamp::from_microseconds(date * kMicrosecondsPerDay +
+                                          (hour * 3600 + minute * 60) * kMicrosecondsPerSecond);
+  bar.open = low;
+  bar.high = high;
+  bar.low = low;
+  bar.close = close;
+  bar.volume = 10.0;
+  return bar;
+}
+
+TEST(SessionAggregatorTest, AssignsOvernightBarsToNextTradingDay) {
+  SessionTimes times;
+  times.start_second = 18 * 3600;
+  times.end_second = 17 * 3600 - 1;
+  SessionAggregator aggregator(times, 0);
+
+  aggregator.update(0, Bar(kDate, 16, 0, 1.0, 2.0, 1.5));
+  aggregator.update(1, Bar(kDate, 18, 0, 3.0, 4.0, 3.5));
+  aggregator.update(2, Bar(kDate + 1, 9, 0, 2.5, 5.0, 4.0));
+
+  ASSERT_EQ(aggregator.periods().size(), 2u);
+  EXPECT_EQ(aggregator.periods()[1].trading_date, kDate + 1);
+  EXPECT_EQ(aggregator.period_of_bar(2), 1u);
+  EXPECT_DOUBLE_EQ(aggregator.periods()[1].open, 3.0);
+  EXPECT_DOUBLE_EQ(aggregator.periods()[1].high, 5.0);
+  EXPECT_DOUBLE_EQ(aggregator.periods()[1].low, 2.5);
+  EXPECT_DOUBLE_EQ(aggregator.periods()[1].close, 4.0);
+  EXPECT_DOUBLE_EQ(aggregator.periods()[1].volume, 20.0);
+}
+
+TEST(SessionAggregatorTest, TracksInitialBalance) {
+  SessionTimes times;
+  times.start_second = 9 * 3600 + 30 * 60;
+  times.end_second = 16 * 3600;
+  SessionAggregator aggregator(times, 3600);
+
+  aggregator.update(0, Bar(kDate, 8, 0, 0.5, 10.0, 1.0));  // до сессии — не входит в IB
+  aggregator.update(1, Bar(kDate, 9, 30, 2.0, 3.0, 2.5));
+  aggregator.update(2, Bar(kDate, 10, 15, 1.5, 2.8, 2.0));
+  EXPECT_FALSE(aggregator.prior(0)->ib_complete);
+  aggregator.update(3, Bar(kDate, 10, 30, 0.1, 9.0, 5.0));
+
+  const auto* period = aggregator.prior(0);
+  ASSERT_NE(period, nullptr);
+  EXPECT_TRUE(period->ib_complete);
+  EXPECT_DOUBLE_EQ(period->ib_high, 3.0);
+  EXPECT_DOUBLE_EQ(period->ib_low, 1.5);
+}
+
+TEST(SessionAggregatorTest, RecomputesLastBarWithoutDoubleCounting) {
+  SessionAggregator aggregator(SessionTimes{}, 0);
+  aggregator.update(0, Bar(kDate, 10, 0, 1.0, 2.0, 1.5));
+  aggregator.update(1, Bar(kDate, 11, 0, 1.0, 2.0, 1.5));
+  aggregator.update(1, Bar(kDate, 11, 0, 0.5, 2.5, 2.2));
+
+  const auto* period = aggregator.prior(0);
+  EXPECT_DOUBLE_EQ(period->volume, 20.0);
+  EXPECT_DOUBLE_EQ(period->low, 0.5);
+  EXPECT_DOUBLE_EQ(period->close, 2.2);
+  EXPECT_THROW(aggregator.update(5, Bar(kDate, 12, 0, 1.0, 1.0, 1.0)), std::invalid_argument);
+}
+
+TEST(SessionAggregatorTest, SnapshotRestoresPeriodsAndLastBarCheckpoint) {
+  SessionTimes times;
+  times.start_second = 18 * 3600;
+  times.end_second = 17 * 3600 - 1;
+  SessionAggregator aggregator(times, 3600);
+  aggregator.update(0, Bar(kDate, 16, 0, 1.0, 2.0, 1.5));
+  aggregator.update(1, Bar(kDate, 18, 0, 3.0, 4.0, 3.5));
+  sierra::core::SnapshotWriter writer;
+  aggregator.save(writer);
+
+  SessionAggregator restored(times, 3600);
+  sierra::core::SnapshotReader reader(writer.bytes());
+  ASSERT_TRUE(restored.restore(reader));
+  for (SessionAggregator* target : {&aggregator, &restored}) {
+    target->update(1, Bar(kDate, 18, 0, 2.5, 4.5, 4.0));
+    target->update(2, Bar(kDate + 1, 9, 0, 2.0, 5.0, 4.0));
+  }
+  ASSERT_EQ(restored.periods().size(), aggregator.periods().size());
+  EXPECT_EQ(restored.period_of_bar(2), aggregator.period_of_bar(2));
+  EXPECT_DOUBLE_EQ(restored.prior(0)->low, aggregator.prior(0)->low);
+  EXPECT_DOUBLE_EQ(restored.prior(0)->volume, 20.0);
+  EXPECT_DOUBLE_EQ(restored.prior(0)->ib_high, aggregator.prior(0)->ib_high);
+
+  SessionAggregator other(SessionTimes{}, 3600);
+  sierra::core::SnapshotReader again(writer.bytes());
+  EXPECT_FALSE(other.restore(again));
+  EXPECT_EQ(other.size(), 0u);
+}
+
+TEST(SessionAggregatorTest, ComputesClassicPivotsFromPriorDay) {
+  SessionAggregator aggregator(SessionTimes{}, 0);
+  aggregator.update(0, Bar(kDate, 10, 0, 90.0, 110.0, 100.0));
+  aggregator.update(1, Bar(kDate + 1, 10, 0, 95.0, 96.0, 95.5));
+
+  const auto levels = sierra::core::classic_pivots(*aggregator.prior(1));
+  EXPECT_DOUBLE_EQ(levels.pivot, 100.0);
+  EXPECT_DOUBLE_EQ(levels.r1, 110.0);
+  EXPECT_DOUBLE_EQ(levels.s1, 90.0);
+  EXPECT_DOUBLE_EQ(levels.r2, 120.0);
+  EXPECT_DOUBLE_EQ(levels.s2, 80.0);
+  EXPECT_EQ(aggregator.prior(2), nullptr);
+}
+
+}  // namespace
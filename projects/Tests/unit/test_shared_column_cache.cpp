@@ -0,0 +1,94 @@
+/**
+ * @brief Модульные тесты процессного кэша общих столбцов.
+ * @note Проверяем ключи, время жизни столбцов и чтение во время дописывания из другого потока.
+ */
+#include "sierra/core/shared_column_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+sierra::core::ColumnKey Key(double period) {
+  return sierra::core::ColumnKey{"ESZ3", 60, "SierraStudy.MovingAverage", {period}, 1000};
+}
+
+TEST(SharedColumnCacheTest, SameKeySharesColumnUntilLastSubscriberLeaves) {
+  sierra::core::SharedColumnCache cache;
+  auto first = cache.acquire(Key(20));
+  auto second = cache.acquire(Key(20));
+  auto other = cache.acquire(Key(21));
+  EXPECT_EQ(first, second);
+  EXPECT_NE(first, other);
+  EXPECT_EQ(cache.columns(), 2u);
+
+  other.reset();
+  EXPECT_EQ(cache.columns(), 1u);
+  first.reset();
+  second.reset();
+  EXPECT_EQ(cache.columns(), 0u);
+  EXPECT_EQ(cache.memory_bytes(), 0u);
+}
+
+TEST(SharedColumnCacheTest, AppendPublishesOnlyContiguousBars) {
+  sierra::core::SharedColumnCache cache;
+  auto column = cache.acquire(Key(20));
+  const float values[] = {1.0f, 2.0f, 3.0f};
+  const std::int64_t times[] = {10, 20, 30};
+  const float sources[] = {100.0f, 101.0f, 102.0f};
+  EXPECT_TRUE(column->append(0, values, times, sources, 2));
+  EXPECT_FALSE(column->append(1, values + 1, times + 1, sources + 1, 2));  // бар 1 уже есть
+  EXPECT_TRUE(column->append(2, values + 2, times + 2, sources + 2, 1));
+  EXPECT_EQ(column->size(), 3u);
+
+  const auto guard = column->pin();
+  const auto view = column->read(guard);
+  ASSERT_EQ(view.size, 3u);
+  EXPECT_EQ(view.values[2], 3.0f);
+  EXPECT_EQ(view.times[1], 20);
+  EXPECT_EQ(view.sources[0], 100.0f);
+  EXPECT_GT(cache.memory_bytes(), 0u);
+}
+
+TEST(SharedColumnCacheTest, ReadersSeeConsistentPrefixWhileWriterGrowsColumn) {
+  sierra::core::SharedColumnCache cache;
+  auto column = cache.acquire(Key(20));
+  constexpr std::size_t kBars = 50000;
+  std::atomic<bool> done{false};
+  std::atomic<int> bad{0};
+
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 3; ++r) {
+    readers.emplace_back([&] {
+      while (!done.load()) {
+        const auto guard = column->pin();
+        const auto view = column->read(guard);
+        for (std::size_t i = 0; i < view.size; i += 97) {
+          if (view.values[i] != static_cast<float>(i) || view.times[i] != static_cast<std::int64_t>(i)) {
+            bad.fetch_add(1);
+          }
+        }
+      }
+    });
+  }
+  for (std::size_t i = 0; i < kBars; i += 10) {
+    float values[10];
+    std::int64_t times[10];
+    for (std::size_t k = 0; k < 10; ++k) {
+      values[k] = static_cast<float>(i + k);
+      times[k] = static_cast<std::int64_t>(i + k);
+    }
+    ASSERT_TRUE(column->append(i, values, times, values, 10));
+  }
+  done.store(true);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(bad.load(), 0);
+  EXPECT_EQ(column->size(), kBars);
+}
+
+}  // namespace
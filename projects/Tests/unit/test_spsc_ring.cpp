@@ -0,0 +1,75 @@
+/**
+ * @brief Модульные тесты lock-free очереди SpscRing.
+ * @note Проверяем границы ёмкости, порядок элементов и работу с двумя потоками.
+ */
+#include "sierra/core/spsc_ring.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+TEST(SpscRingTest, RoundsCapacityToPowerOfTwo) {
+  sierra::core::SpscRing<int> ring(5);
+  EXPECT_EQ(ring.capacity(), 8u);
+}
+
+TEST(SpscRingTest, RejectsWhenFullAndPreservesOrder) {
+  sierra::core::SpscRing<int> ring(4);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(ring.try_push(i));
+  }
+  EXPECT_FALSE(ring.try_push(4));
+
+  int value = -1;
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(ring.try_pop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(ring.try_pop(value));
+}
+
+TEST(SpscRingTest, PopBulkDrainsAvailableElements) {
+  sierra::core::SpscRing<int> ring(8);
+  for (int i = 0; i < 5; ++i) {
+    ring.try_push(i);
+  }
+  std::vector<int> out(8);
+  EXPECT_EQ(ring.pop_bulk(out.data(), out.size()), 5u);
+  EXPECT_EQ(out[4], 4);
+  EXPECT_EQ(ring.pop_bulk(out.data(), out.size()), 0u);
+}
+
+TEST(SpscRingTest, TransfersAllElementsBetweenThreads) {
+  constexpr std::uint64_t kCount = 200000;
+  sierra::core::SpscRing<std::uint64_t> ring(1024);
+
+  std::thread producer([&] {
+    for (std::uint64_t i = 1; i <= kCount; ++i) {
+      while (!ring.try_push(i)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  std::uint64_t expected = 1;
+  std::uint64_t value = 0;
+  while (expected <= kCount) {
+    if (ring.try_pop(value)) {
+      ASSERT_EQ(value, expected);
+      ++expected;
+    }
+  }
+  producer.join();
+  EXPECT_EQ(ring.size_approx(), 0u);
+}
+
+TEST(SpscRingTest, ThrowsOnZeroCapacity) {
+  EXPECT_THROW(sierra::core::SpscRing<int>(0), std::invalid_argument);
+}
+
+}  // namespace
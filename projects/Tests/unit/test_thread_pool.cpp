@@ -0,0 +1,51 @@
+/**
+ * @brief Модульные тесты пула потоков с перехватом работы.
+ * @note Проверяем выполнение всех задач, вложенную подачу и проброс исключений.
+ */
+#include "sierra/core/thread_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+
+namespace {
+
+TEST(ThreadPoolTest, RunsEveryTask) {
+  sierra::core::ThreadPool pool(4);
+  std::atomic<int> counter{0};
+  for (int i = 0; i < 1000; ++i) {
+    pool.submit([&counter] { counter.fetch_add(1); });
+  }
+  pool.wait_idle();
+  EXPECT_EQ(counter.load(), 1000);
+}
+
+TEST(ThreadPoolTest, AcceptsTasksSubmittedFromWorkers) {
+  sierra::core::ThreadPool pool(3);
+  std::atomic<int> counter{0};
+  for (int i = 0; i < 10; ++i) {
+    pool.submit([&pool, &counter] {
+      for (int j = 0; j < 10; ++j) {
+        pool.submit([&counter] { counter.fetch_add(1); });
+      }
+    });
+  }
+  pool.wait_idle();
+  EXPECT_EQ(counter.load(), 100);
+}
+
+TEST(ThreadPoolTest, RethrowsTaskException) {
+  sierra::core::ThreadPool pool(2);
+  pool.submit([] { throw std::runtime_error("boom"); });
+  EXPECT_THROW(pool.wait_idle(), std::runtime_error);
+  pool.submit([] {});
+  EXPECT_NO_THROW(pool.wait_idle());
+}
+
+TEST(ThreadPoolTest, DefaultsToHardwareConcurrency) {
+  sierra::core::ThreadPool pool;
+  EXPECT_GE(pool.size(), 1u);
+}
+
+}  // namespace
@@ -0,0 +1,35 @@
+/**
+ * @brief Модульные тесты счётчика тактов и его калибровки.
+ * @note Сверяем пересчёт тактов с `steady_clock` и `system_clock` на коротком интервале с запасом на планировщик.
+ */
+#include "sierra/core/tick_clock.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+namespace {
+
+TEST(TickClockTest, CalibratedTicksFollowSteadyClock) {
+  sierra::core::TickCalibration clock;
+  const auto start = std::chrono::steady_clock::now();
+  const std::int64_t first = sierra::core::read_ticks();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  const std::int64_t last = sierra::core::read_ticks();
+  const double elapsed =
+      std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  clock.update();
+
+  ASSERT_GT(last, first);
+  EXPECT_GT(clock.nanoseconds_per_tick(), 0.0);
+  EXPECT_NEAR(clock.to_nanoseconds(last - first), elapsed, elapsed * 0.25);
+
+  const auto system_now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::system_clock::now().time_since_epoch())
+                              .count();
+  EXPECT_NEAR(static_cast<double>(clock.to_system_ns(sierra::core::read_ticks())),
+              static_cast<double>(system_now), 5e6);
+}
+
+}  // namespace
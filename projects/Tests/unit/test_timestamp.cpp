@@ -0,0 +1,72 @@
+/**
+ * @brief Модульные тесты целочисленного времени и пакетной календарной раскладки.
+ * @note Пакетные ядра сверяются со скалярным `Timestamp` на случайных и граничных значениях.
+ */
+#include "sierra/core/timestamp.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+using sierra::core::kMicrosecondsPerDay;
+using sierra::core::kMicrosecondsPerSecond;
+using sierra::core::Timestamp;
+
+TEST(TimestampTest, DecomposesKnownDate) {
+  // 2024-01-15 (понедельник) 09:30:00.250 — день 45306 от 1899-12-30.
+  const std::int64_t us = 45306LL * kMicrosecondsPerDay + (9 * 3600 + 30 * 60) * kMicrosecondsPerSecond +
+                          250000;
+  const auto stamp = Timestamp::from_microseconds(us);
+  EXPECT_EQ(stamp.date(), 45306);
+  EXPECT_EQ(stamp.seconds_of_day(), 34200);
+  EXPECT_EQ(stamp.day_of_week(), 1);
+}
+
+TEST(TimestampTest, RoundTripsThroughDays) {
+  for (std::int64_t ms = 0; ms < 86400000; ms += 997) {
+    const auto stamp = Timestamp::from_microseconds(45306LL * kMicrosecondsPerDay + ms * 1000);
+    ASSERT_EQ(Timestamp::from_days(stamp.to_days()), stamp) << ms;
+  }
+}
+
+TEST(TimestampTest, BatchDecompositionMatchesScalar) {
+  std::mt19937_64 rng(42);
+  std::vector<std::int64_t> values;
+  std::int64_t current = 45000LL * kMicrosecondsPerDay;
+  for (int i = 0; i < 5000; ++i) {
+    current += static_cast<std::int64_t>(rng() % (3600 * kMicrosecondsPerSecond));
+    values.push_back(current);
+  }
+  values.push_back(45306LL * kMicrosecondsPerDay - 1);  // последняя микросекунда дня
+  values.push_back(12345);                              // неотсортированный хвост
+
+  std::vector<std::int32_t> date(values.size());
+  std::vector<std::int32_t> seconds(values.size());
+  std::vector<std::uint8_t> weekday(values.size());
+  sierra::core::decompose_calendar(values.data(), values.size(), date.data(), seconds.data(),
+                                   weekday.data());
+
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    const auto stamp = Timestamp::from_microseconds(values[i]);
+    ASSERT_EQ(date[i], stamp.date()) << i;
+    ASSERT_EQ(seconds[i], stamp.seconds_of_day()) << i;
+    ASSERT_EQ(weekday[i], stamp.day_of_week()) << i;
+  }
+}
+
+TEST(TimestampTest, SessionMaskHandlesOvernightSessions) {
+  const std::vector<std::int32_t> seconds{0, 3600, 32400, 34200, 57599, 57600, 64800, 86399, 100};
+  std::vector<std::uint8_t> day(seconds.size());
+  std::vector<std::uint8_t> night(seconds.size());
+  sierra::core::session_mask(seconds.data(), seconds.size(), 34200, 57599, day.data());
+  sierra::core::session_mask(seconds.data(), seconds.size(), 64800, 3600, night.data());
+
+  EXPECT_EQ(day, (std::vector<std::uint8_t>{0, 0, 0, 1, 1, 0, 0, 0, 0}));
+  EXPECT_EQ(night, (std::vector<std::uint8_t>{1, 1, 0, 0, 0, 0, 1, 1, 1}));
+}
+
+}  // namespace
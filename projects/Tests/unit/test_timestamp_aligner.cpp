@@ -0,0 +1,115 @@
+/**
+ * @brief Модульные тесты выравнивания баров нескольких графиков по времени.
+ * @note Сравниваем результат с наивным поиском «содержащего» бара и проверяем инкрементальное продолжение.
+ */
+#include "sierra/core/timestamp_aligner.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using sierra::core::TimeColumn;
+using sierra::core::TimestampAligner;
+
+TimeColumn Column(const std::vector<std::int64_t>& values) {
+  return TimeColumn{values.data(), values.size()};
+}
+
+int NaiveContainingIndex(const std::vector<std::int64_t>& source, std::int64_t time) {
+  const auto it = std::upper_bound(source.begin(), source.end(), time);
+  return static_cast<int>(it - source.begin()) - 1;
+}
+
+TEST(TimestampAlignerTest, MatchesNaiveContainingIndex) {
+  const std::vector<std::int64_t> destination{10, 20, 30, 40, 50, 60};
+  const std::vector<std::int64_t> fast{5, 10, 15, 25, 30, 35, 55};
+  const std::vector<std::int64_t> slow{20, 45};
+
+  TimestampAligner aligner(2);
+  aligner.update(Column(destination), {Column(fast), Column(slow)});
+
+  for (std::size_t d = 0; d < destination.size(); ++d) {
+    EXPECT_EQ(aligner.mapping(0)[d], NaiveContainingIndex(fast, destination[d]));
+    EXPECT_EQ(aligner.mapping(1)[d], NaiveContainingIndex(slow, destination[d]));
+  }
+  EXPECT_EQ(aligner.mapping(1)[0], TimestampAligner::kNoMatch);
+}
+
+TEST(TimestampAlignerTest, ExtendsIncrementallyAndRefreshesLastBar) {
+  std::vector<std::int64_t> destination{10, 20, 30};
+  std::vector<std::int64_t> source{10, 20};
+
+  TimestampAligner aligner(1);
+  aligner.update(Column(destination), {Column(source)});
+  EXPECT_EQ(aligner.mapping(0)[2], 1);
+
+  source.push_back(30);
+  destination.push_back(40);
+  const std::size_t first_changed = aligner.update(Column(destination), {Column(source)});
+  EXPECT_EQ(first_changed, 2u);
+  EXPECT_EQ(aligner.mapping(0)[2], 2);
+  EXPECT_EQ(aligner.mapping(0)[3], 2);
+  EXPECT_EQ(aligner.size(), 4u);
+}
+
+TEST(TimestampAlignerTest, SourceThatStartsEmptyIsMappedWhenItFills) {
+  const std::vector<std::int64_t> destination{10, 20, 30, 40};
+  std::vector<std::int64_t> early{10, 20, 30, 40};
+  std::vector<std::int64_t> late;
+
+  TimestampAligner aligner(2);
+  aligner.update(Column(destination), {Column(early), Column(late)});
+  EXPECT_EQ(aligner.mapping(1), (std::vector<int>(4, TimestampAligner::kNoMatch)));
+
+  // Источник догрузился после целевого графика: меняются и давно сопоставленные бары.
+  late = {15, 25};
+  EXPECT_EQ(aligner.update(Column(destination), {Column(early), Column(late)}), 1u);
+  for (std::size_t d = 0; d < destination.size(); ++d) {
+    EXPECT_EQ(aligner.mapping(1)[d], NaiveContainingIndex(late, destination[d])) << "bar " << d;
+  }
+
+  late.push_back(26);
+  EXPECT_EQ(aligner.update(Column(destination), {Column(early), Column(late)}), 2u);
+  EXPECT_EQ(aligner.mapping(1)[2], 2);
+  EXPECT_EQ(aligner.mapping(1)[1], 0);
+}
+
+TEST(TimestampAlignerTest, RestartsSourceThatShrankOrGainedEarlierHistory) {
+  const std::vector<std::int64_t> destination{10, 20, 30, 40, 50};
+  std::vector<std::int64_t> source{30, 40};
+
+  TimestampAligner aligner(1);
+  aligner.update(Column(destination), {Column(source)});
+  EXPECT_EQ(aligner.mapping(0)[1], TimestampAligner::kNoMatch);
+
+  // Догружена более ранняя история: источник растёт к началу, меняется время первого бара.
+  source = {5, 15, 30, 40};
+  EXPECT_EQ(aligner.update(Column(destination), {Column(source)}), 0u);
+  for (std::size_t d = 0; d < destination.size(); ++d) {
+    EXPECT_EQ(aligner.mapping(0)[d], NaiveContainingIndex(source, destination[d])) << "bar " << d;
+  }
+
+  source = {5, 15};
+  EXPECT_EQ(aligner.update(Column(destination), {Column(source)}), 0u);
+  for (std::size_t d = 0; d < destination.size(); ++d) {
+    EXPECT_EQ(aligner.mapping(0)[d], NaiveContainingIndex(source, destination[d])) << "bar " << d;
+  }
+}
+
+TEST(TimestampAlignerTest, ThrowsOnSourceCountMismatch) {
+  const std::vector<std::int64_t> destination{10};
+  TimestampAligner aligner(2);
+  EXPECT_THROW(aligner.update(Column(destination), {Column(destination)}), std::invalid_argument);
+}
+
+TEST(TimestampAlignerTest, ParsesChartNumberList) {
+  const auto numbers = sierra::core::parse_chart_numbers(" 1, 3,,x, 12 ,-2");
+  EXPECT_EQ(numbers, (std::vector<int>{1, 3, 12, -2}));
+}
+
+}  // namespace
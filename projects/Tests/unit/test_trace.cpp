@@ -0,0 +1,109 @@
+/**
+ * @brief Модульные тесты сборщика трассировки.
+ * @note Проверяем выгрузку интервалов нескольких потоков в Chrome trace JSON, выключенную запись, учёт переполнения и вырезание меток без `SIERRA_TRACE`.
+ */
+#include "sierra/core/trace.hpp"
+
+#include "sierra/core/moving_average.hpp"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::size_t CountOf(const std::string& text, const std::string& needle) {
+  std::size_t count = 0;
+  for (auto position = text.find(needle); position != std::string::npos; position = text.find(needle, position + 1)) {
+    ++count;
+  }
+  return count;
+}
+
+std::string Dump(std::size_t* spans = nullptr) {
+  std::ostringstream out;
+  const std::size_t written = sierra::core::TraceRecorder::instance().write_chrome_json(out);
+  if (spans != nullptr) {
+    *spans = written;
+  }
+  return out.str();
+}
+
+TEST(TraceTest, WritesSpansOfAllThreadsAsChromeJson) {
+  auto& recorder = sierra::core::TraceRecorder::instance();
+  recorder.start();
+  {
+    sierra::core::TraceSpan outer("test", "outer");
+    sierra::core::TraceSpan inner("test", "inner \"quoted\"");
+  }
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 3; ++t) {
+    threads.emplace_back([] {
+      for (int i = 0; i < 10; ++i) {
+        sierra::core::TraceSpan span("test", "worker");
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  recorder.stop();
+
+  std::size_t spans = 0;
+  const std::string json = Dump(&spans);
+  EXPECT_EQ(spans, 32u);
+  EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+  EXPECT_EQ(json.substr(json.size() - 3), "]}\n");
+  EXPECT_EQ(CountOf(json, "\"ph\":\"X\""), 32u);
+  EXPECT_EQ(CountOf(json, "\"name\":\"worker\""), 30u);
+  EXPECT_EQ(CountOf(json, "\"name\":\"outer\""), 1u);
+  EXPECT_EQ(CountOf(json, "\"name\":\"inner \\\"quoted\\\"\""), 1u);
+  EXPECT_GE(CountOf(json, "\"ph\":\"M\""), 4u);
+
+  // Выгрузка забирает интервалы: повторная пуста.
+  Dump(&spans);
+  EXPECT_EQ(spans, 0u);
+}
+
+TEST(TraceTest, StoppedRecorderRecordsNothing) {
+  auto& recorder = sierra::core::TraceRecorder::instance();
+  recorder.start();
+  recorder.stop();
+  {
+    sierra::core::TraceSpan span("test", "ignored");
+  }
+  std::size_t spans = 0;
+  Dump(&spans);
+  EXPECT_EQ(spans, 0u);
+}
+
+TEST(TraceTest, CountsDroppedSpansWhenThreadBufferIsFull) {
+  auto& recorder = sierra::core::TraceRecorder::instance();
+  recorder.start();
+  // Очередь потока создаётся один раз (и переходит к потоку с тем же id), поэтому переполняем её с запасом.
+  constexpr std::size_t kSpans = std::size_t{1} << 17;
+  const std::int64_t now = sierra::core::read_ticks();
+  for (std::size_t i = 0; i < kSpans; ++i) {
+    recorder.record("test", "burst", now, now + 1);
+  }
+  recorder.stop();
+  std::size_t spans = 0;
+  Dump(&spans);
+  EXPECT_GT(recorder.dropped(), 0u);
+  EXPECT_EQ(spans + recorder.dropped(), kSpans);
+}
+
+TEST(TraceTest, CoreKernelSpansFollowBuildConfiguration) {
+  auto& recorder = sierra::core::TraceRecorder::instance();
+  recorder.start();
+  const std::vector<double> prices(64, 1.0);
+  sierra::core::moving_average(prices, 8);
+  recorder.stop();
+  const std::string json = Dump();
+  EXPECT_EQ(CountOf(json, "\"name\":\"moving_average\""), SIERRA_TRACE ? 1u : 0u);
+}
+
+}  // namespace
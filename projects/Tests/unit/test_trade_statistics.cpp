@@ -0,0 +1,108 @@
+/**
+ * @brief Модульные тесты накопительной статистики сделок.
+ * @note Сверяем инкрементальный расчёт с прямым проходом по сделкам и проверяем, что объединение шардов совпадает с последовательным учётом.
+ */
+#include "sierra/core/trade_statistics.hpp"
+
+#include "sierra/core/backtester.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+using sierra::core::BacktestTrade;
+using sierra::core::Timestamp;
+using sierra::core::TradeStatistics;
+
+BacktestTrade Trade(double profit, int direction = 1, double commission = 0.0) {
+  BacktestTrade trade;
+  trade.open_time = Timestamp::from_microseconds(0);
+  trade.close_time = Timestamp::from_microseconds(10);
+  trade.direction = direction;
+  trade.entry_quantity = 1;
+  trade.exit_quantity = 1;
+  trade.max_open_quantity = 1;
+  trade.profit_loss = profit + commission;
+  trade.commission = commission;
+  trade.max_open_profit = (std::max)(profit, 0.0) + 1.0;
+  trade.max_open_loss = (std::min)(profit, 0.0) - 1.0;
+  return trade;
+}
+
+TradeStatistics Accumulate(const std::vector<double>& profits, std::size_t begin, std::size_t end) {
+  TradeStatistics stats;
+  for (std::size_t i = begin; i < end; ++i) {
+    stats.add(Trade(profits[i]));
+  }
+  return stats;
+}
+
+void ExpectSame(const TradeStatistics& lhs, const TradeStatistics& rhs) {
+  EXPECT_NEAR(lhs.net_profit(), rhs.net_profit(), 1e-9);
+  EXPECT_NEAR(lhs.maximum_drawdown, rhs.maximum_drawdown, 1e-9);
+  EXPECT_NEAR(lhs.maximum_runup, rhs.maximum_runup, 1e-9);
+  EXPECT_EQ(lhs.total_trades, rhs.total_trades);
+  EXPECT_EQ(lhs.winning_trades, rhs.winning_trades);
+  EXPECT_EQ(lhs.max_consecutive_winners, rhs.max_consecutive_winners);
+  EXPECT_EQ(lhs.max_consecutive_losers, rhs.max_consecutive_losers);
+  EXPECT_EQ(lhs.leading_winners, rhs.leading_winners);
+  EXPECT_EQ(lhs.trailing_losers, rhs.trailing_losers);
+  EXPECT_DOUBLE_EQ(lhs.largest_losing_trade, rhs.largest_losing_trade);
+}
+
+TEST(TradeStatisticsTest, TracksSummaryMetrics) {
+  TradeStatistics stats;
+  for (double profit : {100.0, 50.0, -30.0, -40.0, -10.0, 0.0, 80.0}) {
+    stats.add(Trade(profit, profit < 0.0 ? -1 : 1, 2.0));
+  }
+  EXPECT_EQ(stats.total_trades, 7u);
+  EXPECT_EQ(stats.winning_trades, 3u);
+  EXPECT_EQ(stats.losing_trades, 3u);
+  EXPECT_EQ(stats.short_trades, 3u);
+  EXPECT_DOUBLE_EQ(stats.net_profit(), 150.0);
+  EXPECT_DOUBLE_EQ(stats.total_commission, 14.0);
+  EXPECT_DOUBLE_EQ(stats.profit_factor(), 230.0 / 80.0);
+  EXPECT_DOUBLE_EQ(stats.maximum_drawdown, -80.0);
+  EXPECT_DOUBLE_EQ(stats.maximum_runup, 150.0);
+  EXPECT_DOUBLE_EQ(stats.largest_winning_trade, 100.0);
+  EXPECT_DOUBLE_EQ(stats.largest_losing_trade, -40.0);
+  EXPECT_DOUBLE_EQ(stats.maximum_trade_runup, 101.0);
+  EXPECT_DOUBLE_EQ(stats.maximum_trade_drawdown, -41.0);
+  EXPECT_EQ(stats.max_consecutive_winners, 2u);
+  EXPECT_EQ(stats.max_consecutive_losers, 3u);
+  EXPECT_EQ(stats.time_in_losing_trades, 30);
+  EXPECT_DOUBLE_EQ(stats.average_trade(), 150.0 / 7.0);
+}
+
+TEST(TradeStatisticsTest, MergeMatchesSequentialAtEverySplit) {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> dist(-3, 3);
+  std::vector<double> profits(40);
+  for (auto& profit : profits) {
+    profit = dist(rng) * 10.0;
+  }
+  const TradeStatistics whole = Accumulate(profits, 0, profits.size());
+  for (std::size_t split = 0; split <= profits.size(); ++split) {
+    TradeStatistics merged = Accumulate(profits, 0, split);
+    merged.merge(Accumulate(profits, split, profits.size()));
+    ExpectSame(merged, whole);
+  }
+}
+
+TEST(TradeStatisticsTest, MergeJoinsStreaksAcrossShards) {
+  const std::vector<double> profits = {5.0, 5.0, 5.0, 5.0, 5.0, -1.0};
+  TradeStatistics merged;
+  for (std::size_t i = 0; i < profits.size(); i += 2) {
+    merged.merge(Accumulate(profits, i, i + 2));
+  }
+  EXPECT_EQ(merged.max_consecutive_winners, 5u);
+  EXPECT_EQ(merged.leading_winners, 5u);
+  EXPECT_EQ(merged.trailing_losers, 1u);
+  EXPECT_DOUBLE_EQ(merged.maximum_drawdown, -1.0);
+}
+
+}  // namespace
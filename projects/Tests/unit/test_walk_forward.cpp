@@ -0,0 +1,161 @@
+/**
+ * @brief Модульные тесты walk-forward оптимизации.
+ * @note Проверяем границы фолдов, выбор лучшего набора на окне обучения, переиспользование оценок сегментов и перенос позиции между окнами проверки.
+ */
+#include "sierra/core/walk_forward.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using sierra::core::ParameterSet;
+using sierra::core::WalkForwardOptions;
+
+TEST(WalkForwardTest, BuildsRollingFoldsAndReusesSegments) {
+  sierra::core::ThreadPool pool(4);
+  const std::vector<ParameterSet> candidates{{0.0}, {1.0}};
+  std::atomic<int> calls{0};
+
+  // Набор 0 выигрывает на первых 300 тиках, набор 1 — дальше.
+  const auto evaluate = [&calls](const ParameterSet& set, std::size_t begin, std::size_t) {
+    calls.fetch_add(1);
+    const bool early = begin < 300;
+    return (set[0] == 0.0) == early ? 1.0 : -1.0;
+  };
+
+  const auto report = sierra::core::walk_forward(1000, candidates, evaluate, {},
+                                                 WalkForwardOptions{100, 3, 1, false}, pool);
+  // 10 сегментов, окно 4 → 7 фолдов; каждая пара считается один раз.
+  ASSERT_EQ(report.folds.size(), 7u);
+  EXPECT_EQ(calls.load(), 2 * 10);
+
+  const auto& first = report.folds[0];
+  EXPECT_EQ(first.train_begin, 0u);
+  EXPECT_EQ(first.train_end, 300u);
+  EXPECT_EQ(first.test_end, 400u);
+  EXPECT_EQ(first.best_parameters, (ParameterSet{0.0}));
+  EXPECT_DOUBLE_EQ(first.train_objective, 3.0);
+  EXPECT_DOUBLE_EQ(first.test_objective, -1.0);
+  EXPECT_EQ(first.evaluated_segments, 8u);
+  EXPECT_EQ(first.reused_segments, 0u);
+
+  const auto& last = report.folds.back();
+  EXPECT_EQ(last.best_parameters, (ParameterSet{1.0}));
+  EXPECT_EQ(last.evaluated_segments, 2u);
+  EXPECT_EQ(last.reused_segments, 6u);
+  EXPECT_DOUBLE_EQ(report.total_test_objective, 3.0);  // -1 -1 +1 +1 +1 +1 +1
+  EXPECT_DOUBLE_EQ(report.flat_test_objective, report.total_test_objective);
+}
+
+TEST(WalkForwardTest, RunsOnBacktesterSegments) {
+  std::vector<sierra::core::ScidRecord> ticks(4000);
+  std::vector<float> closes(ticks.size());
+  for (std::size_t i = 0; i < ticks.size(); ++i) {
+    ticks[i].date_time = static_cast<std::int64_t>(i);
+    ticks[i].close = 100.0f + static_cast<float>(5.0 * std::sin(static_cast<double>(i) / 40.0));
+    closes[i] = ticks[i].close;
+  }
+  sierra::core::IndicatorCache cache(closes);
+  sierra::core::ThreadPool pool(4);
+  const auto candidates = sierra::core::grid_search(
+      {sierra::core::ParameterRange{"fast", 5.0, 10.0, 5.0},
+       sierra::core::ParameterRange{"slow", 30.0, 60.0, 30.0}});
+
+  sierra::core::Backtester account;
+  const auto report = sierra::core::walk_forward(
+      ticks.size(), candidates,
+      [&](const ParameterSet& set, std::size_t begin, std::size_t end) {
+        return sierra::core::evaluate_ma_crossover_range(
+                   ticks.data(), begin, end, cache, static_cast<std::size_t>(set[0]),
+                   static_cast<std::size_t>(set[1]), {})
+            .objective;
+      },
+      [&](const ParameterSet& set, std::size_t begin, std::size_t end) {
+        return sierra::core::continue_ma_crossover_range(ticks.data(), begin, end, cache,
+                                                         static_cast<std::size_t>(set[0]),
+                                                         static_cast<std::size_t>(set[1]), account)
+            .objective;
+      },
+      WalkForwardOptions{500, 4, 2}, pool);
+
+  ASSERT_EQ(report.folds.size(), 2u);
+  EXPECT_EQ(cache.computed_count(), 4u);
+  for (const auto& fold : report.folds) {
+    EXPECT_EQ(fold.best_parameters.size(), 2u);
+    EXPECT_GE(fold.seconds, 0.0);
+  }
+}
+
+TEST(WalkForwardTest, CarriesPositionAcrossTestWindows) {
+  std::vector<sierra::core::ScidRecord> ticks(3000);
+  std::vector<float> closes(ticks.size());
+  for (std::size_t i = 0; i < ticks.size(); ++i) {
+    ticks[i].date_time = static_cast<std::int64_t>(i);
+    ticks[i].close = 100.0f + static_cast<float>(5.0 * std::sin(static_cast<double>(i) / 40.0));
+    closes[i] = ticks[i].close;
+  }
+  sierra::core::IndicatorCache cache(closes);
+  sierra::core::ThreadPool pool(2);
+  const std::vector<ParameterSet> candidates{{5.0, 30.0}};
+  sierra::core::BacktestOptions options;
+  options.commission_per_contract = 1.0;
+
+  const auto run = [&](bool carry, sierra::core::Backtester& account) {
+    WalkForwardOptions split{250, 2, 1};
+    split.carry_position = carry;
+    return sierra::core::walk_forward(
+        ticks.size(), candidates,
+        [&](const ParameterSet& set, std::size_t begin, std::size_t end) {
+          return sierra::core::evaluate_ma_crossover_range(
+                     ticks.data(), begin, end, cache, static_cast<std::size_t>(set[0]),
+                     static_cast<std::size_t>(set[1]), options)
+              .objective;
+        },
+        [&](const ParameterSet& set, std::size_t begin, std::size_t end) {
+          return sierra::core::continue_ma_crossover_range(ticks.data(), begin, end, cache,
+                                                           static_cast<std::size_t>(set[0]),
+                                                           static_cast<std::size_t>(set[1]), account)
+              .objective;
+        },
+        split, pool);
+  };
+
+  sierra::core::Backtester account(options);
+  const auto carried = run(true, account);
+  ASSERT_EQ(carried.folds.size(), 10u);
+  // Позиция не закрывается на границах окон: сшитый результат равен одному прогону по всем окнам проверки.
+  sierra::core::Backtester whole(options);
+  const double continuous = sierra::core::continue_ma_crossover_range(
+                                ticks.data(), carried.folds.front().test_begin, carried.folds.back().test_end,
+                                cache, 5, 30, whole)
+                                .objective;
+  EXPECT_NEAR(carried.total_test_objective, continuous, 1e-6);
+  EXPECT_EQ(account.statistics().total_trades, whole.statistics().total_trades);
+  EXPECT_NE(account.position(), 0);
+
+  // Принудительный flat платит лишний круг комиссии на каждой границе; отчёт показывает оба результата.
+  EXPECT_LT(carried.flat_test_objective, carried.total_test_objective);
+  sierra::core::Backtester unused;
+  const auto flat = run(false, unused);
+  EXPECT_DOUBLE_EQ(flat.total_test_objective, carried.flat_test_objective);
+  EXPECT_EQ(unused.statistics().total_trades, 0u);
+}
+
+TEST(WalkForwardTest, RejectsEmptyWindows) {
+  sierra::core::ThreadPool pool(1);
+  EXPECT_THROW(sierra::core::walk_forward(
+                   10, {{1.0}}, [](const ParameterSet&, std::size_t, std::size_t) { return 0.0; }, {},
+                   WalkForwardOptions{0, 1, 1, false}, pool),
+               std::invalid_argument);
+  EXPECT_THROW(sierra::core::walk_forward(
+                   10, {{1.0}}, [](const ParameterSet&, std::size_t, std::size_t) { return 0.0; }, {},
+                   WalkForwardOptions{5, 1, 1}, pool),
+               std::invalid_argument);
+}
+
+}  // namespace
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "SierraChart.h"
+
+#include <cstdint>
+#include <initializer_list>
+
+namespace sierra::acsil {
+
+/**
+ * @brief Отпечаток выходов исследования: `digest_floats` по `Data` подграфиков с непустым `Name` в диапазоне баров.
+ * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+ * @param first Первый бар диапазона; последний — `sc.ArraySize - 1`.
+ * @return std::uint64_t Отпечаток для сравнения записанного и повторённого вызова.
+ */
+std::uint64_t SubgraphDigest(SCStudyInterfaceRef sc, int first);
+
+struct CallCaptureState;
+
+/**
+ * @brief Записывает входные данные вызовов исследования в файл для повтора вне Sierra Chart (`SierraStudy.Host --replay`).
+ * @note Управляется пунктами контекстного меню графика «SierraStudy: Start Capture» и «SierraStudy: Stop Capture».
+ * «Start» открывает `Logs/SierraStudy.<ChartNumber>.<StudyGraphInstanceID>.calls.bin` и выставляет
+ * `sc.FlagFullRecalculate`: запись начинается с полного пересчёта, поэтому повтор не зависит от состояния движка до неё.
+ * На каждый вызов пишутся `Index`, `ArraySize`, `UpdateStartIndex`, срез `BaseDataIn[]` и `BaseDateTimeIn` с первого
+ * изменившегося бара, изменившиеся входы и persistent-значения `stateKeys`, а после вызова — отпечаток выходов
+ * (`SubgraphDigest`), по которому повтор проверяет, что исследование повело себя так же.
+ * @warning Файл пишется в потоке графика: режим диагностический, на время записи вызовы медленнее. Ключи не должны
+ * совпадать с ключами движков и других помощников. При ошибке записи захват останавливается с сообщением в Message Log.
+ */
+class CallCapture {
+ public:
+  /**
+   * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+   * @param menuKey Первый из двух ключей `sc.GetPersistentInt` (`menuKey`, `menuKey + 1`) для номеров пунктов меню.
+   * @param pointerKey Ключ `sc.GetPersistentPointer` для состояния захвата.
+   * @param stateKeys Ключи `GetPersistentInt` и `GetPersistentDouble`, в которых исследование само хранит состояние.
+   */
+  CallCapture(SCStudyInterfaceRef sc, int menuKey, int pointerKey, std::initializer_list<int> stateKeys = {});
+  ~CallCapture();
+
+  CallCapture(const CallCapture&) = delete;
+  CallCapture& operator=(const CallCapture&) = delete;
+
+ private:
+  SCStudyInterfaceRef sc_;
+  int pointerKey_;
+  CallCaptureState* state_ = nullptr;  ///< Не `nullptr`, только если этот вызов записывается.
+};
+
+}  // namespace sierra::acsil
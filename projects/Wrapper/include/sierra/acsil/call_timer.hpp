@@ -0,0 +1,50 @@
+#pragma once
+
+#include "SierraChart.h"
+
+#include <cstdint>
+
+namespace sierra::acsil {
+
+/// @brief Фаза вызова исследования, по которой раскладываются замеры `StudyCallTimer`.
+enum class StudyCallPhase { kSetDefaults, kFullRecalculation, kLiveUpdate, kCount };
+
+struct StudyCallStats;
+
+/**
+ * @brief Замеряет один вызов исследования и раз в заданный интервал выводит сводку задержек в Message Log.
+ * @note Создаётся первой строкой `scsf_*`; время от конструктора до деструктора раскладывается по фазам (SetDefaults,
+ * полный пересчёт, обновление в реальном времени) в гистограммы `LatencyHistogram` в тактах `read_ticks()`.
+ * На вызов приходятся два чтения TSC и запись в гистограмму; часы и перевод тактов в микросекунды трогаются только
+ * при проверке интервала (не чаще раза в несколько миллисекунд) и при выводе сводки.
+ * Сводка (число вызовов, p50, p99, максимум) охватывает вызовы с прошлой сводки; последняя выводится при `LastCallToFunction`.
+ * Вход интервала читается после SetDefaults, который его и задаёт: вызов SetDefaults замеряется всегда, а замер
+ * отбрасывается в деструкторе, если замеры выключены. Остальные вызовы при выключенных замерах TSC не читают.
+ * @warning Статистика хранится в `sc.GetPersistentPointer(key)`: ключ не должен совпадать с ключами движков.
+ */
+class StudyCallTimer {
+ public:
+  /**
+   * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+   * @param key Ключ `sc.GetPersistentPointer` для статистики экземпляра.
+   * @param interval Вход исследования с периодом сводки в секундах; `0` выключает замеры и освобождает статистику.
+   */
+  StudyCallTimer(SCStudyInterfaceRef sc, int key, SCInputRef interval);
+  ~StudyCallTimer();
+
+  StudyCallTimer(const StudyCallTimer&) = delete;
+  StudyCallTimer& operator=(const StudyCallTimer&) = delete;
+
+ private:
+  /// @brief Создаёт, перенастраивает или освобождает статистику по текущему значению входа.
+  void configure();
+
+  SCStudyInterfaceRef sc_;
+  SCInputRef interval_;
+  int key_;
+  StudyCallStats* stats_ = nullptr;
+  StudyCallPhase phase_ = StudyCallPhase::kLiveUpdate;
+  std::int64_t start_ = 0;
+};
+
+}  // namespace sierra::acsil
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "SierraChart.h"
+
+#include "sierra/core/column_store.hpp"
+#include "sierra/core/shared_column_cache.hpp"
+
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+namespace sierra::acsil {
+
+/**
+ * @brief Общий для DLL кэш столбцов результатов: одинаковые исследования на графиках одного символа и периода
+ * считают историю один раз.
+ * @return sierra::core::SharedColumnCache& Кэш; живёт до выгрузки DLL (без статического деструктора).
+ */
+sierra::core::SharedColumnCache& SharedIndicatorCache();
+
+/// @brief Подписка экземпляра исследования на общий столбец (хранится в persistent-указателе).
+struct SharedColumnSubscription {
+  sierra::core::ColumnKey key;
+  std::shared_ptr<sierra::core::SharedColumn> column;
+  std::vector<std::int64_t> times;  ///< Буфер времени баров для публикации.
+};
+
+/**
+ * @brief Возвращает подписку экземпляра на общий столбец `SharedIndicatorCache()`.
+ * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+ * @param key Ключ `sc.GetPersistentPointer` для подписки.
+ * @param study Идентификатор расчёта (строковый литерал, общий для всех экземпляров исследования).
+ * @param parameters Входы, от которых зависит результат.
+ * @param enabled Вход исследования «делить результат между графиками»; `false` освобождает подписку.
+ * @return SharedColumnSubscription* Подписка; `nullptr` при `LastCallToFunction`, `enabled == false` или пустом графике.
+ * @note Ключ столбца — `sc.Symbol`, `sc.SecondsPerBar`, `study`, `parameters` и время первого бара; при смене любого
+ * из них экземпляр переходит на другой столбец. Сравнение с текущим ключом не выделяет память.
+ * @warning Вызывайте и при `LastCallToFunction`, иначе подписка утечёт и столбец не освободится.
+ */
+SharedColumnSubscription* AcquireSharedColumn(SCStudyInterfaceRef sc, int key, const char* study,
+                                              std::initializer_list<double> parameters, bool enabled);
+
+/**
+ * @brief Заполняет выход закрытыми барами из общего столбца вместо расчёта.
+ * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+ * @param subscription Подписка из `AcquireSharedColumn`.
+ * @param first Первый бар, который нужно пересчитать.
+ * @param source Ряд, по которому считается исследование (например, `sc.Close`), длиной `sc.ArraySize`.
+ * @param output Выход исследования длиной `sc.ArraySize`.
+ * @return int Первый бар, который исследованию осталось посчитать самому (`first`, если кэш не помог).
+ * @note Кэш читается только при полном пересчёте: в реальном времени новых закрытых баров один-два, и их дешевле
+ * посчитать, чем сбросить состояние движка. Бары копируются, только если время и значение источника каждого
+ * совпадают с теми, на которых считался столбец; иначе график считает всё сам.
+ */
+int ReadSharedColumn(SCStudyInterfaceRef sc, SharedColumnSubscription& subscription, int first, const float* source,
+                     float* output);
+
+/**
+ * @brief Дописывает в общий столбец закрытые бары графика, которых там ещё нет.
+ * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+ * @param subscription Подписка из `AcquireSharedColumn`.
+ * @param source Ряд, по которому считалось исследование, длиной `sc.ArraySize`.
+ * @param output Посчитанный выход длиной `sc.ArraySize`.
+ * @note Публикует, только если последний бар столбца совпадает с баром графика; бары дописывает первый успевший график.
+ */
+void PublishSharedColumn(SCStudyInterfaceRef sc, SharedColumnSubscription& subscription, const float* source,
+                         const float* output);
+
+/// @brief Файл посчитанных значений экземпляра исследования на диске (хранится в persistent-указателе).
+struct PersistedColumn {
+  std::unique_ptr<sierra::core::ColumnStore> store;
+  std::vector<std::int64_t> times;  ///< Буфер времени одного блока для сверки и записи.
+  bool failed = false;  ///< Запись не удалась: файл не используется до смены ключа.
+};
+
+/**
+ * @brief Возвращает файл посчитанных значений экземпляра для перезагрузки графика без полного пересчёта.
+ * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+ * @param key Ключ `sc.GetPersistentPointer` для файла.
+ * @param study Идентификатор расчёта (строковый литерал, общий для всех экземпляров исследования).
+ * @param parameters Входы, от которых зависит результат.
+ * @param version Версия расчёта движка (например, `MovingAverageEngine::kResultVersion`): файл, записанный сборкой
+ * с другой формулой, не загружается и перезаписывается.
+ * @param enabled Вход исследования «хранить результат на диске»; `false` освобождает объект (файл остаётся).
+ * @return PersistedColumn* Файл; `nullptr` при `LastCallToFunction` или `enabled == false`.
+ * @note Файл — `SierraStudy.Cache/SierraStudy.<график>.<экземпляр>.col` в каталоге данных Sierra Chart
+ * (`sc.DataFilesFolder()`), а не в рабочем каталоге процесса; ключ (`sc.Symbol`, `sc.SecondsPerBar`, `study`,
+ * `parameters`, `version`) сверяется с заголовком. Ключ пересчитывается только при полном пересчёте: смена входов в Sierra
+ * Chart всегда его вызывает.
+ * @warning Вызывайте и при `LastCallToFunction`, иначе объект утечёт.
+ */
+PersistedColumn* AcquirePersistedColumn(SCStudyInterfaceRef sc, int key, const char* study,
+                                        std::initializer_list<double> parameters, std::uint32_t version,
+                                        bool enabled);
+
+/**
+ * @brief Заполняет выход закрытыми барами из файла, сохранённого до перезапуска Sierra Chart или замены DLL.
+ * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+ * @param column Файл из `AcquirePersistedColumn`.
+ * @param first Первый бар, который нужно пересчитать.
+ * @param source Ряд, по которому считается исследование (например, `sc.Close`), длиной `sc.ArraySize`.
+ * @param output Выход исследования длиной `sc.ArraySize`.
+ * @return int Первый бар, который исследованию осталось посчитать самому (`first`, если файл не помог).
+ * @note Работает только при полном пересчёте. Блоки файла сверяются с временем и источником баров графика
+ * (`sierra::core::ColumnStore::load`): после правки данных берётся только префикс до изменённого блока. Время баров
+ * переводится только для сверяемых блоков; если файла нет или его заголовок не подходит — не переводится вовсе.
+ */
+int LoadPersistedColumn(SCStudyInterfaceRef sc, PersistedColumn& column, int first, const float* source,
+                        float* output);
+
+/**
+ * @brief Дописывает в файл завершённые блоки закрытых баров.
+ * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+ * @param column Файл из `AcquirePersistedColumn`.
+ * @param source Ряд, по которому считалось исследование, длиной `sc.ArraySize`.
+ * @param output Посчитанный выход длиной `sc.ArraySize`.
+ * @note Пишет на диск при полном пересчёте и раз в `ColumnStore::kChunkBars` новых баров; остальные вызовы только
+ * сравнивают длины. Обновление с `sc.UpdateStartIndex` внутри сохранённых блоков отбрасывает их. Ошибка записи
+ * выводится в Message Log и выключает файл.
+ */
+void StorePersistedColumn(SCStudyInterfaceRef sc, PersistedColumn& column, const float* source, const float* output);
+
+}  // namespace sierra::acsil
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "SierraChart.h"
+
+#include "sierra/core/engine_snapshot.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <vector>
+
+namespace sierra::acsil {
+
+/**
+ * @brief Записывает снимок состояния движка во временный файл перед выгрузкой DLL.
+ * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+ * @param state Снимок движка (`Engine::save`).
+ * @param committed Закрытых баров, учтённых движком.
+ * @param window Последних закрытых баров, от которых зависит состояние движка (например, период среднего).
+ * @param source Ряд, по которому считалось исследование, длиной не меньше `committed`.
+ * @param output Выход исследования длиной не меньше `committed`.
+ * @note Файл — `<temp>/SierraStudy.<график>.<экземпляр>.engine.bin`: ключ (`sc.Symbol`, `sc.SecondsPerBar`,
+ * `sc.GraphName`), хеш времени и источника баров окна, значения выхода окна и снимок. Ошибка записи выводится в
+ * Message Log; исследование после перезагрузки просто посчитается целиком.
+ */
+void WriteEngineSnapshot(SCStudyInterfaceRef sc, const sierra::core::SnapshotWriter& state, std::size_t committed,
+                         std::size_t window, const float* source, const float* output);
+
+/**
+ * @brief Читает снимок `WriteEngineSnapshot`, если он снят с этого же графика; файл удаляется в любом случае.
+ * @param state Снимок движка для `Engine::restore`.
+ * @param committed Закрытых баров, учтённых движком в снимке.
+ * @return bool `true`, если ключ, бары окна и значения выхода окна совпали с графиком.
+ * @note Совпадение выхода окна означает, что Sierra Chart сохранила массивы подграфиков через перезагрузку DLL:
+ * без них снимок не поможет, и исследование считается заново.
+ */
+bool ReadEngineSnapshot(SCStudyInterfaceRef sc, const float* source, const float* output,
+                        std::vector<unsigned char>& state, std::size_t& committed);
+
+/**
+ * @brief Удаляет из каталога снимки движков старше `maxAge`.
+ * @param folder Каталог снимков.
+ * @param maxAge Возраст файла (по времени изменения), после которого снимок считается брошенным.
+ * @return std::size_t Количество удалённых файлов.
+ * @note Трогает только файлы `SierraStudy.*.engine.bin`. Ошибки файловой системы пропускаются.
+ */
+std::size_t RemoveStaleEngineSnapshots(const std::filesystem::path& folder, std::chrono::seconds maxAge);
+
+/**
+ * @brief Один раз за загрузку DLL удаляет брошенные снимки движков из временного каталога.
+ * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+ * @note Вызывайте в `sc.SetDefaults`. Снимок остаётся, когда исследование удалили или книгу графиков закрыли:
+ * `LastCallToFunction` в этих случаях не отличить от выгрузки DLL. Замена DLL занимает минуты, поэтому файлы старше
+ * часа уже никто не прочитает.
+ */
+void RemoveStaleEngineSnapshots(SCStudyInterfaceRef sc);
+
+/**
+ * @brief Сохраняет состояние движка экземпляра перед выгрузкой DLL (`sc.FreeDLL = 1`, `scripts/HotSwap.ps1`).
+ * @tparam Engine Тип движка: `save(SnapshotWriter&)` и `committed_bars()`.
+ * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+ * @param key Ключ `sc.GetPersistentPointer`, закреплённый за движком.
+ * @param window Последних закрытых баров, от которых зависит состояние движка.
+ * @param source Ряд, по которому считалось исследование.
+ * @param output Выход исследования.
+ * @note Делает что-то только при `sc.LastCallToFunction` и `sc.FreeDLL`: без `FreeDLL` Sierra Chart не выгружает
+ * DLL до выхода, и снимок некому прочитать. Вызывайте до `AcquireEngine`, который удаляет движок.
+ */
+template <typename Engine>
+void SaveEngineSnapshot(SCStudyInterfaceRef sc, int key, std::size_t window, const float* source,
+                        const float* output) {
+  if (!sc.LastCallToFunction || sc.FreeDLL == 0 || source == nullptr || output == nullptr) {
+    return;
+  }
+  const auto* engine = static_cast<const Engine*>(sc.GetPersistentPointer(key));
+  if (engine == nullptr || engine->committed_bars() == 0) {
+    return;
+  }
+  sierra::core::SnapshotWriter state;
+  engine->save(state);
+  const std::size_t committed = engine->committed_bars();
+  WriteEngineSnapshot(sc, state, committed, (std::min)(window, committed), source, output);
+}
+
+/**
+ * @brief Восстанавливает движок из снимка предыдущей загрузки DLL вместо пересчёта истории.
+ * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+ * @param engine Движок из `AcquireEngine` (сброшенный полным пересчётом).
+ * @param first Первый бар, который нужно пересчитать.
+ * @param source Ряд, по которому считается исследование, длиной `sc.ArraySize`.
+ * @param output Выход исследования длиной `sc.ArraySize`.
+ * @return int Первый бар, который исследованию осталось посчитать (`first`, если снимок не подошёл).
+ * @note Работает только при полном пересчёте. `Engine::restore` сам сверяет версию снимка и параметры движка
+ * и при несовпадении оставляет движок сброшенным. Время восстановления — O(размер состояния), а не O(история).
+ */
+template <typename Engine>
+int RestoreEngineSnapshot(SCStudyInterfaceRef sc, Engine& engine, int first, const float* source, float* output) {
+  if (!sc.IsFullRecalculation || source == nullptr || output == nullptr) {
+    return first;
+  }
+  std::vector<unsigned char> state;
+  std::size_t committed = 0;
+  if (!ReadEngineSnapshot(sc, source, output, state, committed)) {
+    return first;
+  }
+  try {
+    sierra::core::SnapshotReader reader(state);
+    if (!engine.restore(reader)) {
+      return first;
+    }
+  } catch (const std::exception&) {
+    return first;
+  }
+  sc.AddMessageToLog("SierraStudy engine state restored after DLL reload", 0);
+  return (std::max)(first, static_cast<int>(committed));
+}
+
+}  // namespace sierra::acsil
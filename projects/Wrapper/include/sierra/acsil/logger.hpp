@@ -0,0 +1,20 @@
+#pragma once
+
+#include "SierraChart.h"
+
+#include "sierra/core/async_logger.hpp"
+
+namespace sierra::acsil {
+
+/**
+ * @brief Возвращает общий для DLL асинхронный журнал `Logs/SierraStudy.log`.
+ * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+ * @param key Ключ `sc.GetPersistentInt`, в котором экземпляр помнит, что держит ссылку на журнал.
+ * @return sierra::core::AsyncLogger* Журнал; `nullptr` при `sc.LastCallToFunction` или если файл не открылся.
+ * @note Журнал создаёт первый экземпляр исследования, а разрушает последний при `LastCallToFunction`: записи
+ * дописываются и фоновый поток останавливается в потоке графика, до выгрузки DLL (`sc.FreeDLL = 1`), а не в `DllMain`.
+ * @warning Вызывайте и при `LastCallToFunction`, иначе поток журнала переживёт выгрузку DLL. После неудачного открытия файла экземпляр больше не пытается.
+ */
+sierra::core::AsyncLogger* AcquireLogger(SCStudyInterfaceRef sc, int key);
+
+}  // namespace sierra::acsil
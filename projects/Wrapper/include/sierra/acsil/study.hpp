@@ -8,3 +8,8 @@
 /// @note Декларацию выносим в заголовок, чтобы её могли видеть study.cpp и потенциальные другие модули обёртки.
 /// @warning Убедитесь, что сигнатура и имя полностью совпадают с экспортом в реализации.
 SCSFExport scsf_SierraStudyMovingAverage(SCStudyGraphRef sc);
+
+/// @brief Исследование потока ордеров: новые сделки Time & Sales уходят в `sierra::core::OrderFlowWorker`.
+/// @param sc Интерфейс ACSIL, предоставляемый Sierra Chart при каждом вызове.
+/// @return void.
+SCSFExport scsf_SierraStudyOrderFlow(SCStudyGraphRef sc);
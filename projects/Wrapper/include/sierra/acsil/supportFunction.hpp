@@ -2,6 +2,12 @@
 
 #include "SierraChart.h"
 
+#include "sierra/core/depth_fill.hpp"
+#include "sierra/core/order_flow_worker.hpp"
+#include "sierra/core/timestamp.hpp"
+
+#include <vector>
+
 namespace sierra::acsil {
 
 /**
@@ -13,4 +19,69 @@ namespace sierra::acsil {
  */
 void LogDllStartup(SCStudyInterfaceRef sc);
 
+/**
+ * @brief Передаёт в обработчик ядра только новые сделки из Time & Sales.
+ * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+ * @param worker Фоновый обработчик ленты сделок из Core.
+ * @param lastSequence Последний переданный `Sequence`; обновляется функцией (храните в persistent-переменной).
+ * @return int Количество переданных сделок.
+ * @note Массив просматривается с конца только до последней известной записи, записи котировок (`SC_TS_BIDASKVALUES`) пропускаются.
+ * @warning Вызывайте из потока графика — очередь обработчика рассчитана на одного писателя.
+ */
+int PushNewTimeAndSales(SCStudyInterfaceRef sc, sierra::core::OrderFlowWorker& worker,
+                        unsigned int& lastSequence);
+
+/**
+ * @brief Переводит `SCDateTimeMS` в целочисленный момент ядра.
+ * @param dateTime Время Sierra Chart.
+ * @return sierra::core::Timestamp Момент с той же микросекундой.
+ * @note Перевод точный: используется внутреннее int64-представление `SCDateTime`.
+ */
+sierra::core::Timestamp ToTimestamp(const SCDateTimeMS& dateTime);
+
+/**
+ * @brief Переводит момент ядра обратно в `SCDateTimeMS`.
+ * @param timestamp Момент в микросекундах от эпохи Sierra Chart.
+ * @return SCDateTimeMS Время Sierra Chart с той же микросекундой.
+ */
+SCDateTimeMS ToSCDateTime(sierra::core::Timestamp timestamp);
+
+/**
+ * @brief Копирует сводки стакана графика (`c_ACSILDepthBars`) в книгу ядра.
+ * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+ * @return sierra::core::DepthBook Книга уровней по барам графика; пустая, если данных стакана нет.
+ * @note Бары без данных стакана пропускаются — модель исполнения для их тиков берёт уровень предыдущего бара.
+ * @warning Требует включённой записи истории стакана; вызывайте до бэктеста, а не на каждом обновлении.
+ */
+sierra::core::DepthBook BuildDepthBook(SCStudyInterfaceRef sc);
+
+/**
+ * @brief Возвращает движок ядра, который живёт в persistent-указателе экземпляра исследования.
+ * @tparam Engine Тип движка: конструктор из `Config`, `config()` и `reset(const Config&)`.
+ * @tparam Config Параметры движка, сравнимые через `==` (обычно собираются из входов исследования).
+ * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+ * @param key Ключ `sc.GetPersistentPointer`, закреплённый за движком.
+ * @param config Текущие параметры из входов.
+ * @return Engine* Готовый движок; `nullptr` при `sc.LastCallToFunction` — движок уже удалён.
+ * @note Движок создаётся при первом вызове и сбрасывается при `sc.IsFullRecalculation` или изменении параметров.
+ * @warning Рассчитано на `AutoLoop = 0`: при автоцикле `IsFullRecalculation` стоит на каждом баре полного пересчёта и движок сбрасывался бы каждый раз. Вызывайте и при `LastCallToFunction`, иначе движок утечёт.
+ */
+template <typename Engine, typename Config>
+Engine* AcquireEngine(SCStudyInterfaceRef sc, int key, const Config& config) {
+  void*& slot = sc.GetPersistentPointer(key);
+  Engine* engine = static_cast<Engine*>(slot);
+  if (sc.LastCallToFunction) {
+    delete engine;
+    slot = nullptr;
+    return nullptr;
+  }
+  if (engine == nullptr) {
+    engine = new Engine(config);
+    slot = engine;
+  } else if (sc.IsFullRecalculation || !(engine->config() == config)) {
+    engine->reset(config);
+  }
+  return engine;
+}
+
 }  // namespace sierra::acsil
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "SierraChart.h"
+
+#include "sierra/core/trace.hpp"
+
+namespace sierra::acsil {
+
+/**
+ * @brief Пункты контекстного меню графика «SierraStudy: Start Trace» и «SierraStudy: Dump Trace».
+ * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+ * @param key Первый из двух ключей `sc.GetPersistentInt` (`key`, `key + 1`) для номеров пунктов меню.
+ * @return void Функция не возвращает значение.
+ * @note «Start» очищает и включает `TraceRecorder`, «Dump» пишет интервалы в `Logs/SierraStudy.trace.json`
+ * (открывается в `chrome://tracing` или Perfetto) и выключает запись. Пункты удаляются при `LastCallToFunction`.
+ * Без `SIERRA_TRACE` (Release без `SIERRA_ENABLE_TRACE`) функция пустая и меню не появляется.
+ */
+#if SIERRA_TRACE
+void HandleTraceMenu(SCStudyInterfaceRef sc, int key);
+#else
+inline void HandleTraceMenu(SCStudyInterfaceRef, int) {}
+#endif
+
+}  // namespace sierra::acsil
@@ -0,0 +1,206 @@
+#include "sierra/acsil/call_capture.hpp"
+
+#include "sierra/core/call_recording.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <map>
+#include <string>
+
+namespace sierra::acsil {
+
+/// @brief Открытый захват вызовов одного экземпляра исследования.
+struct CallCaptureState {
+  CallCaptureState(const std::string& file, const sierra::core::CallRecordingHeader& header)
+      : path(file), writer(file, header) {}
+
+  std::string path;
+  sierra::core::CallRecordWriter writer;
+  sierra::core::RecordedCall call;  ///< Буфер текущего вызова; его память переиспользуется.
+  std::array<double, SC_INPUTS_AVAILABLE> inputs{};
+  std::map<int, int> persistentInts;
+  std::map<int, double> persistentDoubles;
+  bool recording = false;  ///< Дождались полного пересчёта.
+  bool first = true;
+  int previousSize = 0;
+  int previousStart = -1;
+  int previousIndex = -1;
+};
+
+namespace {
+
+/// @brief Закрывает захват экземпляра и сообщает итог в Message Log.
+void StopCapture(SCStudyInterfaceRef sc, void*& slot) {
+  auto* state = static_cast<CallCaptureState*>(slot);
+  if (state == nullptr) {
+    return;
+  }
+  char message[512];
+  try {
+    state->writer.close();
+    std::snprintf(message, sizeof(message), "SierraStudy capture: %llu calls, %llu bytes written to %s",
+                  static_cast<unsigned long long>(state->writer.calls()),
+                  static_cast<unsigned long long>(state->writer.bytes()), state->path.c_str());
+  } catch (const std::exception& error) {
+    std::snprintf(message, sizeof(message), "SierraStudy capture failed: %s", error.what());
+  }
+  sc.AddMessageToLog(message, 1);
+  delete state;
+  slot = nullptr;
+}
+
+/// @brief Открывает файл захвата и просит Sierra Chart полный пересчёт, с которого начнётся запись.
+void StartCapture(SCStudyInterfaceRef sc, void*& slot) {
+  char path[256];
+  std::snprintf(path, sizeof(path), "Logs/SierraStudy.%d.%d.calls.bin", sc.ChartNumber, sc.StudyGraphInstanceID);
+  char message[512];
+  try {
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+    sierra::core::CallRecordingHeader header;
+    header.study = sc.GraphName.GetChars();
+    header.base_arrays = NUM_BASE_GRAPH_ARRAYS;
+    header.tick_size = sc.TickSize;
+    slot = new CallCaptureState(path, header);
+    sc.FlagFullRecalculate = 1;
+    std::snprintf(message, sizeof(message), "SierraStudy capture to %s starts with the next full recalculation", path);
+  } catch (const std::exception& error) {
+    std::snprintf(message, sizeof(message), "SierraStudy capture failed: %s", error.what());
+  }
+  sc.AddMessageToLog(message, 1);
+}
+
+}  // namespace
+
+std::uint64_t SubgraphDigest(SCStudyInterfaceRef sc, int first) {
+  const int size = (std::max)(0, sc.ArraySize);
+  first = (std::min)((std::max)(0, first), size);
+  std::uint64_t digest = sierra::core::kDigestSeed;
+  for (int i = 0; i < SC_SUBGRAPHS_AVAILABLE; ++i) {
+    SCFloatArrayRef data = sc.Subgraph[i].Data;
+    if (sc.Subgraph[i].Name.IsEmpty() || data.GetPointer() == nullptr || data.GetArraySize() < size) {
+      continue;
+    }
+    digest = sierra::core::digest_floats(data.GetPointer() + first, static_cast<std::size_t>(size - first), digest);
+  }
+  return digest;
+}
+
+/**
+ * @brief Обрабатывает меню захвата и снимает входные данные вызова.
+ * @note Срез баров начинается с `min(UpdateStartIndex, прошлый ArraySize)`: более ранние бары Sierra Chart не меняла.
+ * Повторные вызовы одного прохода автоцикла (тот же `ArraySize` и `UpdateStartIndex`, растущий `Index`) пишутся без среза.
+ */
+CallCapture::CallCapture(SCStudyInterfaceRef sc, int menuKey, int pointerKey, std::initializer_list<int> stateKeys)
+    : sc_(sc), pointerKey_(pointerKey) {
+  int& startID = sc.GetPersistentInt(menuKey);
+  int& stopID = sc.GetPersistentInt(menuKey + 1);
+  void*& slot = sc.GetPersistentPointer(pointerKey);
+  if (sc.LastCallToFunction) {
+    for (int* id : {&startID, &stopID}) {
+      if (*id > 0) {
+        sc.RemoveACSChartShortcutMenuItem(sc.ChartNumber, *id);
+      }
+      *id = 0;
+    }
+    StopCapture(sc, slot);
+    return;
+  }
+  if (sc.SetDefaults) {
+    return;
+  }
+  if (startID == 0) {
+    startID = (std::max)(-1, sc.AddACSChartShortcutMenuItem(sc.ChartNumber, "SierraStudy: Start Capture"));
+    stopID = (std::max)(-1, sc.AddACSChartShortcutMenuItem(sc.ChartNumber, "SierraStudy: Stop Capture"));
+  }
+  if (sc.MenuEventID != 0 && sc.MenuEventID == startID) {
+    StopCapture(sc, slot);
+    StartCapture(sc, slot);
+  } else if (sc.MenuEventID != 0 && sc.MenuEventID == stopID) {
+    StopCapture(sc, slot);
+  }
+
+  auto* state = static_cast<CallCaptureState*>(slot);
+  if (state == nullptr || (!state->recording && !sc.IsFullRecalculation)) {
+    return;
+  }
+  state->recording = true;
+
+  sierra::core::RecordedCall& call = state->call;
+  const int size = (std::max)(0, sc.ArraySize);
+  call.flags = sc.IsFullRecalculation ? sierra::core::RecordedCall::kFullRecalculation : 0;
+  call.index = sc.Index;
+  call.array_size = size;
+  call.update_start_index = sc.UpdateStartIndex;
+  int sliceStart = (std::min)((std::max)(0, (std::min)(sc.UpdateStartIndex, state->previousSize)), size);
+  if (state->first) {
+    sliceStart = 0;
+  } else if (size == state->previousSize && sc.UpdateStartIndex == state->previousStart &&
+             sc.Index > state->previousIndex) {
+    sliceStart = size;
+  }
+  call.slice_start = sliceStart;
+  state->previousSize = size;
+  state->previousStart = sc.UpdateStartIndex;
+  state->previousIndex = sc.Index;
+
+  const auto slice = static_cast<std::size_t>(size - sliceStart);
+  call.date_times.resize(slice);
+  for (std::size_t i = 0; i < slice; ++i) {
+    call.date_times[i] = sc.BaseDateTimeIn[sliceStart + static_cast<int>(i)].GetInternalDateTime();
+  }
+  call.base.assign(slice * NUM_BASE_GRAPH_ARRAYS, 0.0f);
+  for (int array = 0; array < NUM_BASE_GRAPH_ARRAYS; ++array) {
+    const float* data = sc.BaseDataIn[array].GetPointer();
+    if (data != nullptr && sc.BaseDataIn[array].GetArraySize() >= size) {
+      std::copy(data + sliceStart, data + size, call.base.begin() + static_cast<std::ptrdiff_t>(slice * array));
+    }
+  }
+
+  call.inputs.clear();
+  for (int i = 0; i < SC_INPUTS_AVAILABLE; ++i) {
+    const double value = sc.Input[i].GetDouble();
+    if (!sc.Input[i].Name.IsEmpty() && (state->first || value != state->inputs[i])) {
+      call.inputs.emplace_back(i, value);
+      state->inputs[i] = value;
+    }
+  }
+  call.persistent_ints.clear();
+  call.persistent_doubles.clear();
+  for (const int key : stateKeys) {
+    const int intValue = sc.GetPersistentInt(key);
+    const auto knownInt = state->persistentInts.find(key);
+    if (knownInt == state->persistentInts.end() || knownInt->second != intValue) {
+      call.persistent_ints.emplace_back(key, intValue);
+      state->persistentInts[key] = intValue;
+    }
+    const double doubleValue = sc.GetPersistentDouble(key);
+    const auto knownDouble = state->persistentDoubles.find(key);
+    if (knownDouble == state->persistentDoubles.end() || knownDouble->second != doubleValue) {
+      call.persistent_doubles.emplace_back(key, doubleValue);
+      state->persistentDoubles[key] = doubleValue;
+    }
+  }
+  state->first = false;
+  state_ = state;
+}
+
+CallCapture::~CallCapture() {
+  if (state_ == nullptr) {
+    return;
+  }
+  state_->call.output_digest = SubgraphDigest(sc_, state_->call.update_start_index);
+  try {
+    state_->writer.write(state_->call);
+  } catch (const std::exception& error) {
+    char message[512];
+    std::snprintf(message, sizeof(message), "SierraStudy capture stopped: %s", error.what());
+    sc_.AddMessageToLog(message, 1);
+    StopCapture(sc_, sc_.GetPersistentPointer(pointerKey_));
+  }
+}
+
+}  // namespace sierra::acsil
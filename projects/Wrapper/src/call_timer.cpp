@@ -0,0 +1,130 @@
+#include "sierra/acsil/call_timer.hpp"
+
+#include "sierra/core/latency_histogram.hpp"
+#include "sierra/core/tick_clock.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+namespace sierra::acsil {
+
+/// @brief Статистика вызовов одного экземпляра исследования между сводками.
+struct StudyCallStats {
+  std::array<sierra::core::LatencyHistogram, static_cast<std::size_t>(StudyCallPhase::kCount)> phases;
+  sierra::core::TickCalibration clock;
+  std::chrono::seconds interval{60};
+  std::chrono::steady_clock::time_point next_summary;
+  std::int64_t last_check = 0;
+};
+
+namespace {
+
+/// Как часто (в тактах) деструктор `StudyCallTimer` сверяется с часами: ~5 мс при 3 ГГц.
+constexpr std::int64_t kSummaryCheckTicks = std::int64_t{1} << 24;
+
+const char* const kPhaseNames[] = {"defaults", "full", "live"};
+
+/// @brief Выводит сводку задержек в Message Log и начинает новый интервал.
+void EmitCallSummary(SCStudyInterfaceRef sc, StudyCallStats& stats) {
+  stats.clock.update();
+  char message[512];
+  int length = std::snprintf(message, sizeof(message), "%s latency, us:", sc.GraphName.GetChars());
+  bool any = false;
+  for (std::size_t i = 0; i < stats.phases.size(); ++i) {
+    const sierra::core::LatencyHistogram& histogram = stats.phases[i];
+    if (histogram.count() == 0 || length < 0 || static_cast<std::size_t>(length) >= sizeof(message)) {
+      continue;
+    }
+    const auto us = [&](std::uint64_t ticks) {
+      return stats.clock.to_nanoseconds(static_cast<std::int64_t>(ticks)) / 1000.0;
+    };
+    length += std::snprintf(message + length, sizeof(message) - static_cast<std::size_t>(length),
+                            " %s n=%llu p50=%.2f p99=%.2f max=%.2f;", kPhaseNames[i],
+                            static_cast<unsigned long long>(histogram.count()), us(histogram.quantile(0.5)),
+                            us(histogram.quantile(0.99)), us(histogram.max()));
+    any = true;
+  }
+  if (any) {
+    sc.AddMessageToLog(message, 0);
+  }
+  for (auto& histogram : stats.phases) {
+    histogram.reset();
+  }
+  stats.next_summary = std::chrono::steady_clock::now() + stats.interval;
+}
+
+}  // namespace
+
+/**
+ * @brief Начинает замер вызова исследования.
+ * @note При `LastCallToFunction` замер не ведётся: деструктор только выводит итоговую сводку и освобождает статистику.
+ */
+StudyCallTimer::StudyCallTimer(SCStudyInterfaceRef sc, int key, SCInputRef interval)
+    : sc_(sc), interval_(interval), key_(key) {
+  stats_ = static_cast<StudyCallStats*>(sc.GetPersistentPointer(key));
+  if (sc.LastCallToFunction) {
+    return;
+  }
+  if (sc.SetDefaults) {
+    phase_ = StudyCallPhase::kSetDefaults;  // вход ещё не задан: решение принимает деструктор
+  } else {
+    configure();
+    if (stats_ == nullptr) {
+      return;
+    }
+    if (sc.IsFullRecalculation) {
+      phase_ = StudyCallPhase::kFullRecalculation;
+    }
+  }
+  start_ = sierra::core::read_ticks();
+}
+
+StudyCallTimer::~StudyCallTimer() {
+  if (sc_.LastCallToFunction) {
+    if (stats_ != nullptr) {
+      EmitCallSummary(sc_, *stats_);
+      delete stats_;
+      sc_.GetPersistentPointer(key_) = nullptr;
+    }
+    return;
+  }
+  const std::int64_t end = sierra::core::read_ticks();
+  if (sc_.SetDefaults) {
+    configure();
+  }
+  if (stats_ == nullptr) {
+    return;
+  }
+  stats_->phases[static_cast<std::size_t>(phase_)].record(static_cast<std::uint64_t>(end - start_));
+  if (end - stats_->last_check >= kSummaryCheckTicks) {
+    stats_->last_check = end;
+    if (std::chrono::steady_clock::now() >= stats_->next_summary) {
+      EmitCallSummary(sc_, *stats_);
+    }
+  }
+}
+
+void StudyCallTimer::configure() {
+  void*& slot = sc_.GetPersistentPointer(key_);
+  const int seconds = interval_.GetInt();
+  if (seconds <= 0) {
+    delete stats_;
+    slot = nullptr;
+    stats_ = nullptr;
+    return;
+  }
+  const std::chrono::seconds interval(seconds);
+  if (stats_ == nullptr) {
+    stats_ = new StudyCallStats();
+    stats_->interval = interval;
+    stats_->next_summary = std::chrono::steady_clock::now() + interval;
+    slot = stats_;
+  } else if (stats_->interval != interval) {
+    stats_->next_summary += interval - stats_->interval;
+    stats_->interval = interval;
+  }
+}
+
+}  // namespace sierra::acsil
@@ -0,0 +1,193 @@
+#include "sierra/acsil/column_cache.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <system_error>
+
+namespace sierra::acsil {
+
+namespace {
+
+/// Баров за одну публикацию в общий столбец: буфер времени не растёт с длиной истории.
+constexpr std::size_t kPublishChunk = 4096;
+
+/// Подкаталог каталога данных Sierra Chart для файлов `PersistedColumn`.
+constexpr const char* kColumnFolder = "SierraStudy.Cache";
+
+/// @brief Время баров графика для `ColumnStore`, переводимое поблочно.
+sierra::core::ColumnStore::BarTimes ChartBarTimes(SCStudyInterfaceRef sc) {
+  const SCDateTime* dateTimes = sc.BaseDateTimeIn.GetPointer();
+  return [dateTimes](std::size_t first, std::size_t count, std::int64_t* times) {
+    for (std::size_t i = 0; i < count; ++i) {
+      times[i] = dateTimes[first + i].GetInternalDateTime();
+    }
+  };
+}
+
+}  // namespace
+
+sierra::core::SharedColumnCache& SharedIndicatorCache() {
+  static sierra::core::SharedColumnCache* cache = new sierra::core::SharedColumnCache();
+  return *cache;
+}
+
+SharedColumnSubscription* AcquireSharedColumn(SCStudyInterfaceRef sc, int key, const char* study,
+                                              std::initializer_list<double> parameters, bool enabled) {
+  void*& slot = sc.GetPersistentPointer(key);
+  auto* subscription = static_cast<SharedColumnSubscription*>(slot);
+  if (sc.LastCallToFunction || !enabled || sc.ArraySize <= 0) {
+    delete subscription;
+    slot = nullptr;
+    return nullptr;
+  }
+  const std::int64_t firstBarTime = sc.BaseDateTimeIn[0].GetInternalDateTime();
+  if (subscription == nullptr) {
+    subscription = new SharedColumnSubscription();
+    slot = subscription;
+  } else {
+    const sierra::core::ColumnKey& current = subscription->key;
+    if (current.first_bar_time == firstBarTime && current.bar_period_seconds == sc.SecondsPerBar &&
+        current.symbol == sc.Symbol.GetChars() && current.study == study &&
+        std::equal(current.parameters.begin(), current.parameters.end(), parameters.begin(), parameters.end())) {
+      return subscription;
+    }
+  }
+  sierra::core::ColumnKey next{sc.Symbol.GetChars(), sc.SecondsPerBar, study, parameters, firstBarTime};
+  subscription->column = SharedIndicatorCache().acquire(next);
+  subscription->key = std::move(next);
+  return subscription;
+}
+
+int ReadSharedColumn(SCStudyInterfaceRef sc, SharedColumnSubscription& subscription, int first, const float* source,
+                     float* output) {
+  if (!sc.IsFullRecalculation || source == nullptr || output == nullptr || first < 0) {
+    return first;
+  }
+  const sierra::core::EpochDomain::Guard guard = subscription.column->pin();
+  const sierra::core::SharedColumn::View view = subscription.column->read(guard);
+  const int shared = static_cast<int>((std::min)(view.size, static_cast<std::size_t>((std::max)(0, sc.ArraySize - 1))));
+  if (shared <= first) {
+    return first;
+  }
+  const SCDateTime* times = sc.BaseDateTimeIn.GetPointer();
+  if (times == nullptr || sc.BaseDateTimeIn.GetArraySize() < shared ||
+      std::memcmp(view.sources + first, source + first, static_cast<std::size_t>(shared - first) * sizeof(float)) != 0) {
+    return first;
+  }
+  for (int i = first; i < shared; ++i) {
+    if (view.times[i] != times[i].GetInternalDateTime()) {
+      return first;
+    }
+  }
+  std::memcpy(output + first, view.values + first, static_cast<std::size_t>(shared - first) * sizeof(float));
+  return shared;
+}
+
+void PublishSharedColumn(SCStudyInterfaceRef sc, SharedColumnSubscription& subscription, const float* source,
+                         const float* output) {
+  if (source == nullptr || output == nullptr || sc.ArraySize <= 1 || sc.BaseDateTimeIn.GetPointer() == nullptr ||
+      sc.BaseDateTimeIn.GetArraySize() < sc.ArraySize) {
+    return;
+  }
+  sierra::core::SharedColumn& column = *subscription.column;
+  const auto closed = static_cast<std::size_t>(sc.ArraySize - 1);
+  std::size_t size = column.size();
+  if (closed <= size) {
+    return;
+  }
+  if (size > 0) {
+    const sierra::core::EpochDomain::Guard guard = column.pin();
+    const sierra::core::SharedColumn::View view = column.read(guard);
+    const int last = static_cast<int>(size - 1);
+    if (view.size != size || view.times[last] != sc.BaseDateTimeIn[last].GetInternalDateTime() ||
+        view.sources[last] != source[last]) {
+      return;
+    }
+  }
+  if (closed - size > kPublishChunk) {
+    column.reserve(closed + closed / 8);  // история целиком и запас на бары реального времени
+  }
+  while (size < closed) {
+    const std::size_t count = (std::min)(kPublishChunk, closed - size);
+    subscription.times.resize(count);
+    const SCDateTime* times = sc.BaseDateTimeIn.GetPointer() + size;
+    for (std::size_t i = 0; i < count; ++i) {
+      subscription.times[i] = times[i].GetInternalDateTime();
+    }
+    if (!column.append(size, output + size, subscription.times.data(), source + size, count)) {
+      return;  // бары дописал другой график
+    }
+    size += count;
+  }
+}
+
+PersistedColumn* AcquirePersistedColumn(SCStudyInterfaceRef sc, int key, const char* study,
+                                        std::initializer_list<double> parameters, std::uint32_t version,
+                                        bool enabled) {
+  void*& slot = sc.GetPersistentPointer(key);
+  auto* column = static_cast<PersistedColumn*>(slot);
+  if (sc.LastCallToFunction || !enabled) {
+    delete column;
+    slot = nullptr;
+    return nullptr;
+  }
+  if (column != nullptr && !sc.IsFullRecalculation) {
+    return column;
+  }
+  const std::uint64_t keyHash =
+      sierra::core::persistent_hash({sc.Symbol.GetChars(), sc.SecondsPerBar, study, parameters, 0, version});
+  if (column == nullptr) {
+    column = new PersistedColumn();
+    slot = column;
+  }
+  if (column->store == nullptr || column->store->key_hash() != keyHash) {
+    char name[96];
+    std::snprintf(name, sizeof(name), "SierraStudy.%d.%d.col", sc.ChartNumber, sc.StudyGraphInstanceID);
+    const std::filesystem::path folder = std::filesystem::path(sc.DataFilesFolder().GetChars()) / kColumnFolder;
+    std::error_code error;
+    std::filesystem::create_directories(folder, error);
+    column->store = std::make_unique<sierra::core::ColumnStore>((folder / name).string(), keyHash);
+    column->failed = false;
+  }
+  return column;
+}
+
+int LoadPersistedColumn(SCStudyInterfaceRef sc, PersistedColumn& column, int first, const float* source,
+                        float* output) {
+  if (!sc.IsFullRecalculation || column.failed || source == nullptr || output == nullptr || sc.ArraySize <= 1 ||
+      sc.BaseDateTimeIn.GetPointer() == nullptr || sc.BaseDateTimeIn.GetArraySize() < sc.ArraySize) {
+    return first;
+  }
+  const auto closed = static_cast<std::size_t>(sc.ArraySize - 1);
+  const std::size_t loaded = column.store->load(ChartBarTimes(sc), source, closed, output, column.times);
+  return (std::max)(first, static_cast<int>(loaded));
+}
+
+void StorePersistedColumn(SCStudyInterfaceRef sc, PersistedColumn& column, const float* source, const float* output) {
+  if (column.failed || source == nullptr || output == nullptr || sc.ArraySize <= 1 ||
+      sc.BaseDateTimeIn.GetPointer() == nullptr || sc.BaseDateTimeIn.GetArraySize() < sc.ArraySize) {
+    return;
+  }
+  sierra::core::ColumnStore& store = *column.store;
+  if (!sc.IsFullRecalculation) {
+    store.invalidate(static_cast<std::size_t>((std::max)(0, sc.UpdateStartIndex)));
+  }
+  const auto closed = static_cast<std::size_t>(sc.ArraySize - 1);
+  if (!store.needs_store(closed)) {
+    return;
+  }
+  try {
+    store.store(ChartBarTimes(sc), source, output, closed, column.times);
+  } catch (const std::exception& error) {
+    column.failed = true;
+    char message[512];
+    std::snprintf(message, sizeof(message), "SierraStudy column cache disabled: %s", error.what());
+    sc.AddMessageToLog(message, 1);
+  }
+}
+
+}  // namespace sierra::acsil
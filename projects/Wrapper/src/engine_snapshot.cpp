@@ -0,0 +1,180 @@
+#include "sierra/acsil/engine_snapshot.hpp"
+
+#include "sierra/core/column_store.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <system_error>
+
+namespace sierra::acsil {
+
+namespace {
+
+constexpr std::uint32_t kSnapshotMagic = 0x53454353;  // "SCES"
+constexpr std::uint32_t kSnapshotFormat = 1;
+constexpr std::chrono::seconds kSnapshotMaxAge = std::chrono::hours(1);
+constexpr const char* kSnapshotPrefix = "SierraStudy.";
+constexpr const char* kSnapshotSuffix = ".engine.bin";
+
+std::filesystem::path EngineSnapshotPath(SCStudyInterfaceRef sc) {
+  std::error_code error;
+  char name[96];
+  std::snprintf(name, sizeof(name), "%s%d.%d%s", kSnapshotPrefix, sc.ChartNumber, sc.StudyGraphInstanceID,
+                kSnapshotSuffix);
+  return std::filesystem::temp_directory_path(error) / name;
+}
+
+std::uint64_t EngineSnapshotKey(SCStudyInterfaceRef sc) {
+  return sierra::core::persistent_hash({sc.Symbol.GetChars(), sc.SecondsPerBar, sc.GraphName.GetChars(), {}, 0});
+}
+
+/// @brief Хеш времени и источника баров `[committed - window, committed)`.
+std::uint64_t HashSnapshotWindow(SCStudyInterfaceRef sc, std::size_t committed, std::size_t window,
+                                 const float* source) {
+  const std::size_t begin = committed - window;
+  std::vector<std::int64_t> times(window);
+  const SCDateTime* dateTimes = sc.BaseDateTimeIn.GetPointer();
+  for (std::size_t i = 0; i < window; ++i) {
+    times[i] = dateTimes[begin + i].GetInternalDateTime();
+  }
+  return sierra::core::hash_bars(times.data(), source + begin, window, sierra::core::kBarHashSeed);
+}
+
+bool HasBarTimes(SCStudyInterfaceRef sc, std::size_t committed) {
+  return sc.BaseDateTimeIn.GetPointer() != nullptr &&
+         static_cast<std::size_t>((std::max)(0, sc.BaseDateTimeIn.GetArraySize())) >= committed;
+}
+
+bool IsEngineSnapshotName(const std::string& name) {
+  const std::size_t prefix = std::strlen(kSnapshotPrefix);
+  const std::size_t suffix = std::strlen(kSnapshotSuffix);
+  return name.size() > prefix + suffix && name.compare(0, prefix, kSnapshotPrefix) == 0 &&
+         name.compare(name.size() - suffix, suffix, kSnapshotSuffix) == 0;
+}
+
+}  // namespace
+
+std::size_t RemoveStaleEngineSnapshots(const std::filesystem::path& folder, std::chrono::seconds maxAge) {
+  std::error_code error;
+  std::filesystem::directory_iterator it(folder, error);
+  if (error) {
+    return 0;
+  }
+  const auto now = std::filesystem::file_time_type::clock::now();
+  std::size_t removed = 0;
+  for (const std::filesystem::directory_iterator end; it != end; it.increment(error)) {
+    if (error) {
+      break;
+    }
+    const std::filesystem::path& path = it->path();
+    if (!IsEngineSnapshotName(path.filename().string()) || !it->is_regular_file(error)) {
+      continue;
+    }
+    const auto written = std::filesystem::last_write_time(path, error);
+    if (!error && now - written > maxAge && std::filesystem::remove(path, error)) {
+      ++removed;
+    }
+  }
+  return removed;
+}
+
+void RemoveStaleEngineSnapshots(SCStudyInterfaceRef sc) {
+  static bool cleaned = false;
+  if (cleaned) {
+    return;
+  }
+  cleaned = true;
+  std::error_code error;
+  const std::filesystem::path folder = std::filesystem::temp_directory_path(error);
+  if (error) {
+    return;
+  }
+  const std::size_t removed = RemoveStaleEngineSnapshots(folder, kSnapshotMaxAge);
+  if (removed != 0) {
+    char message[128];
+    std::snprintf(message, sizeof(message), "SierraStudy removed %zu stale engine snapshots", removed);
+    sc.AddMessageToLog(message, 0);
+  }
+}
+
+void WriteEngineSnapshot(SCStudyInterfaceRef sc, const sierra::core::SnapshotWriter& state, std::size_t committed,
+                         std::size_t window, const float* source, const float* output) {
+  if (committed > static_cast<std::size_t>((std::max)(0, sc.ArraySize)) || window > committed ||
+      !HasBarTimes(sc, committed)) {
+    return;
+  }
+  sierra::core::SnapshotWriter file;
+  file.put(kSnapshotMagic);
+  file.put(kSnapshotFormat);
+  file.put(EngineSnapshotKey(sc));
+  file.put<std::uint64_t>(committed);
+  file.put<std::uint64_t>(window);
+  file.put(HashSnapshotWindow(sc, committed, window, source));
+  file.put_vector(std::vector<float>(output + (committed - window), output + committed));
+  file.put_vector(state.bytes());
+
+  const std::filesystem::path path = EngineSnapshotPath(sc);
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char*>(file.bytes().data()), static_cast<std::streamsize>(file.bytes().size()));
+  out.flush();
+  if (!out) {
+    char message[512];
+    std::snprintf(message, sizeof(message), "SierraStudy cannot save engine state to %s", path.string().c_str());
+    sc.AddMessageToLog(message, 1);
+  }
+}
+
+bool ReadEngineSnapshot(SCStudyInterfaceRef sc, const float* source, const float* output,
+                        std::vector<unsigned char>& state, std::size_t& committed) {
+  const std::filesystem::path path = EngineSnapshotPath(sc);
+  std::error_code error;
+  if (!std::filesystem::is_regular_file(path, error)) {
+    return false;
+  }
+  std::vector<unsigned char> bytes;
+  {
+    std::ifstream in(path, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  // Снимок одноразовый: после следующего полного пересчёта он уже не соответствует выходу.
+  std::filesystem::remove(path, error);
+
+  try {
+    sierra::core::SnapshotReader file(bytes);
+    if (file.get<std::uint32_t>() != kSnapshotMagic || file.get<std::uint32_t>() != kSnapshotFormat ||
+        file.get<std::uint64_t>() != EngineSnapshotKey(sc)) {
+      return false;
+    }
+    const auto bars = file.get<std::uint64_t>();
+    const auto window = file.get<std::uint64_t>();
+    // Последний бар графика не закрыт: движок учитывает только бары до него.
+    if (bars == 0 || sc.ArraySize <= 1 || bars > static_cast<std::uint64_t>(sc.ArraySize - 1) || window > bars ||
+        !HasBarTimes(sc, static_cast<std::size_t>(bars))) {
+      return false;
+    }
+    committed = static_cast<std::size_t>(bars);
+    const std::size_t width = static_cast<std::size_t>(window);
+    if (file.get<std::uint64_t>() != HashSnapshotWindow(sc, committed, width, source)) {
+      return false;
+    }
+    std::vector<float> values;
+    file.get_vector(values);
+    if (values.size() != width ||
+        std::memcmp(values.data(), output + (committed - width), width * sizeof(float)) != 0) {
+      return false;
+    }
+    file.get_vector(state);
+  } catch (const std::exception&) {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace sierra::acsil
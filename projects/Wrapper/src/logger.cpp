@@ -0,0 +1,69 @@
+#include "sierra/acsil/logger.hpp"
+
+#include <mutex>
+
+namespace sierra::acsil {
+
+namespace {
+
+/// @brief Журнал, общий для всех экземпляров исследований DLL.
+/// @note Без статических деструкторов: к выгрузке DLL журнал уже разрушен последним `LastCallToFunction`, а join потока из `DllMain` привёл бы к взаимоблокировке на loader lock.
+struct SharedLogger {
+  std::mutex mutex;
+  sierra::core::AsyncLogger* logger = nullptr;
+  int references = 0;
+};
+
+SharedLogger& SharedLoggerState() {
+  static SharedLogger* state = new SharedLogger();
+  return *state;
+}
+
+}  // namespace
+
+/**
+ * @brief Возвращает общий для DLL асинхронный журнал.
+ * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+ * @param key Ключ persistent-флага: `1` — экземпляр держит ссылку, `-1` — открыть файл не удалось.
+ * @return sierra::core::AsyncLogger* Журнал или `nullptr`.
+ * @note Мьютекс берётся только при захвате и освобождении ссылки; на обычных вызовах хватает persistent-флага.
+ */
+sierra::core::AsyncLogger* AcquireLogger(SCStudyInterfaceRef sc, int key) {
+  int& held = sc.GetPersistentInt(key);
+  SharedLogger& shared = SharedLoggerState();
+  if (sc.LastCallToFunction) {
+    if (held == 1) {
+      std::lock_guard<std::mutex> lock(shared.mutex);
+      if (--shared.references == 0) {
+        delete shared.logger;  // дописывает очереди и останавливает поток
+        shared.logger = nullptr;
+      }
+    }
+    held = 0;
+    return nullptr;
+  }
+  if (held == -1) {
+    return nullptr;
+  }
+  if (held == 1) {
+    return shared.logger;
+  }
+
+  std::lock_guard<std::mutex> lock(shared.mutex);
+  if (shared.logger == nullptr) {
+    try {
+      sierra::core::AsyncLoggerOptions options;
+      options.path = "Logs/SierraStudy.log";
+      shared.logger = new sierra::core::AsyncLogger(options);
+      shared.logger->log(sierra::core::LogLevel::kInfo, "SierraStudy logging initialized");
+    } catch (...) {
+      held = -1;
+      return nullptr;
+    }
+  }
+  ++shared.references;
+  held = 1;
+  return shared.logger;
+}
+
+}  // namespace sierra::acsil
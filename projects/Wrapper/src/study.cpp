@@ -1,77 +1,63 @@
 #include "sierra/acsil/study.hpp"
+#include "sierra/acsil/call_capture.hpp"
+#include "sierra/acsil/call_timer.hpp"
+#include "sierra/acsil/column_cache.hpp"
+#include "sierra/acsil/engine_snapshot.hpp"
+#include "sierra/acsil/logger.hpp"
 #include "sierra/acsil/supportFunction.hpp"
+#include "sierra/acsil/trace_menu.hpp"
 
 #include "sierra/core/moving_average.hpp"
+#include "sierra/core/order_flow_worker.hpp"
 
 #include <algorithm>
 #include <cmath>
-#include <limits>
-#include <vector>
-
-#if __has_include(<plog/Log.h>)
-#define SIERRA_STUDY_HAS_PLOG 1
-#include <filesystem>
-#include <plog/Initializers/RollingFileInitializer.h>
-#include <plog/Log.h>
-#else
-#define SIERRA_STUDY_HAS_PLOG 0
-#endif
+#include <cstddef>
 
 /// \brief Название группы, отображаемое в диалоге Sierra Chart «Add Custom Study».
 SCDLLName("SierraStudy Custom Studies")
 
 namespace {
 
-constexpr int kPersistLogging = 1;
-
-#if SIERRA_STUDY_HAS_PLOG
-/// @brief Однократно настраивает plog (если он доступен).
-/// @param sc Контекст исследования, содержащий persistent-хранилище.
-/// @return void.
-/// @note Создаёт каталог Logs, включает кольцевой файл журнала и помечает это в persistent-хранилище Sierra Chart, чтобы не повторять работу.
-/// @warning При ошибках файловой системы устанавливает флаг `-1` и больше не пытается повторять инициализацию в рамках текущей сессии.
-void EnsureLogging(SCStudyGraphRef sc) {
-  if (sc.Index != 0) {
-    return;
-  }
-
-  const int initialized = sc.GetPersistentInt(kPersistLogging);
-  if (initialized == 1 || initialized == -1) {
-    return;
-  }
-
-  try {
-    std::filesystem::create_directories("Logs");
-    plog::init(plog::info, "Logs/SierraStudy.log", 5 * 1024 * 1024, 3);
-    sc.SetPersistentInt(kPersistLogging, 1);
-    PLOG_INFO << "SierraStudy logging initialized";
-  } catch (...) {
-    sc.SetPersistentInt(kPersistLogging, -1);
-  }
-}
-#else
-void EnsureLogging(SCStudyGraphRef) {}
-#endif
+constexpr int kPersistLogging = 1;  // ключ GetPersistentInt: экземпляр держит ссылку на журнал
+constexpr int kPersistTraceMenu = 2;  // ключи GetPersistentInt 2 и 3: пункты меню трассировки
+constexpr int kPersistCaptureMenu = 4;  // ключи GetPersistentInt 4 и 5: пункты меню захвата вызовов
+constexpr int kPersistEngine = 1;  // ключ GetPersistentPointer для движка ядра
+constexpr int kPersistProfile = 2;  // ключ GetPersistentPointer для статистики задержек вызовов
+constexpr int kPersistCapture = 3;  // ключ GetPersistentPointer для файла захвата вызовов
+constexpr int kPersistShared = 4;  // ключ GetPersistentPointer для подписки на общий столбец
+constexpr int kPersistStore = 5;  // ключ GetPersistentPointer для файла посчитанных значений на диске
+constexpr int kPersistLastSequence = 6;  // ключ GetPersistentInt: последний переданный Sequence ленты сделок
+constexpr int kPersistOrderFlow = 6;  // ключ GetPersistentPointer для обработчика ленты сделок
 
 }  // namespace
 
 /// @brief Обёртка ACSIL, которая перенаправляет данные в ядро Core.
 /// @param sc Контекст Sierra Chart для текущего исследования.
 /// @return void.
-/// @note Повторяет структуру из примеров Sierra Chart: в SetDefaults задаёт все опции, во второй секции формирует буфер и вызывает Core.
+/// @note Повторяет структуру из примеров Sierra Chart: в SetDefaults задаёт все опции, во второй секции передаёт массивы графика в Core. Работает с `AutoLoop = 0`: один вызов обрабатывает диапазон `[sc.UpdateStartIndex, sc.ArraySize)`. Движок ядра хранится в `GetPersistentPointer` и освобождается при `LastCallToFunction`, как и ссылка на общий асинхронный журнал. Вход «Latency Summary Interval» включает замер каждого вызова (`StudyCallTimer`) со сводкой в Message Log. Пункты меню «Start/Stop Capture» записывают вызовы для `SierraStudy.Host --replay` (`CallCapture`). Вход «Share Results Across Charts» делит посчитанную историю между графиками одного символа и периода (`SharedIndicatorCache`), вход «Cache Results On Disk» сохраняет её между перезапусками и заменами DLL (`PersistedColumn`). Вход «Keep State Across DLL Reloads» сохраняет состояние движка при `LastCallToFunction` и восстанавливает его после замены DLL (`SaveEngineSnapshot`/`RestoreEngineSnapshot`).
 /// @warning Перед использованием убедитесь, что `SIERRA_SDK_DIR` и `SIERRA_DATA_DIR` заданы корректно, иначе сборка/копирование DLL не сработают.
 SCSFExport scsf_SierraStudyMovingAverage(SCStudyGraphRef sc) {
+  SIERRA_TRACE_SCOPE("acsil", "scsf_SierraStudyMovingAverage");
+  SCInputRef profileInput = sc.Input[1];
+  sierra::acsil::StudyCallTimer timer(sc, kPersistProfile, profileInput);
   sierra::acsil::LogDllStartup(sc);
+  sierra::acsil::HandleTraceMenu(sc, kPersistTraceMenu);
+  sierra::acsil::CallCapture capture(sc, kPersistCaptureMenu, kPersistCapture);
   SCSubgraphRef ma = sc.Subgraph[0];
   SCInputRef periodInput = sc.Input[0];
+  SCInputRef shareInput = sc.Input[2];
+  SCInputRef storeInput = sc.Input[3];
+  SCInputRef keepStateInput = sc.Input[4];
 
   if (sc.SetDefaults) {
     // Раздел 1 — настройка по умолчанию (как в примерах Sierra Chart).
     sc.GraphName = "SierraStudy - Moving Average";
     sc.StudyDescription = "Example ACSIL study wrapping the core moving average.";
-    sc.AutoLoop = 1;
+    sc.AutoLoop = 0;  // ручной цикл: один вызов на обновление, а не на каждый бар
     sc.FreeDLL = 1;  // позволяет перестраивать DLL без перезапуска Sierra Chart
     sc.GraphRegion = 0;
+    sierra::acsil::RemoveStaleEngineSnapshots(sc);
 
     ma.Name = "Moving Average";
     ma.DrawStyle = DRAWSTYLE_LINE;
@@ -83,43 +69,140 @@ SCSFExport scsf_SierraStudyMovingAverage(SCStudyGraphRef sc) {
     periodInput.SetInt(20);
     periodInput.SetIntLimits(1, 500);
 
-    sc.DataStartIndex = periodInput.GetInt() - 1;
-    return;
-  }
+    profileInput.Name = "Latency Summary Interval (s), 0 = off";
+    profileInput.SetInt(0);
+    profileInput.SetIntLimits(0, 3600);
 
-  if (sc.LastCallToFunction) {
+    shareInput.Name = "Share Results Across Charts";
+    shareInput.SetYesNo(0);  // выгодно для дорогих расчётов; SMA дешевле копии с проверкой (см. README)
+
+    storeInput.Name = "Cache Results On Disk";
+    storeInput.SetYesNo(0);
+
+    keepStateInput.Name = "Keep State Across DLL Reloads";
+    keepStateInput.SetYesNo(1);
+
+    sc.DataStartIndex = periodInput.GetInt() - 1;
     return;
   }
 
   // Раздел 2 — обработка данных исследования.
-  EnsureLogging(sc);
-
+  sierra::core::AsyncLogger* logger = sierra::acsil::AcquireLogger(sc, kPersistLogging);
   const int period = (std::max)(1, periodInput.GetInt());
+  if (keepStateInput.GetYesNo() != 0) {
+    // LastCallToFunction перед выгрузкой DLL: снимок движка переживёт замену, пока AcquireEngine его не удалил.
+    sierra::acsil::SaveEngineSnapshot<sierra::core::MovingAverageEngine>(
+        sc, kPersistEngine, static_cast<std::size_t>(period), sc.Close.GetPointer(), ma.Data.GetPointer());
+  }
+  auto* engine = sierra::acsil::AcquireEngine<sierra::core::MovingAverageEngine>(
+      sc, kPersistEngine, sierra::core::MovingAverageConfig{static_cast<std::size_t>(period)});
+  auto* shared = sierra::acsil::AcquireSharedColumn(sc, kPersistShared, "SierraStudy.MovingAverage",
+                                                     {static_cast<double>(period)}, shareInput.GetYesNo() != 0);
+  auto* stored = sierra::acsil::AcquirePersistedColumn(sc, kPersistStore, "SierraStudy.MovingAverage",
+                                                       {static_cast<double>(period)},
+                                                       sierra::core::MovingAverageEngine::kResultVersion,
+                                                       storeInput.GetYesNo() != 0);
+  if (engine == nullptr) {
+    return;  // LastCallToFunction: движок, подписка, файл и журнал освобождены
+  }
+
   sc.DataStartIndex = period - 1;
 
   const int length = sc.ArraySize;
-  if (length <= 0) {
-    ma[sc.Index] = std::numeric_limits<float>::quiet_NaN();
+  const float* closes = sc.Close.GetPointer();
+  float* output = ma.Data.GetPointer();
+  if (length <= 0 || closes == nullptr || output == nullptr) {
     return;
   }
 
-  // Формируем локальный буфер цен закрытия — в том же стиле, что и примеры
-  // Sierra Chart. Так ядро получает std::vector без прямой зависимости от ACSIL.
-  std::vector<double> closes(static_cast<std::size_t>(sc.Index + 1));
-  for (int i = 0; i <= sc.Index; ++i) {
-    closes[static_cast<std::size_t>(i)] = sc.Close[i];
+  // Ручной цикл: за один вызов пересчитываем только [UpdateStartIndex, ArraySize).
+  // Движок помнит сумму окна закрытых баров, поэтому обновление в реальном времени
+  // не перечитывает период заново.
+  int first = (std::min)((std::max)(0, sc.UpdateStartIndex), length);
+  if (logger != nullptr && sc.IsFullRecalculation) {
+    logger->log(sierra::core::LogLevel::kInfo, "Moving average full recalculation: {} bars, period {}", length, period);
+  }
+  if (keepStateInput.GetYesNo() != 0) {
+    // Первый полный пересчёт новой DLL: если массивы графика уцелели, движок продолжает со снимка.
+    first = sierra::acsil::RestoreEngineSnapshot(sc, *engine, first, closes, output);
+  }
+  if (shared != nullptr) {
+    // Историю, уже посчитанную другим графиком того же символа, копируем; движок продолжает с первого непокрытого бара.
+    first = sierra::acsil::ReadSharedColumn(sc, *shared, first, closes, output);
+  }
+  if (stored != nullptr) {
+    // После перезапуска или замены DLL история берётся из файла; считается только хвост за последним блоком.
+    first = sierra::acsil::LoadPersistedColumn(sc, *stored, first, closes, output);
+  }
+  engine->update(closes, static_cast<std::size_t>(length), static_cast<std::size_t>(first), output);
+  if (shared != nullptr) {
+    sierra::acsil::PublishSharedColumn(sc, *shared, closes, output);
+  }
+  if (stored != nullptr) {
+    sierra::acsil::StorePersistedColumn(sc, *stored, closes, output);
   }
-
-  // Передаём данные в ядро Core: функция вернёт массив SMA, берём последнее
-  // значение и выводим его в Subgraph.
-  const auto averages =
-      sierra::core::moving_average(closes, static_cast<std::size_t>(period));
-  const double value = averages.back();
-  ma[sc.Index] = std::isnan(value) ? std::numeric_limits<float>::quiet_NaN()
-                                   : static_cast<float>(value);
 }
 
+/// @brief Обёртка ACSIL над фоновым обработчиком ленты сделок ядра.
+/// @param sc Контекст Sierra Chart для текущего исследования.
+/// @return void.
+/// @note На каждом вызове новые записи Time & Sales передаются в `OrderFlowWorker` (`PushNewTimeAndSales`), а метрики,
+/// уже посчитанные рабочим потоком, выводятся в последний бар: дельта объёма, VWAP и отброшенные при переполнении
+/// очереди сделки. Обработчик хранится в `GetPersistentPointer` и останавливается при `LastCallToFunction`.
+SCSFExport scsf_SierraStudyOrderFlow(SCStudyGraphRef sc) {
+  SIERRA_TRACE_SCOPE("acsil", "scsf_SierraStudyOrderFlow");
+  SCSubgraphRef delta = sc.Subgraph[0];
+  SCSubgraphRef vwap = sc.Subgraph[1];
+  SCSubgraphRef dropped = sc.Subgraph[2];
+  SCInputRef capacityInput = sc.Input[0];
 
+  if (sc.SetDefaults) {
+    sc.GraphName = "SierraStudy - Order Flow";
+    sc.StudyDescription = "Cumulative delta and VWAP of Time and Sales processed off the chart thread.";
+    sc.AutoLoop = 0;
+    sc.FreeDLL = 1;
+    sc.GraphRegion = 1;
+
+    delta.Name = "Cumulative Delta";
+    delta.DrawStyle = DRAWSTYLE_BAR;
+    delta.PrimaryColor = RGB(0, 160, 0);
+    vwap.Name = "VWAP";
+    vwap.DrawStyle = DRAWSTYLE_IGNORE;
+    dropped.Name = "Dropped Trades";
+    dropped.DrawStyle = DRAWSTYLE_IGNORE;
+
+    capacityInput.Name = "Trade Queue Capacity";
+    capacityInput.SetInt(1 << 16);
+    capacityInput.SetIntLimits(1024, 1 << 22);
+    return;
+  }
 
+  void*& slot = sc.GetPersistentPointer(kPersistOrderFlow);
+  auto* worker = static_cast<sierra::core::OrderFlowWorker*>(slot);
+  if (sc.LastCallToFunction) {
+    delete worker;  // дочитывает очередь и останавливает поток
+    slot = nullptr;
+    return;
+  }
+  int& lastSequenceSlot = sc.GetPersistentInt(kPersistLastSequence);
+  if (worker == nullptr) {
+    worker = new sierra::core::OrderFlowWorker(static_cast<std::size_t>((std::max)(1024, capacityInput.GetInt())));
+    slot = worker;
+    lastSequenceSlot = 0;  // новый обработчик: метрики с нуля, лента берётся целиком
+  }
 
+  auto lastSequence = static_cast<unsigned int>(lastSequenceSlot);
+  sierra::acsil::PushNewTimeAndSales(sc, *worker, lastSequence);
+  lastSequenceSlot = static_cast<int>(lastSequence);
 
+  const int last = sc.ArraySize - 1;
+  if (last < 0) {
+    return;
+  }
+  // Метрики отстают от ленты не больше чем на одну пачку рабочего потока; следующий вызов их догонит.
+  const sierra::core::OrderFlowMetrics metrics = worker->snapshot();
+  delta[last] = static_cast<float>(metrics.delta());
+  const double price = metrics.vwap();
+  vwap[last] = std::isnan(price) ? 0.0f : static_cast<float>(price);
+  dropped[last] = static_cast<float>(metrics.dropped);
+}
@@ -1,5 +1,11 @@
 #include "sierra/acsil/supportFunction.hpp"
 
+#include "sierra/core/trace.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
 namespace sierra::acsil {
 
 /**
@@ -21,4 +27,115 @@ void LogDllStartup(SCStudyInterfaceRef sc) {
   logged = true;
 }
 
+/**
+ * @brief Передаёт в обработчик ядра только новые сделки из Time & Sales.
+ * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+ * @param worker Фоновый обработчик ленты сделок из Core.
+ * @param lastSequence Последний переданный `Sequence`; обновляется функцией.
+ * @return int Количество переданных сделок.
+ * @note Сравнение номеров идёт через знаковую разность, поэтому переполнение `Sequence` не ломает поиск. Нулевой
+ * `lastSequence` — первый вызов: берутся все записи, иначе при `Sequence` от 2^31 разность отрицательна для всех.
+ * @warning При переполнении очереди сделки отбрасываются и учитываются в `OrderFlowMetrics::dropped`.
+ */
+int PushNewTimeAndSales(SCStudyInterfaceRef sc, sierra::core::OrderFlowWorker& worker,
+                        unsigned int& lastSequence) {
+  SIERRA_TRACE_SCOPE("acsil", "PushNewTimeAndSales");
+  c_SCTimeAndSalesArray timeSales;
+  sc.GetTimeAndSales(timeSales);
+  const int size = timeSales.Size();
+  if (size == 0) {
+    return 0;
+  }
+
+  int first = lastSequence == 0 ? 0 : size;
+  while (first > 0 &&
+         static_cast<int>(timeSales[first - 1].Sequence - lastSequence) > 0) {
+    --first;
+  }
+
+  int pushed = 0;
+  for (int i = first; i < size; ++i) {
+    s_TimeAndSales record = timeSales[i];
+    lastSequence = record.Sequence;
+    if (record.Type != SC_TS_BID && record.Type != SC_TS_ASK) {
+      continue;
+    }
+    record *= sc.RealTimePriceMultiplier;
+
+    sierra::core::TradeRecord trade;
+    trade.date_time = record.DateTime.GetAsDouble();
+    trade.price = record.Price;
+    trade.volume = record.Volume;
+    trade.bid = record.Bid;
+    trade.ask = record.Ask;
+    trade.sequence = record.Sequence;
+    trade.side = static_cast<sierra::core::TradeSide>(record.Type);
+    worker.push(trade);
+    ++pushed;
+  }
+  return pushed;
+}
+
+/**
+ * @brief Переводит `SCDateTimeMS` в целочисленный момент ядра.
+ * @param dateTime Время Sierra Chart.
+ * @return sierra::core::Timestamp Момент с той же микросекундой.
+ * @note Обходит `GetAsDouble()`, чтобы не терять точность на современных датах.
+ */
+sierra::core::Timestamp ToTimestamp(const SCDateTimeMS& dateTime) {
+  return sierra::core::Timestamp::from_microseconds(dateTime.GetInternalDateTime());
+}
+
+/**
+ * @brief Переводит момент ядра обратно в `SCDateTimeMS`.
+ * @param timestamp Момент в микросекундах от эпохи Sierra Chart.
+ * @return SCDateTimeMS Время Sierra Chart с той же микросекундой.
+ */
+SCDateTimeMS ToSCDateTime(sierra::core::Timestamp timestamp) {
+  SCDateTimeMS dateTime;
+  dateTime.SetInternalDateTime(timestamp.microseconds());
+  return dateTime;
+}
+
+/**
+ * @brief Копирует сводки стакана графика (`c_ACSILDepthBars`) в книгу ядра.
+ * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+ * @return sierra::core::DepthBook Книга уровней по барам графика.
+ * @note Уровни бара копируются сплошным диапазоном от нижнего до верхнего индекса цены. Индексы Sierra Chart
+ * отсчитываются от своего начала, поэтому нижний уровень переводится в индекс книги через цену.
+ */
+sierra::core::DepthBook BuildDepthBook(SCStudyInterfaceRef sc) {
+  SIERRA_TRACE_SCOPE("acsil", "BuildDepthBook");
+  c_ACSILDepthBars* depthBars = sc.GetMarketDepthBars();
+  const float tickSize = depthBars != nullptr ? depthBars->GetTickSize() : sc.TickSize;
+  sierra::core::DepthBook book(tickSize > 0.0f ? tickSize : 1.0);
+  if (depthBars == nullptr) {
+    return book;
+  }
+
+  std::vector<sierra::core::DepthLevel> levels;
+  const int barCount = (std::min)(depthBars->NumBars(), sc.ArraySize);
+  for (int barIndex = 0; barIndex < barCount; ++barIndex) {
+    if (!depthBars->DepthDataExistsAt(barIndex)) {
+      continue;
+    }
+    const int lowest = depthBars->GetBarLowestPriceTickIndex(barIndex);
+    const int highest = depthBars->GetBarHighestPriceTickIndex(barIndex);
+    if (highest < lowest) {
+      continue;
+    }
+    levels.assign(static_cast<std::size_t>(highest - lowest + 1), sierra::core::DepthLevel{});
+    for (int tickIndex = lowest; tickIndex <= highest; ++tickIndex) {
+      auto& level = levels[static_cast<std::size_t>(tickIndex - lowest)];
+      level.max_bid = static_cast<std::uint32_t>((std::max)(0, depthBars->GetMaxBidQuantity(barIndex, tickIndex)));
+      level.max_ask = static_cast<std::uint32_t>((std::max)(0, depthBars->GetMaxAskQuantity(barIndex, tickIndex)));
+      level.last_bid = static_cast<std::uint32_t>((std::max)(0, depthBars->GetLastBidQuantity(barIndex, tickIndex)));
+      level.last_ask = static_cast<std::uint32_t>((std::max)(0, depthBars->GetLastAskQuantity(barIndex, tickIndex)));
+    }
+    book.add_bar(ToTimestamp(sc.BaseDateTimeIn[barIndex]).microseconds(),
+                 book.tick_index(depthBars->TickIndexToPrice(lowest)), levels);
+  }
+  return book;
+}
+
 }  // namespace sierra::acsil
@@ -0,0 +1,65 @@
+#include "sierra/acsil/trace_menu.hpp"
+
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+
+namespace sierra::acsil {
+
+#if SIERRA_TRACE
+namespace {
+
+constexpr const char* kTracePath = "Logs/SierraStudy.trace.json";
+
+}  // namespace
+
+/**
+ * @brief Обрабатывает пункты меню трассировки.
+ * @param sc Интерфейс исследования, предоставляемый Sierra Chart.
+ * @param key Ключ номера пункта «Start»; номер пункта «Dump» хранится под `key + 1`.
+ * @note Номер `-1` означает, что Sierra Chart не добавила пункт: повторных попыток нет.
+ */
+void HandleTraceMenu(SCStudyInterfaceRef sc, int key) {
+  int& startID = sc.GetPersistentInt(key);
+  int& dumpID = sc.GetPersistentInt(key + 1);
+  if (sc.LastCallToFunction) {
+    for (int* id : {&startID, &dumpID}) {
+      if (*id > 0) {
+        sc.RemoveACSChartShortcutMenuItem(sc.ChartNumber, *id);
+      }
+      *id = 0;
+    }
+    return;
+  }
+  if (sc.SetDefaults) {
+    return;
+  }
+  if (startID == 0) {
+    startID = (std::max)(-1, sc.AddACSChartShortcutMenuItem(sc.ChartNumber, "SierraStudy: Start Trace"));
+    dumpID = (std::max)(-1, sc.AddACSChartShortcutMenuItem(sc.ChartNumber, "SierraStudy: Dump Trace"));
+  }
+  if (sc.MenuEventID == 0) {
+    return;
+  }
+
+  sierra::core::TraceRecorder& recorder = sierra::core::TraceRecorder::instance();
+  char message[256];
+  if (sc.MenuEventID == startID) {
+    recorder.start();
+    sc.AddMessageToLog("SierraStudy trace started", 0);
+  } else if (sc.MenuEventID == dumpID) {
+    try {
+      std::filesystem::create_directories(std::filesystem::path(kTracePath).parent_path());
+      const std::size_t spans = recorder.dump(kTracePath);
+      recorder.stop();
+      std::snprintf(message, sizeof(message), "SierraStudy trace: %zu spans written to %s (dropped %llu)", spans,
+                    kTracePath, static_cast<unsigned long long>(recorder.dropped()));
+    } catch (const std::exception& error) {
+      std::snprintf(message, sizeof(message), "SierraStudy trace dump failed: %s", error.what());
+    }
+    sc.AddMessageToLog(message, 1);
+  }
+}
+#endif
+
+}  // namespace sierra::acsil
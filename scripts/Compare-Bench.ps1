@@ -0,0 +1,221 @@
+<#
+.SYNOPSIS
+  Compares two Google Benchmark JSON files and flags statistically significant regressions.
+
+.DESCRIPTION
+  Per-repetition samples of every benchmark are compared with a two-sided Mann-Whitney U test
+  (normal approximation). A benchmark is a regression when the p-value is below -Alpha and the
+  median slowed down by more than -Threshold. Benchmarks with fewer than 3 samples on either side
+  are reported without a verdict. The script exits with code 1 if any regression is found.
+
+  Timings are only comparable between runs of the same build on the same machine, so the `context`
+  of both files is checked first: host_name, num_cpus, library_build_type and the SierraStudy build
+  fields written by bench_main.cpp (sierra_build_type, sierra_compiler, sierra_max_size). A mismatch
+  or a debug build stops the comparison with exit code 2 unless -IgnoreContext is given, which turns
+  it into a warning.
+
+.PARAMETER Baseline
+  Stored baseline JSON (e.g. projects\Bench\baselines\baseline-windows.json).
+
+.PARAMETER Current
+  Fresh results produced with --benchmark_repetitions.
+
+.PARAMETER Metric
+  Timing field to compare: real_time (default) or cpu_time.
+
+.PARAMETER Alpha
+  Significance level of the test.
+
+.PARAMETER Threshold
+  Minimal relative slowdown of the median that counts as a regression (0.05 = 5%).
+
+.PARAMETER IgnoreContext
+  Compare even if the machine or build recorded in the two contexts differ; only print a warning.
+#>
+param(
+  [Parameter(Mandatory = $true)]
+  [string]$Baseline,
+
+  [Parameter(Mandatory = $true)]
+  [string]$Current,
+
+  [ValidateSet('real_time', 'cpu_time')]
+  [string]$Metric = 'real_time',
+
+  [double]$Alpha = 0.05,
+
+  [double]$Threshold = 0.05,
+
+  [switch]$IgnoreContext
+)
+
+$ErrorActionPreference = 'Stop'
+
+$unitScale = @{ 'ns' = 1.0; 'us' = 1e3; 'ms' = 1e6; 's' = 1e9 }
+
+function Read-Samples {
+  param([string]$Path)
+  if (-not (Test-Path -LiteralPath $Path)) {
+    throw "Benchmark results not found: $Path"
+  }
+  $json = Get-Content -LiteralPath $Path -Raw | ConvertFrom-Json
+  $samples = @{}
+  foreach ($bench in $json.benchmarks) {
+    if ($bench.run_type -and $bench.run_type -ne 'iteration') {
+      continue
+    }
+    $name = if ($bench.run_name) { $bench.run_name } else { $bench.name }
+    if (-not $samples.ContainsKey($name)) {
+      $samples[$name] = [System.Collections.Generic.List[double]]::new()
+    }
+    $scale = if ($bench.time_unit) { $unitScale[$bench.time_unit] } else { 1.0 }
+    $samples[$name].Add([double]$bench.$Metric * $scale)
+  }
+  return $samples
+}
+
+function Get-Median {
+  param([double[]]$Values)
+  $sorted = $Values | Sort-Object
+  $n = $sorted.Count
+  if ($n % 2 -eq 1) {
+    return $sorted[($n - 1) / 2]
+  }
+  return ($sorted[$n / 2 - 1] + $sorted[$n / 2]) / 2.0
+}
+
+# Нормальная функция распределения через erf (Abramowitz–Stegun 7.1.26, погрешность < 1.5e-7).
+function Get-NormalCdf {
+  param([double]$Z)
+  $x = [math]::Abs($Z) / [math]::Sqrt(2.0)
+  $t = 1.0 / (1.0 + 0.3275911 * $x)
+  $poly = (((1.061405429 * $t - 1.453152027) * $t + 1.421413741) * $t - 0.284496736) * $t + 0.254829592
+  $erf = 1.0 - $poly * $t * [math]::Exp(-$x * $x)
+  if ($Z -ge 0) {
+    return 0.5 * (1.0 + $erf)
+  }
+  return 0.5 * (1.0 - $erf)
+}
+
+# Двусторонний U-тест Манна–Уитни; совпадающие значения получают средний ранг.
+function Get-MannWhitneyP {
+  param([double[]]$Left, [double[]]$Right)
+  $all = @()
+  foreach ($v in $Left) { $all += [pscustomobject]@{ Value = $v; Left = $true } }
+  foreach ($v in $Right) { $all += [pscustomobject]@{ Value = $v; Left = $false } }
+  $all = $all | Sort-Object Value
+  $rankSum = 0.0
+  $i = 0
+  while ($i -lt $all.Count) {
+    $j = $i
+    while ($j + 1 -lt $all.Count -and $all[$j + 1].Value -eq $all[$i].Value) {
+      $j++
+    }
+    $rank = ($i + $j) / 2.0 + 1.0
+    for ($k = $i; $k -le $j; $k++) {
+      if ($all[$k].Left) {
+        $rankSum += $rank
+      }
+    }
+    $i = $j + 1
+  }
+  $n1 = $Left.Count
+  $n2 = $Right.Count
+  $u = $rankSum - $n1 * ($n1 + 1) / 2.0
+  $mean = $n1 * $n2 / 2.0
+  $sigma = [math]::Sqrt($n1 * $n2 * ($n1 + $n2 + 1) / 12.0)
+  if ($sigma -eq 0) {
+    return 1.0
+  }
+  $z = ([math]::Abs($u - $mean) - 0.5) / $sigma
+  if ($z -lt 0) {
+    $z = 0
+  }
+  return 2.0 * (1.0 - (Get-NormalCdf $z))
+}
+
+$contextFields = @('host_name', 'num_cpus', 'library_build_type', 'sierra_build_type', 'sierra_compiler',
+                   'sierra_max_size')
+
+function Test-Context {
+  $left = (Get-Content -LiteralPath $Baseline -Raw | ConvertFrom-Json).context
+  $right = (Get-Content -LiteralPath $Current -Raw | ConvertFrom-Json).context
+  $problems = @()
+  foreach ($field in $contextFields) {
+    $a = if ($left) { $left.$field } else { $null }
+    $b = if ($right) { $right.$field } else { $null }
+    if ("$a" -ne "$b") {
+      $problems += "$field differs: baseline '$a', current '$b'"
+    }
+  }
+  foreach ($field in @('library_build_type', 'sierra_build_type')) {
+    foreach ($side in @(@('baseline', $left), @('current', $right))) {
+      if ($side[1] -and $side[1].$field -eq 'debug') {
+        $problems += "$($side[0]) was measured with $field = debug"
+      }
+    }
+  }
+  if ($problems.Count -eq 0) {
+    return
+  }
+  foreach ($problem in $problems) {
+    Write-Warning "[compare] $problem"
+  }
+  if (-not $IgnoreContext) {
+    Write-Host "[compare] runs are not comparable; regenerate the baseline on the reference machine or pass -IgnoreContext"
+    exit 2
+  }
+}
+
+$base = Read-Samples $Baseline
+$curr = Read-Samples $Current
+Test-Context
+
+$rows = @()
+$regressions = 0
+foreach ($name in ($curr.Keys | Sort-Object)) {
+  if (-not $base.ContainsKey($name)) {
+    $rows += [pscustomobject]@{ Benchmark = $name; Baseline = ''; Current = ''; Change = ''; P = ''; Verdict = 'new' }
+    continue
+  }
+  $left = $base[$name].ToArray()
+  $right = $curr[$name].ToArray()
+  $baseMedian = Get-Median $left
+  $currMedian = Get-Median $right
+  $change = if ($baseMedian -gt 0) { $currMedian / $baseMedian - 1.0 } else { 0.0 }
+
+  $p = [double]::NaN
+  $verdict = 'too few samples'
+  if ($left.Count -ge 3 -and $right.Count -ge 3) {
+    $p = Get-MannWhitneyP $left $right
+    if ($p -lt $Alpha -and $change -gt $Threshold) {
+      $verdict = 'REGRESSION'
+      $regressions++
+    } elseif ($p -lt $Alpha -and $change -lt -$Threshold) {
+      $verdict = 'faster'
+    } else {
+      $verdict = 'same'
+    }
+  }
+  $pText = if ([double]::IsNaN($p)) { '' } else { '{0:0.0000}' -f $p }
+  $rows += [pscustomobject]@{
+    Benchmark = $name
+    Baseline = '{0:N1} ns' -f $baseMedian
+    Current = '{0:N1} ns' -f $currMedian
+    Change = '{0:+0.0%;-0.0%;0.0%}' -f $change
+    P = $pText
+    Verdict = $verdict
+  }
+}
+foreach ($name in ($base.Keys | Where-Object { -not $curr.ContainsKey($_) } | Sort-Object)) {
+  $rows += [pscustomobject]@{ Benchmark = $name; Baseline = ''; Current = ''; Change = ''; P = ''; Verdict = 'missing' }
+}
+
+$rows | Format-Table -AutoSize | Out-String -Width 400 | Write-Host
+
+if ($regressions -gt 0) {
+  Write-Host "[compare] $regressions regression(s): $Metric median slower than $($Threshold * 100)% with p < $Alpha"
+  exit 1
+}
+Write-Host "[compare] no significant regressions ($Metric, alpha = $Alpha, threshold = $($Threshold * 100)%)"
+exit 0
@@ -0,0 +1,169 @@
+<#
+.SYNOPSIS
+  Builds (optionally) and runs the SierraStudy.Bench Google Benchmark suite with JSON export.
+
+.PARAMETER Executable
+  Path to the benchmark binary. Defaults to out\x64\Release\SierraStudy.Bench.exe on Windows
+  and out/linux/Release/SierraStudy.Bench elsewhere.
+
+.PARAMETER Build
+  Build the benchmark before running: MSBuild (Release|x64) on Windows, the C++ compiler from
+  $env:CXX (g++ by default) against a system Google Benchmark elsewhere.
+
+.PARAMETER BenchmarkRoot
+  Optional Google Benchmark install prefix for the non-Windows build (adds include/ and lib/).
+
+.PARAMETER Filter
+  Optional --benchmark_filter regular expression.
+
+.PARAMETER Repetitions
+  Repetitions per benchmark; every repetition is kept in the JSON so Compare-Bench.ps1 can test
+  significance. Use at least 5.
+
+.PARAMETER MaxSize
+  Upper bound for the input sizes (SIERRA_BENCH_MAX_SIZE); defaults to 1e8 inside the binary.
+
+.PARAMETER Out
+  JSON output path. Defaults to build/bench/bench-<timestamp>.json.
+
+.PARAMETER Baseline
+  Baseline JSON to compare against after the run (skipped when the file does not exist). Defaults to
+  projects\Bench\baselines\baseline-windows.json on Windows and baseline-linux.json elsewhere:
+  timings from different compilers and machines are not comparable.
+
+.PARAMETER UpdateBaseline
+  Copy the fresh results over -Baseline instead of comparing. Only a full default run is accepted:
+  no -Filter or -MaxSize, at least 10 repetitions and a release build of both the suite and
+  Google Benchmark, so every baseline is measured with the same flags.
+
+.PARAMETER IgnoreContext
+  Forwarded to Compare-Bench.ps1: compare even if the baseline comes from another machine or build.
+
+.PARAMETER AdditionalArgs
+  Additional arguments forwarded to the benchmark binary.
+#>
+param(
+  [string]$Executable,
+
+  [switch]$Build,
+
+  [string]$BenchmarkRoot,
+
+  [string]$Filter,
+
+  [int]$Repetitions = 10,
+
+  [long]$MaxSize,
+
+  [string]$Out,
+
+  [string]$Baseline,
+
+  [switch]$UpdateBaseline,
+
+  [switch]$IgnoreContext,
+
+  [string[]]$AdditionalArgs
+)
+
+$ErrorActionPreference = 'Stop'
+
+$root = (Resolve-Path -LiteralPath (Join-Path $PSScriptRoot '..')).ProviderPath
+$onWindows = $IsWindows -or ($PSVersionTable.PSEdition -eq 'Desktop')
+
+if (-not $Executable) {
+  if ($onWindows) {
+    $Executable = Join-Path $root 'out\x64\Release\SierraStudy.Bench.exe'
+  } else {
+    $Executable = Join-Path $root 'out/linux/Release/SierraStudy.Bench'
+  }
+}
+if (-not $Baseline) {
+  $platform = if ($onWindows) { 'windows' } else { 'linux' }
+  $Baseline = Join-Path $root "projects/Bench/baselines/baseline-$platform.json"
+}
+
+if ($UpdateBaseline -and ($Filter -or $MaxSize -gt 0 -or $Repetitions -lt 10)) {
+  throw 'A baseline must be a full run: drop -Filter and -MaxSize and keep -Repetitions at 10 or more.'
+}
+
+if ($Build) {
+  if ($onWindows) {
+    $msbuildPath = & (Join-Path $PSScriptRoot 'Resolve-Msbuild.ps1') -ThrowIfNotFound
+    $project = Join-Path $root 'projects\Bench\SierraStudy.Bench.vcxproj'
+    Write-Host "[bench] build Release|x64 -> $project"
+    & $msbuildPath $project '/m' '/p:Configuration=Release' '/p:Platform=x64' "/p:SolutionDir=$root\"
+    if ($LASTEXITCODE -ne 0) {
+      throw "MSBuild failed with exit code $LASTEXITCODE."
+    }
+  } else {
+    $compiler = if ($env:CXX) { $env:CXX } else { 'g++' }
+    $sources = @(Get-ChildItem -Path (Join-Path $root 'projects/Core/src') -Filter '*.cpp') +
+               @(Get-ChildItem -Path (Join-Path $root 'projects/Bench/bench') -Filter '*.cpp')
+    $compileArgs = @('-std=c++17', '-O2', '-DNDEBUG', '-pthread',
+                     '-I', (Join-Path $root 'projects/Core/include'))
+    if ($BenchmarkRoot) {
+      $compileArgs += @('-I', (Join-Path $BenchmarkRoot 'include'), '-L', (Join-Path $BenchmarkRoot 'lib'))
+    }
+    $compileArgs += $sources.FullName
+    $compileArgs += @('-o', $Executable, '-lbenchmark', '-pthread')
+    New-Item -ItemType Directory -Force -Path (Split-Path -Parent $Executable) | Out-Null
+    Write-Host "[bench] $compiler -> $Executable"
+    & $compiler @compileArgs
+    if ($LASTEXITCODE -ne 0) {
+      throw "Compiler failed with exit code $LASTEXITCODE."
+    }
+  }
+}
+
+if (-not (Test-Path -LiteralPath $Executable)) {
+  throw "Benchmark executable not found: $Executable"
+}
+
+if (-not $Out) {
+  $outDir = Join-Path $root 'build/bench'
+  New-Item -ItemType Directory -Force -Path $outDir | Out-Null
+  $Out = Join-Path $outDir ("bench-{0}.json" -f (Get-Date -Format 'yyyyMMdd-HHmmss'))
+}
+
+$argsList = @(
+  "--benchmark_out=$Out",
+  '--benchmark_out_format=json',
+  "--benchmark_repetitions=$Repetitions"
+)
+if ($Filter) {
+  $argsList += "--benchmark_filter=$Filter"
+}
+if ($AdditionalArgs) {
+  $argsList += $AdditionalArgs
+}
+if ($MaxSize -gt 0) {
+  $env:SIERRA_BENCH_MAX_SIZE = "$MaxSize"
+}
+
+Write-Host "[bench] $Executable $($argsList -join ' ')"
+& $Executable @argsList
+if ($LASTEXITCODE -ne 0) {
+  throw "Benchmark failed with exit code $LASTEXITCODE."
+}
+Write-Host "[bench] results: $Out"
+
+if ($UpdateBaseline) {
+  $context = (Get-Content -LiteralPath $Out -Raw | ConvertFrom-Json).context
+  if ($context.library_build_type -ne 'release' -or $context.sierra_build_type -ne 'release') {
+    throw "Baseline not updated: library_build_type '$($context.library_build_type)', sierra_build_type '$($context.sierra_build_type)'; both must be release."
+  }
+  New-Item -ItemType Directory -Force -Path (Split-Path -Parent $Baseline) | Out-Null
+  Copy-Item -LiteralPath $Out -Destination $Baseline -Force
+  Write-Host "[bench] baseline updated: $Baseline"
+} elseif (Test-Path -LiteralPath $Baseline) {
+  & (Join-Path $PSScriptRoot 'Compare-Bench.ps1') -Baseline $Baseline -Current $Out -IgnoreContext:$IgnoreContext
+  if ($LASTEXITCODE -eq 2) {
+    throw "Results are not comparable with $Baseline (different machine or build)."
+  }
+  if ($LASTEXITCODE -ne 0) {
+    throw "Performance regressions against $Baseline."
+  }
+} else {
+  Write-Host "[bench] baseline not found, comparison skipped: $Baseline"
+}
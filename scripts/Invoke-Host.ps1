@@ -0,0 +1,161 @@
+<#
+.SYNOPSIS
+  Builds (optionally) and runs SierraStudy.Host — the headless ACSIL host that calls the Wrapper's
+  scsf_* functions outside Sierra Chart and reports time and allocations per call.
+
+.PARAMETER Executable
+  Path to the host binary. Defaults to out\x64\Release\SierraStudy.Host.exe on Windows
+  and out/linux/Release/SierraStudy.Host elsewhere.
+
+.PARAMETER Build
+  Build the host before running: MSBuild (Release|x64) on Windows, the C++ compiler from
+  $env:CXX (g++ by default) elsewhere. The Sierra Chart SDK is not required: the Wrapper is
+  compiled against projects/Host/mock/SierraChart.h.
+
+.PARAMETER Test
+  Build (with -Build) and run SierraStudy.Host.Tests — lifecycle and leak tests of the Wrapper studies
+  under the mock host — instead of the profiling run. The non-Windows build links the system Google Test.
+
+.PARAMETER Study
+  Study name registered in projects/Host/src/main.cpp (MovingAverage by default).
+
+.PARAMETER Bars
+  History bars for the full recalculation.
+
+.PARAMETER Scid
+  Optional .scid file; its last -Updates records are replayed as live updates.
+
+.PARAMETER Updates
+  Live updates after the full recalculation.
+
+.PARAMETER TicksPerBar
+  Live updates per bar: every K-th update appends a new bar, the rest update the last one.
+
+.PARAMETER Replay
+  Call recording made in Sierra Chart with the chart menu "SierraStudy: Start Capture"
+  (Logs\SierraStudy.<chart>.<instance>.calls.bin). The host replays the recorded calls instead of the
+  synthetic or .scid workload and fails if the study outputs differ from the recording.
+
+.PARAMETER Trace
+  Path of a Chrome trace-event JSON file (chrome://tracing, Perfetto) with the Wrapper and Core spans of the run.
+  With -Build the host is compiled with SIERRA_ENABLE_TRACE (MSBuild: /p:SierraTrace=true); otherwise the
+  executable must already be built with it.
+
+.PARAMETER AdditionalArgs
+  Additional arguments forwarded to the host (e.g. '--input', '0=50', '--log').
+#>
+param(
+  [string]$Executable,
+
+  [switch]$Build,
+
+  [switch]$Test,
+
+  [string]$Study = 'MovingAverage',
+
+  [long]$Bars = 20000,
+
+  [string]$Scid,
+
+  [long]$Updates = 1000,
+
+  [long]$TicksPerBar = 10,
+
+  [string]$Replay,
+
+  [string]$Trace,
+
+  [string[]]$AdditionalArgs
+)
+
+$ErrorActionPreference = 'Stop'
+
+$root = (Resolve-Path -LiteralPath (Join-Path $PSScriptRoot '..')).ProviderPath
+$onWindows = $IsWindows -or ($PSVersionTable.PSEdition -eq 'Desktop')
+
+$targetName = if ($Test) { 'SierraStudy.Host.Tests' } else { 'SierraStudy.Host' }
+if (-not $Executable) {
+  if ($onWindows) {
+    $Executable = Join-Path $root "out\x64\Release\$targetName.exe"
+  } else {
+    $Executable = Join-Path $root "out/linux/Release/$targetName"
+  }
+}
+
+if ($Build) {
+  if ($onWindows) {
+    $msbuildPath = & (Join-Path $PSScriptRoot 'Resolve-Msbuild.ps1') -ThrowIfNotFound
+    $project = Join-Path $root "projects\Host\$targetName.vcxproj"
+    Write-Host "[host] build Release|x64 -> $project"
+    $msbuildArgs = @($project, '/m', '/p:Configuration=Release', '/p:Platform=x64', "/p:SolutionDir=$root\")
+    if ($Trace) {
+      $msbuildArgs += '/p:SierraTrace=true'
+    }
+    & $msbuildPath @msbuildArgs
+    if ($LASTEXITCODE -ne 0) {
+      throw "MSBuild failed with exit code $LASTEXITCODE."
+    }
+  } else {
+    $compiler = if ($env:CXX) { $env:CXX } else { 'g++' }
+    $sources = @(Get-ChildItem -Path (Join-Path $root 'projects/Core/src') -Filter '*.cpp') +
+               @(Get-ChildItem -Path (Join-Path $root 'projects/Wrapper/src') -Filter '*.cpp') +
+               @(Get-ChildItem -Path (Join-Path $root 'projects/Host/src') -Filter '*.cpp')
+    if ($Test) {
+      $sources = @($sources | Where-Object { $_.Name -ne 'main.cpp' }) +
+                 @(Get-ChildItem -Path (Join-Path $root 'projects/Host/tests') -Filter '*.cpp')
+    }
+    # Каталог mock идёт первым, чтобы #include "SierraChart.h" обёртки попал в заглушку SDK.
+    $compileArgs = @('-std=c++17', '-O2', '-DNDEBUG', '-pthread',
+                     '-I', (Join-Path $root 'projects/Host/mock'),
+                     '-I', (Join-Path $root 'projects/Host/include'),
+                     '-I', (Join-Path $root 'projects/Wrapper/include'),
+                     '-I', (Join-Path $root 'projects/Core/include'))
+    if ($Trace) {
+      $compileArgs += '-DSIERRA_ENABLE_TRACE'
+    }
+    $compileArgs += $sources.FullName
+    $compileArgs += @('-o', $Executable, '-pthread')
+    if ($Test) {
+      $compileArgs += @('-lgtest', '-lgtest_main')
+    }
+    New-Item -ItemType Directory -Force -Path (Split-Path -Parent $Executable) | Out-Null
+    Write-Host "[host] $compiler -> $Executable"
+    & $compiler @compileArgs
+    if ($LASTEXITCODE -ne 0) {
+      throw "Compiler failed with exit code $LASTEXITCODE."
+    }
+  }
+}
+
+if (-not (Test-Path -LiteralPath $Executable)) {
+  throw "Host executable not found: $Executable"
+}
+
+if ($Test) {
+  Write-Host "[host] $Executable"
+  & $Executable
+  if ($LASTEXITCODE -ne 0) {
+    throw "Host tests failed with exit code $LASTEXITCODE."
+  }
+  return
+}
+
+$argsList = @('--study', $Study, '--bars', "$Bars", '--updates', "$Updates", '--ticks-per-bar', "$TicksPerBar")
+if ($Scid) {
+  $argsList += @('--scid', $Scid)
+}
+if ($Replay) {
+  $argsList += @('--replay', $Replay)
+}
+if ($Trace) {
+  $argsList += @('--trace', $Trace)
+}
+if ($AdditionalArgs) {
+  $argsList += $AdditionalArgs
+}
+
+Write-Host "[host] $Executable $($argsList -join ' ')"
+& $Executable @argsList
+if ($LASTEXITCODE -ne 0) {
+  throw "Host failed with exit code $LASTEXITCODE."
+}